@@ -4,13 +4,12 @@ in vec3 vN, vL, vE;
 in vec2 vST;
 in vec3 vModelPos;
 
-uniform sampler2D uNoise;
-uniform sampler2D uNoiseMask;
-uniform float uBumpTime;
-uniform float uSpinTime;
-uniform float uBulbTime;
+// uLightPos and the u*Time animation values come from the FrameUniforms block,
+// which GLSLProgram adds to every shader
 
-const float M_PI = 3.141593;
+uniform sampler2DArray uNoiseLayers;		// NOISE_LAYER, NOISE_MASK_LAYER, WHOOSH_LAYER
+
+#include "common.glsl"
 
 vec3 
 RotateNormal(float angx, float angy, float angz, vec3 n)
@@ -54,12 +53,12 @@ main()
 {
 	float noiseFreq = .01;
 	float noiseAmp = .1;
-	vec4 nv = texture2D(uNoise, vST);
+	vec4 nv = texture(uNoiseLayers, vec3(vST, NOISE_LAYER));
 	float flowT = fract(vST.t - uSpinTime);
 	float flowS = fract(vST.s - uBulbTime);
 	float flow = fract(sqrt(flowT * flowT + flowS * flowS));
 	float seed = 235.534 * flow * noiseFreq * uBulbTime;
-	float n = fract(8. * sin(seed * M_PI) + 4. * sin(seed * 4. * M_PI) + 2. * sin(seed * 8. * M_PI) + sin(seed * 16. * M_PI));	// range is 0. -> 1.
+	float n = fract(BakedSineSeries(seed));	// range is 0. -> 1.
 	n *= 2.;	// range is 0. -> 2.									
 	n -= 1.;	// range is -1. -> 1.
 	n *= noiseAmp;
@@ -77,10 +76,10 @@ main()
 	float t = smoothstep(stripeThick - tol, stripeThick + tol, ds);
 	color = mix(vec3(18. / 255., 69. / 255., 1.), vec3(1.), t);	//50. / 255., 131. / 255., 168. / 255.
 
-	float mask =  texture2D(uNoiseMask, vec2((vST.s - uBulbTime), sin(flowT * 2. * M_PI))).g;
+	float mask =  texture(uNoiseLayers, vec3((vST.s - uBulbTime), sin(flowT * 2. * M_PI), NOISE_MASK_LAYER)).g;
 	color = mix(vec3(1.), color, mask);//205. / 255., 242. / 255., 250. / 255.
 
-	float mask2 = texture2D(uNoiseMask, vec2((vST.s + uBulbTime) * 10., flowT * 10.)).r;
+	float mask2 = texture(uNoiseLayers, vec3((vST.s + uBulbTime) * 10., flowT * 10., NOISE_MASK_LAYER)).r;
 	color = mix(vec3(0., 204. / 255., 1.), color, mask2);	//20. / 255., 69. / 255., 1.
 
 	
@@ -88,7 +87,7 @@ main()
 	// Get X-angle
 	float bumpFreq = 10.;
 	float bumpAmp = .5;
-	vec4 bV = texture(uNoise, vST * bumpFreq - uBumpTime * bumpFreq);
+	vec4 bV = texture(uNoiseLayers, vec3(vST * bumpFreq - uBumpTime * bumpFreq, NOISE_LAYER));
 	//float noise = fract(sin(bV.r * 2. * M_PI) + sin(bV.g * 4. * M_PI) / 2. + sin(bV.b * 8. * M_PI) / 4. + sin(bV.a * 16. * M_PI) / 8.);
 	bV *= 2.;
 	bV -= 1.;
@@ -106,17 +105,5 @@ main()
 	float kS = 0.2;
 	float shininess = 500.;
 
-	vec3 ambient = kA * color;
-	float d = max(dot(Normal, Light), 0.);
-	vec3 diffuse = kD * d * color;
-
-	float s = 0.;
-	if(dot(Normal, Light) > 0.)
-	{
-		vec3 ref = normalize(reflect(-Light, Normal));
-		s = pow(max(dot(Eye, ref), 0.), shininess);
-	}
-	vec3 specular = kS * s * vec3(1., 1., 1.);
-
-	gl_FragColor = vec4(vec3(ambient + diffuse + specular), 1.);
+	gl_FragColor = vec4(Lighting(color, Normal, Light, Eye, kA, kD, kS, shininess), 1.);
 }
\ No newline at end of file
@@ -1,15 +1,23 @@
 #version 330 compatibility
 
-uniform vec3	uLightPos;
-uniform float	uBulbTime;
-uniform float	uSpinTime;
-uniform int		uIsWhoosh;
+// uLightPos and the u*Time animation values come from the FrameUniforms block,
+// which GLSLProgram adds to every shader
+
+// IS_WHOOSH is set when the program is created:
+// the whoosh variant pushes the surface out along the normal
+
+// the matrices are the view's (see views.glsl), which are the fixed-function ones unless MULTIVIEW is set
+
+#ifndef IS_WHOOSH
+#define IS_WHOOSH	0
+#endif
 
 out vec3 vN, vL, vE;
 out vec2 vST;
 out vec3 vModelPos;
 
-const float M_PI = 3.141593;
+#include "common.glsl"
+#include "views.glsl"
 
 void 
 main()
@@ -44,17 +52,18 @@ main()
 	normal.x *= (1 + mbT * 0.05 + 0.0075 * cos(bulbS * 2. * M_PI * 10.));
 	normal.y *= (1 + mbT * 0.05 + 0.0075 * sin(bulbS * 2. * M_PI * 10.));
 	normal = normalize(normal);
+#if IS_WHOOSH
 	float whooshScale = 0.05;
-	vModelPos.x += (float(uIsWhoosh) * normal.x * whooshScale);
-	vModelPos.y += (float(uIsWhoosh) * normal.y * whooshScale);
-	vModelPos.z += (float(uIsWhoosh) * normal.z * whooshScale);
+	vModelPos += normal * whooshScale;
+#endif
 
 	// Set lighting outs
-	vN = normalize(gl_NormalMatrix * normal);//gl_Normal);
-	vec3 worldPos = (gl_ModelViewMatrix * vec4(vModelPos, 1.)).xyz;
+	vN = normalize(ViewNormalMatrix * normal);//gl_Normal);
+	vec3 worldPos = (ViewModelViewMatrix * vec4(vModelPos, 1.)).xyz;
 	vL = uLightPos - worldPos;
 	vE = vec3(0.) - worldPos;
 
 	// Set position
-	gl_Position = gl_ModelViewProjectionMatrix * vec4(vModelPos, 1.);
+	gl_Position = ViewModelViewProjectionMatrix * vec4(vModelPos, 1.);
+	SetViewLayer();
 }
\ No newline at end of file
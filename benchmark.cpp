@@ -0,0 +1,360 @@
+#include "benchmark.h"
+#include "framescheduler.h"
+
+#include <math.h>
+#include <algorithm>
+
+
+Benchmark *		Benchmark::Active = NULL;
+
+
+Benchmark::Benchmark( )
+{
+	Warmup = BENCH_DEFAULT_WARMUP;
+	Frames = BENCH_DEFAULT_FRAMES;
+	Apply = NULL;
+	Current = 0;
+	Frame = 0;
+	Measuring = false;
+	FrameStart = 0.;
+	CanTime = false;
+	Done = false;
+	Verbose = false;
+}
+
+
+Benchmark::~Benchmark( )
+{
+	if( ! Queries.empty( ) )
+		glDeleteQueries( (GLsizei)Queries.size( ), &Queries[0] );
+	if( Active == this )
+		Active = NULL;
+}
+
+
+// the matrix -- every path is run at every particle count and every level of detail
+// (with none added, the program's own setting is used, which Apply( ) sees as a -1):
+
+void
+Benchmark::AddLod( int lod )
+{
+	Lods.push_back( lod );
+}
+
+
+void
+Benchmark::AddParticleCount( int particles )
+{
+	ParticleCounts.push_back( particles );
+}
+
+
+// a path the camera moves along, evenly over the measured frames (it sits at from during the warmup):
+
+void
+Benchmark::AddPath( const char *name, BenchCamera from, BenchCamera to )
+{
+	Path p;
+	p.Name = name;
+	p.From = from;
+	p.To = to;
+	Paths.push_back( p );
+}
+
+
+// call after the frame's swap:
+
+void
+Benchmark::EndFrame( )
+{
+	if( Done  ||  ! Measuring )
+		return;
+
+	Run &r = Runs[Current];
+	r.Cpu.push_back( 1000. * ( FrameScheduler::Now( ) - FrameStart ) );
+	if( CanTime )
+		glQueryCounter( Queries[ 2*( Frame-1-Warmup ) + 1 ], GL_TIMESTAMP );
+	Measuring = false;
+}
+
+
+// the run is over -- read back its gpu times (this is the only place that waits for them), and print it:
+
+void
+Benchmark::FinishRun( )
+{
+	Run &r = Runs[Current];
+	if( CanTime )
+	{
+		for( int i = 0; i < Frames; i++ )
+		{
+			GLuint64 t0, t1;
+			glGetQueryObjectui64v( Queries[2*i], GL_QUERY_RESULT, &t0 );
+			glGetQueryObjectui64v( Queries[2*i+1], GL_QUERY_RESULT, &t1 );
+			r.Gpu.push_back( t1 > t0 ? (double)( t1 - t0 ) / 1000000. : 0. );
+		}
+	}
+
+	if( Verbose )
+	{
+		fprintf( stderr, "Benchmark: %d/%d: %-10s %6d particles, lod %2d: %7.1f fps, cpu p50 %6.2f ms, gpu p50 %6.2f ms\n",
+			Current+1, (int)Runs.size( ), Paths[r.Path].Name.c_str( ), r.Particles, r.Lod,
+			Fps( r.Interval ),
+			Percentile( r.Cpu, 0.5 ), Percentile( r.Gpu, 0.5 ) );
+	}
+}
+
+
+// frames per second, from the times between them:
+
+double
+Benchmark::Fps( const std::vector<double> &intervals )
+{
+	double sum = 0.;
+	for( int i = 0; i < (int)intervals.size( ); i++ )
+		sum += intervals[i];
+	return sum > 0. ? 1000. * (double)intervals.size( ) / sum : 0.;
+}
+
+
+int
+Benchmark::FrameBeginCB( int ticks )
+{
+	return Active != NULL ? Active->FrameBegin( ticks ) : ticks;
+}
+
+
+// a frame is starting -- set it up, and have it run exactly one tick, whatever the clock says:
+
+int
+Benchmark::FrameBegin( int ticks )
+{
+	if( Done )
+		return ticks;
+
+	double now = FrameScheduler::Now( );
+	if( Frame > Warmup )
+		Runs[Current].Interval.push_back( 1000. * ( now - FrameStart ) );
+
+	if( Frame == Warmup + Frames )
+	{
+		FinishRun( );
+		Current++;
+		Frame = 0;
+		if( Current >= (int)Runs.size( ) )
+		{
+			Done = true;
+			Measuring = false;
+			return ticks;
+		}
+	}
+
+	Run &r = Runs[Current];
+	const Path &p = Paths[r.Path];
+	float t = 0.;
+	if( Frame >= Warmup  &&  Frames > 1 )
+		t = (float)( Frame - Warmup ) / (float)( Frames - 1 );
+	BenchCamera c;
+	c.Xrot  = p.From.Xrot  + t * ( p.To.Xrot  - p.From.Xrot );
+	c.Yrot  = p.From.Yrot  + t * ( p.To.Yrot  - p.From.Yrot );
+	c.Scale = p.From.Scale + t * ( p.To.Scale - p.From.Scale );
+	( *Apply )( c, r.Particles, r.Lod, Frame == 0 );
+
+	// (the time starts after Apply( ), so a run's first frame does not count what it did)
+	Measuring = Frame >= Warmup;
+	FrameStart = FrameScheduler::Now( );
+	if( Measuring  &&  CanTime )
+		glQueryCounter( Queries[ 2*( Frame-Warmup ) ], GL_TIMESTAMP );
+	Frame++;
+	return 1;
+}
+
+
+bool
+Benchmark::IsDone( )
+{
+	return Done;
+}
+
+
+// the nearest-rank percentile (p is from 0. to 1.):
+
+double
+Benchmark::Percentile( const std::vector<double> &values, double p )
+{
+	if( values.empty( ) )
+		return 0.;
+	std::vector<double> sorted( values );
+	std::sort( sorted.begin( ), sorted.end( ) );
+	int n = (int)sorted.size( );
+	int i = (int)ceil( p * (double)n ) - 1;
+	return sorted[ std::max( 0, std::min( n-1, i ) ) ];
+}
+
+
+// print a table of all the runs:
+
+void
+Benchmark::Report( FILE *fp )
+{
+	fprintf( fp, "Benchmark: %d runs of %d frames (after %d of warmup) on %s\n", (int)Runs.size( ), Frames, Warmup, Renderer.c_str( ) );
+	fprintf( fp, "%-10s %9s %4s %8s   %-22s   %-22s   %-22s\n", "path", "particles", "lod", "fps",
+		"cpu ms p50/p95/p99", "gpu ms p50/p95/p99", "frame ms p50/p95/p99" );
+	for( int i = 0; i < (int)Runs.size( ); i++ )
+	{
+		Run &r = Runs[i];
+		fprintf( fp, "%-10s %9d %4d %8.1f   %6.2f %6.2f %6.2f   %6.2f %6.2f %6.2f   %6.2f %6.2f %6.2f\n",
+			Paths[r.Path].Name.c_str( ), r.Particles, r.Lod,
+			Fps( r.Interval ),
+			Percentile( r.Cpu, 0.50 ), Percentile( r.Cpu, 0.95 ), Percentile( r.Cpu, 0.99 ),
+			Percentile( r.Gpu, 0.50 ), Percentile( r.Gpu, 0.95 ), Percentile( r.Gpu, 0.99 ),
+			Percentile( r.Interval, 0.50 ), Percentile( r.Interval, 0.95 ), Percentile( r.Interval, 0.99 ) );
+	}
+}
+
+
+// frames per run to warm up with, and then to measure:
+
+void
+Benchmark::SetFrames( int warmup, int frames )
+{
+	Warmup = warmup >= 0 ? warmup : 0;
+	Frames = frames > 0 ? frames : 1;
+}
+
+
+// print each run as it finishes:
+
+void
+Benchmark::SetVerbose( bool v )
+{
+	Verbose = v;
+}
+
+
+// make the runs out of the paths and the matrix, and start the first one -- call with the context current,
+// and then have the frame loop call FrameBegin( ) (or give FrameBeginCB to the FrameScheduler):
+// returns false if there is nothing to run
+
+bool
+Benchmark::Start( BenchApplyFunc apply )
+{
+	Apply = apply;
+	if( Apply == NULL  ||  Paths.empty( ) )
+	{
+		fprintf( stderr, "Benchmark: no paths to run\n" );
+		Done = true;
+		return false;
+	}
+	if( ParticleCounts.empty( ) )
+		ParticleCounts.push_back( -1 );
+	if( Lods.empty( ) )
+		Lods.push_back( -1 );
+
+	// the level of detail goes slowest, since changing it is what costs the most:
+	Runs.clear( );
+	for( int l = 0; l < (int)Lods.size( ); l++ )
+		for( int n = 0; n < (int)ParticleCounts.size( ); n++ )
+			for( int p = 0; p < (int)Paths.size( ); p++ )
+			{
+				Run r;
+				r.Path = p;
+				r.Particles = ParticleCounts[n];
+				r.Lod = Lods[l];
+				Runs.push_back( r );
+			}
+
+	const char *renderer = (const char *)glGetString( GL_RENDERER );
+	Renderer = renderer != NULL ? renderer : "an unknown renderer";
+	CanTime = GLEW_VERSION_3_3  ||  GLEW_ARB_timer_query;
+	if( CanTime )
+	{
+		Queries.resize( 2*Frames );
+		glGenQueries( 2*Frames, &Queries[0] );
+	}
+	else
+	{
+		fprintf( stderr, "Benchmark: no timer queries -- the gpu times will all be 0\n" );
+	}
+
+	Current = 0;
+	Frame = 0;
+	Done = false;
+	Active = this;
+	fprintf( stderr, "Benchmark: %d runs of %d+%d frames\n", (int)Runs.size( ), Warmup, Frames );
+	return true;
+}
+
+
+// one line per run:
+
+bool
+Benchmark::WriteCsv( const char *file )
+{
+	FILE *fp = fopen( file, "w" );
+	if( fp == NULL )
+	{
+		fprintf( stderr, "Benchmark: cannot create '%s'\n", file );
+		return false;
+	}
+
+	fprintf( fp, "path,particles,lod,frames,fps,cpu_p50,cpu_p95,cpu_p99,gpu_p50,gpu_p95,gpu_p99,frame_p50,frame_p95,frame_p99\n" );
+	for( int i = 0; i < (int)Runs.size( ); i++ )
+	{
+		Run &r = Runs[i];
+		fprintf( fp, "%s,%d,%d,%d,%.2f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n",
+			Paths[r.Path].Name.c_str( ), r.Particles, r.Lod, (int)r.Cpu.size( ),
+			Fps( r.Interval ),
+			Percentile( r.Cpu, 0.50 ), Percentile( r.Cpu, 0.95 ), Percentile( r.Cpu, 0.99 ),
+			Percentile( r.Gpu, 0.50 ), Percentile( r.Gpu, 0.95 ), Percentile( r.Gpu, 0.99 ),
+			Percentile( r.Interval, 0.50 ), Percentile( r.Interval, 0.95 ), Percentile( r.Interval, 0.99 ) );
+	}
+	fclose( fp );
+	return true;
+}
+
+
+// the same, with what it was run on:
+
+bool
+Benchmark::WriteJson( const char *file )
+{
+	FILE *fp = fopen( file, "w" );
+	if( fp == NULL )
+	{
+		fprintf( stderr, "Benchmark: cannot create '%s'\n", file );
+		return false;
+	}
+
+	// (the renderer string is the only one that is not ours, so it is the only one that might need escaping)
+	std::string renderer;
+	for( size_t i = 0; i < Renderer.size( ); i++ )
+	{
+		if( Renderer[i] == '"'  ||  Renderer[i] == '\\' )
+			renderer += '\\';
+		renderer += Renderer[i];
+	}
+
+	fprintf( fp, "{\n" );
+	fprintf( fp, "  \"renderer\": \"%s\",\n", renderer.c_str( ) );
+	fprintf( fp, "  \"warmup\": %d,\n", Warmup );
+	fprintf( fp, "  \"frames\": %d,\n", Frames );
+	fprintf( fp, "  \"runs\": [\n" );
+	for( int i = 0; i < (int)Runs.size( ); i++ )
+	{
+		Run &r = Runs[i];
+		fprintf( fp, "    { \"path\": \"%s\", \"particles\": %d, \"lod\": %d, \"fps\": %.2f,\n",
+			Paths[r.Path].Name.c_str( ), r.Particles, r.Lod, Fps( r.Interval ) );
+		fprintf( fp, "      \"cpu_ms\":   { \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f },\n",
+			Percentile( r.Cpu, 0.50 ), Percentile( r.Cpu, 0.95 ), Percentile( r.Cpu, 0.99 ) );
+		fprintf( fp, "      \"gpu_ms\":   { \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f },\n",
+			Percentile( r.Gpu, 0.50 ), Percentile( r.Gpu, 0.95 ), Percentile( r.Gpu, 0.99 ) );
+		fprintf( fp, "      \"frame_ms\": { \"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f } }%s\n",
+			Percentile( r.Interval, 0.50 ), Percentile( r.Interval, 0.95 ), Percentile( r.Interval, 0.99 ),
+			i < (int)Runs.size( ) - 1 ? "," : "" );
+	}
+	fprintf( fp, "  ]\n" );
+	fprintf( fp, "}\n" );
+	fclose( fp );
+	return true;
+}
@@ -0,0 +1,106 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdio.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "glew.h"
+#include <GL/gl.h>
+
+#include <string>
+#include <vector>
+
+
+#define BENCH_DEFAULT_WARMUP	60			// frames per run that are drawn but not measured
+#define BENCH_DEFAULT_FRAMES	300			// frames per run that are measured
+
+
+// where the camera is, in the program's own terms:
+struct BenchCamera
+{
+	float		Xrot, Yrot;		// degrees
+	float		Scale;
+};
+
+
+// set up one frame of a run: the camera, and what to draw -- first is true on a run's first (warmup) frame,
+// which is when anything expensive, like rebuilding a mesh, should be done:
+typedef void (*BenchApplyFunc)( const BenchCamera &, int particles, int lod, bool first );
+
+
+// a scripted benchmark: every camera path is run at every particle count and every level of detail,
+// each run being some warmup frames and then some measured ones
+//
+// the program's frame loop calls FrameBegin( ) as each frame starts (it is a FrameBeginFunc, so the
+// FrameScheduler can call it) -- that moves the camera along the path, and has every frame run exactly one
+// simulation tick, so the frames drawn do not depend on how fast they are -- and EndFrame( ) after the swap
+//
+// for each measured frame it keeps the cpu time from FrameBegin( ) to EndFrame( ), the gpu time between two
+// timestamps at the same points (read back only once the run is over, so they never stall it), and the time
+// from that frame's start to the next one's
+// Report( ), WriteCsv( ), and WriteJson( ) give the 50th, 95th, and 99th percentiles of each, and the frame rate
+
+class Benchmark
+{
+    private:
+	struct Path
+	{
+		std::string		Name;
+		BenchCamera		From, To;
+	};
+
+	struct Run
+	{
+		int			Path;
+		int			Particles;
+		int			Lod;
+		std::vector<double>	Cpu, Gpu, Interval;	// milliseconds
+	};
+
+	std::vector<Path>	Paths;
+	std::vector<int>	ParticleCounts;
+	std::vector<int>	Lods;
+	std::vector<Run>	Runs;
+	int			Warmup, Frames;
+	BenchApplyFunc		Apply;
+	std::string		Renderer;
+
+	int			Current;		// run
+	int			Frame;			// of the current run, counting the warmup
+	bool			Measuring;		// this frame is one of the measured ones
+	double			FrameStart;
+	std::vector<GLuint>	Queries;		// two timestamps per measured frame
+	bool			CanTime;
+	bool			Done;
+	bool			Verbose;
+
+	static Benchmark *	Active;
+
+	void			FinishRun( );
+	static double		Fps( const std::vector<double> & );
+	static double		Percentile( const std::vector<double> &, double );
+
+    public:
+	Benchmark( );
+	~Benchmark( );
+
+	void			AddLod( int );
+	void			AddParticleCount( int );
+	void			AddPath( const char *, BenchCamera, BenchCamera );
+	void			EndFrame( );
+	int			FrameBegin( int );
+	bool			IsDone( );
+	void			Report( FILE * = stderr );
+	void			SetFrames( int, int );
+	void			SetVerbose( bool );
+	bool			Start( BenchApplyFunc );
+	bool			WriteCsv( const char * );
+	bool			WriteJson( const char * );
+
+	static int		FrameBeginCB( int );
+};
+
+#endif		// #ifndef BENCHMARK_H
@@ -0,0 +1,449 @@
+#include "bmpimage.h"
+
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define BMP_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define BMP_TARGET(t)
+#else
+#define BMP_TARGET(t)	__attribute__((target(t)))
+#endif
+#endif
+
+
+// the parts of the headers that matter, as byte offsets into the file:
+
+#define BMP_FILE_HEADER_SIZE	14
+#define BMP_INFO_HEADER_SIZE	40
+#define BMP_OFF_BITS		10
+#define BMP_BI_SIZE		14
+#define BMP_BI_WIDTH		18
+#define BMP_BI_HEIGHT		22
+#define BMP_BI_PLANES		26
+#define BMP_BI_BIT_COUNT	28
+#define BMP_BI_COMPRESSION	30
+#define BMP_BI_CLR_USED		46
+#define BMP_MASKS		54		// red, green, blue, and (v3 headers and later) alpha masks
+
+#define BMP_BI_RGB		0
+#define BMP_BI_BITFIELDS	3
+
+#define BMP_MAX_DIMENSION	32768
+
+
+static unsigned int
+Le32( const unsigned char *p )
+{
+	return (unsigned int)p[0]  |  ( (unsigned int)p[1] << 8 )  |  ( (unsigned int)p[2] << 16 )  |  ( (unsigned int)p[3] << 24 );
+}
+
+static unsigned short
+Le16( const unsigned char *p )
+{
+	return (unsigned short)( p[0]  |  ( p[1] << 8 ) );
+}
+
+
+// one pixel at a time -- the tail of every row, and all of it on a cpu without ssse3:
+// (the file stores b, g, r[, a]; swap turns that into r, g, b[, a], and alpha is or'ed into the a's)
+
+static void
+ScalarRow( const unsigned char *src, int srcBytes, unsigned char *dst, int dstBytes, int width, bool swap, unsigned char alpha )
+{
+	for( int s = 0; s < width; s++, src += srcBytes, dst += dstBytes )
+	{
+		unsigned char b = src[0];
+		unsigned char g = src[1];
+		unsigned char r = src[2];
+		dst[0] = swap ? r : b;
+		dst[1] = g;
+		dst[2] = swap ? b : r;
+		if( dstBytes == 4 )
+			dst[3] = ( srcBytes == 4 ? src[3] : 255 )  |  alpha;
+	}
+}
+
+
+#ifdef BMP_X86
+
+// the pshufb mask that takes the pixels of one 16-byte load to one 16-byte store:
+// 3 -> 3 bytes moves 5 pixels (the 16th byte is garbage that the next store overwrites), everything else moves 4
+
+static int
+ShuffleMask( int srcBytes, int dstBytes, bool swap, unsigned char mask[16], unsigned char ormask[16] )
+{
+	int pixels = ( srcBytes == 3  &&  dstBytes == 3 ) ? 5 : 4;
+	memset( mask, 0x80, 16 );
+	memset( ormask, 0, 16 );
+	for( int p = 0; p < pixels; p++ )
+	{
+		unsigned char *d = &mask[ p * dstBytes ];
+		int s = p * srcBytes;
+		d[0] = (unsigned char)( swap ? s + 2 : s );
+		d[1] = (unsigned char)( s + 1 );
+		d[2] = (unsigned char)( swap ? s : s + 2 );
+		if( dstBytes == 4 )
+		{
+			if( srcBytes == 4 )
+				d[3] = (unsigned char)( s + 3 );
+			else
+				ormask[ p * 4 + 3 ] = 255;
+		}
+	}
+	return pixels;
+}
+
+
+// every 16-byte load and store stays inside the row as long as at least 6 pixels are left:
+
+BMP_TARGET("ssse3")
+static void
+Ssse3Row( const unsigned char *src, int srcBytes, unsigned char *dst, int dstBytes, int width, bool swap, unsigned char alpha )
+{
+	unsigned char m[16], o[16];
+	int pixels = ShuffleMask( srcBytes, dstBytes, swap, m, o );
+	if( dstBytes == 4 )
+		o[3] |= alpha,  o[7] |= alpha,  o[11] |= alpha,  o[15] |= alpha;
+	__m128i mask = _mm_loadu_si128( (const __m128i *)m );
+	__m128i ormask = _mm_loadu_si128( (const __m128i *)o );
+
+	int s = 0;
+	for( ; s + 6 <= width; s += pixels )
+	{
+		__m128i v = _mm_loadu_si128( (const __m128i *)&src[ s * srcBytes ] );
+		v = _mm_or_si128( _mm_shuffle_epi8( v, mask ), ormask );
+		_mm_storeu_si128( (__m128i *)&dst[ s * dstBytes ], v );
+	}
+	ScalarRow( &src[ s * srcBytes ], srcBytes, &dst[ s * dstBytes ], dstBytes, width - s, swap, alpha );
+}
+
+
+// 32 -> 32 bits only: vpshufb shuffles within each 128-bit half, which 4-byte pixels never cross:
+
+BMP_TARGET("avx2")
+static void
+Avx2Row( const unsigned char *src, unsigned char *dst, int width, bool swap, unsigned char alpha )
+{
+	unsigned char m[16], o[16];
+	ShuffleMask( 4, 4, swap, m, o );
+	o[3] = o[7] = o[11] = o[15] = alpha;
+	__m256i mask = _mm256_broadcastsi128_si256( _mm_loadu_si128( (const __m128i *)m ) );
+	__m256i ormask = _mm256_broadcastsi128_si256( _mm_loadu_si128( (const __m128i *)o ) );
+
+	int s = 0;
+	for( ; s + 8 <= width; s += 8 )
+	{
+		__m256i v = _mm256_loadu_si256( (const __m256i *)&src[ 4*s ] );
+		v = _mm256_or_si256( _mm256_shuffle_epi8( v, mask ), ormask );
+		_mm256_storeu_si256( (__m256i *)&dst[ 4*s ], v );
+	}
+	ScalarRow( &src[ 4*s ], 4, &dst[ 4*s ], 4, width - s, swap, alpha );
+}
+
+#endif		// #ifdef BMP_X86
+
+
+static void
+ConvertRow( const unsigned char *src, int srcBytes, unsigned char *dst, int dstBytes, int width, bool swap, unsigned char alpha, int simd )
+{
+	if( srcBytes == dstBytes  &&  ! swap  &&  alpha == 0 )
+	{
+		memcpy( dst, src, width * dstBytes );
+		return;
+	}
+#ifdef BMP_X86
+	if( simd >= BMP_SIMD_AVX2  &&  srcBytes == 4  &&  dstBytes == 4 )
+	{
+		Avx2Row( src, dst, width, swap, alpha );
+		return;
+	}
+	if( simd >= BMP_SIMD_SSSE3 )
+	{
+		Ssse3Row( src, srcBytes, dst, dstBytes, width, swap, alpha );
+		return;
+	}
+#endif
+	ScalarRow( src, srcBytes, dst, dstBytes, width, swap, alpha );
+}
+
+
+BmpImage::BmpImage( )
+{
+	Width = Height = 0;
+	Format = GL_RGB;
+	RowBytes = 0;
+	Pixels = NULL;
+	Verbose = false;
+}
+
+
+void
+BmpImage::Close( )
+{
+	File.Close( );
+	Converted.clear( );
+	Width = Height = 0;
+	RowBytes = 0;
+	Pixels = NULL;
+}
+
+
+int
+BmpImage::GetAlignment( )
+{
+	if( RowBytes % 4 == 0 )
+		return 4;
+	if( RowBytes % 2 == 0 )
+		return 2;
+	return 1;
+}
+
+
+GLenum
+BmpImage::GetFormat( )
+{
+	return Format;
+}
+
+
+int
+BmpImage::GetHeight( )
+{
+	return Height;
+}
+
+
+const unsigned char *
+BmpImage::GetPixels( )
+{
+	return Pixels;
+}
+
+
+int
+BmpImage::GetRowBytes( )
+{
+	return RowBytes;
+}
+
+
+int
+BmpImage::GetWidth( )
+{
+	return Width;
+}
+
+
+// true if GetPixels( ) points into the file itself:
+
+bool
+BmpImage::IsMapped( )
+{
+	return Pixels != NULL  &&  Converted.empty( );
+}
+
+
+// map the file, check its headers, and get its pixels into format (GL_RGB, GL_RGBA, GL_BGR, or GL_BGRA):
+
+bool
+BmpImage::Load( const char *filename, GLenum format )
+{
+	Close( );
+
+	int dstBytes;
+	bool swap;
+	switch( format )
+	{
+		case GL_RGB:	dstBytes = 3;	swap = true;	break;
+		case GL_RGBA:	dstBytes = 4;	swap = true;	break;
+		case GL_BGR:	dstBytes = 3;	swap = false;	break;
+		case GL_BGRA:	dstBytes = 4;	swap = false;	break;
+		default:
+			fprintf( stderr, "BmpImage: cannot load '%s' as format 0x%x\n", filename, format );
+			return false;
+	}
+
+	if( ! File.Open( filename ) )
+		return false;
+	const unsigned char *data = File.GetData( );
+	size_t size = File.GetSize( );
+
+	if( size < BMP_FILE_HEADER_SIZE + BMP_INFO_HEADER_SIZE  ||  data[0] != 'B'  ||  data[1] != 'M' )
+	{
+		fprintf( stderr, "File '%s' is not a bmp file\n", filename );
+		Close( );
+		return false;
+	}
+
+	unsigned int offBits     = Le32( &data[BMP_OFF_BITS] );
+	unsigned int biSize      = Le32( &data[BMP_BI_SIZE] );
+	int width                = (int)Le32( &data[BMP_BI_WIDTH] );
+	int height               = (int)Le32( &data[BMP_BI_HEIGHT] );
+	int planes               = Le16( &data[BMP_BI_PLANES] );
+	int bitCount             = Le16( &data[BMP_BI_BIT_COUNT] );
+	unsigned int compression = Le32( &data[BMP_BI_COMPRESSION] );
+	unsigned int clrUsed     = Le32( &data[BMP_BI_CLR_USED] );
+
+	// a negative height means the rows are stored top-down:
+	bool bottomUp = height > 0;
+	if( height < 0 )
+		height = -height;
+
+	if( biSize < BMP_INFO_HEADER_SIZE  ||  planes != 1 )
+	{
+		fprintf( stderr, "Bmp file '%s' has an unsupported header (size %u, %d planes)\n", filename, biSize, planes );
+		Close( );
+		return false;
+	}
+	if( width <= 0  ||  height <= 0  ||  width > BMP_MAX_DIMENSION  ||  height > BMP_MAX_DIMENSION )
+	{
+		fprintf( stderr, "Bmp file '%s' has a bad image size: %d x %d\n", filename, width, height );
+		Close( );
+		return false;
+	}
+	if( bitCount != 8  &&  bitCount != 24  &&  bitCount != 32 )
+	{
+		fprintf( stderr, "Bmp file '%s' has %d bits per pixel -- only 8, 24, and 32 are supported\n", filename, bitCount );
+		Close( );
+		return false;
+	}
+
+	// 32-bit pixels are b, g, r, and either a real alpha or a byte to ignore:
+	unsigned char alpha = 255;
+	if( compression == BMP_BI_BITFIELDS  &&  bitCount == 32  &&  size >= BMP_MASKS + 12 )
+	{
+		if( Le32( &data[BMP_MASKS] ) != 0x00ff0000  ||  Le32( &data[BMP_MASKS+4] ) != 0x0000ff00  ||  Le32( &data[BMP_MASKS+8] ) != 0x000000ff )
+		{
+			fprintf( stderr, "Bmp file '%s' has bit masks other than b, g, r, a\n", filename );
+			Close( );
+			return false;
+		}
+		if( biSize >= BMP_INFO_HEADER_SIZE + 16  &&  Le32( &data[BMP_MASKS+12] ) == 0xff000000 )
+			alpha = 0;
+	}
+	else if( compression != BMP_BI_RGB )
+	{
+		fprintf( stderr, "Image file '%s' has the wrong type of image compression: %u\n", filename, compression );
+		Close( );
+		return false;
+	}
+
+	// each row is padded out to a multiple of 4 bytes, and the pixels start wherever bfOffBits says:
+	int srcBytes = bitCount / 8;
+	int stride = 4 * ( ( width * srcBytes + 3 ) / 4 );
+	if( offBits < BMP_FILE_HEADER_SIZE + biSize  ||  (unsigned long long)offBits + (unsigned long long)stride * height > size )
+	{
+		fprintf( stderr, "Bmp file '%s' is truncated\n", filename );
+		Close( );
+		return false;
+	}
+	const unsigned char *bits = &data[offBits];
+
+	// 8-bit pixels index a palette of b, g, r, x entries, which are converted once:
+	unsigned char palette[256][4];
+	if( bitCount == 8 )
+	{
+		unsigned int colors = ( clrUsed == 0 ) ? 256 : clrUsed;
+		size_t first = BMP_FILE_HEADER_SIZE + biSize;
+		if( colors > 256  ||  first + 4 * colors > offBits )
+		{
+			fprintf( stderr, "Bmp file '%s' has a bad palette (%u colors)\n", filename, colors );
+			Close( );
+			return false;
+		}
+		memset( palette, 0, sizeof(palette) );
+		ScalarRow( &data[first], 4, &palette[0][0], 4, (int)colors, swap, 255 );
+	}
+
+	Width = width;
+	Height = height;
+	Format = format;
+
+	int simd = SimdLevel( );
+	const char *how;
+	if( bottomUp  &&  srcBytes == dstBytes  &&  ! swap  &&  ( srcBytes == 3  ||  alpha == 0 ) )
+	{
+		// already in the order, and the row layout, that was asked for:
+		Pixels = bits;
+		RowBytes = stride;
+		how = "mapped";
+	}
+	else
+	{
+		RowBytes = width * dstBytes;
+		Converted.resize( (size_t)RowBytes * height );
+		for( int t = 0; t < height; t++ )
+		{
+			const unsigned char *src = &bits[ (size_t)stride * ( bottomUp ? t : height - 1 - t ) ];
+			unsigned char *dst = &Converted[ (size_t)RowBytes * t ];
+			if( bitCount == 8 )
+			{
+				for( int s = 0; s < width; s++, dst += dstBytes )
+					memcpy( dst, palette[ src[s] ], dstBytes );
+			}
+			else
+			{
+				ConvertRow( src, srcBytes, dst, dstBytes, width, swap, srcBytes == 4 ? alpha : 0, simd );
+			}
+		}
+		Pixels = &Converted[0];
+		how = ( bitCount == 8 ) ? "palette" : ( simd == BMP_SIMD_AVX2 && srcBytes == 4 ) ? "avx2" : ( simd >= BMP_SIMD_SSSE3 ) ? "ssse3" : "scalar";
+	}
+
+	if( Verbose )
+		fprintf( stderr, "BmpImage: '%s' is %d x %d, %d bits, %s (%s)\n", filename, Width, Height, bitCount,
+			bottomUp ? "bottom-up" : "top-down", how );
+	return true;
+}
+
+
+void
+BmpImage::SetVerbose( bool v )
+{
+	Verbose = v;
+}
+
+
+// which of the shuffle paths this cpu can run:
+
+static int
+DetectSimdLevel( )
+{
+	int level = BMP_SIMD_NONE;
+#ifdef BMP_X86
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid( info, 1 );
+	bool ssse3   = ( info[2] & ( 1 << 9 ) ) != 0;
+	bool osxsave = ( info[2] & ( 1 << 27 ) ) != 0;
+	bool avx     = ( info[2] & ( 1 << 28 ) ) != 0;
+	__cpuidex( info, 7, 0 );
+	bool avx2    = ( info[1] & ( 1 << 5 ) ) != 0;
+	if( ssse3 )
+		level = BMP_SIMD_SSSE3;
+	if( ssse3  &&  osxsave  &&  avx  &&  avx2  &&  ( _xgetbv( 0 ) & 6 ) == 6 )	// the os saves the ymm registers
+		level = BMP_SIMD_AVX2;
+#else
+	__builtin_cpu_init( );
+	if( __builtin_cpu_supports( "ssse3" ) )
+		level = BMP_SIMD_SSSE3;
+	if( __builtin_cpu_supports( "avx2" ) )
+		level = BMP_SIMD_AVX2;
+#endif
+#endif
+	return level;
+}
+
+
+// ... checked once -- Load( ) runs on the JobGraph workers, and a function-level static is initialized
+// by whichever thread gets there first, with the others waiting for it:
+
+int
+BmpImage::SimdLevel( )
+{
+	static const int level = DetectSimdLevel( );
+	return level;
+}
@@ -0,0 +1,62 @@
+#ifndef BMP_IMAGE_H
+#define BMP_IMAGE_H
+
+#include <stdio.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "glew.h"
+#include <GL/gl.h>
+
+#include <vector>
+
+#include "mappedfile.h"
+
+
+// an uncompressed 8, 24, or 32 bit bmp, mapped into memory and converted a whole row at a time
+//
+// Load( ) is asked for the pixel format it should hand back:
+//	GL_BGR, GL_BGRA	the order the file already stores them in, so when the rows are stored bottom-up
+//			(the way glTexImage2D wants them) GetPixels( ) points straight into the mapped file and nothing is copied
+//	GL_RGB, GL_RGBA	swizzled with ssse3 or avx2 shuffles when the cpu has them
+//
+// the pixels are always bottom row first, and each row starts GetRowBytes( ) after the one before it:
+// that is the file's own 4-byte padded stride when they are mapped, and a tightly packed one when they were converted
+// (GetAlignment( ) is what GL_UNPACK_ALIGNMENT has to be set to for glTexImage2D to step through them the same way)
+
+class BmpImage
+{
+    private:
+	MappedFile		File;
+	int			Width;
+	int			Height;
+	GLenum			Format;
+	int			RowBytes;
+	const unsigned char *	Pixels;
+	std::vector<unsigned char>	Converted;
+	bool			Verbose;
+
+    public:
+	BmpImage( );
+
+	void			Close( );
+	int			GetAlignment( );
+	GLenum			GetFormat( );
+	int			GetHeight( );
+	const unsigned char *	GetPixels( );
+	int			GetRowBytes( );
+	int			GetWidth( );
+	bool			IsMapped( );
+	bool			Load( const char *, GLenum = GL_RGB );
+	void			SetVerbose( bool );
+
+	static int		SimdLevel( );
+};
+
+#define BMP_SIMD_NONE	0
+#define BMP_SIMD_SSSE3	1
+#define BMP_SIMD_AVX2	2
+
+#endif		// #ifndef BMP_IMAGE_H
@@ -0,0 +1,80 @@
+// common.glsl -- helpers shared by the beam shaders
+// (pulled in with #include "common.glsl", which GLSLProgram resolves)
+
+const float M_PI = 3.141593;
+
+
+// the layers of the uNoiseLayers texture array -- sample.cpp #defines these to match its layout:
+
+#ifndef NOISE_LAYER
+#define NOISE_LAYER		0
+#endif
+#ifndef NOISE_MASK_LAYER
+#define NOISE_MASK_LAYER	1
+#endif
+#ifndef WHOOSH_LAYER
+#define WHOOSH_LAYER		2
+#endif
+
+
+// the four-octave sine series that wobbles the beam's stripes:
+// (the range is about -15. -> 15.)
+
+float
+SineSeries(float seed)
+{
+	return 8. * sin(seed * M_PI) + 4. * sin(seed * 4. * M_PI) + 2. * sin(seed * 8. * M_PI) + sin(seed * 16. * M_PI);
+}
+
+
+// with USE_NOISE_LUT, these read the tables baked by noisebake.cs instead of calling sin( )
+// (only the fragment shaders use them, so the samplers are never bound by a vertex shader):
+
+#ifndef USE_NOISE_LUT
+#define USE_NOISE_LUT	0
+#endif
+
+#if USE_NOISE_LUT
+uniform sampler2DArray uNoiseLut;	// layer 0: SineSeries( ) over [0.,2.), layer 1: sin( ) over one period
+#endif
+
+float
+BakedSineSeries(float seed)
+{
+#if USE_NOISE_LUT
+	return texture(uNoiseLut, vec3(seed * 0.5, 0.5, 0.)).r;
+#else
+	return SineSeries(seed);
+#endif
+}
+
+float
+BakedSin(float x)
+{
+#if USE_NOISE_LUT
+	return texture(uNoiseLut, vec3(x * (0.5 / M_PI), 0.5, 1.)).r;
+#else
+	return sin(x);
+#endif
+}
+
+
+// ambient + diffuse + specular, with a white highlight:
+
+vec3
+Lighting(vec3 color, vec3 Normal, vec3 Light, vec3 Eye, float kA, float kD, float kS, float shininess)
+{
+	vec3 ambient = kA * color;
+	float d = max(dot(Normal, Light), 0.);
+	vec3 diffuse = kD * d * color;
+
+	float s = 0.;
+	if(dot(Normal, Light) > 0.)
+	{
+		vec3 ref = normalize(reflect(-Light, Normal));
+		s = pow(max(dot(Eye, ref), 0.), shininess);
+	}
+	vec3 specular = kS * s * vec3(1., 1., 1.);
+
+	return ambient + diffuse + specular;
+}
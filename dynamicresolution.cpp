@@ -0,0 +1,352 @@
+#include "dynamicresolution.h"
+#include "glstate.h"
+
+#include <math.h>
+#include <algorithm>
+#include <chrono>
+
+
+#define DEFAULT_BUDGET		16.6		// milliseconds
+#define HEADROOM		0.90		// aim for this much of the budget, to leave room for the swap and for noise
+#define DEADBAND		0.80		// do not scale up until the time is under this much of the aim
+#define SMOOTHING		0.20		// how much of each new timing goes into the smoothed one
+#define MAX_STEP		0.08		// most the scale changes per timing, as a fraction of itself
+#define REPORT_INTERVAL		1.		// seconds between the verbose reports
+
+
+static double
+Now( )
+{
+	return std::chrono::duration<double>( std::chrono::steady_clock::now( ).time_since_epoch( ) ).count( );
+}
+
+
+DynamicResolution::DynamicResolution( )
+{
+	Fbo = ColorTex = DepthTex = 0;
+	AllocWidth = AllocHeight = 0;
+	WindowWidth = WindowHeight = 0;
+	Width = Height = 0;
+	Supported = false;
+	CanTime = false;
+	Enabled = false;
+	Scale = 1.;
+	MinScale = 0.25;
+	MaxScale = 1.;
+	Budget = DEFAULT_BUDGET;
+	GpuMs = 0.;
+	LastGpuMs = 0.;
+	for( int i = 0; i < RESOLUTION_LATENCY; i++ )
+	{
+		Queries[i][0] = Queries[i][1] = 0;
+		InFlight[i] = false;
+	}
+	Next = 0;
+	Timing = false;
+	ReportTime = 0.;
+	Verbose = false;
+}
+
+
+DynamicResolution::~DynamicResolution( )
+{
+	if( Fbo != 0 )
+		glDeleteFramebuffers( 1, &Fbo );
+	if( ColorTex != 0 )
+		glDeleteTextures( 1, &ColorTex );
+	if( DepthTex != 0 )
+		glDeleteTextures( 1, &DepthTex );
+	if( CanTime )
+		glDeleteQueries( 2*RESOLUTION_LATENCY, &Queries[0][0] );
+}
+
+
+// the controller: move the scale toward what would have made that frame take the budget:
+
+void
+DynamicResolution::Adjust( double ms )
+{
+	LastGpuMs = ms;
+	GpuMs = ( GpuMs <= 0. ) ? ms : GpuMs + SMOOTHING * ( ms - GpuMs );
+
+	double aim = HEADROOM * Budget;
+	if( GpuMs <= aim  &&  GpuMs >= DEADBAND * aim )
+		return;						// close enough -- leave it alone
+	if( GpuMs <= 0. )
+		return;
+
+	double wanted = Scale * sqrt( aim / GpuMs );
+	wanted = std::max( wanted, Scale * ( 1. - MAX_STEP ) );
+	wanted = std::min( wanted, Scale * ( 1. + MAX_STEP ) );
+	Scale = std::max( MinScale, std::min( MaxScale, wanted ) );
+}
+
+
+// (re)make the render target, big enough for the largest scale of the window:
+
+void
+DynamicResolution::Allocate( int width, int height )
+{
+	AllocWidth = width;
+	AllocHeight = height;
+
+	if( Fbo == 0 )
+		glGenFramebuffers( 1, &Fbo );
+	if( ColorTex == 0 )
+		glGenTextures( 1, &ColorTex );
+	if( DepthTex == 0 )
+		glGenTextures( 1, &DepthTex );
+
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D, ColorTex );
+	glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D, DepthTex );
+	glTexImage2D( GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D, 0 );
+
+	glBindFramebuffer( GL_FRAMEBUFFER, Fbo );
+	glFramebufferTexture2D( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ColorTex, 0 );
+	glFramebufferTexture2D( GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, DepthTex, 0 );
+	GLenum status = glCheckFramebufferStatus( GL_FRAMEBUFFER );
+	glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+
+	if( status != GL_FRAMEBUFFER_COMPLETE )
+	{
+		fprintf( stderr, "DynamicResolution: the %dx%d render target is not complete (0x%04x) -- drawing at full resolution\n",
+			width, height, status );
+		Supported = false;
+		Enabled = false;
+	}
+	else if( Verbose )
+	{
+		fprintf( stderr, "DynamicResolution: render target is %dx%d\n", width, height );
+	}
+}
+
+
+// start drawing a frame for a window this big -- afterwards, GetWidth( ) and GetHeight( ) are the size to draw it at:
+
+void
+DynamicResolution::Begin( int windowWidth, int windowHeight )
+{
+	WindowWidth = windowWidth > 0 ? windowWidth : 1;
+	WindowHeight = windowHeight > 0 ? windowHeight : 1;
+
+	Collect( );
+
+	if( Enabled )
+	{
+		int w = (int)ceil( WindowWidth * MaxScale );
+		int h = (int)ceil( WindowHeight * MaxScale );
+		if( w != AllocWidth  ||  h != AllocHeight )
+			Allocate( w, h );
+	}
+
+	if( Enabled )
+	{
+		Width = std::min( AllocWidth, std::max( 1, (int)( WindowWidth * Scale + 0.5 ) ) );
+		Height = std::min( AllocHeight, std::max( 1, (int)( WindowHeight * Scale + 0.5 ) ) );
+		glBindFramebuffer( GL_FRAMEBUFFER, Fbo );
+		glDrawBuffer( GL_COLOR_ATTACHMENT0 );
+	}
+	else
+	{
+		Width = WindowWidth;
+		Height = WindowHeight;
+		if( Supported )
+			glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+		glDrawBuffer( GL_BACK );
+	}
+
+	// time the frame, unless the queries in this slot have not come back yet:
+	Timing = CanTime  &&  ! InFlight[Next];
+	if( Timing )
+		glQueryCounter( Queries[Next][0], GL_TIMESTAMP );
+}
+
+
+// read back the timings that have finished, oldest first, without waiting for any:
+
+void
+DynamicResolution::Collect( )
+{
+	if( ! CanTime )
+		return;
+
+	for( int i = 0; i < RESOLUTION_LATENCY; i++ )
+	{
+		int slot = ( Next + i ) % RESOLUTION_LATENCY;
+		if( ! InFlight[slot] )
+			continue;
+
+		GLint available = 0;
+		glGetQueryObjectiv( Queries[slot][1], GL_QUERY_RESULT_AVAILABLE, &available );
+		if( ! available )
+			break;
+
+		GLuint64 t0, t1;
+		glGetQueryObjectui64v( Queries[slot][0], GL_QUERY_RESULT, &t0 );
+		glGetQueryObjectui64v( Queries[slot][1], GL_QUERY_RESULT, &t1 );
+		InFlight[slot] = false;
+		if( t1 > t0 )
+			Adjust( (double)( t1 - t0 ) / 1000000. );
+	}
+}
+
+
+// stretch what was drawn up to the window:
+
+void
+DynamicResolution::End( )
+{
+	if( Enabled )
+	{
+		glBindFramebuffer( GL_READ_FRAMEBUFFER, Fbo );
+		glBindFramebuffer( GL_DRAW_FRAMEBUFFER, 0 );
+		glDrawBuffer( GL_BACK );
+		GLenum filter = ( Width == WindowWidth  &&  Height == WindowHeight ) ? GL_NEAREST : GL_LINEAR;
+		glBlitFramebuffer( 0, 0, Width, Height,  0, 0, WindowWidth, WindowHeight,  GL_COLOR_BUFFER_BIT, filter );
+		glBindFramebuffer( GL_FRAMEBUFFER, 0 );
+	}
+
+	if( Timing )
+	{
+		glQueryCounter( Queries[Next][1], GL_TIMESTAMP );
+		InFlight[Next] = true;
+		Next = ( Next + 1 ) % RESOLUTION_LATENCY;
+	}
+
+	double now = Now( );
+	if( Verbose  &&  now - ReportTime >= REPORT_INTERVAL )
+	{
+		fprintf( stderr, "Resolution: %3.0f%% (%dx%d of %dx%d), gpu %5.2f ms (smoothed %5.2f) of a %4.1f ms budget%s\n",
+			100. * ( Enabled ? Scale : 1. ), Width, Height, WindowWidth, WindowHeight,
+			LastGpuMs, GpuMs, Budget, Enabled ? "" : " -- scaling is off" );
+		ReportTime = now;
+	}
+}
+
+
+GLuint
+DynamicResolution::GetColorTexture( )
+{
+	return ColorTex;
+}
+
+
+GLuint
+DynamicResolution::GetDepthTexture( )
+{
+	return DepthTex;
+}
+
+
+// the framebuffer that Begin( ) bound -- 0 when drawing straight to the window:
+
+GLuint
+DynamicResolution::GetFramebuffer( )
+{
+	return Enabled ? Fbo : 0;
+}
+
+
+double
+DynamicResolution::GetGpuMs( )
+{
+	return GpuMs;
+}
+
+
+int
+DynamicResolution::GetHeight( )
+{
+	return Height;
+}
+
+
+double
+DynamicResolution::GetScale( )
+{
+	return Enabled ? Scale : 1.;
+}
+
+
+int
+DynamicResolution::GetWidth( )
+{
+	return Width;
+}
+
+
+// call with the context current -- returns false if the scene will just be drawn straight to the window:
+
+bool
+DynamicResolution::Init( )
+{
+	Supported = GLEW_VERSION_3_0  ||  GLEW_ARB_framebuffer_object;
+	CanTime = GLEW_VERSION_3_3  ||  GLEW_ARB_timer_query;
+	if( CanTime )
+		glGenQueries( 2*RESOLUTION_LATENCY, &Queries[0][0] );
+
+	if( ! Supported )
+		fprintf( stderr, "DynamicResolution: no framebuffer objects -- drawing at full resolution\n" );
+	else if( ! CanTime )
+		fprintf( stderr, "DynamicResolution: no timer queries -- drawing at a fixed %.0f%% resolution\n", 100. * Scale );
+	Enabled = Supported;
+	ReportTime = Now( );
+	return Enabled;
+}
+
+
+bool
+DynamicResolution::IsEnabled( )
+{
+	return Enabled;
+}
+
+
+// milliseconds of gpu time to hold each frame to:
+
+void
+DynamicResolution::SetBudget( double ms )
+{
+	if( ms > 0. )
+		Budget = ms;
+}
+
+
+// with scaling off, the scene is drawn straight to the window (but is still timed):
+
+void
+DynamicResolution::SetEnabled( bool on )
+{
+	Enabled = on  &&  Supported;
+}
+
+
+void
+DynamicResolution::SetScaleRange( double minScale, double maxScale )
+{
+	if( minScale <= 0.  ||  maxScale < minScale )
+		return;
+	MinScale = minScale;
+	MaxScale = maxScale;
+	Scale = std::max( MinScale, std::min( MaxScale, Scale ) );
+}
+
+
+// print the scale and the gpu time once a second:
+
+void
+DynamicResolution::SetVerbose( bool v )
+{
+	Verbose = v;
+}
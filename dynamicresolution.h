@@ -0,0 +1,81 @@
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <stdio.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "glew.h"
+#include <GL/gl.h>
+
+
+// timestamps are read back this many frames later, so reading them never stalls the pipeline:
+#define RESOLUTION_LATENCY	4
+
+
+// renders the scene into an offscreen target that is some fraction of the window's size, and stretches it
+// back up to the window with a linear blit
+//
+// the fraction is picked every frame by a controller that reads how long the gpu took to draw the frames
+// before (with timestamp queries, so they do not collide with the GLSLProgram profiler's elapsed-time ones):
+// when the gpu time is over the budget the scale comes down, and when it is comfortably under, it goes back up
+// -- the pixel count goes as the square of the scale, so the step is the square root of the time ratio,
+// limited so that noise in the timings does not make the resolution pump
+//
+// without framebuffer objects or timer queries, it just draws straight to the window
+
+class DynamicResolution
+{
+    private:
+	GLuint			Fbo;
+	GLuint			ColorTex;
+	GLuint			DepthTex;		// a texture, so later passes can read the scene's depth
+	int			AllocWidth, AllocHeight;
+	int			WindowWidth, WindowHeight;
+	int			Width, Height;		// of this frame's render
+
+	bool			Supported;		// framebuffer objects
+	bool			CanTime;		// timer queries
+	bool			Enabled;
+	double			Scale;
+	double			MinScale, MaxScale;
+	double			Budget;			// milliseconds of gpu time per frame
+	double			GpuMs;			// smoothed
+	double			LastGpuMs;		// the latest one read back
+
+	GLuint			Queries[RESOLUTION_LATENCY][2];	// timestamps at Begin( ) and End( )
+	bool			InFlight[RESOLUTION_LATENCY];
+	int			Next;
+	bool			Timing;			// this frame's queries were issued
+
+	double			ReportTime;
+	bool			Verbose;
+
+	void			Adjust( double );
+	void			Allocate( int, int );
+	void			Collect( );
+
+    public:
+	DynamicResolution( );
+	~DynamicResolution( );
+
+	void			Begin( int, int );
+	void			End( );
+	GLuint			GetColorTexture( );
+	GLuint			GetDepthTexture( );
+	GLuint			GetFramebuffer( );
+	double			GetGpuMs( );
+	int			GetHeight( );
+	double			GetScale( );
+	int			GetWidth( );
+	bool			Init( );
+	bool			IsEnabled( );
+	void			SetBudget( double );
+	void			SetEnabled( bool );
+	void			SetScaleRange( double, double );
+	void			SetVerbose( bool );
+};
+
+#endif		// #ifndef DYNAMIC_RESOLUTION_H
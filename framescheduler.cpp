@@ -0,0 +1,435 @@
+#include "framescheduler.h"
+
+#include <math.h>
+#include <time.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#ifdef WIN32
+#include <mmsystem.h>
+#pragma comment( lib, "winmm.lib" )
+#else
+#include <GL/glx.h>
+#endif
+
+
+#define DEFAULT_TARGET_RATE	60.
+#define DEFAULT_TICK_RATE	60.
+#define DEFAULT_CATCH_UP	4
+#define TIMER_SLACK		0.002		// seconds early to have the glut timer go off -- the rest is slept out
+#define REPORT_INTERVAL		1.		// seconds between the verbose reports
+
+
+FrameScheduler *	FrameScheduler::Active = NULL;
+
+
+FrameScheduler::FrameScheduler( )
+{
+	Tick = NULL;
+	BeginFrame = NULL;
+	TargetRate = DEFAULT_TARGET_RATE;
+	TickRate = DEFAULT_TICK_RATE;
+	MaxCatchUp = DEFAULT_CATCH_UP;
+	Suspended = false;
+	Armed = false;
+	TimerPeriodSet = false;
+	Verbose = false;
+	NextFrame = LastTime = LastFrameEnd = 0.;
+	Accumulator = SimTime = 0.;
+	ResetStats( 0. );
+}
+
+
+FrameScheduler::~FrameScheduler( )
+{
+	Stop( );
+}
+
+
+// set the glut timer to go off a little before the next frame's deadline:
+
+void
+FrameScheduler::Arm( )
+{
+	if( Armed  ||  Suspended  ||  Active != this )
+		return;
+
+	int ms = 0;
+	if( TargetRate > 0. )
+	{
+		double wait = NextFrame - Now( ) - TIMER_SLACK;
+		if( wait > 0. )
+			ms = (int)( 1000. * wait );
+	}
+	glutTimerFunc( ms, FrameScheduler::Timer, 0 );
+	Armed = true;
+}
+
+
+// the process's cpu time, in seconds, over all of its threads:
+
+double
+FrameScheduler::CpuSeconds( )
+{
+#ifdef WIN32
+	FILETIME created, exited, kernel, user;
+	if( ! GetProcessTimes( GetCurrentProcess( ), &created, &exited, &kernel, &user ) )
+		return 0.;
+	ULARGE_INTEGER k, u;
+	k.LowPart = kernel.dwLowDateTime;
+	k.HighPart = kernel.dwHighDateTime;
+	u.LowPart = user.dwLowDateTime;
+	u.HighPart = user.dwHighDateTime;
+	return (double)( k.QuadPart + u.QuadPart ) * 1.e-7;		// 100 ns units
+#else
+	return (double)clock( ) / (double)CLOCKS_PER_SEC;
+#endif
+}
+
+
+// call at the end of Display( ), after the swap:
+
+void
+FrameScheduler::EndFrame( )
+{
+	double now = Now( );
+	if( LastFrameEnd > 0. )
+		Intervals.push_back( now - LastFrameEnd );
+	LastFrameEnd = now;
+
+	if( Verbose  &&  now - ReportTime >= REPORT_INTERVAL )
+	{
+		PrintStats( stderr );
+		ResetStats( now );
+	}
+
+	Arm( );
+}
+
+
+// the timer went off -- wait out the deadline, bring the simulation up to date, and have the frame drawn:
+
+void
+FrameScheduler::Fire( )
+{
+	Armed = false;
+	if( Suspended )
+		return;
+
+	double now = Now( );
+	if( TargetRate > 0.  &&  now < NextFrame )
+	{
+		std::this_thread::sleep_for( std::chrono::duration<double>( NextFrame - now ) );
+		now = Now( );
+	}
+
+	Step( );
+
+	if( TargetRate > 0. )
+	{
+		NextFrame += 1. / TargetRate;
+		if( NextFrame < now )
+			NextFrame = now + 1. / TargetRate;		// missed it: start over from here, not with a burst of frames
+	}
+
+	glutPostRedisplay( );
+}
+
+
+// how far the clock is past the last tick, as a fraction of a tick, for drawing in between ticks:
+
+double
+FrameScheduler::GetAlpha( )
+{
+	return Accumulator * TickRate;
+}
+
+
+double
+FrameScheduler::GetSimTime( )
+{
+	return SimTime;
+}
+
+
+double
+FrameScheduler::GetTargetRate( )
+{
+	return TargetRate;
+}
+
+
+double
+FrameScheduler::GetTickSeconds( )
+{
+	return 1. / TickRate;
+}
+
+
+double
+FrameScheduler::Now( )
+{
+	return std::chrono::duration<double>( std::chrono::steady_clock::now( ).time_since_epoch( ) ).count( );
+}
+
+
+// print what the frames have done since the last report:
+// (the jitter is how much the time between frames varies, and the cpu is as a percentage of one core)
+
+void
+FrameScheduler::PrintStats( FILE *fp )
+{
+	double now = Now( );
+	double wall = now - ReportTime;
+	double cpu = CpuSeconds( ) - ReportCpu;
+	int frames = (int)Intervals.size( );
+
+	double mean = 0., worst = 0.;
+	for( int i = 0; i < frames; i++ )
+	{
+		mean += Intervals[i];
+		worst = std::max( worst, Intervals[i] );
+	}
+	if( frames > 0 )
+		mean /= (double)frames;
+	double variance = 0.;
+	for( int i = 0; i < frames; i++ )
+		variance += ( Intervals[i] - mean ) * ( Intervals[i] - mean );
+	if( frames > 1 )
+		variance /= (double)( frames - 1 );
+
+	fprintf( fp, "Frames: %5.1f fps (%s), %6.2f ms mean, %5.2f ms jitter, %6.2f ms worst -- %d ticks, %d dropped -- cpu %5.1f%%\n",
+		wall > 0. ? frames / wall : 0.,
+		TargetRate > 0. ? "paced" : ( TargetRate < 0. ? "flat out" : "vsync" ),
+		1000. * mean, 1000. * sqrt( variance ), 1000. * worst,
+		Ticks, DroppedTicks,
+		wall > 0. ? 100. * cpu / wall : 0. );
+}
+
+
+void
+FrameScheduler::ResetStats( double now )
+{
+	Intervals.clear( );
+	ReportTime = now;
+	ReportCpu = now > 0. ? CpuSeconds( ) : 0.;
+	Ticks = 0;
+	DroppedTicks = 0;
+}
+
+
+// the most ticks to run for one frame before giving up on catching up:
+
+void
+FrameScheduler::SetCatchUp( int ticks )
+{
+	MaxCatchUp = ticks > 0 ? ticks : 1;
+}
+
+
+// have beginFrame decide how many ticks each frame runs (NULL = the clock decides):
+
+void
+FrameScheduler::SetFrameBegin( FrameBeginFunc beginFrame )
+{
+	BeginFrame = beginFrame;
+}
+
+
+// frames per second to aim for, or 0 to draw as fast as the swap interval lets the frames through,
+// or less than 0 to draw as fast as possible, with no pacing and no vsync (for benchmarking):
+
+void
+FrameScheduler::SetTargetRate( double fps )
+{
+	TargetRate = fps > 0. ? fps : ( fps < 0. ? -1. : 0. );
+	NextFrame = Now( );
+	SetSwapInterval( TargetRate != 0. ? 0 : 1 );
+	ResetStats( NextFrame );
+}
+
+
+// what to call once per tick (Start( ) sets it too):
+
+void
+FrameScheduler::SetTick( FrameTickFunc tick )
+{
+	Tick = tick;
+}
+
+
+void
+FrameScheduler::SetTickRate( double hz )
+{
+	if( hz > 0. )
+		TickRate = hz;
+}
+
+
+// print the stats once a second:
+
+void
+FrameScheduler::SetVerbose( bool v )
+{
+	Verbose = v;
+	ResetStats( Now( ) );
+}
+
+
+// call from the glut visibility callback -- nothing at all runs while the window is hidden:
+
+void
+FrameScheduler::SetVisible( bool visible )
+{
+	if( visible == ! Suspended )
+		return;
+
+	Suspended = ! visible;
+	if( Suspended )
+	{
+		if( Verbose )
+			fprintf( stderr, "FrameScheduler: window hidden -- suspended\n" );
+		return;
+	}
+
+	// start the clock over, so the time spent hidden is not ticked through:
+	double now = Now( );
+	LastTime = NextFrame = now;
+	LastFrameEnd = 0.;
+	ResetStats( now );
+	Arm( );
+}
+
+
+// ask the driver for a swap interval (1 = wait for vsync, 0 = do not), if it lets us
+// (if it does not, the frames stay locked to vsync, and this says so, once):
+
+bool
+FrameScheduler::SetSwapInterval( int interval )
+{
+	bool set = false;
+#ifdef WIN32
+	typedef BOOL ( WINAPI *SwapIntervalFunc )( int );
+	SwapIntervalFunc swapInterval = (SwapIntervalFunc)wglGetProcAddress( "wglSwapIntervalEXT" );
+	if( swapInterval != NULL )
+		set = swapInterval( interval ) != FALSE;
+#else
+	// GLX_EXT_swap_control sets it for the current window, GLX_MESA_swap_control for the current context:
+	typedef void ( *SwapIntervalEXTFunc )( Display *, GLXDrawable, int );
+	typedef int ( *SwapIntervalMESAFunc )( unsigned int );
+	SwapIntervalEXTFunc swapIntervalEXT = (SwapIntervalEXTFunc)glXGetProcAddressARB( (const GLubyte *)"glXSwapIntervalEXT" );
+	SwapIntervalMESAFunc swapIntervalMESA = (SwapIntervalMESAFunc)glXGetProcAddressARB( (const GLubyte *)"glXSwapIntervalMESA" );
+	Display *display = glXGetCurrentDisplay( );
+	GLXDrawable drawable = glXGetCurrentDrawable( );
+	if( swapIntervalEXT != NULL  &&  display != NULL  &&  drawable != 0 )
+	{
+		swapIntervalEXT( display, drawable, interval );
+		set = true;
+	}
+	else if( swapIntervalMESA != NULL )
+	{
+		set = swapIntervalMESA( (unsigned int)interval ) == 0;
+	}
+#endif
+
+	static bool warned = false;
+	if( ! set  &&  ! warned )
+	{
+		fprintf( stderr, "FrameScheduler: the driver does not let the swap interval be set -- frames stay at what it picks\n" );
+		warned = true;
+	}
+	return set;
+}
+
+
+// take over the main loop: tick is called once per simulation tick, and a redisplay is posted per frame
+// (call this once the window and everything Display( ) needs is ready):
+
+void
+FrameScheduler::Start( FrameTickFunc tick )
+{
+	SetTick( tick );
+	Active = this;
+
+#ifdef WIN32
+	// so that the glut timers (and the sleeps) are good to 1 ms, rather than to the 15.6 ms default:
+	if( ! TimerPeriodSet )
+		TimerPeriodSet = timeBeginPeriod( 1 ) == TIMERR_NOERROR;
+#endif
+	SetSwapInterval( TargetRate != 0. ? 0 : 1 );
+
+	double now = Now( );
+	LastTime = NextFrame = now;
+	ResetStats( now );
+	Arm( );
+}
+
+
+// bring the simulation up to date with the clock (or with what the SetFrameBegin( ) function says), without
+// waiting for any deadline -- each frame's timer does this, and a loop of one's own can call it directly:
+
+void
+FrameScheduler::Step( )
+{
+	double now = Now( );
+	double step = GetTickSeconds( );
+	Accumulator += now - LastTime;
+	LastTime = now;
+	int n = 0;
+	while( Accumulator >= step  &&  n < MaxCatchUp )
+	{
+		Accumulator -= step;
+		n++;
+	}
+
+	// too far behind to catch up -- let the simulation slow down rather than stall every frame after this one:
+	if( Accumulator >= step )
+	{
+		DroppedTicks += (int)( Accumulator / step );
+		Accumulator = fmod( Accumulator, step );
+	}
+
+	// something else may be deciding the ticks -- then the clock has no say in what gets drawn:
+	if( BeginFrame != NULL )
+	{
+		int wanted = ( *BeginFrame )( n );
+		if( wanted != n )
+		{
+			n = wanted > 0 ? wanted : 0;
+			Accumulator = 0.;
+		}
+	}
+
+	for( int i = 0; i < n; i++ )
+	{
+		if( Tick != NULL )
+			( *Tick )( );
+		SimTime += step;
+	}
+	Ticks += n;
+}
+
+
+// give the main loop back: no more frames are armed (any timer on its way does nothing),
+// and windows' timers go back to the resolution they had before Start( ):
+
+void
+FrameScheduler::Stop( )
+{
+	if( Active == this )
+		Active = NULL;
+#ifdef WIN32
+	if( TimerPeriodSet )
+		timeEndPeriod( 1 );
+#endif
+	TimerPeriodSet = false;
+}
+
+
+void
+FrameScheduler::Timer( int )
+{
+	if( Active != NULL )
+		Active->Fire( );
+}
@@ -0,0 +1,97 @@
+#ifndef FRAME_SCHEDULER_H
+#define FRAME_SCHEDULER_H
+
+#include <stdio.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "glew.h"
+#include <GL/gl.h>
+#include "glut.h"
+
+#include <vector>
+
+
+// one fixed-length step of the simulation (GetTickSeconds( ) long):
+typedef void (*FrameTickFunc)( );
+
+// called as each frame starts, with the number of ticks the clock says to run -- returns how many to run:
+typedef int (*FrameBeginFunc)( int );
+
+
+// paces the glut main loop, instead of an idle callback that spins a core redrawing as fast as it can
+//
+// each frame is started by a glut timer that is set to go off just before that frame's deadline, and the
+// last part of the wait is slept out exactly -- then the simulation is stepped in fixed ticks to catch up
+// with the clock (but by no more than a few, so one long hitch does not turn into a burst of them),
+// and a redisplay is posted
+// with a target rate of 0, there is no deadline: the next frame starts as soon as the last one is done,
+// and vsync (the swap interval) does the pacing -- and with a negative one, nothing does
+//
+// Display( ) calls EndFrame( ) after it swaps, which arms the timer for the next frame, so there is only ever
+// one frame in flight -- and while the window is hidden, nothing is armed at all
+//
+// SetFrameBegin( ) lets something else (an InputRecorder replaying a run) decide how many ticks each frame runs,
+// so the simulation can be made to step exactly as it did before, however long the frames take now
+
+class FrameScheduler
+{
+    private:
+	FrameTickFunc		Tick;
+	FrameBeginFunc		BeginFrame;		// NULL, or what decides each frame's ticks instead of the clock
+	double			TargetRate;		// frames per second, 0 to be paced by vsync, or -1 for flat out
+	double			TickRate;		// simulation ticks per second
+	int			MaxCatchUp;		// ticks per frame at most
+	bool			Suspended;
+	bool			Armed;			// a glut timer is on its way
+	bool			TimerPeriodSet;		// Start( ) asked windows for 1 ms timers, and Stop( ) has not given them back
+	bool			Verbose;
+
+	double			NextFrame;		// the deadline of the next frame
+	double			LastTime;		// when the simulation was last brought up to date
+	double			Accumulator;		// clock time the simulation has not ticked through yet
+	double			SimTime;		// seconds of simulation ticked so far
+	double			LastFrameEnd;
+
+	std::vector<double>	Intervals;		// seconds between EndFrame( )s, since the last report
+	double			ReportTime;
+	double			ReportCpu;
+	int			Ticks;
+	int			DroppedTicks;
+
+	static FrameScheduler *	Active;
+
+	void			Arm( );
+	void			Fire( );
+	void			ResetStats( double );
+	static void		Timer( int );
+
+    public:
+	FrameScheduler( );
+	~FrameScheduler( );
+
+	void			EndFrame( );
+	double			GetAlpha( );
+	double			GetSimTime( );
+	double			GetTargetRate( );
+	double			GetTickSeconds( );
+	void			PrintStats( FILE * = stderr );
+	void			SetCatchUp( int );
+	void			SetFrameBegin( FrameBeginFunc );
+	void			SetTargetRate( double );
+	void			SetTick( FrameTickFunc );
+	void			SetTickRate( double );
+	void			SetVerbose( bool );
+	void			SetVisible( bool );
+	void			Start( FrameTickFunc );
+	void			Step( );
+	void			Stop( );
+
+	static double		CpuSeconds( );
+	static double		Now( );
+	static bool		SetSwapInterval( int );
+};
+
+#endif		// #ifndef FRAME_SCHEDULER_H
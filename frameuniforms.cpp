@@ -0,0 +1,134 @@
+#include "frameuniforms.h"
+
+
+const char *FrameUniformsGlsl =
+{
+"layout(std140) uniform FrameUniforms\n\
+{\n\
+	vec3	uLightPos;\n\
+	float	uBumpTime;\n\
+	float	uBulbTime;\n\
+	float	uSpinTime;\n\
+	float	uStarTime;\n\
+};\n"
+};
+
+
+FrameUniforms::FrameUniforms( )
+{
+	Buffer = 0;
+	Stride = 0;
+	Mapped = NULL;
+	Current = 0;
+	Verbose = false;
+	for( int i = 0; i < FRAME_UNIFORMS_RING; i++ )
+		Fences[i] = NULL;
+	memset( &Data, 0, sizeof(Data) );
+}
+
+
+FrameUniforms::~FrameUniforms( )
+{
+	for( int i = 0; i < FRAME_UNIFORMS_RING; i++ )
+	{
+		if( Fences[i] != NULL )
+			glDeleteSync( Fences[i] );
+	}
+	if( Buffer != 0 )
+	{
+		if( Mapped != NULL )
+		{
+			GLState::BindBuffer( GL_UNIFORM_BUFFER, Buffer );
+			glUnmapBuffer( GL_UNIFORM_BUFFER );
+			GLState::BindBuffer( GL_UNIFORM_BUFFER, 0 );
+		}
+		glDeleteBuffers( 1, &Buffer );
+	}
+}
+
+
+// create the ring buffer -- a window must be open and glew must be initialized:
+
+void
+FrameUniforms::Init( )
+{
+	GLint align;
+	glGetIntegerv( GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align );
+	if( align <= 0 )
+		align = 256;
+	Stride = ( ( (GLint)sizeof(FrameUniformData) + align - 1 ) / align ) * align;
+	GLsizeiptr size = Stride * FRAME_UNIFORMS_RING;
+
+	glGenBuffers( 1, &Buffer );
+	GLState::BindBuffer( GL_UNIFORM_BUFFER, Buffer );
+
+	// if we can, map the ring once and just write into it every frame:
+
+	if( GLEW_ARB_buffer_storage )
+	{
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glBufferStorage( GL_UNIFORM_BUFFER, size, NULL, flags );
+		Mapped = (unsigned char *) glMapBufferRange( GL_UNIFORM_BUFFER, 0, size, flags );
+	}
+
+	if( Mapped == NULL )
+		glBufferData( GL_UNIFORM_BUFFER, size, NULL, GL_STREAM_DRAW );
+
+	GLState::BindBuffer( GL_UNIFORM_BUFFER, 0 );
+
+	if( Verbose )
+		fprintf( stderr, "Frame uniforms: %d bytes x %d frames, %s\n", Stride, FRAME_UNIFORMS_RING,
+			Mapped != NULL ? "persistently mapped" : "glBufferSubData" );
+}
+
+
+void
+FrameUniforms::SetVerbose( bool v )
+{
+	Verbose = v;
+}
+
+
+// write Data into the next slot of the ring and bind it for this frame's draws:
+
+void
+FrameUniforms::Update( )
+{
+	if( Buffer == 0 )
+		return;
+
+	// everything that reads the current slot has been issued by now, so fence it:
+
+	if( Fences[Current] != NULL )
+		glDeleteSync( Fences[Current] );
+	Fences[Current] = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+
+	Current = ( Current + 1 ) % FRAME_UNIFORMS_RING;
+	GLintptr offset = Current * Stride;
+
+	if( Mapped != NULL )
+	{
+		// don't overwrite a slot the gpu might still be reading:
+
+		if( Fences[Current] != NULL )
+		{
+			GLenum status = glClientWaitSync( Fences[Current], 0, 0 );
+			if( status == GL_TIMEOUT_EXPIRED )
+			{
+				if( Verbose )
+					fprintf( stderr, "Frame uniforms: waiting on slot %d\n", Current );
+				glClientWaitSync( Fences[Current], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000 );
+			}
+			glDeleteSync( Fences[Current] );
+			Fences[Current] = NULL;
+		}
+		memcpy( Mapped + offset, &Data, sizeof(Data) );
+	}
+	else
+	{
+		GLState::BindBuffer( GL_UNIFORM_BUFFER, Buffer );
+		glBufferSubData( GL_UNIFORM_BUFFER, offset, sizeof(Data), &Data );
+	}
+
+	GLState::BindBufferRange( GL_UNIFORM_BUFFER, FRAME_UNIFORMS_BINDING, Buffer, offset, sizeof(Data) );
+}
@@ -0,0 +1,65 @@
+#ifndef FRAME_UNIFORMS_H
+#define FRAME_UNIFORMS_H
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "glew.h"
+#include <GL/gl.h>
+#include "glstate.h"
+
+
+// the per-frame uniform block is bound here, and every GLSLProgram declares it:
+
+#define FRAME_UNIFORMS_BINDING		0
+
+// how many frames can be in flight before we have to wait on the gpu:
+
+#define FRAME_UNIFORMS_RING		3
+
+
+// this must match the std140 layout of FrameUniformsGlsl, below
+// (a vec3 is 16-byte aligned, but the float after it packs into its 4th slot):
+
+struct FrameUniformData
+{
+	float	uLightPos[3];		// offset  0
+	float	uBumpTime;		// offset 12
+	float	uBulbTime;		// offset 16
+	float	uSpinTime;		// offset 20
+	float	uStarTime;		// offset 24
+	float	pad;			// offset 28
+};
+
+
+// the glsl declaration that GLSLProgram puts in front of every shader:
+
+extern const char *FrameUniformsGlsl;
+
+
+class FrameUniforms
+{
+    private:
+	GLuint			Buffer;
+	GLint			Stride;		// sizeof(FrameUniformData), rounded up to the offset alignment
+	unsigned char *		Mapped;		// persistent mapping of the whole ring, or NULL
+	GLsync			Fences[FRAME_UNIFORMS_RING];
+	int			Current;
+	bool			Verbose;
+
+    public:
+	FrameUniformData	Data;		// fill this in, then call Update( )
+
+	FrameUniforms( );
+	~FrameUniforms( );
+
+	void	Init( );
+	void	SetVerbose( bool );
+	void	Update( );
+};
+
+#endif		// #ifndef FRAME_UNIFORMS_H
@@ -308,3 +308,7 @@ namespace detail
 	}
 
 }//namespace glm
+
+#if GLM_NOT_BUGGY_VC32BITS && (GLM_ARCH & GLM_ARCH_SSE2)
+#	include "func_matrix_simd.inl"
+#endif
@@ -674,10 +674,27 @@
 // Not standard
 #define GLM_HAS_ANONYMOUS_UNION (GLM_LANG & GLM_LANG_CXXMS_FLAG)
 
+// User defines: GLM_FORCE_SIMD_STORAGE
+
+// The SSE and AVX code paths of vec4 and mat4 load and store the components with unaligned loads and
+// stores, so vec4 keeps the layout of four Ts (4 byte aligned for float) on every compiler but MSVC.
+// MSVC with its language extensions (GLM_HAS_ANONYMOUS_UNION) has always kept a register in a union with
+// the components, which makes vec4 16 byte aligned (and dvec4 32 byte aligned with AVX).
+// GLM_FORCE_SIMD_STORAGE does the same with GCC and Clang, as a GNU extension, so the paths work on the
+// register directly. It changes the size and alignment of any type holding a vec4, so it has to be
+// defined the same way in every translation unit and library that share those types.
+#if GLM_HAS_ANONYMOUS_UNION
+#	define GLM_HAS_SIMD_STORAGE 1
+#elif defined(GLM_FORCE_SIMD_STORAGE) && (GLM_COMPILER & (GLM_COMPILER_GCC | GLM_COMPILER_LLVM | GLM_COMPILER_APPLE_CLANG))
+#	define GLM_HAS_SIMD_STORAGE 1
+#else
+#	define GLM_HAS_SIMD_STORAGE 0
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////////
 // Platform 
 
-// User defines: GLM_FORCE_PURE GLM_FORCE_SSE2 GLM_FORCE_SSE3 GLM_FORCE_AVX GLM_FORCE_AVX2
+// User defines: GLM_FORCE_PURE GLM_FORCE_SSE2 GLM_FORCE_SSE3 GLM_FORCE_SSE4 GLM_FORCE_AVX GLM_FORCE_AVX2
 
 #define GLM_ARCH_PURE		0x0000
 #define GLM_ARCH_ARM		0x0001
@@ -702,9 +719,11 @@
 #	define GLM_ARCH (GLM_ARCH_SSE2)
 #elif (GLM_COMPILER & (GLM_COMPILER_APPLE_CLANG | GLM_COMPILER_LLVM | GLM_COMPILER_GCC)) || ((GLM_COMPILER & GLM_COMPILER_INTEL) && (GLM_PLATFORM & GLM_PLATFORM_LINUX))
 #	if(__AVX2__)
-#		define GLM_ARCH (GLM_ARCH_AVX2 | GLM_ARCH_AVX | GLM_ARCH_SSE3 | GLM_ARCH_SSE2)
+#		define GLM_ARCH (GLM_ARCH_AVX2 | GLM_ARCH_AVX | GLM_ARCH_SSE4 | GLM_ARCH_SSE3 | GLM_ARCH_SSE2)
 #	elif(__AVX__)
-#		define GLM_ARCH (GLM_ARCH_AVX | GLM_ARCH_SSE3 | GLM_ARCH_SSE2)
+#		define GLM_ARCH (GLM_ARCH_AVX | GLM_ARCH_SSE4 | GLM_ARCH_SSE3 | GLM_ARCH_SSE2)
+#	elif(__SSE4_1__)
+#		define GLM_ARCH (GLM_ARCH_SSE4 | GLM_ARCH_SSE3 | GLM_ARCH_SSE2)
 #	elif(__SSE3__)
 #		define GLM_ARCH (GLM_ARCH_SSE3 | GLM_ARCH_SSE2)
 #	elif(__SSE2__)
@@ -719,7 +738,7 @@
 #		define GLM_ARCH (GLM_ARCH_AVX2 | GLM_ARCH_AVX | GLM_ARCH_SSE4 | GLM_ARCH_SSE3 | GLM_ARCH_SSE2)
 #	elif defined(__AVX__)
 #		define GLM_ARCH (GLM_ARCH_AVX | GLM_ARCH_SSE4 | GLM_ARCH_SSE3 | GLM_ARCH_SSE2)
-#	elif _M_IX86_FP == 2
+#	elif defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP == 2) // _M_IX86_FP is only defined for 32 bits, x64 always has SSE2
 #		define GLM_ARCH (GLM_ARCH_SSE2)
 #	else
 #		define GLM_ARCH (GLM_ARCH_PURE)
@@ -782,6 +801,8 @@
 #		pragma message("GLM: AVX2 instruction set")
 #	elif(GLM_ARCH & GLM_ARCH_AVX)
 #		pragma message("GLM: AVX instruction set")
+#	elif(GLM_ARCH & GLM_ARCH_SSE4)
+#		pragma message("GLM: SSE4 instruction set")
 #	elif(GLM_ARCH & GLM_ARCH_SSE3)
 #		pragma message("GLM: SSE3 instruction set")
 #	elif(GLM_ARCH & GLM_ARCH_SSE2)
@@ -789,6 +810,39 @@
 #	endif//GLM_ARCH
 #endif//GLM_MESSAGE
 
+///////////////////////////////////////////////////////////////////////////////////
+// SIMD results
+
+// User defines: GLM_FORCE_SIMD_STRICT
+
+// The SSE and AVX code paths of vec4 and mat4 normally use fused multiply-adds where the
+// compiler allows them (AVX2 with FMA3) and shorter chains of additions in matrix products,
+// so their results can differ from the platform independent code in the last bits.
+// With GLM_FORCE_SIMD_STRICT they do the same operations, in the same order, as the
+// platform independent code and give the same bits. (With GCC and Clang, also build with
+// -ffp-contract=off, or the compiler fuses the multiplies and adds on its own.)
+
+#if defined(GLM_FORCE_SIMD_STRICT)
+#	define GLM_SIMD_STRICT 1
+#else
+#	define GLM_SIMD_STRICT 0
+#endif
+
+#if (GLM_ARCH & GLM_ARCH_AVX2) && !GLM_SIMD_STRICT && (defined(__FMA__) || (GLM_COMPILER & GLM_COMPILER_VC))
+#	define GLM_SIMD_FMA 1
+#else
+#	define GLM_SIMD_FMA 0
+#endif
+
+#if defined(GLM_MESSAGES) && !defined(GLM_MESSAGE_SIMD_STRICT_DISPLAYED)
+#	define GLM_MESSAGE_SIMD_STRICT_DISPLAYED
+#	if GLM_SIMD_STRICT
+#		pragma message("GLM: SIMD code paths give the same results as the platform independent code")
+#	elif GLM_SIMD_FMA
+#		pragma message("GLM: SIMD code paths use fused multiply-adds, #define GLM_FORCE_SIMD_STRICT to match the platform independent code")
+#	endif
+#endif//GLM_MESSAGE
+
 ///////////////////////////////////////////////////////////////////////////////////
 // Static assert
 
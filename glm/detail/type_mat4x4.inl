@@ -788,3 +788,7 @@ namespace detail
 		return (m1[0] != m2[0]) || (m1[1] != m2[1]) || (m1[2] != m2[2]) || (m1[3] != m2[3]);
 	}
 }//namespace glm
+
+#if GLM_NOT_BUGGY_VC32BITS && (GLM_ARCH & GLM_ARCH_SSE2)
+#	include "type_mat4x4_simd.inl"
+#endif
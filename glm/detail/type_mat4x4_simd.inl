@@ -0,0 +1,187 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// OpenGL Mathematics (glm.g-truc.net)
+///
+/// Copyright (c) 2005 - 2015 G-Truc Creation (www.g-truc.net)
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+/// 
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+/// 
+/// Restrictions:
+///		By making use of the Software for military purposes, you choose to make
+///		a Bunny unhappy.
+/// 
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+/// @ref core
+/// @file glm/detail/type_mat4x4_simd.inl
+/// @date 2026-10-19 / 2026-10-19
+///////////////////////////////////////////////////////////////////////////////////
+
+#include "intrinsic_matrix.hpp"
+
+namespace glm{
+namespace detail
+{
+	// m[0] * v[0] + m[1] * v[1] + m[2] * v[2] + m[3] * v[3], added up from left to right like the platform
+	// independent mat4 * mat4 and vec4 * mat4 do, unless GLM_SIMD_STRICT is off and a shorter chain can be used
+	GLM_FUNC_QUALIFIER __m128 sse_mul_col_ps(__m128 const m[4], __m128 v)
+	{
+		__m128 const v0 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+		__m128 const v1 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+		__m128 const v2 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+		__m128 const v3 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+
+#		if GLM_SIMD_STRICT
+			__m128 const a0 = _mm_add_ps(_mm_mul_ps(m[0], v0), _mm_mul_ps(m[1], v1));
+			__m128 const a1 = _mm_add_ps(a0, _mm_mul_ps(m[2], v2));
+			return _mm_add_ps(a1, _mm_mul_ps(m[3], v3));
+#		elif GLM_SIMD_FMA
+			__m128 const a0 = _mm_fmadd_ps(m[1], v1, _mm_mul_ps(m[0], v0));
+			__m128 const a1 = _mm_fmadd_ps(m[3], v3, _mm_mul_ps(m[2], v2));
+			return _mm_add_ps(a0, a1);
+#		else
+			__m128 const a0 = _mm_add_ps(_mm_mul_ps(m[0], v0), _mm_mul_ps(m[1], v1));
+			__m128 const a1 = _mm_add_ps(_mm_mul_ps(m[2], v2), _mm_mul_ps(m[3], v3));
+			return _mm_add_ps(a0, a1);
+#		endif
+	}
+
+	// m * v, which the platform independent code adds up in pairs, so only fused multiply-adds change its result
+	GLM_FUNC_QUALIFIER __m128 sse_mul_vec_ps(__m128 const m[4], __m128 v)
+	{
+#		if GLM_SIMD_FMA
+			__m128 const v0 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+			__m128 const v1 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+			__m128 const v2 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+			__m128 const v3 = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+			__m128 const a0 = _mm_fmadd_ps(m[1], v1, _mm_mul_ps(m[0], v0));
+			__m128 const a1 = _mm_fmadd_ps(m[3], v3, _mm_mul_ps(m[2], v2));
+			return _mm_add_ps(a0, a1);
+#		else
+			return sse_mul_ps(m, v);
+#		endif
+	}
+
+	GLM_FUNC_QUALIFIER void sse_mul_mat_ps(__m128 const in1[4], __m128 const in2[4], __m128 out[4])
+	{
+#		if GLM_ARCH & GLM_ARCH_AVX
+			// two columns of the result at a time: each 128 bit half of a register is one column
+			__m256 const a0 = _mm256_insertf128_ps(_mm256_castps128_ps256(in1[0]), in1[0], 1);
+			__m256 const a1 = _mm256_insertf128_ps(_mm256_castps128_ps256(in1[1]), in1[1], 1);
+			__m256 const a2 = _mm256_insertf128_ps(_mm256_castps128_ps256(in1[2]), in1[2], 1);
+			__m256 const a3 = _mm256_insertf128_ps(_mm256_castps128_ps256(in1[3]), in1[3], 1);
+
+			for(int i = 0; i < 4; i += 2)
+			{
+				__m256 const b = _mm256_insertf128_ps(_mm256_castps128_ps256(in2[i]), in2[i + 1], 1);
+				__m256 const b0 = _mm256_permute_ps(b, _MM_SHUFFLE(0, 0, 0, 0));
+				__m256 const b1 = _mm256_permute_ps(b, _MM_SHUFFLE(1, 1, 1, 1));
+				__m256 const b2 = _mm256_permute_ps(b, _MM_SHUFFLE(2, 2, 2, 2));
+				__m256 const b3 = _mm256_permute_ps(b, _MM_SHUFFLE(3, 3, 3, 3));
+
+#				if GLM_SIMD_STRICT
+					__m256 const s0 = _mm256_add_ps(_mm256_mul_ps(a0, b0), _mm256_mul_ps(a1, b1));
+					__m256 const s1 = _mm256_add_ps(s0, _mm256_mul_ps(a2, b2));
+					__m256 const r = _mm256_add_ps(s1, _mm256_mul_ps(a3, b3));
+#				elif GLM_SIMD_FMA
+					__m256 const s0 = _mm256_fmadd_ps(a1, b1, _mm256_mul_ps(a0, b0));
+					__m256 const s1 = _mm256_fmadd_ps(a3, b3, _mm256_mul_ps(a2, b2));
+					__m256 const r = _mm256_add_ps(s0, s1);
+#				else
+					__m256 const s0 = _mm256_add_ps(_mm256_mul_ps(a0, b0), _mm256_mul_ps(a1, b1));
+					__m256 const s1 = _mm256_add_ps(_mm256_mul_ps(a2, b2), _mm256_mul_ps(a3, b3));
+					__m256 const r = _mm256_add_ps(s0, s1);
+#				endif
+
+				out[i] = _mm256_castps256_ps128(r);
+				out[i + 1] = _mm256_extractf128_ps(r, 1);
+			}
+#		else
+			out[0] = sse_mul_col_ps(in1, in2[0]);
+			out[1] = sse_mul_col_ps(in1, in2[1]);
+			out[2] = sse_mul_col_ps(in1, in2[2]);
+			out[3] = sse_mul_col_ps(in1, in2[3]);
+#		endif
+	}
+
+	// v * m is the dot product of v with each column, which is m transposed times v
+	GLM_FUNC_QUALIFIER __m128 sse_mul_row_ps(__m128 v, __m128 const m[4])
+	{
+		__m128 t[4];
+		sse_transpose_ps(m, t);
+		return sse_mul_col_ps(t, v);
+	}
+
+	// sse_inverse_ps does the operations of compute_inverse in the same order, so there is no strict version of it
+#	define GLM_MAT4_SIMD_INVERSE(P) \
+	template <> \
+	GLM_FUNC_QUALIFIER tmat4x4<float, P> compute_inverse(tmat4x4<float, P> const & m) \
+	{ \
+		__m128 const in[4] = {detail::simd_load(m[0]), detail::simd_load(m[1]), detail::simd_load(m[2]), detail::simd_load(m[3])}; \
+		__m128 out[4]; \
+		sse_inverse_ps(in, out); \
+		tmat4x4<float, P> Result(uninitialize); \
+		detail::simd_store(Result[0], out[0]); \
+		detail::simd_store(Result[1], out[1]); \
+		detail::simd_store(Result[2], out[2]); \
+		detail::simd_store(Result[3], out[3]); \
+		return Result; \
+	}
+
+	GLM_MAT4_SIMD_INVERSE(lowp)
+	GLM_MAT4_SIMD_INVERSE(mediump)
+	GLM_MAT4_SIMD_INVERSE(highp)
+
+#	undef GLM_MAT4_SIMD_INVERSE
+}//namespace detail
+
+#	define GLM_MAT4_SIMD_OPERATORS(P) \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<float, P> operator*(tmat4x4<float, P> const & m, tvec4<float, P> const & v) \
+	{ \
+		__m128 const in[4] = {detail::simd_load(m[0]), detail::simd_load(m[1]), detail::simd_load(m[2]), detail::simd_load(m[3])}; \
+		tvec4<float, P> Result(uninitialize); \
+		detail::simd_store(Result, detail::sse_mul_vec_ps(in, detail::simd_load(v))); \
+		return Result; \
+	} \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<float, P> operator*(tvec4<float, P> const & v, tmat4x4<float, P> const & m) \
+	{ \
+		__m128 const in[4] = {detail::simd_load(m[0]), detail::simd_load(m[1]), detail::simd_load(m[2]), detail::simd_load(m[3])}; \
+		tvec4<float, P> Result(uninitialize); \
+		detail::simd_store(Result, detail::sse_mul_row_ps(detail::simd_load(v), in)); \
+		return Result; \
+	} \
+	template <> \
+	GLM_FUNC_QUALIFIER tmat4x4<float, P> operator*(tmat4x4<float, P> const & m1, tmat4x4<float, P> const & m2) \
+	{ \
+		__m128 const in1[4] = {detail::simd_load(m1[0]), detail::simd_load(m1[1]), detail::simd_load(m1[2]), detail::simd_load(m1[3])}; \
+		__m128 const in2[4] = {detail::simd_load(m2[0]), detail::simd_load(m2[1]), detail::simd_load(m2[2]), detail::simd_load(m2[3])}; \
+		__m128 out[4]; \
+		detail::sse_mul_mat_ps(in1, in2, out); \
+		tmat4x4<float, P> Result(uninitialize); \
+		detail::simd_store(Result[0], out[0]); \
+		detail::simd_store(Result[1], out[1]); \
+		detail::simd_store(Result[2], out[2]); \
+		detail::simd_store(Result[3], out[3]); \
+		return Result; \
+	}
+
+	GLM_MAT4_SIMD_OPERATORS(lowp)
+	GLM_MAT4_SIMD_OPERATORS(mediump)
+	GLM_MAT4_SIMD_OPERATORS(highp)
+
+#	undef GLM_MAT4_SIMD_OPERATORS
+}//namespace glm
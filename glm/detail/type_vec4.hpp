@@ -133,6 +133,15 @@ namespace detail
 					_GLM_SWIZZLE4_4_MEMBERS(T, P, tvec4, s, t, p, q)
 #				endif//GLM_SWIZZLE
 			};
+#		elif GLM_HAS_SIMD_STORAGE
+			__extension__ union
+			{
+				__extension__ struct { T x, y, z, w;};
+				__extension__ struct { T r, g, b, a; };
+				__extension__ struct { T s, t, p, q; };
+
+				typename detail::simd<T>::type data;
+			};
 #		else
 			union { T x, r, s; };
 			union { T y, g, t; };
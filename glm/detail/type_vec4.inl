@@ -1111,7 +1111,7 @@ namespace glm
 	}
 }//namespace glm
 
-#if GLM_HAS_ANONYMOUS_UNION && GLM_NOT_BUGGY_VC32BITS
+#if GLM_NOT_BUGGY_VC32BITS
 #if GLM_ARCH & GLM_ARCH_SSE2
 #	include "type_vec4_sse2.inl"
 #endif
@@ -1121,4 +1121,4 @@ namespace glm
 #if GLM_ARCH & GLM_ARCH_AVX2
 #	include "type_vec4_avx2.inl"
 #endif
-#endif//
+#endif//GLM_NOT_BUGGY_VC32BITS
@@ -33,9 +33,75 @@
 namespace glm{
 namespace detail
 {
+	template <precision P>
+	GLM_FUNC_QUALIFIER __m256d simd_load(tvec4<double, P> const & v)
+	{
+#		if GLM_HAS_SIMD_STORAGE
+			return v.data;
+#		else
+			return _mm256_loadu_pd(&v.x);
+#		endif
+	}
 
+	// (a store of doubles, for the reason the float one is a store of floats)
+	template <precision P>
+	GLM_FUNC_QUALIFIER void simd_store(tvec4<double, P> & v, __m256d r)
+	{
+#		if GLM_HAS_SIMD_STORAGE
+			v.data = r;
+#		elif GLM_COMPILER & (GLM_COMPILER_GCC | GLM_COMPILER_LLVM | GLM_COMPILER_APPLE_CLANG)
+			typedef double unaligned_type __attribute__((vector_size(32), aligned(8)));
+			*reinterpret_cast<unaligned_type *>(&v.x) = r;
+#		else
+			_mm256_storeu_pd(&v.x, r);
+#		endif
+	}
 }//namespace detail
 
-	
+	//////////////////////////////////////
+	// Binary arithmetic operators of double vectors
+	// (lane by lane, so the results are those of the platform independent code)
 
+#	define GLM_VEC4_AVX_ARITHMETIC(P, op, intrinsic) \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<double, P> operator op(tvec4<double, P> const & v, double scalar) \
+	{ \
+		tvec4<double, P> Result(uninitialize); \
+		detail::simd_store(Result, intrinsic(detail::simd_load(v), _mm256_set1_pd(scalar))); \
+		return Result; \
+	} \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<double, P> operator op(double scalar, tvec4<double, P> const & v) \
+	{ \
+		tvec4<double, P> Result(uninitialize); \
+		detail::simd_store(Result, intrinsic(_mm256_set1_pd(scalar), detail::simd_load(v))); \
+		return Result; \
+	} \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<double, P> operator op(tvec4<double, P> const & v1, tvec4<double, P> const & v2) \
+	{ \
+		tvec4<double, P> Result(uninitialize); \
+		detail::simd_store(Result, intrinsic(detail::simd_load(v1), detail::simd_load(v2))); \
+		return Result; \
+	}
+
+#	define GLM_VEC4_AVX_OPERATORS(P) \
+	GLM_VEC4_AVX_ARITHMETIC(P, +, _mm256_add_pd) \
+	GLM_VEC4_AVX_ARITHMETIC(P, -, _mm256_sub_pd) \
+	GLM_VEC4_AVX_ARITHMETIC(P, *, _mm256_mul_pd) \
+	GLM_VEC4_AVX_ARITHMETIC(P, /, _mm256_div_pd) \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<double, P> operator-(tvec4<double, P> const & v) \
+	{ \
+		tvec4<double, P> Result(uninitialize); \
+		detail::simd_store(Result, _mm256_xor_pd(detail::simd_load(v), _mm256_set1_pd(-0.0))); \
+		return Result; \
+	}
+
+	GLM_VEC4_AVX_OPERATORS(lowp)
+	GLM_VEC4_AVX_OPERATORS(mediump)
+	GLM_VEC4_AVX_OPERATORS(highp)
+
+#	undef GLM_VEC4_AVX_OPERATORS
+#	undef GLM_VEC4_AVX_ARITHMETIC
 }//namespace glm
@@ -33,9 +33,94 @@
 namespace glm{
 namespace detail
 {
+	// (the stores are of the vector's own integers, for the reason the float one is a store of floats)
+	template <precision P>
+	GLM_FUNC_QUALIFIER __m256i simd_load(tvec4<int64, P> const & v)
+	{
+#		if GLM_HAS_SIMD_STORAGE
+			return v.data;
+#		else
+			return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&v.x));
+#		endif
+	}
 
+	template <precision P>
+	GLM_FUNC_QUALIFIER void simd_store(tvec4<int64, P> & v, __m256i r)
+	{
+#		if GLM_HAS_SIMD_STORAGE
+			v.data = r;
+#		elif GLM_COMPILER & (GLM_COMPILER_GCC | GLM_COMPILER_LLVM | GLM_COMPILER_APPLE_CLANG)
+			typedef int64 unaligned_type __attribute__((vector_size(32), aligned(8)));
+			*reinterpret_cast<unaligned_type *>(&v.x) = (unaligned_type)r;
+#		else
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(&v.x), r);
+#		endif
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER __m256i simd_load(tvec4<uint64, P> const & v)
+	{
+#		if GLM_HAS_SIMD_STORAGE
+			return v.data;
+#		else
+			return _mm256_loadu_si256(reinterpret_cast<__m256i const *>(&v.x));
+#		endif
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void simd_store(tvec4<uint64, P> & v, __m256i r)
+	{
+#		if GLM_HAS_SIMD_STORAGE
+			v.data = r;
+#		elif GLM_COMPILER & (GLM_COMPILER_GCC | GLM_COMPILER_LLVM | GLM_COMPILER_APPLE_CLANG)
+			typedef uint64 unaligned_type __attribute__((vector_size(32), aligned(8)));
+			*reinterpret_cast<unaligned_type *>(&v.x) = (unaligned_type)r;
+#		else
+			_mm256_storeu_si256(reinterpret_cast<__m256i *>(&v.x), r);
+#		endif
+	}
 }//namespace detail
 
-	
+	//////////////////////////////////////
+	// Additive and bitwise operators of 64 bit integer vectors
+
+#	define GLM_VEC4_AVX2_OPERATOR(T, P, op, intrinsic) \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<T, P> operator op(tvec4<T, P> const & v, T scalar) \
+	{ \
+		tvec4<T, P> Result(uninitialize); \
+		detail::simd_store(Result, intrinsic(detail::simd_load(v), _mm256_set1_epi64x(static_cast<long long>(scalar)))); \
+		return Result; \
+	} \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<T, P> operator op(T scalar, tvec4<T, P> const & v) \
+	{ \
+		tvec4<T, P> Result(uninitialize); \
+		detail::simd_store(Result, intrinsic(_mm256_set1_epi64x(static_cast<long long>(scalar)), detail::simd_load(v))); \
+		return Result; \
+	} \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<T, P> operator op(tvec4<T, P> const & v1, tvec4<T, P> const & v2) \
+	{ \
+		tvec4<T, P> Result(uninitialize); \
+		detail::simd_store(Result, intrinsic(detail::simd_load(v1), detail::simd_load(v2))); \
+		return Result; \
+	}
+
+#	define GLM_VEC4_AVX2_OPERATORS(T, P) \
+	GLM_VEC4_AVX2_OPERATOR(T, P, +, _mm256_add_epi64) \
+	GLM_VEC4_AVX2_OPERATOR(T, P, -, _mm256_sub_epi64) \
+	GLM_VEC4_AVX2_OPERATOR(T, P, &, _mm256_and_si256) \
+	GLM_VEC4_AVX2_OPERATOR(T, P, |, _mm256_or_si256) \
+	GLM_VEC4_AVX2_OPERATOR(T, P, ^, _mm256_xor_si256)
+
+	GLM_VEC4_AVX2_OPERATORS(int64, lowp)
+	GLM_VEC4_AVX2_OPERATORS(int64, mediump)
+	GLM_VEC4_AVX2_OPERATORS(int64, highp)
+	GLM_VEC4_AVX2_OPERATORS(uint64, lowp)
+	GLM_VEC4_AVX2_OPERATORS(uint64, mediump)
+	GLM_VEC4_AVX2_OPERATORS(uint64, highp)
 
+#	undef GLM_VEC4_AVX2_OPERATORS
+#	undef GLM_VEC4_AVX2_OPERATOR
 }//namespace glm
@@ -33,9 +33,36 @@
 namespace glm{
 namespace detail
 {
+	// the components of a vec4 as a register: its storage with GLM_HAS_SIMD_STORAGE,
+	// otherwise an unaligned load and store of the four floats
+	template <precision P>
+	GLM_FUNC_QUALIFIER __m128 simd_load(tvec4<float, P> const & v)
+	{
+#		if GLM_HAS_SIMD_STORAGE
+			return v.data;
+#		else
+			return _mm_loadu_ps(&v.x);
+#		endif
+	}
 
+	// (with GCC and Clang, as a vector of floats: a store by _mm_storeu_ps( ) may alias anything,
+	// so the compiler would load every pointer it keeps in memory again after it)
+	template <precision P>
+	GLM_FUNC_QUALIFIER void simd_store(tvec4<float, P> & v, __m128 r)
+	{
+#		if GLM_HAS_SIMD_STORAGE
+			v.data = r;
+#		elif GLM_COMPILER & (GLM_COMPILER_GCC | GLM_COMPILER_LLVM | GLM_COMPILER_APPLE_CLANG)
+			typedef float unaligned_type __attribute__((vector_size(16), aligned(4)));
+			*reinterpret_cast<unaligned_type *>(&v.x) = r;
+#		else
+			_mm_storeu_ps(&v.x, r);
+#		endif
+	}
 }//namespace detail
 
+#if GLM_HAS_SIMD_STORAGE
+
 	template <>
 	GLM_FUNC_QUALIFIER tvec4<float, lowp>::tvec4()
 #		ifndef GLM_FORCE_NO_CTOR_INIT
@@ -50,6 +77,13 @@ namespace detail
 #		endif
 	{}
 
+	template <>
+	GLM_FUNC_QUALIFIER tvec4<float, highp>::tvec4()
+#		ifndef GLM_FORCE_NO_CTOR_INIT
+			: data(_mm_setzero_ps())
+#		endif
+	{}
+
 	template <>
 	GLM_FUNC_QUALIFIER tvec4<float, lowp>::tvec4(float s) :
 		data(_mm_set1_ps(s))
@@ -60,6 +94,11 @@ namespace detail
 		data(_mm_set1_ps(s))
 	{}
 
+	template <>
+	GLM_FUNC_QUALIFIER tvec4<float, highp>::tvec4(float s) :
+		data(_mm_set1_ps(s))
+	{}
+
 	template <>
 	GLM_FUNC_QUALIFIER tvec4<float, lowp>::tvec4(float a, float b, float c, float d) :
 		data(_mm_set_ps(d, c, b, a))
@@ -70,11 +109,38 @@ namespace detail
 		data(_mm_set_ps(d, c, b, a))
 	{}
 
+	template <>
+	GLM_FUNC_QUALIFIER tvec4<float, highp>::tvec4(float a, float b, float c, float d) :
+		data(_mm_set_ps(d, c, b, a))
+	{}
+
+#endif//GLM_HAS_SIMD_STORAGE
+
+	// (copied as one register rather than four floats, which would have to be put back together to be used)
+#	define GLM_VEC4_SSE2_COPY(P) \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<float, P>::tvec4(tvec4<float, P> const & v) \
+	{ \
+		detail::simd_store(*this, detail::simd_load(v)); \
+	} \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<float, P> & tvec4<float, P>::operator=(tvec4<float, P> const & v) \
+	{ \
+		detail::simd_store(*this, detail::simd_load(v)); \
+		return *this; \
+	}
+
+	GLM_VEC4_SSE2_COPY(lowp)
+	GLM_VEC4_SSE2_COPY(mediump)
+	GLM_VEC4_SSE2_COPY(highp)
+
+#	undef GLM_VEC4_SSE2_COPY
+
 	template <>
 	template <typename U>
 	GLM_FUNC_QUALIFIER tvec4<float, lowp> & tvec4<float, lowp>::operator+=(U scalar)
 	{
-		this->data = _mm_add_ps(this->data, _mm_set_ps1(static_cast<float>(scalar)));
+		detail::simd_store(*this, _mm_add_ps(detail::simd_load(*this), _mm_set_ps1(static_cast<float>(scalar))));
 		return *this;
 	}
 
@@ -82,7 +148,7 @@ namespace detail
 	template <>
 	GLM_FUNC_QUALIFIER tvec4<float, lowp> & tvec4<float, lowp>::operator+=<float>(float scalar)
 	{
-		this->data = _mm_add_ps(this->data, _mm_set_ps1(scalar));
+		detail::simd_store(*this, _mm_add_ps(detail::simd_load(*this), _mm_set_ps1(scalar)));
 		return *this;
 	}
 
@@ -90,7 +156,7 @@ namespace detail
 	template <typename U>
 	GLM_FUNC_QUALIFIER tvec4<float, mediump> & tvec4<float, mediump>::operator+=(U scalar)
 	{
-		this->data = _mm_add_ps(this->data, _mm_set_ps1(static_cast<float>(scalar)));
+		detail::simd_store(*this, _mm_add_ps(detail::simd_load(*this), _mm_set_ps1(static_cast<float>(scalar))));
 		return *this;
 	}
 
@@ -98,7 +164,7 @@ namespace detail
 	template <>
 	GLM_FUNC_QUALIFIER tvec4<float, mediump> & tvec4<float, mediump>::operator+=<float>(float scalar)
 	{
-		this->data = _mm_add_ps(this->data, _mm_set_ps1(scalar));
+		detail::simd_store(*this, _mm_add_ps(detail::simd_load(*this), _mm_set_ps1(scalar)));
 		return *this;
 	}
 
@@ -106,7 +172,7 @@ namespace detail
 	template <typename U>
 	GLM_FUNC_QUALIFIER tvec4<float, lowp> & tvec4<float, lowp>::operator+=(tvec1<U, lowp> const & v)
 	{
-		this->data = _mm_add_ps(this->data, _mm_set_ps1(static_cast<float>(v.x)));
+		detail::simd_store(*this, _mm_add_ps(detail::simd_load(*this), _mm_set_ps1(static_cast<float>(v.x))));
 		return *this;
 	}
 
@@ -114,7 +180,54 @@ namespace detail
 	template <typename U>
 	GLM_FUNC_QUALIFIER tvec4<float, mediump> & tvec4<float, mediump>::operator+=(tvec1<U, mediump> const & v)
 	{
-		this->data = _mm_add_ps(this->data, _mm_set_ps1(static_cast<float>(v.x)));
+		detail::simd_store(*this, _mm_add_ps(detail::simd_load(*this), _mm_set_ps1(static_cast<float>(v.x))));
 		return *this;
 	}
+
+	//////////////////////////////////////
+	// Binary arithmetic operators
+	// (lane by lane, so the results are those of the platform independent code)
+
+#	define GLM_VEC4_SSE2_ARITHMETIC(P, op, intrinsic) \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<float, P> operator op(tvec4<float, P> const & v, float scalar) \
+	{ \
+		tvec4<float, P> Result(uninitialize); \
+		detail::simd_store(Result, intrinsic(detail::simd_load(v), _mm_set1_ps(scalar))); \
+		return Result; \
+	} \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<float, P> operator op(float scalar, tvec4<float, P> const & v) \
+	{ \
+		tvec4<float, P> Result(uninitialize); \
+		detail::simd_store(Result, intrinsic(_mm_set1_ps(scalar), detail::simd_load(v))); \
+		return Result; \
+	} \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<float, P> operator op(tvec4<float, P> const & v1, tvec4<float, P> const & v2) \
+	{ \
+		tvec4<float, P> Result(uninitialize); \
+		detail::simd_store(Result, intrinsic(detail::simd_load(v1), detail::simd_load(v2))); \
+		return Result; \
+	}
+
+#	define GLM_VEC4_SSE2_OPERATORS(P) \
+	GLM_VEC4_SSE2_ARITHMETIC(P, +, _mm_add_ps) \
+	GLM_VEC4_SSE2_ARITHMETIC(P, -, _mm_sub_ps) \
+	GLM_VEC4_SSE2_ARITHMETIC(P, *, _mm_mul_ps) \
+	GLM_VEC4_SSE2_ARITHMETIC(P, /, _mm_div_ps) \
+	template <> \
+	GLM_FUNC_QUALIFIER tvec4<float, P> operator-(tvec4<float, P> const & v) \
+	{ \
+		tvec4<float, P> Result(uninitialize); \
+		detail::simd_store(Result, _mm_xor_ps(detail::simd_load(v), _mm_set1_ps(-0.0f))); \
+		return Result; \
+	}
+
+	GLM_VEC4_SSE2_OPERATORS(lowp)
+	GLM_VEC4_SSE2_OPERATORS(mediump)
+	GLM_VEC4_SSE2_OPERATORS(highp)
+
+#	undef GLM_VEC4_SSE2_OPERATORS
+#	undef GLM_VEC4_SSE2_ARITHMETIC
 }//namespace glm
@@ -26,16 +26,28 @@
 ///
 /// @ref gtx_fast_trigonometry
 /// @file glm/gtx/fast_trigonometry.hpp
-/// @date 2006-01-08 / 2011-06-07
+/// @date 2006-01-08 / 2026-10-19
 /// @author Christophe Riccio
 ///
 /// @see core (dependence)
+/// @see gtx_wide (dependence)
 ///
 /// @defgroup gtx_fast_trigonometry GLM_GTX_fast_trigonometry
 /// @ingroup gtx
 /// 
 /// @brief Fast but less accurate implementations of trigonometric functions.
 /// 
+/// sincos( ) and fastSinCos( ) take the sine and cosine of a whole array of angles, of any size, with one call:
+/// each angle is brought to within pi/4 of a multiple q of pi/2 (pi/2 being split in parts so that the reduction is exact),
+/// and a polynomial of that remainder gives both of them, without a branch, gtx_wide lanes at a time for floats.
+/// The reduction is exact only while q is small, so angles farther from 0 than a limit, and inf and nan, are handed to
+/// std::sin and std::cos instead; every angle is then done right, and the same way whatever instruction set is used:
+///	- sincos( ) is to within 1 ulp of the exact sine and cosine (0.8 measured), for float and for double.
+///	  It uses the polynomials out to 6400 either side of 0 for float and out to 1e8 for double.
+///	- fastSinCos( ) is to within 2e-5 at less cost, out to 1e5 for float and 1e8 for double.
+/// Like any two-part sum, the reduction needs the compiler to keep the order of float operations (no /fp:fast or -ffast-math).
+/// tools/fasttrig.cpp checks both against std::sin and std::cos, and times them.
+/// 
 /// <glm/gtx/fast_trigonometry.hpp> need to be included to use these functionalities.
 ///////////////////////////////////////////////////////////////////////////////////
 
@@ -43,6 +55,9 @@
 
 // Dependency:
 #include "../gtc/constants.hpp"
+#include "wide.hpp"
+#include <cstddef>
+#include <cmath>
 
 #if(defined(GLM_MESSAGES) && !defined(GLM_EXT_INCLUDED))
 #	pragma message("GLM: GLM_GTX_fast_trigonometry extension included")
@@ -98,6 +113,34 @@ namespace glm
 	template <typename T> 
 	GLM_FUNC_DECL T fastAtan(T angle);
 
+	/// Sin[i] = sin(angle[i]) and Cos[i] = cos(angle[i]) for i = 0 to count-1, to within 1 ulp, for any angle.
+	/// threads splits the array into that many bands, each on its own std::thread (0 is one per hardware thread).
+	/// From GLM_GTX_fast_trigonometry extension.
+	GLM_FUNC_DECL void sincos(float const * angle, float * Sin, float * Cos, std::size_t count, int threads = 1);
+
+	/// Sin[i] = sin(angle[i]) and Cos[i] = cos(angle[i]) for i = 0 to count-1, to within 1 ulp, for any angle.
+	/// threads splits the array into that many bands, each on its own std::thread (0 is one per hardware thread).
+	/// From GLM_GTX_fast_trigonometry extension.
+	GLM_FUNC_DECL void sincos(double const * angle, double * Sin, double * Cos, std::size_t count, int threads = 1);
+
+	/// Faster than sincos( ) but less accurate: to within 2e-5, for any angle.
+	/// From GLM_GTX_fast_trigonometry extension.
+	GLM_FUNC_DECL void fastSinCos(float const * angle, float * Sin, float * Cos, std::size_t count, int threads = 1);
+
+	/// Faster than sincos( ) but less accurate: to within 2e-5, for any angle.
+	/// From GLM_GTX_fast_trigonometry extension.
+	GLM_FUNC_DECL void fastSinCos(double const * angle, double * Sin, double * Cos, std::size_t count, int threads = 1);
+
+	/// The sine and cosine of each lane of angle, as the array sincos( ) does them.
+	/// From GLM_GTX_fast_trigonometry extension.
+	template <int N>
+	GLM_FUNC_DECL void sincos(twide<N> const & angle, twide<N> & Sin, twide<N> & Cos);
+
+	/// The sine and cosine of each lane of angle, as the array fastSinCos( ) does them.
+	/// From GLM_GTX_fast_trigonometry extension.
+	template <int N>
+	GLM_FUNC_DECL void fastSinCos(twide<N> const & angle, twide<N> & Sin, twide<N> & Cos);
+
 	/// @}
 }//namespace glm
 
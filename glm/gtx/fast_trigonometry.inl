@@ -26,10 +26,13 @@
 ///
 /// @ref gtx_fast_trigonometry
 /// @file glm/gtx/fast_trigonometry.inl
-/// @date 2006-01-08 / 2014-11-25
+/// @date 2006-01-08 / 2026-10-19
 /// @author Christophe Riccio
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+// sincos( ) is cheap enough per angle that a band needs to be this long to be worth a thread:
+#define GLM_SINCOS_MIN_PER_THREAD	8192
+
 namespace glm{
 namespace detail
 {
@@ -159,4 +162,305 @@ namespace detail
 	{
 		return detail::functor1<T, T, P, vecType>::call(fastAtan, x);
 	}
+
+namespace detail
+{
+	//////////////////////////////////////
+	// sincos
+
+	// angle = q * pi/2 + r with |r| <= pi/4, SinR = sin(r) and CosR = cos(r): q mod 4 says which of those is the sine and
+	// which the cosine of angle, and their signs -- picked by multiplying with 0s and 1s, so each lane takes its own quadrant
+	template <typename T, typename valType>
+	GLM_FUNC_QUALIFIER void sincos_quadrant(valType const & q, valType const & SinR, valType const & CosR, valType & Sin, valType & Cos)
+	{
+		valType const Quadrant = q - T(4) * floor(q * T(0.25));
+		valType const Half = floor(Quadrant * T(0.5));		// the sine is negative in quadrants 2 and 3
+		valType const Odd = Quadrant - T(2) * Half;		// the cosine in 1 and 2, where Odd and Half differ
+		valType const Even = T(1) - Odd;
+		valType const SinSign = T(1) - T(2) * Half;
+		valType const CosSign = T(1) - T(2) * (Odd + Half - T(2) * Odd * Half);
+
+		Sin = (SinR * Even + CosR * Odd) * SinSign;
+		Cos = (CosR * Even + SinR * Odd) * CosSign;
+	}
+
+	// a + b = s + e exactly, whichever of a and b is the larger (Knuth's two-sum, which needs no fused multiply-add)
+	template <typename valType>
+	GLM_FUNC_QUALIFIER void sincos_two_sum(valType const & a, valType const & b, valType & s, valType & e)
+	{
+		s = a + b;
+		valType const bb = s - a;
+		e = (a - (s - bb)) + (b - bb);
+	}
+
+	// the accurate kernels take pi/2 = C1 + C2 + C3 + C4 off in four parts, the first three with few enough bits that
+	// q times them is exact below Limit, and keep what rounds in the sums as rl, so that r + rl is x - q * pi/2 to well past
+	// the precision of r; r * r is then split into z + zl (Dekker, Split = 2^(bits/2) + 1) and the polynomials,
+	// fdlibm's for float and cephes' for double, correct for rl, which is what gets them to within 1 ulp
+	// the fast kernels take pi/2 off in two parts and use minimax fits on [-pi/4, pi/4]
+	// past Limit (or for inf and nan) the kernels are not used: see sincos_fixup
+	template <typename T, bool Accurate>
+	struct sincos_kernel{};
+
+	template <typename T, typename valType>
+	GLM_FUNC_QUALIFIER void sincos_reduce(valType const & x, valType const & q, T C1, T C2, T C3, T C4, valType & r, valType & rl)
+	{
+		valType h1, e1, h2, e2;
+		sincos_two_sum(x - q * C1, q * -C2, h1, e1);
+		sincos_two_sum(h1, q * -C3, h2, e2);
+		valType const lo = (e1 + e2) - q * C4;
+		r = h2 + lo;
+		rl = lo - (r - h2);
+	}
+
+	// SinP and CosP are the sine and cosine polynomials of z beyond their first terms
+	template <typename T, typename valType>
+	GLM_FUNC_QUALIFIER void sincos_accurate(valType const & r, valType const & rl, valType const & z, valType const & zl, valType const & SinP, valType const & CosP, valType & SinR, valType & CosR)
+	{
+		SinR = r + ((rl - T(0.5) * z * rl) + r * z * SinP);
+
+		valType const hz = T(0.5) * z;
+		valType const w = T(1) - hz;
+		CosR = w + (((T(1) - w) - hz) + (z * z * CosP - (T(0.5) * zl + r * rl)));
+	}
+
+	template <typename T, typename valType>
+	GLM_FUNC_QUALIFIER void sincos_square(valType const & r, T Split, valType & z, valType & zl)
+	{
+		valType const c = Split * r;
+		valType const rh = c - (c - r);
+		valType const rlo = r - rh;
+		z = r * r;
+		zl = ((rh * rh - z) + T(2) * rh * rlo) + rlo * rlo;
+	}
+
+	template <>
+	struct sincos_kernel<float, true>
+	{
+		GLM_FUNC_QUALIFIER static float limit() {return 6400.f;}	// q < 2^12
+
+		template <typename valType>
+		GLM_FUNC_QUALIFIER static void call(valType const & x, valType & Sin, valType & Cos)
+		{
+			valType const q = floor(x * 0.636619772367581343f + 0.5f);
+			valType r, rl, z, zl;
+			sincos_reduce<float>(x, q, 1.57080078125f, -4.45358455e-6f, -8.70613803e-10f, 6.22337197e-14f, r, rl);
+			sincos_square<float>(r, 4097.f, z, zl);
+
+			valType const SinP = -1.6666667163e-1f + z * (8.3333337680e-3f + z * (-1.9841270114e-4f + z * 2.7557314297e-6f));
+			valType const CosP = 4.166664568298827e-2f + z * (-1.388731625493765e-3f + z * 2.443315711809948e-5f);
+			valType SinR, CosR;
+			sincos_accurate<float>(r, rl, z, zl, SinP, CosP, SinR, CosR);
+			sincos_quadrant<float>(q, SinR, CosR, Sin, Cos);
+		}
+	};
+
+	template <>
+	struct sincos_kernel<float, false>
+	{
+		GLM_FUNC_QUALIFIER static float limit() {return 1e5f;}		// q < 2^16
+
+		template <typename valType>
+		GLM_FUNC_QUALIFIER static void call(valType const & x, valType & Sin, valType & Cos)
+		{
+			valType const q = floor(x * 0.636619772367581343f + 0.5f);
+			valType const r = (x - q * 1.5703125f) - q * 4.8382679e-4f;
+			valType const z = r * r;
+
+			valType const SinR = r + r * z * (-0.1666283373f + z * 0.008152990499f);
+			valType const CosR = 1.0f + z * (-0.4997763021f + z * 0.04048892279f);
+			sincos_quadrant<float>(q, SinR, CosR, Sin, Cos);
+		}
+	};
+
+	template <>
+	struct sincos_kernel<double, true>
+	{
+		GLM_FUNC_QUALIFIER static double limit() {return 1e8;}		// q < 2^26
+
+		template <typename valType>
+		GLM_FUNC_QUALIFIER static void call(valType const & x, valType & Sin, valType & Cos)
+		{
+			valType const q = floor(x * 0.636619772367581343 + 0.5);
+			valType r, rl, z, zl;
+			sincos_reduce<double>(x, q, 1.5707963407039642, -1.3909067675399456e-8, 6.123233932053594e-17, 6.36831716351095e-25, r, rl);
+			sincos_square<double>(r, 134217729.0, z, zl);
+
+			valType const SinP = -1.66666666666666307295e-1 + z * (8.33333333332211858878e-3 + z * (-1.98412698295895385996e-4 +
+				z * (2.75573136213857245213e-6 + z * (-2.50507477628578072866e-8 + z * 1.58962301576546568060e-10))));
+			valType const CosP = 4.16666666666665929218e-2 + z * (-1.38888888888730564116e-3 + z * (2.48015872888517045348e-5 +
+				z * (-2.75573141792967388112e-7 + z * (2.08757008419747316778e-9 + z * -1.13585365213876817300e-11))));
+			valType SinR, CosR;
+			sincos_accurate<double>(r, rl, z, zl, SinP, CosP, SinR, CosR);
+			sincos_quadrant<double>(q, SinR, CosR, Sin, Cos);
+		}
+	};
+
+	template <>
+	struct sincos_kernel<double, false>
+	{
+		GLM_FUNC_QUALIFIER static double limit() {return 1e8;}		// q < 2^29
+
+		template <typename valType>
+		GLM_FUNC_QUALIFIER static void call(valType const & x, valType & Sin, valType & Cos)
+		{
+			valType const q = floor(x * 0.636619772367581343 + 0.5);
+			valType const r = (x - q * 1.57079625129699707031) - q * 7.54978995489188e-8;
+			valType const z = r * r;
+
+			valType const SinR = r + r * z * (-0.1666283373 + z * 0.008152990499);
+			valType const CosR = 1.0 + z * (-0.4997763021 + z * 0.04048892279);
+			sincos_quadrant<double>(q, SinR, CosR, Sin, Cos);
+		}
+	};
+
+	// the angles past Limit, and inf and nan, go to std::sin and std::cos instead (in double for floats, which rounds
+	// to the nearest float all but never), so that every angle is reduced correctly, and the same way on every instruction set
+	template <typename T>
+	GLM_FUNC_QUALIFIER void sincos_fixup(T const * Angle, T * Sin, T * Cos, std::size_t count, T Limit)
+	{
+		for(std::size_t i = 0; i < count; ++i)
+			if(!(Angle[i] <= Limit && Angle[i] >= -Limit))
+			{
+				double const a = static_cast<double>(Angle[i]);
+				Sin[i] = static_cast<T>(std::sin(a));
+				Cos[i] = static_cast<T>(std::cos(a));
+			}
+	}
+
+	// floats go through the kernel N at a time in twides, with the lanes past the end copies of the last angle
+	template <int N, bool Accurate>
+	struct sincos_job_float
+	{
+		float const * Angle;
+		float * Sin;
+		float * Cos;
+
+		GLM_FUNC_QUALIFIER void operator()(std::size_t first, std::size_t last) const
+		{
+			for(std::size_t i = first; i < last; i += N)
+			{
+				int const Count = last - i < std::size_t(N) ? static_cast<int>(last - i) : N;
+
+				twide<N> S, C;
+				if(Count == N)
+				{
+					sincos_kernel<float, Accurate>::call(twide<N>::load(Angle + i), S, C);
+					S.store(Sin + i);
+					C.store(Cos + i);
+					sincos_fixup(Angle + i, Sin + i, Cos + i, N, sincos_kernel<float, Accurate>::limit());
+				}
+				else
+				{
+					float Lanes[N];
+					for(int l = 0; l < N; ++l)
+						Lanes[l] = Angle[i + (l < Count ? l : Count - 1)];
+					sincos_kernel<float, Accurate>::call(twide<N>::load(Lanes), S, C);
+
+					float TmpSin[N], TmpCos[N];
+					S.store(TmpSin);
+					C.store(TmpCos);
+					sincos_fixup(Lanes, TmpSin, TmpCos, N, sincos_kernel<float, Accurate>::limit());
+					for(int l = 0; l < Count; ++l)
+					{
+						Sin[i + l] = TmpSin[l];
+						Cos[i + l] = TmpCos[l];
+					}
+				}
+			}
+		}
+	};
+
+	// gtx_wide has no double lanes: doubles go through the kernel one at a time, which, having no branches,
+	// is a loop the compiler is free to vectorize, and are fixed up after the whole band
+	template <bool Accurate>
+	struct sincos_job_double
+	{
+		double const * Angle;
+		double * Sin;
+		double * Cos;
+
+		GLM_FUNC_QUALIFIER void operator()(std::size_t first, std::size_t last) const
+		{
+			for(std::size_t i = first; i < last; ++i)
+				sincos_kernel<double, Accurate>::call(Angle[i], Sin[i], Cos[i]);
+			sincos_fixup(Angle + first, Sin + first, Cos + first, last - first, sincos_kernel<double, Accurate>::limit());
+		}
+	};
+
+	template <bool Accurate>
+	GLM_FUNC_QUALIFIER void sincos_run(float const * angle, float * Sin, float * Cos, std::size_t count, int threads)
+	{
+		sincos_job_float<wide_width, Accurate> Job;
+		Job.Angle = angle;
+		Job.Sin = Sin;
+		Job.Cos = Cos;
+		wide_run(Job, count, threads, GLM_SINCOS_MIN_PER_THREAD);
+	}
+
+	template <bool Accurate>
+	GLM_FUNC_QUALIFIER void sincos_run(double const * angle, double * Sin, double * Cos, std::size_t count, int threads)
+	{
+		sincos_job_double<Accurate> Job;
+		Job.Angle = angle;
+		Job.Sin = Sin;
+		Job.Cos = Cos;
+		wide_run(Job, count, threads, GLM_SINCOS_MIN_PER_THREAD);
+	}
+}//namespace detail
+
+	GLM_FUNC_QUALIFIER void sincos(float const * angle, float * Sin, float * Cos, std::size_t count, int threads)
+	{
+		detail::sincos_run<true>(angle, Sin, Cos, count, threads);
+	}
+
+	GLM_FUNC_QUALIFIER void sincos(double const * angle, double * Sin, double * Cos, std::size_t count, int threads)
+	{
+		detail::sincos_run<true>(angle, Sin, Cos, count, threads);
+	}
+
+	GLM_FUNC_QUALIFIER void fastSinCos(float const * angle, float * Sin, float * Cos, std::size_t count, int threads)
+	{
+		detail::sincos_run<false>(angle, Sin, Cos, count, threads);
+	}
+
+	GLM_FUNC_QUALIFIER void fastSinCos(double const * angle, double * Sin, double * Cos, std::size_t count, int threads)
+	{
+		detail::sincos_run<false>(angle, Sin, Cos, count, threads);
+	}
+
+namespace detail
+{
+	template <int N, bool Accurate>
+	GLM_FUNC_QUALIFIER void sincos_wide(twide<N> const & angle, twide<N> & Sin, twide<N> & Cos)
+	{
+		sincos_kernel<float, Accurate>::call(angle, Sin, Cos);
+
+		float Angle[N];
+		angle.store(Angle);
+		for(int l = 0; l < N; ++l)
+			if(!(Angle[l] <= sincos_kernel<float, Accurate>::limit() && Angle[l] >= -sincos_kernel<float, Accurate>::limit()))
+			{
+				float TmpSin[N], TmpCos[N];
+				Sin.store(TmpSin);
+				Cos.store(TmpCos);
+				sincos_fixup(Angle, TmpSin, TmpCos, N, sincos_kernel<float, Accurate>::limit());
+				Sin = twide<N>::load(TmpSin);
+				Cos = twide<N>::load(TmpCos);
+				break;
+			}
+	}
+}//namespace detail
+
+	template <int N>
+	GLM_FUNC_QUALIFIER void sincos(twide<N> const & angle, twide<N> & Sin, twide<N> & Cos)
+	{
+		detail::sincos_wide<N, true>(angle, Sin, Cos);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER void fastSinCos(twide<N> const & angle, twide<N> & Sin, twide<N> & Cos)
+	{
+		detail::sincos_wide<N, false>(angle, Sin, Cos);
+	}
 }//namespace glm
@@ -0,0 +1,118 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// OpenGL Mathematics (glm.g-truc.net)
+///
+/// Copyright (c) 2005 - 2015 G-Truc Creation (www.g-truc.net)
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// Restrictions:
+///		By making use of the Software for military purposes, you choose to make
+///		a Bunny unhappy.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+/// @ref gtx_noise_batch
+/// @file glm/gtx/noise_batch.hpp
+/// @date 2026-10-19 / 2026-10-19
+///
+/// @see core (dependence)
+/// @see gtc_noise (dependence)
+/// @see gtx_wide (dependence)
+///
+/// @defgroup gtx_noise_batch GLM_GTX_noise_batch
+/// @ingroup gtx
+///
+/// @brief perlin( ) and simplex( ) of gtc_noise for a whole array of positions with one call.
+///
+/// The positions are taken gtx_wide lanes at a time, 8 with AVX and 4 otherwise, and each lane goes through
+/// the same operations, in the same order, as the scalar function does for its position. gtc_noise hashes its lattice
+/// points with a polynomial rather than a permutation table, so there are no lookups to gather lane by lane,
+/// and its branches are a step( ) or a min/max here. Each result is what gtc_noise gives to within rounding:
+/// bit for bit when neither side is compiled with fused multiply-adds.
+///
+/// threads splits the array into that many bands, each on its own std::thread (0 is one per hardware thread);
+/// an image laid out row after row is split into bands of whole rows. Short arrays,
+/// and compilers without std::thread, are done on the calling thread.
+///
+/// <glm/gtx/noise_batch.hpp> need to be included to use these functionalities.
+///////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include "../gtc/noise.hpp"
+#include "wide.hpp"
+#include <cstddef>
+
+#if(defined(GLM_MESSAGES) && !defined(GLM_EXT_INCLUDED))
+#	pragma message("GLM: GLM_GTX_noise_batch extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_noise_batch
+	/// @{
+
+	/// Result[i] = perlin(Position[i]) for i = 0 to count-1.
+	/// From GLM_GTX_noise_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void perlin(tvec2<float, P> const * Position, float * Result, std::size_t count, int threads = 1);
+
+	/// Result[i] = perlin(Position[i]) for i = 0 to count-1.
+	/// From GLM_GTX_noise_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void perlin(tvec3<float, P> const * Position, float * Result, std::size_t count, int threads = 1);
+
+	/// Result[i] = perlin(Position[i]) for i = 0 to count-1.
+	/// From GLM_GTX_noise_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void perlin(tvec4<float, P> const * Position, float * Result, std::size_t count, int threads = 1);
+
+	/// Result[i] = perlin(Position[i], rep), the noise that repeats every rep, for i = 0 to count-1.
+	/// From GLM_GTX_noise_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void perlin(tvec2<float, P> const * Position, tvec2<float, P> const & rep, float * Result, std::size_t count, int threads = 1);
+
+	/// Result[i] = perlin(Position[i], rep), the noise that repeats every rep, for i = 0 to count-1.
+	/// From GLM_GTX_noise_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void perlin(tvec3<float, P> const * Position, tvec3<float, P> const & rep, float * Result, std::size_t count, int threads = 1);
+
+	/// Result[i] = perlin(Position[i], rep), the noise that repeats every rep, for i = 0 to count-1.
+	/// From GLM_GTX_noise_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void perlin(tvec4<float, P> const * Position, tvec4<float, P> const & rep, float * Result, std::size_t count, int threads = 1);
+
+	/// Result[i] = simplex(Position[i]) for i = 0 to count-1.
+	/// From GLM_GTX_noise_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void simplex(tvec2<float, P> const * Position, float * Result, std::size_t count, int threads = 1);
+
+	/// Result[i] = simplex(Position[i]) for i = 0 to count-1.
+	/// From GLM_GTX_noise_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void simplex(tvec3<float, P> const * Position, float * Result, std::size_t count, int threads = 1);
+
+	/// Result[i] = simplex(Position[i]) for i = 0 to count-1.
+	/// From GLM_GTX_noise_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void simplex(tvec4<float, P> const * Position, float * Result, std::size_t count, int threads = 1);
+
+	/// @}
+}//namespace glm
+
+#include "noise_batch.inl"
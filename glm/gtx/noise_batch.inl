@@ -0,0 +1,650 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// OpenGL Mathematics (glm.g-truc.net)
+///
+/// Copyright (c) 2005 - 2015 G-Truc Creation (www.g-truc.net)
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// Restrictions:
+///		By making use of the Software for military purposes, you choose to make
+///		a Bunny unhappy.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+/// @ref gtx_noise_batch
+/// @file glm/gtx/noise_batch.inl
+/// @date 2026-10-19 / 2026-10-19
+///////////////////////////////////////////////////////////////////////////////////
+// Each kernel below is the gtc_noise function of the same name taken apart a corner at a time:
+// what the scalar code does to the x, y, z, w of a tvec4 of corners is done here to four twides,
+// keeping its constants (rounded from double the way static_cast<T> does) and the order of its sums.
+///////////////////////////////////////////////////////////////////////////////////
+
+// noise costs enough per position that a band this long is worth a thread:
+#define GLM_NOISE_BATCH_MIN_PER_THREAD	256
+
+namespace glm{
+namespace detail
+{
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_mod289(twide<N> const & x)
+	{
+		return x - floor(x / 289.0f) * 289.0f;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_permute(twide<N> const & x)
+	{
+		return noise_mod289((x * 34.0f + 1.0f) * x);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_taylorInvSqrt(twide<N> const & r)
+	{
+		return static_cast<float>(1.79284291400159) - static_cast<float>(0.85373472095314) * r;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_fade(twide<N> const & t)
+	{
+		return (t * t * t) * (t * (t * 6.0f - 15.0f) + 10.0f);
+	}
+
+	//////////////////////////////////////
+	// perlin
+
+	// the gradient of the corner hashed to i, dotted with the offset (fx, fy) from the corner
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_perlin2_corner(twide<N> const & i, twide<N> const & fx, twide<N> const & fy)
+	{
+		twide<N> gx = 2.0f * fract(i / 41.0f) - 1.0f;
+		twide<N> const gy = abs(gx) - 0.5f;
+		gx = gx - floor(gx + 0.5f);
+
+		twide<N> const norm = noise_taylorInvSqrt(gx * gx + gy * gy);
+		return (gx * norm) * fx + (gy * norm) * fy;
+	}
+
+	// X0, X1, Y0, Y1 are the cell's corners, already wrapped
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_perlin2(
+		twide<N> const & X0, twide<N> const & X1, twide<N> const & Y0, twide<N> const & Y1,
+		twide<N> const & fx0, twide<N> const & fy0)
+	{
+		twide<N> const fx1 = fx0 - 1.0f;
+		twide<N> const fy1 = fy0 - 1.0f;
+		twide<N> const px0 = noise_permute(X0);
+		twide<N> const px1 = noise_permute(X1);
+
+		twide<N> const n00 = noise_perlin2_corner(noise_permute(px0 + Y0), fx0, fy0);
+		twide<N> const n10 = noise_perlin2_corner(noise_permute(px1 + Y0), fx1, fy0);
+		twide<N> const n01 = noise_perlin2_corner(noise_permute(px0 + Y1), fx0, fy1);
+		twide<N> const n11 = noise_perlin2_corner(noise_permute(px1 + Y1), fx1, fy1);
+
+		twide<N> const fadeX = noise_fade(fx0);
+		twide<N> const fadeY = noise_fade(fy0);
+		return static_cast<float>(2.3) * mix(mix(n00, n10, fadeX), mix(n01, n11, fadeX), fadeY);
+	}
+
+	// (the periodic perlin( ) divides by 7 where the other one multiplies by 1/7)
+	template <int N, bool Periodic>
+	GLM_FUNC_QUALIFIER twide<N> noise_perlin3_corner(twide<N> const & i, twide<N> const & fx, twide<N> const & fy, twide<N> const & fz)
+	{
+		twide<N> gx = Periodic ? i / 7.0f : i * static_cast<float>(1.0 / 7.0);
+		twide<N> gy = fract(Periodic ? floor(gx) / 7.0f : floor(gx) * static_cast<float>(1.0 / 7.0)) - 0.5f;
+		gx = fract(gx);
+		twide<N> const gz = 0.5f - abs(gx) - abs(gy);
+		twide<N> const sz = step(gz, 0.0f);
+		gx = gx - sz * (step(0.0f, gx) - 0.5f);
+		gy = gy - sz * (step(0.0f, gy) - 0.5f);
+
+		twide<N> const norm = noise_taylorInvSqrt(gx * gx + gy * gy + gz * gz);
+		return (gx * norm) * fx + (gy * norm) * fy + (gz * norm) * fz;
+	}
+
+	template <int N, bool Periodic>
+	GLM_FUNC_QUALIFIER twide<N> noise_perlin3(
+		twide<N> const & X0, twide<N> const & X1, twide<N> const & Y0, twide<N> const & Y1, twide<N> const & Z0, twide<N> const & Z1,
+		twide<N> const & fx0, twide<N> const & fy0, twide<N> const & fz0)
+	{
+		twide<N> const fx1 = fx0 - 1.0f;
+		twide<N> const fy1 = fy0 - 1.0f;
+		twide<N> const fz1 = fz0 - 1.0f;
+		twide<N> const px0 = noise_permute(X0);
+		twide<N> const px1 = noise_permute(X1);
+		twide<N> const p00 = noise_permute(px0 + Y0);
+		twide<N> const p10 = noise_permute(px1 + Y0);
+		twide<N> const p01 = noise_permute(px0 + Y1);
+		twide<N> const p11 = noise_permute(px1 + Y1);
+
+		twide<N> const n000 = noise_perlin3_corner<N, Periodic>(noise_permute(p00 + Z0), fx0, fy0, fz0);
+		twide<N> const n100 = noise_perlin3_corner<N, Periodic>(noise_permute(p10 + Z0), fx1, fy0, fz0);
+		twide<N> const n010 = noise_perlin3_corner<N, Periodic>(noise_permute(p01 + Z0), fx0, fy1, fz0);
+		twide<N> const n110 = noise_perlin3_corner<N, Periodic>(noise_permute(p11 + Z0), fx1, fy1, fz0);
+		twide<N> const n001 = noise_perlin3_corner<N, Periodic>(noise_permute(p00 + Z1), fx0, fy0, fz1);
+		twide<N> const n101 = noise_perlin3_corner<N, Periodic>(noise_permute(p10 + Z1), fx1, fy0, fz1);
+		twide<N> const n011 = noise_perlin3_corner<N, Periodic>(noise_permute(p01 + Z1), fx0, fy1, fz1);
+		twide<N> const n111 = noise_perlin3_corner<N, Periodic>(noise_permute(p11 + Z1), fx1, fy1, fz1);
+
+		twide<N> const fadeX = noise_fade(fx0);
+		twide<N> const fadeY = noise_fade(fy0);
+		twide<N> const fadeZ = noise_fade(fz0);
+		twide<N> const n00 = mix(n000, n001, fadeZ);
+		twide<N> const n10 = mix(n100, n101, fadeZ);
+		twide<N> const n01 = mix(n010, n011, fadeZ);
+		twide<N> const n11 = mix(n110, n111, fadeZ);
+		return static_cast<float>(2.2) * mix(mix(n00, n01, fadeY), mix(n10, n11, fadeY), fadeX);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_perlin4_corner(twide<N> const & i, twide<N> const & fx, twide<N> const & fy, twide<N> const & fz, twide<N> const & fw)
+	{
+		twide<N> gx = i / 7.0f;
+		twide<N> gy = floor(gx) / 7.0f;
+		twide<N> gz = floor(gy) / 6.0f;
+		gx = fract(gx) - 0.5f;
+		gy = fract(gy) - 0.5f;
+		gz = fract(gz) - 0.5f;
+		twide<N> const gw = 0.75f - abs(gx) - abs(gy) - abs(gz);
+		twide<N> const sw = step(gw, 0.0f);
+		gx = gx - sw * (step(0.0f, gx) - 0.5f);
+		gy = gy - sw * (step(0.0f, gy) - 0.5f);
+
+		twide<N> const norm = noise_taylorInvSqrt((gx * gx + gy * gy) + (gz * gz + gw * gw));
+		return ((gx * norm) * fx + (gy * norm) * fy) + ((gz * norm) * fz + (gw * norm) * fw);
+	}
+
+	// the two corners along w of the corner hashed to pxyz, mixed along w
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_perlin4_edge(
+		twide<N> const & pxyz, twide<N> const & W0, twide<N> const & W1,
+		twide<N> const & fx, twide<N> const & fy, twide<N> const & fz, twide<N> const & fw0, twide<N> const & fadeW)
+	{
+		twide<N> const n0 = noise_perlin4_corner(noise_permute(pxyz + W0), fx, fy, fz, fw0);
+		twide<N> const n1 = noise_perlin4_corner(noise_permute(pxyz + W1), fx, fy, fz, fw0 - 1.0f);
+		return mix(n0, n1, fadeW);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_perlin4(
+		twide<N> const & X0, twide<N> const & X1, twide<N> const & Y0, twide<N> const & Y1,
+		twide<N> const & Z0, twide<N> const & Z1, twide<N> const & W0, twide<N> const & W1,
+		twide<N> const & fx0, twide<N> const & fy0, twide<N> const & fz0, twide<N> const & fw0)
+	{
+		twide<N> const fx1 = fx0 - 1.0f;
+		twide<N> const fy1 = fy0 - 1.0f;
+		twide<N> const fz1 = fz0 - 1.0f;
+		twide<N> const px0 = noise_permute(X0);
+		twide<N> const px1 = noise_permute(X1);
+		twide<N> const p00 = noise_permute(px0 + Y0);
+		twide<N> const p10 = noise_permute(px1 + Y0);
+		twide<N> const p01 = noise_permute(px0 + Y1);
+		twide<N> const p11 = noise_permute(px1 + Y1);
+
+		twide<N> const fadeX = noise_fade(fx0);
+		twide<N> const fadeY = noise_fade(fy0);
+		twide<N> const fadeZ = noise_fade(fz0);
+		twide<N> const fadeW = noise_fade(fw0);
+
+		twide<N> const n00 = mix(
+			noise_perlin4_edge(noise_permute(p00 + Z0), W0, W1, fx0, fy0, fz0, fw0, fadeW),
+			noise_perlin4_edge(noise_permute(p00 + Z1), W0, W1, fx0, fy0, fz1, fw0, fadeW), fadeZ);
+		twide<N> const n10 = mix(
+			noise_perlin4_edge(noise_permute(p10 + Z0), W0, W1, fx1, fy0, fz0, fw0, fadeW),
+			noise_perlin4_edge(noise_permute(p10 + Z1), W0, W1, fx1, fy0, fz1, fw0, fadeW), fadeZ);
+		twide<N> const n01 = mix(
+			noise_perlin4_edge(noise_permute(p01 + Z0), W0, W1, fx0, fy1, fz0, fw0, fadeW),
+			noise_perlin4_edge(noise_permute(p01 + Z1), W0, W1, fx0, fy1, fz1, fw0, fadeW), fadeZ);
+		twide<N> const n11 = mix(
+			noise_perlin4_edge(noise_permute(p11 + Z0), W0, W1, fx1, fy1, fz0, fw0, fadeW),
+			noise_perlin4_edge(noise_permute(p11 + Z1), W0, W1, fx1, fy1, fz1, fw0, fadeW), fadeZ);
+		return static_cast<float>(2.2) * mix(mix(n00, n01, fadeY), mix(n10, n11, fadeY), fadeX);
+	}
+
+	//////////////////////////////////////
+	// simplex
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_simplex2(twide<N> const & vx, twide<N> const & vy)
+	{
+		float const Cx = static_cast<float>(0.211324865405187);
+		float const Cy = static_cast<float>(0.366025403784439);
+		float const Cz = static_cast<float>(-0.577350269189626);
+		float const Cw = static_cast<float>(0.024390243902439);
+
+		// first corner
+		twide<N> const d = vx * Cy + vy * Cy;
+		twide<N> ix = floor(vx + d);
+		twide<N> iy = floor(vy + d);
+		twide<N> const e = ix * Cx + iy * Cx;
+		twide<N> const x0 = vx - ix + e;
+		twide<N> const y0 = vy - iy + e;
+
+		// other corners: i1 is (1, 0) where x0.x > x0.y, else (0, 1)
+		twide<N> const i1y = step(x0, y0);
+		twide<N> const i1x = 1.0f - i1y;
+		twide<N> const x1 = x0 + Cx - i1x;
+		twide<N> const y1 = y0 + Cx - i1y;
+		twide<N> const x2 = x0 + Cz;
+		twide<N> const y2 = y0 + Cz;
+
+		// permutations
+		ix = noise_mod289(ix);
+		iy = noise_mod289(iy);
+		twide<N> const p0 = noise_permute(noise_permute(iy) + ix);
+		twide<N> const p1 = noise_permute(noise_permute(iy + i1y) + ix + i1x);
+		twide<N> const p2 = noise_permute(noise_permute(iy + 1.0f) + ix + 1.0f);
+
+		twide<N> m0 = max(0.5f - (x0 * x0 + y0 * y0), twide<N>(0.0f));
+		twide<N> m1 = max(0.5f - (x1 * x1 + y1 * y1), twide<N>(0.0f));
+		twide<N> m2 = max(0.5f - (x2 * x2 + y2 * y2), twide<N>(0.0f));
+		m0 = m0 * m0;
+		m1 = m1 * m1;
+		m2 = m2 * m2;
+		m0 = m0 * m0;
+		m1 = m1 * m1;
+		m2 = m2 * m2;
+
+		// gradients: 41 points over a line, mapped onto a diamond, and normalized by scaling m
+		twide<N> const gx0 = 2.0f * fract(p0 * Cw) - 1.0f;
+		twide<N> const gx1 = 2.0f * fract(p1 * Cw) - 1.0f;
+		twide<N> const gx2 = 2.0f * fract(p2 * Cw) - 1.0f;
+		twide<N> const h0 = abs(gx0) - 0.5f;
+		twide<N> const h1 = abs(gx1) - 0.5f;
+		twide<N> const h2 = abs(gx2) - 0.5f;
+		twide<N> const a0 = gx0 - floor(gx0 + 0.5f);
+		twide<N> const a1 = gx1 - floor(gx1 + 0.5f);
+		twide<N> const a2 = gx2 - floor(gx2 + 0.5f);
+		m0 = m0 * noise_taylorInvSqrt(a0 * a0 + h0 * h0);
+		m1 = m1 * noise_taylorInvSqrt(a1 * a1 + h1 * h1);
+		m2 = m2 * noise_taylorInvSqrt(a2 * a2 + h2 * h2);
+
+		return 130.0f * (m0 * (a0 * x0 + h0 * y0) + m1 * (a1 * x1 + h1 * y1) + m2 * (a2 * x2 + h2 * y2));
+	}
+
+	// the corner hashed to p, at (x, y, z) from the position: its falloff squared times its gradient dotted with (x, y, z)
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_simplex3_corner(twide<N> const & p, twide<N> const & x, twide<N> const & y, twide<N> const & z)
+	{
+		// gradients: 7x7 points over a square, mapped onto an octahedron
+		float const n_ = static_cast<float>(0.142857142857); // 1.0/7.0
+		float const nsx = n_ * 2.0f - 0.0f;
+		float const nsy = n_ * 0.5f - 1.0f;
+		float const nsz = n_ * 1.0f - 0.0f;
+
+		twide<N> const j = p - 49.0f * floor(p * nsz * nsz);  // mod(p,7*7)
+		twide<N> const x_ = floor(j * nsz);
+		twide<N> const y_ = floor(j - 7.0f * x_);               // mod(j,N)
+		twide<N> const gx = x_ * nsx + nsy;
+		twide<N> const gy = y_ * nsx + nsy;
+		twide<N> const h = 1.0f - abs(gx) - abs(gy);
+		twide<N> const sh = -step(h, 0.0f);
+
+		twide<N> px = gx + (floor(gx) * 2.0f + 1.0f) * sh;
+		twide<N> py = gy + (floor(gy) * 2.0f + 1.0f) * sh;
+		twide<N> pz = h;
+		twide<N> const norm = noise_taylorInvSqrt(px * px + py * py + pz * pz);
+		px = px * norm;
+		py = py * norm;
+		pz = pz * norm;
+
+		twide<N> m = max(static_cast<float>(0.6) - (x * x + y * y + z * z), twide<N>(0.0f));
+		m = m * m;
+		return (m * m) * (px * x + py * y + pz * z);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_simplex3(twide<N> const & vx, twide<N> const & vy, twide<N> const & vz)
+	{
+		float const Cx = static_cast<float>(1.0 / 6.0);
+		float const Cy = static_cast<float>(1.0 / 3.0);
+
+		// first corner
+		twide<N> const d = vx * Cy + vy * Cy + vz * Cy;
+		twide<N> ix = floor(vx + d);
+		twide<N> iy = floor(vy + d);
+		twide<N> iz = floor(vz + d);
+		twide<N> const e = ix * Cx + iy * Cx + iz * Cx;
+		twide<N> const x0 = vx - ix + e;
+		twide<N> const y0 = vy - iy + e;
+		twide<N> const z0 = vz - iz + e;
+
+		// other corners
+		twide<N> const gx = step(y0, x0);
+		twide<N> const gy = step(z0, y0);
+		twide<N> const gz = step(x0, z0);
+		twide<N> const lx = 1.0f - gx;
+		twide<N> const ly = 1.0f - gy;
+		twide<N> const lz = 1.0f - gz;
+		twide<N> const i1x = min(gx, lz);
+		twide<N> const i1y = min(gy, lx);
+		twide<N> const i1z = min(gz, ly);
+		twide<N> const i2x = max(gx, lz);
+		twide<N> const i2y = max(gy, lx);
+		twide<N> const i2z = max(gz, ly);
+
+		// permutations
+		ix = noise_mod289(ix);
+		iy = noise_mod289(iy);
+		iz = noise_mod289(iz);
+		twide<N> const p0 = noise_permute(noise_permute(noise_permute(iz) + iy) + ix);
+		twide<N> const p1 = noise_permute(noise_permute(noise_permute(iz + i1z) + iy + i1y) + ix + i1x);
+		twide<N> const p2 = noise_permute(noise_permute(noise_permute(iz + i2z) + iy + i2y) + ix + i2x);
+		twide<N> const p3 = noise_permute(noise_permute(noise_permute(iz + 1.0f) + iy + 1.0f) + ix + 1.0f);
+
+		return 42.0f * (
+			(noise_simplex3_corner(p0, x0, y0, z0) +
+			noise_simplex3_corner(p1, x0 - i1x + Cx, y0 - i1y + Cx, z0 - i1z + Cx)) +
+			(noise_simplex3_corner(p2, x0 - i2x + Cy, y0 - i2y + Cy, z0 - i2z + Cy) +
+			noise_simplex3_corner(p3, x0 - 0.5f, y0 - 0.5f, z0 - 0.5f)));
+	}
+
+	// as noise_simplex3_corner, with grad4( ) for the gradient: 7x7x6 points over a cube, mapped onto a 4-cross polytope
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_simplex4_corner(twide<N> const & j, twide<N> const & x, twide<N> const & y, twide<N> const & z, twide<N> const & w)
+	{
+		float const ipx = 1.0f / 294.0f;
+		float const ipy = 1.0f / 49.0f;
+		float const ipz = 1.0f / 7.0f;
+
+		twide<N> px = floor(fract(j * ipx) * 7.0f) * ipz - 1.0f;
+		twide<N> py = floor(fract(j * ipy) * 7.0f) * ipz - 1.0f;
+		twide<N> pz = floor(fract(j * ipz) * 7.0f) * ipz - 1.0f;
+		twide<N> pw = 1.5f - (abs(px) + abs(py) + abs(pz));
+		twide<N> const sw = 1.0f - step(0.0f, pw);
+		px = px + ((1.0f - step(0.0f, px)) * 2.0f - 1.0f) * sw;
+		py = py + ((1.0f - step(0.0f, py)) * 2.0f - 1.0f) * sw;
+		pz = pz + ((1.0f - step(0.0f, pz)) * 2.0f - 1.0f) * sw;
+
+		twide<N> const norm = noise_taylorInvSqrt((px * px + py * py) + (pz * pz + pw * pw));
+		px = px * norm;
+		py = py * norm;
+		pz = pz * norm;
+		pw = pw * norm;
+
+		twide<N> m = max(static_cast<float>(0.6) - ((x * x + y * y) + (z * z + w * w)), twide<N>(0.0f));
+		m = m * m;
+		return (m * m) * ((px * x + py * y) + (pz * z + pw * w));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_simplex4(twide<N> const & vx, twide<N> const & vy, twide<N> const & vz, twide<N> const & vw)
+	{
+		float const Cx = static_cast<float>(0.138196601125011);  // (5 - sqrt(5))/20  G4
+		float const Cy = static_cast<float>(0.276393202250021);  // 2 * G4
+		float const Cz = static_cast<float>(0.414589803375032);  // 3 * G4
+		float const Cw = static_cast<float>(-0.447213595499958); // -1 + 4 * G4
+		float const F4 = static_cast<float>(0.309016994374947451);
+
+		// first corner
+		twide<N> const d = (vx * F4 + vy * F4) + (vz * F4 + vw * F4);
+		twide<N> ix = floor(vx + d);
+		twide<N> iy = floor(vy + d);
+		twide<N> iz = floor(vz + d);
+		twide<N> iw = floor(vw + d);
+		twide<N> const e = (ix * Cx + iy * Cx) + (iz * Cx + iw * Cx);
+		twide<N> const x0 = vx - ix + e;
+		twide<N> const y0 = vy - iy + e;
+		twide<N> const z0 = vz - iz + e;
+		twide<N> const w0 = vw - iw + e;
+
+		// other corners, by rank sorting: i0 gets the unique values 0, 1, 2, 3 in its components
+		twide<N> const isXy = step(y0, x0);
+		twide<N> const isXz = step(z0, x0);
+		twide<N> const isXw = step(w0, x0);
+		twide<N> const isYZx = step(z0, y0);
+		twide<N> const isYZy = step(w0, y0);
+		twide<N> const isYZz = step(w0, z0);
+		twide<N> const i0x = isXy + isXz + isXw;
+		twide<N> const i0y = (1.0f - isXy) + (isYZx + isYZy);
+		twide<N> const i0z = (1.0f - isXz) + (1.0f - isYZx) + isYZz;
+		twide<N> const i0w = (1.0f - isXw) + (1.0f - isYZy) + (1.0f - isYZz);
+
+		twide<N> const i1x = clamp(i0x - 2.0f, 0.0f, 1.0f);
+		twide<N> const i1y = clamp(i0y - 2.0f, 0.0f, 1.0f);
+		twide<N> const i1z = clamp(i0z - 2.0f, 0.0f, 1.0f);
+		twide<N> const i1w = clamp(i0w - 2.0f, 0.0f, 1.0f);
+		twide<N> const i2x = clamp(i0x - 1.0f, 0.0f, 1.0f);
+		twide<N> const i2y = clamp(i0y - 1.0f, 0.0f, 1.0f);
+		twide<N> const i2z = clamp(i0z - 1.0f, 0.0f, 1.0f);
+		twide<N> const i2w = clamp(i0w - 1.0f, 0.0f, 1.0f);
+		twide<N> const i3x = clamp(i0x, 0.0f, 1.0f);
+		twide<N> const i3y = clamp(i0y, 0.0f, 1.0f);
+		twide<N> const i3z = clamp(i0z, 0.0f, 1.0f);
+		twide<N> const i3w = clamp(i0w, 0.0f, 1.0f);
+
+		// permutations
+		ix = noise_mod289(ix);
+		iy = noise_mod289(iy);
+		iz = noise_mod289(iz);
+		iw = noise_mod289(iw);
+		twide<N> const j0 = noise_permute(noise_permute(noise_permute(noise_permute(iw) + iz) + iy) + ix);
+		twide<N> const j1 = noise_permute(noise_permute(noise_permute(noise_permute(iw + i1w) + iz + i1z) + iy + i1y) + ix + i1x);
+		twide<N> const j2 = noise_permute(noise_permute(noise_permute(noise_permute(iw + i2w) + iz + i2z) + iy + i2y) + ix + i2x);
+		twide<N> const j3 = noise_permute(noise_permute(noise_permute(noise_permute(iw + i3w) + iz + i3z) + iy + i3y) + ix + i3x);
+		twide<N> const j4 = noise_permute(noise_permute(noise_permute(noise_permute(iw + 1.0f) + iz + 1.0f) + iy + 1.0f) + ix + 1.0f);
+
+		// mix contributions from the five corners
+		return 49.0f * (
+			(noise_simplex4_corner(j0, x0, y0, z0, w0) +
+			noise_simplex4_corner(j1, x0 - i1x + Cx, y0 - i1y + Cx, z0 - i1z + Cx, w0 - i1w + Cx) +
+			noise_simplex4_corner(j2, x0 - i2x + Cy, y0 - i2y + Cy, z0 - i2z + Cy, w0 - i2w + Cy)) +
+			(noise_simplex4_corner(j3, x0 - i3x + Cz, y0 - i3y + Cz, z0 - i3z + Cz, w0 - i3w + Cz) +
+			noise_simplex4_corner(j4, x0 + Cw, y0 + Cw, z0 + Cw, w0 + Cw)));
+	}
+
+	//////////////////////////////////////
+	// the kernels, from a position to its noise
+
+	// perlin( ) of the cell with corners Pi0 and Pi1, at Pf0 in it
+	template <int N, bool Periodic>
+	GLM_FUNC_QUALIFIER twide<N> noise_perlin_cell(twide<N> const (&Pi0)[2], twide<N> const (&Pi1)[2], twide<N> const (&Pf0)[2])
+	{
+		return noise_perlin2(Pi0[0], Pi1[0], Pi0[1], Pi1[1], Pf0[0], Pf0[1]);
+	}
+
+	template <int N, bool Periodic>
+	GLM_FUNC_QUALIFIER twide<N> noise_perlin_cell(twide<N> const (&Pi0)[3], twide<N> const (&Pi1)[3], twide<N> const (&Pf0)[3])
+	{
+		return noise_perlin3<N, Periodic>(Pi0[0], Pi1[0], Pi0[1], Pi1[1], Pi0[2], Pi1[2], Pf0[0], Pf0[1], Pf0[2]);
+	}
+
+	template <int N, bool Periodic>
+	GLM_FUNC_QUALIFIER twide<N> noise_perlin_cell(twide<N> const (&Pi0)[4], twide<N> const (&Pi1)[4], twide<N> const (&Pf0)[4])
+	{
+		return noise_perlin4(Pi0[0], Pi1[0], Pi0[1], Pi1[1], Pi0[2], Pi1[2], Pi0[3], Pi1[3], Pf0[0], Pf0[1], Pf0[2], Pf0[3]);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_simplex_at(twide<N> const (&Position)[2])
+	{
+		return noise_simplex2(Position[0], Position[1]);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_simplex_at(twide<N> const (&Position)[3])
+	{
+		return noise_simplex3(Position[0], Position[1], Position[2]);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> noise_simplex_at(twide<N> const (&Position)[4])
+	{
+		return noise_simplex4(Position[0], Position[1], Position[2], Position[3]);
+	}
+
+	// Periodic says to wrap the cell's corners at Rep first
+	template <int D, bool Periodic>
+	struct noise_perlin_kernel
+	{
+		float Rep[D];
+
+		template <int N>
+		GLM_FUNC_QUALIFIER twide<N> operator()(twide<N> const (&Position)[D]) const
+		{
+			twide<N> Pi0[D], Pi1[D], Pf0[D];
+			for(int c = 0; c < D; ++c)
+			{
+				twide<N> const Floor = floor(Position[c]);
+				Pf0[c] = fract(Position[c]);
+				if(Periodic)
+				{
+					// (the 2D perlin( ) wraps floor + 1, the others add 1 to the wrapped floor and wrap that)
+					Pi0[c] = mod(Floor, Rep[c]);
+					Pi1[c] = mod((D == 2 ? Floor : Pi0[c]) + 1.0f, Rep[c]);
+				}
+				else
+				{
+					Pi0[c] = Floor;
+					Pi1[c] = Floor + 1.0f;
+				}
+
+				// (the periodic 4D perlin( ) leaves its corners as they are)
+				if(D < 4 || !Periodic)
+				{
+					Pi0[c] = noise_mod289(Pi0[c]);
+					Pi1[c] = noise_mod289(Pi1[c]);
+				}
+			}
+			return noise_perlin_cell<N, Periodic>(Pi0, Pi1, Pf0);
+		}
+	};
+
+	template <int D>
+	struct noise_simplex_kernel
+	{
+		template <int N>
+		GLM_FUNC_QUALIFIER twide<N> operator()(twide<N> const (&Position)[D]) const
+		{
+			return noise_simplex_at(Position);
+		}
+	};
+
+	// Result[i] = Kernel(Position[i]), N positions of D floats at a time
+	template <int N, int D, typename kernelType>
+	struct noise_batch_job
+	{
+		kernelType Kernel;
+		float const * Position;
+		float * Result;
+
+		GLM_FUNC_QUALIFIER void operator()(std::size_t first, std::size_t last) const
+		{
+			for(std::size_t i = first; i < last; i += N)
+			{
+				// the lanes past the end are copies of the last position, so the store below is all that has to know
+				int const Count = last - i < std::size_t(N) ? static_cast<int>(last - i) : N;
+
+				float Lanes[D][N];
+				for(int l = 0; l < N; ++l)
+				{
+					float const * p = Position + (i + (l < Count ? l : Count - 1)) * D;
+					for(int c = 0; c < D; ++c)
+						Lanes[c][l] = p[c];
+				}
+
+				twide<N> Components[D];
+				for(int c = 0; c < D; ++c)
+					Components[c] = twide<N>::load(Lanes[c]);
+				twide<N> const Noise = Kernel(Components);
+
+				if(Count == N)
+					Noise.store(Result + i);
+				else
+				{
+					float Tmp[N];
+					Noise.store(Tmp);
+					for(int l = 0; l < Count; ++l)
+						Result[i + l] = Tmp[l];
+				}
+			}
+		}
+	};
+
+	template <int D, typename kernelType>
+	GLM_FUNC_QUALIFIER void noise_batch_run(kernelType const & Kernel, float const * Position, float * Result, std::size_t count, int threads)
+	{
+		noise_batch_job<wide_width, D, kernelType> Job;
+		Job.Kernel = Kernel;
+		Job.Position = Position;
+		Job.Result = Result;
+		wide_run(Job, count, threads, GLM_NOISE_BATCH_MIN_PER_THREAD);
+	}
+}//namespace detail
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void perlin(tvec2<float, P> const * Position, float * Result, std::size_t count, int threads)
+	{
+		detail::noise_batch_run<2>(detail::noise_perlin_kernel<2, false>(), &Position[0].x, Result, count, threads);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void perlin(tvec3<float, P> const * Position, float * Result, std::size_t count, int threads)
+	{
+		detail::noise_batch_run<3>(detail::noise_perlin_kernel<3, false>(), &Position[0].x, Result, count, threads);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void perlin(tvec4<float, P> const * Position, float * Result, std::size_t count, int threads)
+	{
+		detail::noise_batch_run<4>(detail::noise_perlin_kernel<4, false>(), &Position[0].x, Result, count, threads);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void perlin(tvec2<float, P> const * Position, tvec2<float, P> const & rep, float * Result, std::size_t count, int threads)
+	{
+		detail::noise_perlin_kernel<2, true> Kernel;
+		for(length_t c = 0; c < 2; ++c)
+			Kernel.Rep[c] = rep[c];
+		detail::noise_batch_run<2>(Kernel, &Position[0].x, Result, count, threads);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void perlin(tvec3<float, P> const * Position, tvec3<float, P> const & rep, float * Result, std::size_t count, int threads)
+	{
+		detail::noise_perlin_kernel<3, true> Kernel;
+		for(length_t c = 0; c < 3; ++c)
+			Kernel.Rep[c] = rep[c];
+		detail::noise_batch_run<3>(Kernel, &Position[0].x, Result, count, threads);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void perlin(tvec4<float, P> const * Position, tvec4<float, P> const & rep, float * Result, std::size_t count, int threads)
+	{
+		detail::noise_perlin_kernel<4, true> Kernel;
+		for(length_t c = 0; c < 4; ++c)
+			Kernel.Rep[c] = rep[c];
+		detail::noise_batch_run<4>(Kernel, &Position[0].x, Result, count, threads);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void simplex(tvec2<float, P> const * Position, float * Result, std::size_t count, int threads)
+	{
+		detail::noise_batch_run<2>(detail::noise_simplex_kernel<2>(), &Position[0].x, Result, count, threads);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void simplex(tvec3<float, P> const * Position, float * Result, std::size_t count, int threads)
+	{
+		detail::noise_batch_run<3>(detail::noise_simplex_kernel<3>(), &Position[0].x, Result, count, threads);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void simplex(tvec4<float, P> const * Position, float * Result, std::size_t count, int threads)
+	{
+		detail::noise_batch_run<4>(detail::noise_simplex_kernel<4>(), &Position[0].x, Result, count, threads);
+	}
+}//namespace glm
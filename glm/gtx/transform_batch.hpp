@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// OpenGL Mathematics (glm.g-truc.net)
+///
+/// Copyright (c) 2005 - 2015 G-Truc Creation (www.g-truc.net)
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// Restrictions:
+///		By making use of the Software for military purposes, you choose to make
+///		a Bunny unhappy.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+/// @ref gtx_transform_batch
+/// @file glm/gtx/transform_batch.hpp
+/// @date 2026-10-19 / 2026-10-19
+///
+/// @see core (dependence)
+/// @see gtx_wide (dependence)
+///
+/// @defgroup gtx_transform_batch GLM_GTX_transform_batch
+/// @ingroup gtx
+///
+/// @brief Transform whole arrays of points, normals or matrices with one call.
+///
+/// The points and normals are gathered into gtx_wide vectors, 8 at a time with AVX and 4 otherwise,
+/// and each lane gets the same bits as transforming its point by itself with mat4 * vec4
+/// (or the normal with the normal matrix) would give, without fused multiply-adds.
+///
+/// Each array is given by a pointer to the x of its first element and the number of bytes from one element
+/// to the next, so a member of an array of structs can be transformed where it is:
+/// transform_points(m, &v[0].x, sizeof(Point), &v[0].x, sizeof(Point), n) for the positions of
+/// VertexBufferObject Points, or &v[0].nx for their normals. The output may be the input.
+///
+/// threads splits the array into that many bands, each transformed on its own std::thread
+/// (0 is one per hardware thread). Arrays too small to be worth it, and compilers
+/// without std::thread, are transformed on the calling thread.
+///
+/// <glm/gtx/transform_batch.hpp> need to be included to use these functionalities.
+///////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include "wide.hpp"
+#include <cstddef>
+
+#if(defined(GLM_MESSAGES) && !defined(GLM_EXT_INCLUDED))
+#	pragma message("GLM: GLM_GTX_transform_batch extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_transform_batch
+	/// @{
+
+	/// out[i] = vec3(m * vec4(in[i], 1)) for i = 0 to count-1.
+	/// From GLM_GTX_transform_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void transform_points(tmat4x4<float, P> const & m, tvec3<float, P> const * in, tvec3<float, P> * out, std::size_t count, int threads = 1);
+
+	/// The same, for points of 3 floats that are inStride and outStride bytes apart.
+	/// From GLM_GTX_transform_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void transform_points(tmat4x4<float, P> const & m, float const * in, std::size_t inStride, float * out, std::size_t outStride, std::size_t count, int threads = 1);
+
+	/// out[i] = normalize(n * in[i]), where n = transpose(inverse(mat3(m))) is the normal matrix of m:
+	/// the normals of a surface whose points were transformed by m.
+	/// From GLM_GTX_transform_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void transform_normals(tmat4x4<float, P> const & m, tvec3<float, P> const * in, tvec3<float, P> * out, std::size_t count, int threads = 1);
+
+	/// The same, for normals of 3 floats that are inStride and outStride bytes apart.
+	/// From GLM_GTX_transform_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void transform_normals(tmat4x4<float, P> const & m, float const * in, std::size_t inStride, float * out, std::size_t outStride, std::size_t count, int threads = 1);
+
+	/// out[i] = vec3(c) / c.w, where c = m * vec4(in[i], 1):
+	/// with a projection * view * model matrix, the points in normalized device coordinates.
+	/// From GLM_GTX_transform_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void project_points(tmat4x4<float, P> const & m, tvec3<float, P> const * in, tvec3<float, P> * out, std::size_t count, int threads = 1);
+
+	/// The same, for points of 3 floats that are inStride and outStride bytes apart.
+	/// From GLM_GTX_transform_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void project_points(tmat4x4<float, P> const & m, float const * in, std::size_t inStride, float * out, std::size_t outStride, std::size_t count, int threads = 1);
+
+	/// out[i] = a[i] * b[i] for i = 0 to count-1.
+	/// From GLM_GTX_transform_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void mul_batch(tmat4x4<float, P> const * a, tmat4x4<float, P> const * b, tmat4x4<float, P> * out, std::size_t count, int threads = 1);
+
+	/// out[i] = a * b[i] for i = 0 to count-1 -- a view-projection matrix times the model matrix of each instance, say.
+	/// From GLM_GTX_transform_batch extension.
+	template <precision P>
+	GLM_FUNC_DECL void mul_batch(tmat4x4<float, P> const & a, tmat4x4<float, P> const * b, tmat4x4<float, P> * out, std::size_t count, int threads = 1);
+
+	/// @}
+}//namespace glm
+
+#include "transform_batch.inl"
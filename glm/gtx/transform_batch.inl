@@ -0,0 +1,357 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// OpenGL Mathematics (glm.g-truc.net)
+///
+/// Copyright (c) 2005 - 2015 G-Truc Creation (www.g-truc.net)
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// Restrictions:
+///		By making use of the Software for military purposes, you choose to make
+///		a Bunny unhappy.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+/// @ref gtx_transform_batch
+/// @file glm/gtx/transform_batch.inl
+/// @date 2026-10-19 / 2026-10-19
+///////////////////////////////////////////////////////////////////////////////////
+
+// fewer elements than this per thread and starting the threads costs more than it saves
+// (a thread takes 10 us or so to start and join, and this many points about 25 us on one):
+#define GLM_TRANSFORM_BATCH_MIN_PER_THREAD	16384
+
+// elements this many bytes apart or more are done 4 at a time even with AVX:
+// gathering 8 of them costs more than the arithmetic it saves
+#define GLM_TRANSFORM_BATCH_MAX_STRIDE_X8	32
+
+namespace glm{
+namespace detail
+{
+	// a block of N vec3s that are stride bytes apart, to and from a tvec3x<N>
+	// (Wide says 16 bytes can be read at each: the stride is at least that, or more elements follow the block)
+	template <int N>
+	GLM_FUNC_QUALIFIER void transform_batch_load(tvec3x<N> & v, char const * p, std::size_t stride, bool)
+	{
+		load_strided(v, reinterpret_cast<float const *>(p), stride);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER void transform_batch_store(char * p, std::size_t stride, tvec3x<N> const & v)
+	{
+		store_strided(reinterpret_cast<float *>(p), stride, v);
+	}
+
+#	if GLM_ARCH & GLM_ARCH_SSE2
+		// a vec4 per element and a transpose, instead of a float at a time through memory
+		template <>
+		GLM_FUNC_QUALIFIER void transform_batch_load(tvec3x<4> & v, char const * p, std::size_t stride, bool Wide)
+		{
+			if(!Wide)
+			{
+				load_strided(v, reinterpret_cast<float const *>(p), stride);
+				return;
+			}
+
+			__m128 r0 = _mm_loadu_ps(reinterpret_cast<float const *>(p));
+			__m128 r1 = _mm_loadu_ps(reinterpret_cast<float const *>(p + stride));
+			__m128 r2 = _mm_loadu_ps(reinterpret_cast<float const *>(p + stride * 2));
+			__m128 r3 = _mm_loadu_ps(reinterpret_cast<float const *>(p + stride * 3));
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			v.x = twide<4>(r0);
+			v.y = twide<4>(r1);
+			v.z = twide<4>(r2);
+		}
+
+		// only the xyz of each element is written, so whatever follows it in its struct is left alone
+		GLM_FUNC_QUALIFIER void transform_batch_store3(char * p, __m128 const & r)
+		{
+			_mm_storel_pi(reinterpret_cast<__m64 *>(p), r);
+			_mm_store_ss(reinterpret_cast<float *>(p) + 2, _mm_movehl_ps(r, r));
+		}
+
+		template <>
+		GLM_FUNC_QUALIFIER void transform_batch_store(char * p, std::size_t stride, tvec3x<4> const & v)
+		{
+			__m128 r0 = v.x.data;
+			__m128 r1 = v.y.data;
+			__m128 r2 = v.z.data;
+			__m128 r3 = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+			transform_batch_store3(p, r0);
+			transform_batch_store3(p + stride, r1);
+			transform_batch_store3(p + stride * 2, r2);
+			transform_batch_store3(p + stride * 3, r3);
+		}
+#	endif//GLM_ARCH & GLM_ARCH_SSE2
+
+#	if GLM_ARCH & GLM_ARCH_AVX
+		// element i in the low half of a register and i + 4 in the high half, so one transpose does all 8
+		template <>
+		GLM_FUNC_QUALIFIER void transform_batch_load(tvec3x<8> & v, char const * p, std::size_t stride, bool Wide)
+		{
+			if(!Wide)
+			{
+				load_strided(v, reinterpret_cast<float const *>(p), stride);
+				return;
+			}
+
+			__m256 r[4];
+			for(int i = 0; i < 4; ++i)
+				r[i] = _mm256_insertf128_ps(
+					_mm256_castps128_ps256(_mm_loadu_ps(reinterpret_cast<float const *>(p + stride * i))),
+					_mm_loadu_ps(reinterpret_cast<float const *>(p + stride * (i + 4))), 1);
+
+			__m256 const t0 = _mm256_unpacklo_ps(r[0], r[1]);
+			__m256 const t1 = _mm256_unpackhi_ps(r[0], r[1]);
+			__m256 const t2 = _mm256_unpacklo_ps(r[2], r[3]);
+			__m256 const t3 = _mm256_unpackhi_ps(r[2], r[3]);
+			v.x = twide<8>(_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)));
+			v.y = twide<8>(_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)));
+			v.z = twide<8>(_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)));
+		}
+
+		template <>
+		GLM_FUNC_QUALIFIER void transform_batch_store(char * p, std::size_t stride, tvec3x<8> const & v)
+		{
+			__m256 const t0 = _mm256_unpacklo_ps(v.x.data, v.y.data);
+			__m256 const t1 = _mm256_unpackhi_ps(v.x.data, v.y.data);
+			__m256 const t2 = _mm256_unpacklo_ps(v.z.data, _mm256_setzero_ps());
+			__m256 const t3 = _mm256_unpackhi_ps(v.z.data, _mm256_setzero_ps());
+			__m256 const r[4] = {
+				_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)),
+				_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)),
+				_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)),
+				_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2))};
+			for(int i = 0; i < 4; ++i)
+				transform_batch_store3(p + stride * i, _mm256_castps256_ps128(r[i]));
+			for(int i = 0; i < 4; ++i)
+				transform_batch_store3(p + stride * (i + 4), _mm256_extractf128_ps(r[i], 1));
+		}
+#	endif//GLM_ARCH & GLM_ARCH_AVX
+
+	// the lanes of each block are loaded before any are stored, so out can be in
+	template <int N>
+	struct transform_points_job
+	{
+		float m[16];
+		float const * in;
+		std::size_t inStride;
+		float * out;
+		std::size_t outStride;
+		bool project;
+
+		GLM_FUNC_QUALIFIER void operator()(std::size_t first, std::size_t last) const
+		{
+			twide<N> const m00(m[0]), m01(m[1]), m02(m[2]), m03(m[3]);
+			twide<N> const m10(m[4]), m11(m[5]), m12(m[6]), m13(m[7]);
+			twide<N> const m20(m[8]), m21(m[9]), m22(m[10]), m23(m[11]);
+			twide<N> const m30(m[12]), m31(m[13]), m32(m[14]), m33(m[15]);
+
+			char const * Src = reinterpret_cast<char const *>(in) + first * inStride;
+			char * Dst = reinterpret_cast<char *>(out) + first * outStride;
+			for(std::size_t i = first; i < last; i += N)
+			{
+				int const Count = last - i < std::size_t(N) ? static_cast<int>(last - i) : N;
+
+				tvec3x<N> p;
+				if(Count == N)
+					transform_batch_load(p, Src, inStride, inStride >= 4 * sizeof(float) || i + std::size_t(N) < last);
+				else
+					load_strided(p, reinterpret_cast<float const *>(Src), inStride, Count);
+
+				// the sums in the order mat4 * vec4 does them: (m[0] * x + m[1] * y) + (m[2] * z + m[3] * 1)
+				tvec3x<N> r(
+					(m00 * p.x + m10 * p.y) + (m20 * p.z + m30),
+					(m01 * p.x + m11 * p.y) + (m21 * p.z + m31),
+					(m02 * p.x + m12 * p.y) + (m22 * p.z + m32));
+				if(project)
+					r = r / ((m03 * p.x + m13 * p.y) + (m23 * p.z + m33));
+
+				if(Count == N)
+					transform_batch_store(Dst, outStride, r);
+				else
+					store_strided(reinterpret_cast<float *>(Dst), outStride, r, Count);
+				Src += N * inStride;
+				Dst += N * outStride;
+			}
+		}
+	};
+
+	template <int N>
+	struct transform_normals_job
+	{
+		float n[9];
+		float const * in;
+		std::size_t inStride;
+		float * out;
+		std::size_t outStride;
+
+		GLM_FUNC_QUALIFIER void operator()(std::size_t first, std::size_t last) const
+		{
+			twide<N> const n00(n[0]), n01(n[1]), n02(n[2]);
+			twide<N> const n10(n[3]), n11(n[4]), n12(n[5]);
+			twide<N> const n20(n[6]), n21(n[7]), n22(n[8]);
+
+			char const * Src = reinterpret_cast<char const *>(in) + first * inStride;
+			char * Dst = reinterpret_cast<char *>(out) + first * outStride;
+			for(std::size_t i = first; i < last; i += N)
+			{
+				int const Count = last - i < std::size_t(N) ? static_cast<int>(last - i) : N;
+
+				tvec3x<N> v;
+				if(Count == N)
+					transform_batch_load(v, Src, inStride, inStride >= 4 * sizeof(float) || i + std::size_t(N) < last);
+				else
+					load_strided(v, reinterpret_cast<float const *>(Src), inStride, Count);
+
+				// the sums in the order mat3 * vec3 does them: m[0] * x + m[1] * y + m[2] * z
+				tvec3x<N> const r(
+					n00 * v.x + n10 * v.y + n20 * v.z,
+					n01 * v.x + n11 * v.y + n21 * v.z,
+					n02 * v.x + n12 * v.y + n22 * v.z);
+
+				if(Count == N)
+					transform_batch_store(Dst, outStride, normalize(r));
+				else
+					store_strided(reinterpret_cast<float *>(Dst), outStride, normalize(r), Count);
+				Src += N * inStride;
+				Dst += N * outStride;
+			}
+		}
+	};
+
+	template <precision P>
+	struct mul_batch_job
+	{
+		tmat4x4<float, P> const * a;
+		std::size_t aStep;		// 0 when every b is multiplied by the same a
+		tmat4x4<float, P> const * b;
+		tmat4x4<float, P> * out;
+
+		GLM_FUNC_QUALIFIER void operator()(std::size_t first, std::size_t last) const
+		{
+			for(std::size_t i = first; i < last; ++i)
+				out[i] = a[i * aStep] * b[i];
+		}
+	};
+
+	GLM_FUNC_QUALIFIER bool transform_batch_x8(std::size_t inStride, std::size_t outStride)
+	{
+		return wide_width == 8 && inStride < GLM_TRANSFORM_BATCH_MAX_STRIDE_X8 && outStride < GLM_TRANSFORM_BATCH_MAX_STRIDE_X8;
+	}
+
+	template <int N, precision P>
+	GLM_FUNC_QUALIFIER void transform_points_run(tmat4x4<float, P> const & m, float const * in, std::size_t inStride, float * out, std::size_t outStride, std::size_t count, int threads, bool project)
+	{
+		transform_points_job<N> Job;
+		for(length_t c = 0; c < 4; ++c)
+		for(length_t r = 0; r < 4; ++r)
+			Job.m[c * 4 + r] = m[c][r];
+		Job.in = in;
+		Job.inStride = inStride;
+		Job.out = out;
+		Job.outStride = outStride;
+		Job.project = project;
+		wide_run(Job, count, threads, GLM_TRANSFORM_BATCH_MIN_PER_THREAD);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void transform_points_run(tmat4x4<float, P> const & m, float const * in, std::size_t inStride, float * out, std::size_t outStride, std::size_t count, int threads, bool project)
+	{
+		if(transform_batch_x8(inStride, outStride))
+			transform_points_run<wide_width>(m, in, inStride, out, outStride, count, threads, project);
+		else
+			transform_points_run<4>(m, in, inStride, out, outStride, count, threads, project);
+	}
+
+	template <int N, precision P>
+	GLM_FUNC_QUALIFIER void transform_normals_run(tmat3x3<float, P> const & n, float const * in, std::size_t inStride, float * out, std::size_t outStride, std::size_t count, int threads)
+	{
+		transform_normals_job<N> Job;
+		for(length_t c = 0; c < 3; ++c)
+		for(length_t r = 0; r < 3; ++r)
+			Job.n[c * 3 + r] = n[c][r];
+		Job.in = in;
+		Job.inStride = inStride;
+		Job.out = out;
+		Job.outStride = outStride;
+		wide_run(Job, count, threads, GLM_TRANSFORM_BATCH_MIN_PER_THREAD);
+	}
+}//namespace detail
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void transform_points(tmat4x4<float, P> const & m, float const * in, std::size_t inStride, float * out, std::size_t outStride, std::size_t count, int threads)
+	{
+		detail::transform_points_run(m, in, inStride, out, outStride, count, threads, false);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void transform_points(tmat4x4<float, P> const & m, tvec3<float, P> const * in, tvec3<float, P> * out, std::size_t count, int threads)
+	{
+		transform_points(m, &in[0].x, sizeof(tvec3<float, P>), &out[0].x, sizeof(tvec3<float, P>), count, threads);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void project_points(tmat4x4<float, P> const & m, float const * in, std::size_t inStride, float * out, std::size_t outStride, std::size_t count, int threads)
+	{
+		detail::transform_points_run(m, in, inStride, out, outStride, count, threads, true);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void project_points(tmat4x4<float, P> const & m, tvec3<float, P> const * in, tvec3<float, P> * out, std::size_t count, int threads)
+	{
+		project_points(m, &in[0].x, sizeof(tvec3<float, P>), &out[0].x, sizeof(tvec3<float, P>), count, threads);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void transform_normals(tmat4x4<float, P> const & m, float const * in, std::size_t inStride, float * out, std::size_t outStride, std::size_t count, int threads)
+	{
+		tmat3x3<float, P> const n(transpose(inverse(tmat3x3<float, P>(m))));
+
+		if(detail::transform_batch_x8(inStride, outStride))
+			detail::transform_normals_run<detail::wide_width>(n, in, inStride, out, outStride, count, threads);
+		else
+			detail::transform_normals_run<4>(n, in, inStride, out, outStride, count, threads);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void transform_normals(tmat4x4<float, P> const & m, tvec3<float, P> const * in, tvec3<float, P> * out, std::size_t count, int threads)
+	{
+		transform_normals(m, &in[0].x, sizeof(tvec3<float, P>), &out[0].x, sizeof(tvec3<float, P>), count, threads);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void mul_batch(tmat4x4<float, P> const * a, tmat4x4<float, P> const * b, tmat4x4<float, P> * out, std::size_t count, int threads)
+	{
+		detail::mul_batch_job<P> Job;
+		Job.a = a;
+		Job.aStep = 1;
+		Job.b = b;
+		Job.out = out;
+		detail::wide_run(Job, count, threads, GLM_TRANSFORM_BATCH_MIN_PER_THREAD);
+	}
+
+	template <precision P>
+	GLM_FUNC_QUALIFIER void mul_batch(tmat4x4<float, P> const & a, tmat4x4<float, P> const * b, tmat4x4<float, P> * out, std::size_t count, int threads)
+	{
+		detail::mul_batch_job<P> Job;
+		Job.a = &a;
+		Job.aStep = 0;
+		Job.b = b;
+		Job.out = out;
+		detail::wide_run(Job, count, threads, GLM_TRANSFORM_BATCH_MIN_PER_THREAD);
+	}
+}//namespace glm
@@ -0,0 +1,273 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// OpenGL Mathematics (glm.g-truc.net)
+///
+/// Copyright (c) 2005 - 2015 G-Truc Creation (www.g-truc.net)
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// Restrictions:
+///		By making use of the Software for military purposes, you choose to make
+///		a Bunny unhappy.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+/// @ref gtx_wide
+/// @file glm/gtx/wide.hpp
+/// @date 2026-10-19 / 2026-10-19
+///
+/// @see core (dependence)
+///
+/// @defgroup gtx_wide GLM_GTX_wide
+/// @ingroup gtx
+///
+/// @brief Structure-of-arrays vectors: 4 or 8 vec3s or vec4s operated on at once.
+///
+/// twide<N> is N floats, one per lane: an SSE register for N = 4 when GLM_ARCH has SSE2,
+/// an AVX register for N = 8 when it has AVX, and otherwise an array the compiler is left to vectorize.
+/// tvec3x<N> and tvec4x<N> are a twide<N> per component, so one operation on them is the same operation
+/// on N vectors, each lane giving what the scalar glm function gives for that vector.
+///
+/// Get vectors in and out of them with load_aos( ) / store_aos( ) (arrays of tvec3 or tvec4) or
+/// load_strided( ) / store_strided( ) (vectors that are a member of a larger struct).
+/// The AVX types want 32-byte alignment, so keep them on the stack, as the temporaries of a kernel,
+/// rather than in containers that may not align them.
+///
+/// <glm/gtx/wide.hpp> need to be included to use these functionalities.
+///////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+#include <cstddef>
+
+#if(defined(GLM_MESSAGES) && !defined(GLM_EXT_INCLUDED))
+#	pragma message("GLM: GLM_GTX_wide extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_wide
+	/// @{
+
+	/// N floats, operated on a lane at a time.
+	/// From GLM_GTX_wide extension.
+	template <int N>
+	struct twide
+	{
+		float data[N];
+
+		GLM_FUNC_DECL twide();
+		GLM_FUNC_DECL explicit twide(float s);
+
+		/// N floats from p, which need not be aligned.
+		GLM_FUNC_DECL static twide<N> load(float const * p);
+		GLM_FUNC_DECL void store(float * p) const;
+		GLM_FUNC_DECL float operator[](int i) const;
+	};
+
+#if GLM_ARCH & GLM_ARCH_SSE2
+	template <>
+	struct twide<4>
+	{
+		__m128 data;
+
+		GLM_FUNC_DECL twide();
+		GLM_FUNC_DECL explicit twide(float s);
+		GLM_FUNC_DECL explicit twide(__m128 const & d);
+
+		GLM_FUNC_DECL static twide<4> load(float const * p);
+		GLM_FUNC_DECL void store(float * p) const;
+		GLM_FUNC_DECL float operator[](int i) const;
+	};
+#endif//GLM_ARCH & GLM_ARCH_SSE2
+
+#if GLM_ARCH & GLM_ARCH_AVX
+	template <>
+	struct twide<8>
+	{
+		__m256 data;
+
+		GLM_FUNC_DECL twide();
+		GLM_FUNC_DECL explicit twide(float s);
+		GLM_FUNC_DECL explicit twide(__m256 const & d);
+
+		GLM_FUNC_DECL static twide<8> load(float const * p);
+		GLM_FUNC_DECL void store(float * p) const;
+		GLM_FUNC_DECL float operator[](int i) const;
+	};
+#endif//GLM_ARCH & GLM_ARCH_AVX
+
+	/// N vec3s, a twide<N> per component.
+	/// From GLM_GTX_wide extension.
+	template <int N>
+	struct tvec3x
+	{
+		twide<N> x, y, z;
+
+		GLM_FUNC_DECL tvec3x();
+		GLM_FUNC_DECL tvec3x(twide<N> const & a, twide<N> const & b, twide<N> const & c);
+
+		/// v in every lane.
+		template <precision P>
+		GLM_FUNC_DECL explicit tvec3x(tvec3<float, P> const & v);
+
+		/// The vector in lane i.
+		GLM_FUNC_DECL tvec3<float, defaultp> operator[](int i) const;
+	};
+
+	/// N vec4s, a twide<N> per component.
+	/// From GLM_GTX_wide extension.
+	template <int N>
+	struct tvec4x
+	{
+		twide<N> x, y, z, w;
+
+		GLM_FUNC_DECL tvec4x();
+		GLM_FUNC_DECL tvec4x(twide<N> const & a, twide<N> const & b, twide<N> const & c, twide<N> const & d);
+		GLM_FUNC_DECL tvec4x(tvec3x<N> const & v, twide<N> const & s);
+
+		/// v in every lane.
+		template <precision P>
+		GLM_FUNC_DECL explicit tvec4x(tvec4<float, P> const & v);
+
+		/// The vector in lane i.
+		GLM_FUNC_DECL tvec4<float, defaultp> operator[](int i) const;
+	};
+
+	typedef twide<4>	floatx4;
+	typedef twide<8>	floatx8;
+	typedef tvec3x<4>	vec3x4;
+	typedef tvec3x<8>	vec3x8;
+	typedef tvec4x<4>	vec4x4;
+	typedef tvec4x<8>	vec4x8;
+
+	// lane-wise arithmetic and functions of twide:
+
+	template <int N> GLM_FUNC_DECL twide<N> operator+(twide<N> const & a, twide<N> const & b);
+	template <int N> GLM_FUNC_DECL twide<N> operator-(twide<N> const & a, twide<N> const & b);
+	template <int N> GLM_FUNC_DECL twide<N> operator*(twide<N> const & a, twide<N> const & b);
+	template <int N> GLM_FUNC_DECL twide<N> operator/(twide<N> const & a, twide<N> const & b);
+	template <int N> GLM_FUNC_DECL twide<N> operator-(twide<N> const & a);
+	template <int N> GLM_FUNC_DECL twide<N> min(twide<N> const & a, twide<N> const & b);
+	template <int N> GLM_FUNC_DECL twide<N> max(twide<N> const & a, twide<N> const & b);
+	template <int N> GLM_FUNC_DECL twide<N> abs(twide<N> const & a);
+	template <int N> GLM_FUNC_DECL twide<N> sqrt(twide<N> const & a);
+	template <int N> GLM_FUNC_DECL twide<N> floor(twide<N> const & a);
+	template <int N> GLM_FUNC_DECL twide<N> step(twide<N> const & edge, twide<N> const & x);
+
+	template <int N> GLM_FUNC_DECL twide<N> operator+(twide<N> const & a, float b);
+	template <int N> GLM_FUNC_DECL twide<N> operator+(float a, twide<N> const & b);
+	template <int N> GLM_FUNC_DECL twide<N> operator-(twide<N> const & a, float b);
+	template <int N> GLM_FUNC_DECL twide<N> operator-(float a, twide<N> const & b);
+	template <int N> GLM_FUNC_DECL twide<N> operator*(twide<N> const & a, float b);
+	template <int N> GLM_FUNC_DECL twide<N> operator*(float a, twide<N> const & b);
+	template <int N> GLM_FUNC_DECL twide<N> operator/(twide<N> const & a, float b);
+	template <int N> GLM_FUNC_DECL twide<N> operator/(float a, twide<N> const & b);
+
+	template <int N> GLM_FUNC_DECL twide<N> inversesqrt(twide<N> const & a);
+	template <int N> GLM_FUNC_DECL twide<N> clamp(twide<N> const & x, float minVal, float maxVal);
+	template <int N> GLM_FUNC_DECL twide<N> clamp(twide<N> const & x, twide<N> const & minVal, twide<N> const & maxVal);
+	template <int N> GLM_FUNC_DECL twide<N> mix(twide<N> const & x, twide<N> const & y, twide<N> const & a);
+	template <int N> GLM_FUNC_DECL twide<N> mix(twide<N> const & x, twide<N> const & y, float a);
+	template <int N> GLM_FUNC_DECL twide<N> smoothstep(float edge0, float edge1, twide<N> const & x);
+	template <int N> GLM_FUNC_DECL twide<N> smoothstep(twide<N> const & edge0, twide<N> const & edge1, twide<N> const & x);
+	template <int N> GLM_FUNC_DECL twide<N> fract(twide<N> const & x);
+	template <int N> GLM_FUNC_DECL twide<N> mod(twide<N> const & x, twide<N> const & y);
+	template <int N> GLM_FUNC_DECL twide<N> mod(twide<N> const & x, float y);
+	template <int N> GLM_FUNC_DECL twide<N> step(float edge, twide<N> const & x);
+	template <int N> GLM_FUNC_DECL twide<N> step(twide<N> const & edge, float x);
+
+	// component-wise arithmetic of tvec3x and tvec4x:
+
+	template <int N> GLM_FUNC_DECL tvec3x<N> operator+(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec3x<N> operator-(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec3x<N> operator*(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec3x<N> operator/(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec3x<N> operator*(tvec3x<N> const & a, twide<N> const & s);
+	template <int N> GLM_FUNC_DECL tvec3x<N> operator*(twide<N> const & s, tvec3x<N> const & a);
+	template <int N> GLM_FUNC_DECL tvec3x<N> operator*(tvec3x<N> const & a, float s);
+	template <int N> GLM_FUNC_DECL tvec3x<N> operator*(float s, tvec3x<N> const & a);
+	template <int N> GLM_FUNC_DECL tvec3x<N> operator/(tvec3x<N> const & a, twide<N> const & s);
+	template <int N> GLM_FUNC_DECL tvec3x<N> operator/(tvec3x<N> const & a, float s);
+	template <int N> GLM_FUNC_DECL tvec3x<N> operator-(tvec3x<N> const & a);
+
+	template <int N> GLM_FUNC_DECL tvec4x<N> operator+(tvec4x<N> const & a, tvec4x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec4x<N> operator-(tvec4x<N> const & a, tvec4x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec4x<N> operator*(tvec4x<N> const & a, tvec4x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec4x<N> operator/(tvec4x<N> const & a, tvec4x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec4x<N> operator*(tvec4x<N> const & a, twide<N> const & s);
+	template <int N> GLM_FUNC_DECL tvec4x<N> operator*(twide<N> const & s, tvec4x<N> const & a);
+	template <int N> GLM_FUNC_DECL tvec4x<N> operator*(tvec4x<N> const & a, float s);
+	template <int N> GLM_FUNC_DECL tvec4x<N> operator*(float s, tvec4x<N> const & a);
+	template <int N> GLM_FUNC_DECL tvec4x<N> operator/(tvec4x<N> const & a, twide<N> const & s);
+	template <int N> GLM_FUNC_DECL tvec4x<N> operator/(tvec4x<N> const & a, float s);
+	template <int N> GLM_FUNC_DECL tvec4x<N> operator-(tvec4x<N> const & a);
+
+	// the geometric and common functions, a vector per lane:
+
+	template <int N> GLM_FUNC_DECL twide<N> dot(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <int N> GLM_FUNC_DECL twide<N> dot(tvec4x<N> const & a, tvec4x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec3x<N> cross(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <int N> GLM_FUNC_DECL twide<N> length(tvec3x<N> const & v);
+	template <int N> GLM_FUNC_DECL twide<N> length(tvec4x<N> const & v);
+	template <int N> GLM_FUNC_DECL twide<N> distance(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec3x<N> normalize(tvec3x<N> const & v);
+	template <int N> GLM_FUNC_DECL tvec4x<N> normalize(tvec4x<N> const & v);
+
+	template <int N> GLM_FUNC_DECL tvec3x<N> min(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec3x<N> max(tvec3x<N> const & a, tvec3x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec3x<N> clamp(tvec3x<N> const & v, float minVal, float maxVal);
+	template <int N> GLM_FUNC_DECL tvec3x<N> mix(tvec3x<N> const & x, tvec3x<N> const & y, twide<N> const & a);
+	template <int N> GLM_FUNC_DECL tvec3x<N> mix(tvec3x<N> const & x, tvec3x<N> const & y, float a);
+	template <int N> GLM_FUNC_DECL tvec3x<N> smoothstep(float edge0, float edge1, tvec3x<N> const & x);
+
+	template <int N> GLM_FUNC_DECL tvec4x<N> min(tvec4x<N> const & a, tvec4x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec4x<N> max(tvec4x<N> const & a, tvec4x<N> const & b);
+	template <int N> GLM_FUNC_DECL tvec4x<N> clamp(tvec4x<N> const & v, float minVal, float maxVal);
+	template <int N> GLM_FUNC_DECL tvec4x<N> mix(tvec4x<N> const & x, tvec4x<N> const & y, twide<N> const & a);
+	template <int N> GLM_FUNC_DECL tvec4x<N> mix(tvec4x<N> const & x, tvec4x<N> const & y, float a);
+	template <int N> GLM_FUNC_DECL tvec4x<N> smoothstep(float edge0, float edge1, tvec4x<N> const & x);
+
+	// to and from arrays of structures:
+	// (count vectors, 1 to N -- the lanes past count are copies of the last one, so nothing in them divides by zero,
+	// and the store leaves what is past count alone)
+
+	/// Load count vectors from src[0] to src[count-1].
+	/// From GLM_GTX_wide extension.
+	template <int N, precision P> GLM_FUNC_DECL void load_aos(tvec3x<N> & v, tvec3<float, P> const * src, int count = N);
+	template <int N, precision P> GLM_FUNC_DECL void load_aos(tvec4x<N> & v, tvec4<float, P> const * src, int count = N);
+
+	/// Store count vectors to dst[0] to dst[count-1].
+	/// From GLM_GTX_wide extension.
+	template <int N, precision P> GLM_FUNC_DECL void store_aos(tvec3<float, P> * dst, tvec3x<N> const & v, int count = N);
+	template <int N, precision P> GLM_FUNC_DECL void store_aos(tvec4<float, P> * dst, tvec4x<N> const & v, int count = N);
+
+	/// Load count vectors of 3 (or 4) consecutive floats, the first at src and each stride bytes after the one before
+	/// -- a member of an array of structs, say.
+	/// From GLM_GTX_wide extension.
+	template <int N> GLM_FUNC_DECL void load_strided(tvec3x<N> & v, float const * src, std::size_t stride, int count = N);
+	template <int N> GLM_FUNC_DECL void load_strided(tvec4x<N> & v, float const * src, std::size_t stride, int count = N);
+
+	/// Store count vectors of 3 (or 4) consecutive floats, the first at dst and each stride bytes after the one before.
+	/// From GLM_GTX_wide extension.
+	template <int N> GLM_FUNC_DECL void store_strided(float * dst, std::size_t stride, tvec3x<N> const & v, int count = N);
+	template <int N> GLM_FUNC_DECL void store_strided(float * dst, std::size_t stride, tvec4x<N> const & v, int count = N);
+
+	/// @}
+}//namespace glm
+
+#include "wide.inl"
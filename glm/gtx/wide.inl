@@ -0,0 +1,1006 @@
+///////////////////////////////////////////////////////////////////////////////////
+/// OpenGL Mathematics (glm.g-truc.net)
+///
+/// Copyright (c) 2005 - 2015 G-Truc Creation (www.g-truc.net)
+/// Permission is hereby granted, free of charge, to any person obtaining a copy
+/// of this software and associated documentation files (the "Software"), to deal
+/// in the Software without restriction, including without limitation the rights
+/// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+/// copies of the Software, and to permit persons to whom the Software is
+/// furnished to do so, subject to the following conditions:
+///
+/// The above copyright notice and this permission notice shall be included in
+/// all copies or substantial portions of the Software.
+///
+/// Restrictions:
+///		By making use of the Software for military purposes, you choose to make
+///		a Bunny unhappy.
+///
+/// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+/// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+/// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+/// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+/// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+/// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+/// THE SOFTWARE.
+///
+/// @ref gtx_wide
+/// @file glm/gtx/wide.inl
+/// @date 2026-10-19 / 2026-10-19
+///////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+#if (GLM_LANG & GLM_LANG_CXX11_FLAG) || ((GLM_COMPILER & GLM_COMPILER_VC) && (GLM_COMPILER >= GLM_COMPILER_VC2012))
+#	define GLM_WIDE_THREADS 1
+#	include <thread>
+#	include <vector>
+#else
+#	define GLM_WIDE_THREADS 0
+#endif
+
+namespace glm
+{
+	//////////////////////////////////////
+	// twide, portable
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N>::twide()
+	{}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N>::twide(float s)
+	{
+		for(int i = 0; i < N; ++i)
+			data[i] = s;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> twide<N>::load(float const * p)
+	{
+		twide<N> Result;
+		for(int i = 0; i < N; ++i)
+			Result.data[i] = p[i];
+		return Result;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER void twide<N>::store(float * p) const
+	{
+		for(int i = 0; i < N; ++i)
+			p[i] = data[i];
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER float twide<N>::operator[](int i) const
+	{
+		return data[i];
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> operator+(twide<N> const & a, twide<N> const & b)
+	{
+		twide<N> Result;
+		for(int i = 0; i < N; ++i)
+			Result.data[i] = a.data[i] + b.data[i];
+		return Result;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> operator-(twide<N> const & a, twide<N> const & b)
+	{
+		twide<N> Result;
+		for(int i = 0; i < N; ++i)
+			Result.data[i] = a.data[i] - b.data[i];
+		return Result;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> operator*(twide<N> const & a, twide<N> const & b)
+	{
+		twide<N> Result;
+		for(int i = 0; i < N; ++i)
+			Result.data[i] = a.data[i] * b.data[i];
+		return Result;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> operator/(twide<N> const & a, twide<N> const & b)
+	{
+		twide<N> Result;
+		for(int i = 0; i < N; ++i)
+			Result.data[i] = a.data[i] / b.data[i];
+		return Result;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> operator-(twide<N> const & a)
+	{
+		twide<N> Result;
+		for(int i = 0; i < N; ++i)
+			Result.data[i] = -a.data[i];
+		return Result;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> min(twide<N> const & a, twide<N> const & b)
+	{
+		twide<N> Result;
+		for(int i = 0; i < N; ++i)
+			Result.data[i] = b.data[i] < a.data[i] ? b.data[i] : a.data[i];
+		return Result;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> max(twide<N> const & a, twide<N> const & b)
+	{
+		twide<N> Result;
+		for(int i = 0; i < N; ++i)
+			Result.data[i] = a.data[i] < b.data[i] ? b.data[i] : a.data[i];
+		return Result;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> abs(twide<N> const & a)
+	{
+		twide<N> Result;
+		for(int i = 0; i < N; ++i)
+			Result.data[i] = a.data[i] < 0.0f ? -a.data[i] : a.data[i];
+		return Result;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> sqrt(twide<N> const & a)
+	{
+		twide<N> Result;
+		for(int i = 0; i < N; ++i)
+			Result.data[i] = std::sqrt(a.data[i]);
+		return Result;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> floor(twide<N> const & a)
+	{
+		twide<N> Result;
+		for(int i = 0; i < N; ++i)
+			Result.data[i] = std::floor(a.data[i]);
+		return Result;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> step(twide<N> const & edge, twide<N> const & x)
+	{
+		twide<N> Result;
+		for(int i = 0; i < N; ++i)
+			Result.data[i] = x.data[i] < edge.data[i] ? 0.0f : 1.0f;
+		return Result;
+	}
+
+	//////////////////////////////////////
+	// twide<4>, SSE2
+
+#if GLM_ARCH & GLM_ARCH_SSE2
+	GLM_FUNC_QUALIFIER twide<4>::twide()
+	{}
+
+	GLM_FUNC_QUALIFIER twide<4>::twide(float s) :
+		data(_mm_set1_ps(s))
+	{}
+
+	GLM_FUNC_QUALIFIER twide<4>::twide(__m128 const & d) :
+		data(d)
+	{}
+
+	GLM_FUNC_QUALIFIER twide<4> twide<4>::load(float const * p)
+	{
+		return twide<4>(_mm_loadu_ps(p));
+	}
+
+	GLM_FUNC_QUALIFIER void twide<4>::store(float * p) const
+	{
+		_mm_storeu_ps(p, data);
+	}
+
+	GLM_FUNC_QUALIFIER float twide<4>::operator[](int i) const
+	{
+		float v[4];
+		_mm_storeu_ps(v, data);
+		return v[i];
+	}
+
+	GLM_FUNC_QUALIFIER twide<4> operator+(twide<4> const & a, twide<4> const & b)
+	{
+		return twide<4>(_mm_add_ps(a.data, b.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<4> operator-(twide<4> const & a, twide<4> const & b)
+	{
+		return twide<4>(_mm_sub_ps(a.data, b.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<4> operator*(twide<4> const & a, twide<4> const & b)
+	{
+		return twide<4>(_mm_mul_ps(a.data, b.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<4> operator/(twide<4> const & a, twide<4> const & b)
+	{
+		return twide<4>(_mm_div_ps(a.data, b.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<4> operator-(twide<4> const & a)
+	{
+		return twide<4>(_mm_xor_ps(a.data, _mm_set1_ps(-0.0f)));
+	}
+
+	// (minps and maxps return their second operand when either is a NaN, so these are ordered to match the scalar min and max)
+	GLM_FUNC_QUALIFIER twide<4> min(twide<4> const & a, twide<4> const & b)
+	{
+		return twide<4>(_mm_min_ps(b.data, a.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<4> max(twide<4> const & a, twide<4> const & b)
+	{
+		return twide<4>(_mm_max_ps(b.data, a.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<4> abs(twide<4> const & a)
+	{
+		return twide<4>(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<4> sqrt(twide<4> const & a)
+	{
+		return twide<4>(_mm_sqrt_ps(a.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<4> floor(twide<4> const & a)
+	{
+#		if GLM_ARCH & GLM_ARCH_SSE4
+			return twide<4>(_mm_floor_ps(a.data));
+#		else
+			// truncate, take 1 from what came out above a, then put back the sign so that -0 stays -0;
+			// from 2^23 up every float is whole already (and too big for an int), so those are left as they are
+			__m128 const SignMask = _mm_set1_ps(-0.0f);
+			__m128 const Trunc = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.data));
+			__m128 const Floor = _mm_or_ps(_mm_sub_ps(Trunc, _mm_and_ps(_mm_cmpgt_ps(Trunc, a.data), _mm_set1_ps(1.0f))), _mm_and_ps(a.data, SignMask));
+			__m128 const Small = _mm_cmplt_ps(_mm_andnot_ps(SignMask, a.data), _mm_set1_ps(8388608.0f));
+			return twide<4>(_mm_or_ps(_mm_and_ps(Small, Floor), _mm_andnot_ps(Small, a.data)));
+#		endif
+	}
+
+	GLM_FUNC_QUALIFIER twide<4> step(twide<4> const & edge, twide<4> const & x)
+	{
+		return twide<4>(_mm_andnot_ps(_mm_cmplt_ps(x.data, edge.data), _mm_set1_ps(1.0f)));
+	}
+#endif//GLM_ARCH & GLM_ARCH_SSE2
+
+	//////////////////////////////////////
+	// twide<8>, AVX
+
+#if GLM_ARCH & GLM_ARCH_AVX
+	GLM_FUNC_QUALIFIER twide<8>::twide()
+	{}
+
+	GLM_FUNC_QUALIFIER twide<8>::twide(float s) :
+		data(_mm256_set1_ps(s))
+	{}
+
+	GLM_FUNC_QUALIFIER twide<8>::twide(__m256 const & d) :
+		data(d)
+	{}
+
+	GLM_FUNC_QUALIFIER twide<8> twide<8>::load(float const * p)
+	{
+		return twide<8>(_mm256_loadu_ps(p));
+	}
+
+	GLM_FUNC_QUALIFIER void twide<8>::store(float * p) const
+	{
+		_mm256_storeu_ps(p, data);
+	}
+
+	GLM_FUNC_QUALIFIER float twide<8>::operator[](int i) const
+	{
+		float v[8];
+		_mm256_storeu_ps(v, data);
+		return v[i];
+	}
+
+	GLM_FUNC_QUALIFIER twide<8> operator+(twide<8> const & a, twide<8> const & b)
+	{
+		return twide<8>(_mm256_add_ps(a.data, b.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<8> operator-(twide<8> const & a, twide<8> const & b)
+	{
+		return twide<8>(_mm256_sub_ps(a.data, b.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<8> operator*(twide<8> const & a, twide<8> const & b)
+	{
+		return twide<8>(_mm256_mul_ps(a.data, b.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<8> operator/(twide<8> const & a, twide<8> const & b)
+	{
+		return twide<8>(_mm256_div_ps(a.data, b.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<8> operator-(twide<8> const & a)
+	{
+		return twide<8>(_mm256_xor_ps(a.data, _mm256_set1_ps(-0.0f)));
+	}
+
+	GLM_FUNC_QUALIFIER twide<8> min(twide<8> const & a, twide<8> const & b)
+	{
+		return twide<8>(_mm256_min_ps(b.data, a.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<8> max(twide<8> const & a, twide<8> const & b)
+	{
+		return twide<8>(_mm256_max_ps(b.data, a.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<8> abs(twide<8> const & a)
+	{
+		return twide<8>(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<8> sqrt(twide<8> const & a)
+	{
+		return twide<8>(_mm256_sqrt_ps(a.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<8> floor(twide<8> const & a)
+	{
+		return twide<8>(_mm256_floor_ps(a.data));
+	}
+
+	GLM_FUNC_QUALIFIER twide<8> step(twide<8> const & edge, twide<8> const & x)
+	{
+		return twide<8>(_mm256_andnot_ps(_mm256_cmp_ps(x.data, edge.data, _CMP_LT_OQ), _mm256_set1_ps(1.0f)));
+	}
+#endif//GLM_ARCH & GLM_ARCH_AVX
+
+	//////////////////////////////////////
+	// twide, in terms of the above
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> operator+(twide<N> const & a, float b)
+	{
+		return a + twide<N>(b);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> operator+(float a, twide<N> const & b)
+	{
+		return twide<N>(a) + b;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> operator-(twide<N> const & a, float b)
+	{
+		return a - twide<N>(b);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> operator-(float a, twide<N> const & b)
+	{
+		return twide<N>(a) - b;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> operator*(twide<N> const & a, float b)
+	{
+		return a * twide<N>(b);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> operator*(float a, twide<N> const & b)
+	{
+		return twide<N>(a) * b;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> operator/(twide<N> const & a, float b)
+	{
+		return a / twide<N>(b);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> operator/(float a, twide<N> const & b)
+	{
+		return twide<N>(a) / b;
+	}
+
+	// (a divide, not the approximate reciprocal square root, so that it is what the scalar inversesqrt gives)
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> inversesqrt(twide<N> const & a)
+	{
+		return twide<N>(1.0f) / sqrt(a);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> clamp(twide<N> const & x, float minVal, float maxVal)
+	{
+		return min(max(x, twide<N>(minVal)), twide<N>(maxVal));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> clamp(twide<N> const & x, twide<N> const & minVal, twide<N> const & maxVal)
+	{
+		return min(max(x, minVal), maxVal);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> mix(twide<N> const & x, twide<N> const & y, twide<N> const & a)
+	{
+		return x + a * (y - x);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> mix(twide<N> const & x, twide<N> const & y, float a)
+	{
+		return x + twide<N>(a) * (y - x);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> smoothstep(float edge0, float edge1, twide<N> const & x)
+	{
+		twide<N> const tmp(clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f));
+		return tmp * tmp * (3.0f - 2.0f * tmp);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> smoothstep(twide<N> const & edge0, twide<N> const & edge1, twide<N> const & x)
+	{
+		twide<N> const tmp(clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f));
+		return tmp * tmp * (3.0f - 2.0f * tmp);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> fract(twide<N> const & x)
+	{
+		return x - floor(x);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> mod(twide<N> const & x, twide<N> const & y)
+	{
+		return x - y * floor(x / y);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> mod(twide<N> const & x, float y)
+	{
+		return mod(x, twide<N>(y));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> step(float edge, twide<N> const & x)
+	{
+		return step(twide<N>(edge), x);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> step(twide<N> const & edge, float x)
+	{
+		return step(edge, twide<N>(x));
+	}
+
+	//////////////////////////////////////
+	// tvec3x, tvec4x
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N>::tvec3x()
+	{}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N>::tvec3x(twide<N> const & a, twide<N> const & b, twide<N> const & c) :
+		x(a), y(b), z(c)
+	{}
+
+	template <int N>
+	template <precision P>
+	GLM_FUNC_QUALIFIER tvec3x<N>::tvec3x(tvec3<float, P> const & v) :
+		x(v.x), y(v.y), z(v.z)
+	{}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3<float, defaultp> tvec3x<N>::operator[](int i) const
+	{
+		return tvec3<float, defaultp>(x[i], y[i], z[i]);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N>::tvec4x()
+	{}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N>::tvec4x(twide<N> const & a, twide<N> const & b, twide<N> const & c, twide<N> const & d) :
+		x(a), y(b), z(c), w(d)
+	{}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N>::tvec4x(tvec3x<N> const & v, twide<N> const & s) :
+		x(v.x), y(v.y), z(v.z), w(s)
+	{}
+
+	template <int N>
+	template <precision P>
+	GLM_FUNC_QUALIFIER tvec4x<N>::tvec4x(tvec4<float, P> const & v) :
+		x(v.x), y(v.y), z(v.z), w(v.w)
+	{}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4<float, defaultp> tvec4x<N>::operator[](int i) const
+	{
+		return tvec4<float, defaultp>(x[i], y[i], z[i], w[i]);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator+(tvec3x<N> const & a, tvec3x<N> const & b)
+	{
+		return tvec3x<N>(a.x + b.x, a.y + b.y, a.z + b.z);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator-(tvec3x<N> const & a, tvec3x<N> const & b)
+	{
+		return tvec3x<N>(a.x - b.x, a.y - b.y, a.z - b.z);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator*(tvec3x<N> const & a, tvec3x<N> const & b)
+	{
+		return tvec3x<N>(a.x * b.x, a.y * b.y, a.z * b.z);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator/(tvec3x<N> const & a, tvec3x<N> const & b)
+	{
+		return tvec3x<N>(a.x / b.x, a.y / b.y, a.z / b.z);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator*(tvec3x<N> const & a, twide<N> const & s)
+	{
+		return tvec3x<N>(a.x * s, a.y * s, a.z * s);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator*(twide<N> const & s, tvec3x<N> const & a)
+	{
+		return tvec3x<N>(s * a.x, s * a.y, s * a.z);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator*(tvec3x<N> const & a, float s)
+	{
+		return a * twide<N>(s);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator*(float s, tvec3x<N> const & a)
+	{
+		return twide<N>(s) * a;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator/(tvec3x<N> const & a, twide<N> const & s)
+	{
+		return tvec3x<N>(a.x / s, a.y / s, a.z / s);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator/(tvec3x<N> const & a, float s)
+	{
+		return a / twide<N>(s);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> operator-(tvec3x<N> const & a)
+	{
+		return tvec3x<N>(-a.x, -a.y, -a.z);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator+(tvec4x<N> const & a, tvec4x<N> const & b)
+	{
+		return tvec4x<N>(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator-(tvec4x<N> const & a, tvec4x<N> const & b)
+	{
+		return tvec4x<N>(a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator*(tvec4x<N> const & a, tvec4x<N> const & b)
+	{
+		return tvec4x<N>(a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator/(tvec4x<N> const & a, tvec4x<N> const & b)
+	{
+		return tvec4x<N>(a.x / b.x, a.y / b.y, a.z / b.z, a.w / b.w);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator*(tvec4x<N> const & a, twide<N> const & s)
+	{
+		return tvec4x<N>(a.x * s, a.y * s, a.z * s, a.w * s);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator*(twide<N> const & s, tvec4x<N> const & a)
+	{
+		return tvec4x<N>(s * a.x, s * a.y, s * a.z, s * a.w);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator*(tvec4x<N> const & a, float s)
+	{
+		return a * twide<N>(s);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator*(float s, tvec4x<N> const & a)
+	{
+		return twide<N>(s) * a;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator/(tvec4x<N> const & a, twide<N> const & s)
+	{
+		return tvec4x<N>(a.x / s, a.y / s, a.z / s, a.w / s);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator/(tvec4x<N> const & a, float s)
+	{
+		return a / twide<N>(s);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> operator-(tvec4x<N> const & a)
+	{
+		return tvec4x<N>(-a.x, -a.y, -a.z, -a.w);
+	}
+
+	//////////////////////////////////////
+	// geometric and common functions
+	// (the same operations, in the same order, as the scalar ones in func_geometric.inl and func_common.inl)
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> dot(tvec3x<N> const & a, tvec3x<N> const & b)
+	{
+		return a.x * b.x + a.y * b.y + a.z * b.z;
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> dot(tvec4x<N> const & a, tvec4x<N> const & b)
+	{
+		return (a.x * b.x + a.y * b.y) + (a.z * b.z + a.w * b.w);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> cross(tvec3x<N> const & a, tvec3x<N> const & b)
+	{
+		return tvec3x<N>(
+			a.y * b.z - b.y * a.z,
+			a.z * b.x - b.z * a.x,
+			a.x * b.y - b.x * a.y);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> length(tvec3x<N> const & v)
+	{
+		return sqrt(dot(v, v));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> length(tvec4x<N> const & v)
+	{
+		return sqrt(dot(v, v));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER twide<N> distance(tvec3x<N> const & a, tvec3x<N> const & b)
+	{
+		return length(b - a);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> normalize(tvec3x<N> const & v)
+	{
+		return v * inversesqrt(dot(v, v));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> normalize(tvec4x<N> const & v)
+	{
+		return v * inversesqrt(dot(v, v));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> min(tvec3x<N> const & a, tvec3x<N> const & b)
+	{
+		return tvec3x<N>(min(a.x, b.x), min(a.y, b.y), min(a.z, b.z));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> max(tvec3x<N> const & a, tvec3x<N> const & b)
+	{
+		return tvec3x<N>(max(a.x, b.x), max(a.y, b.y), max(a.z, b.z));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> clamp(tvec3x<N> const & v, float minVal, float maxVal)
+	{
+		return tvec3x<N>(clamp(v.x, minVal, maxVal), clamp(v.y, minVal, maxVal), clamp(v.z, minVal, maxVal));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> mix(tvec3x<N> const & x, tvec3x<N> const & y, twide<N> const & a)
+	{
+		return tvec3x<N>(mix(x.x, y.x, a), mix(x.y, y.y, a), mix(x.z, y.z, a));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> mix(tvec3x<N> const & x, tvec3x<N> const & y, float a)
+	{
+		return mix(x, y, twide<N>(a));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec3x<N> smoothstep(float edge0, float edge1, tvec3x<N> const & x)
+	{
+		return tvec3x<N>(smoothstep(edge0, edge1, x.x), smoothstep(edge0, edge1, x.y), smoothstep(edge0, edge1, x.z));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> min(tvec4x<N> const & a, tvec4x<N> const & b)
+	{
+		return tvec4x<N>(min(a.x, b.x), min(a.y, b.y), min(a.z, b.z), min(a.w, b.w));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> max(tvec4x<N> const & a, tvec4x<N> const & b)
+	{
+		return tvec4x<N>(max(a.x, b.x), max(a.y, b.y), max(a.z, b.z), max(a.w, b.w));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> clamp(tvec4x<N> const & v, float minVal, float maxVal)
+	{
+		return tvec4x<N>(clamp(v.x, minVal, maxVal), clamp(v.y, minVal, maxVal), clamp(v.z, minVal, maxVal), clamp(v.w, minVal, maxVal));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> mix(tvec4x<N> const & x, tvec4x<N> const & y, twide<N> const & a)
+	{
+		return tvec4x<N>(mix(x.x, y.x, a), mix(x.y, y.y, a), mix(x.z, y.z, a), mix(x.w, y.w, a));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> mix(tvec4x<N> const & x, tvec4x<N> const & y, float a)
+	{
+		return mix(x, y, twide<N>(a));
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER tvec4x<N> smoothstep(float edge0, float edge1, tvec4x<N> const & x)
+	{
+		return tvec4x<N>(smoothstep(edge0, edge1, x.x), smoothstep(edge0, edge1, x.y), smoothstep(edge0, edge1, x.z), smoothstep(edge0, edge1, x.w));
+	}
+
+	//////////////////////////////////////
+	// to and from arrays of structures
+	// (through a component-major copy on the stack, which the compiler turns into shuffles or plain moves)
+
+	template <int N>
+	GLM_FUNC_QUALIFIER void load_strided(tvec3x<N> & v, float const * src, std::size_t stride, int count)
+	{
+		float tmp[3][N];
+		char const * p = reinterpret_cast<char const *>(src);
+		for(int i = 0; i < N; ++i)
+		{
+			float const * f = reinterpret_cast<float const *>(p + stride * (i < count ? i : count - 1));
+			tmp[0][i] = f[0];
+			tmp[1][i] = f[1];
+			tmp[2][i] = f[2];
+		}
+		v.x = twide<N>::load(tmp[0]);
+		v.y = twide<N>::load(tmp[1]);
+		v.z = twide<N>::load(tmp[2]);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER void load_strided(tvec4x<N> & v, float const * src, std::size_t stride, int count)
+	{
+		float tmp[4][N];
+		char const * p = reinterpret_cast<char const *>(src);
+		for(int i = 0; i < N; ++i)
+		{
+			float const * f = reinterpret_cast<float const *>(p + stride * (i < count ? i : count - 1));
+			tmp[0][i] = f[0];
+			tmp[1][i] = f[1];
+			tmp[2][i] = f[2];
+			tmp[3][i] = f[3];
+		}
+		v.x = twide<N>::load(tmp[0]);
+		v.y = twide<N>::load(tmp[1]);
+		v.z = twide<N>::load(tmp[2]);
+		v.w = twide<N>::load(tmp[3]);
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER void store_strided(float * dst, std::size_t stride, tvec3x<N> const & v, int count)
+	{
+		float tmp[3][N];
+		v.x.store(tmp[0]);
+		v.y.store(tmp[1]);
+		v.z.store(tmp[2]);
+		char * p = reinterpret_cast<char *>(dst);
+		for(int i = 0; i < count; ++i)
+		{
+			float * f = reinterpret_cast<float *>(p + stride * i);
+			f[0] = tmp[0][i];
+			f[1] = tmp[1][i];
+			f[2] = tmp[2][i];
+		}
+	}
+
+	template <int N>
+	GLM_FUNC_QUALIFIER void store_strided(float * dst, std::size_t stride, tvec4x<N> const & v, int count)
+	{
+		float tmp[4][N];
+		v.x.store(tmp[0]);
+		v.y.store(tmp[1]);
+		v.z.store(tmp[2]);
+		v.w.store(tmp[3]);
+		char * p = reinterpret_cast<char *>(dst);
+		for(int i = 0; i < count; ++i)
+		{
+			float * f = reinterpret_cast<float *>(p + stride * i);
+			f[0] = tmp[0][i];
+			f[1] = tmp[1][i];
+			f[2] = tmp[2][i];
+			f[3] = tmp[3][i];
+		}
+	}
+
+#if (GLM_ARCH & GLM_ARCH_SSE2) && !(GLM_ARCH & GLM_ARCH_SSE4)
+	// without SSE4's inserts, going a float at a time through memory stalls every twide<4>::load( ) on the four stores
+	// just before it, so here four vectors are moved in and out of registers whole and transposed there
+	// (with SSE4 the compiler builds the lanes with inserts, which is faster still);
+	// a vec3 is moved as 8 bytes and 4, so nothing past its third float is touched
+	template <>
+	GLM_FUNC_QUALIFIER void load_strided(tvec3x<4> & v, float const * src, std::size_t stride, int count)
+	{
+		__m128 Row[4];
+		char const * p = reinterpret_cast<char const *>(src);
+		for(int i = 0; i < 4; ++i)
+		{
+			float const * f = reinterpret_cast<float const *>(p + stride * (i < count ? i : count - 1));
+			Row[i] = _mm_movelh_ps(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<double const *>(f))), _mm_load_ss(f + 2));
+		}
+		_MM_TRANSPOSE4_PS(Row[0], Row[1], Row[2], Row[3]);
+		v.x = twide<4>(Row[0]);
+		v.y = twide<4>(Row[1]);
+		v.z = twide<4>(Row[2]);
+	}
+
+	template <>
+	GLM_FUNC_QUALIFIER void load_strided(tvec4x<4> & v, float const * src, std::size_t stride, int count)
+	{
+		__m128 Row[4];
+		char const * p = reinterpret_cast<char const *>(src);
+		for(int i = 0; i < 4; ++i)
+			Row[i] = _mm_loadu_ps(reinterpret_cast<float const *>(p + stride * (i < count ? i : count - 1)));
+		_MM_TRANSPOSE4_PS(Row[0], Row[1], Row[2], Row[3]);
+		v.x = twide<4>(Row[0]);
+		v.y = twide<4>(Row[1]);
+		v.z = twide<4>(Row[2]);
+		v.w = twide<4>(Row[3]);
+	}
+
+	template <>
+	GLM_FUNC_QUALIFIER void store_strided(float * dst, std::size_t stride, tvec3x<4> const & v, int count)
+	{
+		__m128 Row[4] = {v.x.data, v.y.data, v.z.data, _mm_setzero_ps()};
+		_MM_TRANSPOSE4_PS(Row[0], Row[1], Row[2], Row[3]);
+		char * p = reinterpret_cast<char *>(dst);
+		for(int i = 0; i < count; ++i)
+		{
+			float * f = reinterpret_cast<float *>(p + stride * i);
+			_mm_storel_pi(reinterpret_cast<__m64 *>(f), Row[i]);
+			_mm_store_ss(f + 2, _mm_movehl_ps(Row[i], Row[i]));
+		}
+	}
+
+	template <>
+	GLM_FUNC_QUALIFIER void store_strided(float * dst, std::size_t stride, tvec4x<4> const & v, int count)
+	{
+		__m128 Row[4] = {v.x.data, v.y.data, v.z.data, v.w.data};
+		_MM_TRANSPOSE4_PS(Row[0], Row[1], Row[2], Row[3]);
+		char * p = reinterpret_cast<char *>(dst);
+		for(int i = 0; i < count; ++i)
+			_mm_storeu_ps(reinterpret_cast<float *>(p + stride * i), Row[i]);
+	}
+#endif//(GLM_ARCH & GLM_ARCH_SSE2) && !(GLM_ARCH & GLM_ARCH_SSE4)
+
+	template <int N, precision P>
+	GLM_FUNC_QUALIFIER void load_aos(tvec3x<N> & v, tvec3<float, P> const * src, int count)
+	{
+		load_strided(v, &src[0].x, sizeof(tvec3<float, P>), count);
+	}
+
+	template <int N, precision P>
+	GLM_FUNC_QUALIFIER void load_aos(tvec4x<N> & v, tvec4<float, P> const * src, int count)
+	{
+		load_strided(v, &src[0].x, sizeof(tvec4<float, P>), count);
+	}
+
+	template <int N, precision P>
+	GLM_FUNC_QUALIFIER void store_aos(tvec3<float, P> * dst, tvec3x<N> const & v, int count)
+	{
+		store_strided(&dst[0].x, sizeof(tvec3<float, P>), v, count);
+	}
+
+	template <int N, precision P>
+	GLM_FUNC_QUALIFIER void store_aos(tvec4<float, P> * dst, tvec4x<N> const & v, int count)
+	{
+		store_strided(&dst[0].x, sizeof(tvec4<float, P>), v, count);
+	}
+
+	//////////////////////////////////////
+	// running a kernel over a whole array (the batch extensions are built on these)
+
+namespace detail
+{
+	// the widest twide this GLM_ARCH has registers for
+#	if GLM_ARCH & GLM_ARCH_AVX
+		static int const wide_width = 8;
+#	else
+		static int const wide_width = 4;
+#	endif
+
+	// calls Job(first, last) on bands of [0, count) that together cover all of it, each on its own std::thread
+	// (threads <= 0 is one per hardware thread), but with no fewer than minPerThread elements in a band
+	template <typename jobType>
+	GLM_FUNC_QUALIFIER void wide_run(jobType const & Job, std::size_t count, int threads, std::size_t minPerThread)
+	{
+#		if GLM_WIDE_THREADS
+			// (asked once: it reads the system's cpu list on every call, which costs as much as a few thousand elements)
+			static int const HardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+			if(threads <= 0)
+				threads = HardwareThreads;
+			std::size_t const MaxThreads = count / (minPerThread > 0 ? minPerThread : 1);
+			if(static_cast<std::size_t>(threads) > MaxThreads)
+				threads = static_cast<int>(MaxThreads);
+
+			if(threads > 1)
+			{
+				std::size_t const Threads = static_cast<std::size_t>(threads);
+				std::vector<std::thread> Workers;
+				for(std::size_t i = 1; i < Threads; ++i)
+					Workers.push_back(std::thread(Job, i * count / Threads, (i + 1) * count / Threads));
+				Job(0, count / Threads);
+				for(std::size_t i = 0; i < Workers.size(); ++i)
+					Workers[i].join();
+				return;
+			}
+#		else
+			(void)threads;
+			(void)minPerThread;
+#		endif
+
+		Job(0, count);
+	}
+}//namespace detail
+}//namespace glm
@@ -4,8 +4,36 @@
 #include "glm/ext.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/type_ptr.hpp"
+#include <algorithm>
 #define NVIDIA_SHADER_BINARY	0x00008e21		// nvidia binary enum
 
+#ifndef WIN32
+#include <GL/glx.h>
+#endif
+
+#ifdef WIN32
+#include <direct.h>
+#define MAKE_DIRECTORY(d)	_mkdir(d)
+#else
+#include <sys/stat.h>
+#define MAKE_DIRECTORY(d)	mkdir(d, 0755)
+#endif
+
+// where linked program binaries are kept between runs:
+
+#define BINARY_CACHE_DIR	"shadercache"
+#define BINARY_CACHE_MAGIC	0x42504c47		// "GLPB"
+#define BINARY_CACHE_VERSION	1
+
+struct GLbinarycacheheader
+{
+	unsigned int		Magic;
+	unsigned int		Version;
+	unsigned long long	Key;
+	GLenum			Format;
+	GLint			Length;
+};
+
 struct GLshadertype
 {
 	char* extension;
@@ -36,9 +64,48 @@ BinaryTypes[] =
 
 extern GLchar* Gstap;		// set later
 
+
+// return how many characters at the start of a shader source are the #version
+// and #extension lines, which must stay ahead of anything we insert:
+
+static
+int
+GetPreambleLength(const char* src, int* numLines)
+{
+	int length = 0;
+	int lines = 0;
+	const char* p = src;
+	while (*p != '\0')
+	{
+		const char* eol = strchr(p, '\n');
+		const char* next = (eol == NULL) ? p + strlen(p) : eol + 1;
+
+		const char* q = p;
+		while (*q == ' ' || *q == '\t' || *q == '\r')
+			q++;
+
+		bool keep = (*q == '\n' || *q == '\0')
+			|| strncmp(q, "//", 2) == 0
+			|| strncmp(q, "#version", 8) == 0
+			|| strncmp(q, "#extension", 10) == 0;
+		if (!keep)
+			break;
+
+		p = next;
+		lines++;
+		if (strncmp(q, "#version", 8) == 0 || strncmp(q, "#extension", 10) == 0)
+		{
+			length = (int)(p - src);
+			*numLines = lines;
+		}
+	}
+	return length;
+}
+
+
 static
-char*
-GetExtension(char* file)
+const char*
+GetExtension(const char* file)
 {
 	int n = (int)strlen(file) - 1;	// index of last non-null character
 
@@ -60,6 +127,12 @@ GetExtension(char* file)
 GLSLProgram::GLSLProgram()
 {
 	Verbose = false;
+	IncludeFrameUniforms = true;
+	UseBinaryCache = true;
+	Pending = false;
+	PendingFromCache = false;
+	PendingKey = 0;
+	ActivePass = -1;
 	InputTopology = GL_TRIANGLES;
 	OutputTopology = GL_TRIANGLE_STRIP;
 
@@ -70,6 +143,8 @@ GLSLProgram::GLSLProgram()
 	CanDoGeometryShaders = IsExtensionSupported("GL_EXT_geometry_shader4");
 	CanDoFragmentShaders = IsExtensionSupported("GL_ARB_fragment_shader");
 	CanDoBinaryFiles = IsExtensionSupported("GL_ARB_get_program_binary");
+	CanDoProgramInterfaceQuery = IsExtensionSupported("GL_ARB_program_interface_query");
+	CanDoProgramUniforms = IsExtensionSupported("GL_ARB_separate_shader_objects");
 
 	fprintf(stderr, "Can do: ");
 	if (CanDoComputeShaders)		fprintf(stderr, "compute shaders, ");
@@ -78,8 +153,28 @@ GLSLProgram::GLSLProgram()
 	if (CanDoTessEvaluationShaders)	fprintf(stderr, "tess evaluation shaders, ");
 	if (CanDoGeometryShaders)		fprintf(stderr, "geometry shaders, ");
 	if (CanDoFragmentShaders)		fprintf(stderr, "fragment shaders, ");
-	if (CanDoBinaryFiles)			fprintf(stderr, "binary shader files ");
+	if (CanDoBinaryFiles)			fprintf(stderr, "binary shader files, ");
+	if (CanDoProgramUniforms)		fprintf(stderr, "program uniforms ");
 	fprintf(stderr, "\n");
+
+	// let the driver compile on as many threads as it likes (only needs to be done once):
+
+	if (!ParallelCompileChecked)
+	{
+		ParallelCompileChecked = true;
+		typedef void (GLAPIENTRY *MaxShaderCompilerThreadsProc)(GLuint);
+		MaxShaderCompilerThreadsProc maxThreads = NULL;
+		if (IsExtensionSupported("GL_KHR_parallel_shader_compile"))
+			maxThreads = (MaxShaderCompilerThreadsProc)GetGLProcAddress("glMaxShaderCompilerThreadsKHR");
+		else if (IsExtensionSupported("GL_ARB_parallel_shader_compile"))
+			maxThreads = (MaxShaderCompilerThreadsProc)GetGLProcAddress("glMaxShaderCompilerThreadsARB");
+		if (maxThreads != NULL)
+		{
+			maxThreads(0xffffffff);		// "as many as the implementation wants"
+			CanDoParallelCompile = true;
+			fprintf(stderr, "Can do: parallel shader compiles\n");
+		}
+	}
 }
 
 
@@ -89,26 +184,122 @@ GLSLProgram::GLSLProgram()
 //	which I know to supply but I'm worried users won't
 
 bool
-GLSLProgram::Create(char* file0, char* file1, char* file2, char* file3, char* file4, char* file5)
+GLSLProgram::Create(const char* file0, const char* file1, const char* file2, const char* file3, const char* file4, const char* file5)
+{
+	CreateHelper(file0, file1, file2, file3, file4, file5, NULL);
+	return Finish();
+}
+
+
+// this issues all of the compiling and linking, but doesn't wait for any of it --
+// do other startup work, then call Finish( ) (or poll IsReady( ) first)
+// the return value only says whether everything could be issued
+
+bool
+GLSLProgram::CreateAsync(const char* file0, const char* file1, const char* file2, const char* file3, const char* file4, const char* file5)
 {
 	return CreateHelper(file0, file1, file2, file3, file4, file5, NULL);
 }
 
 
+// true if Finish( ) would not have to wait
+// (without parallel shader compiles, the driver only compiles when asked for the results,
+// so there is nothing to be gained by waiting)
+
+bool
+GLSLProgram::IsReady()
+{
+	if (!Pending || PendingFromCache || !CanDoParallelCompile)
+		return true;
+
+	GLint done = GL_FALSE;
+	glGetProgramiv(this->Program, GL_COMPLETION_STATUS_KHR, &done);
+	return done != GL_FALSE;
+}
+
+
+// check the results of everything that CreateAsync( ) issued:
+
+bool
+GLSLProgram::Finish()
+{
+	if (!Pending)
+		return Valid;
+	Pending = false;
+
+	if (PendingFromCache)
+	{
+		if (Verbose)
+			fprintf(stderr, "Shader Program loaded from the binary cache.\n");
+		FinishLink();
+		return Valid;
+	}
+
+	for (int i = 0; i < (int)PendingShaders.size(); i++)
+	{
+		if (!CheckCompile(PendingShaders[i], PendingFiles[i].c_str(), PendingSourceMaps[i]))
+			Valid = false;
+	}
+	PendingShaders.clear();
+	PendingFiles.clear();
+	PendingSourceMaps.clear();
+
+	GLchar* infoLog;
+	GLint infoLogLen;
+	GLint linkStatus;
+	glGetProgramiv(this->Program, GL_LINK_STATUS, &linkStatus);
+	CheckGlErrors("Link Shader 2");
+
+	if (linkStatus == 0)
+	{
+		glGetProgramiv(this->Program, GL_INFO_LOG_LENGTH, &infoLogLen);
+		fprintf(stderr, "Failed to link program -- Info Log Length = %d\n", infoLogLen);
+		if (infoLogLen > 0)
+		{
+			infoLog = new GLchar[infoLogLen + 1];
+			glGetProgramInfoLog(this->Program, infoLogLen, NULL, infoLog);
+			infoLog[infoLogLen] = '\0';
+			fprintf(stderr, "Info Log:\n%s\n", infoLog);
+			delete[] infoLog;
+
+		}
+		glDeleteProgram(Program);
+		Valid = false;
+	}
+	else
+	{
+		if (Verbose)
+			fprintf(stderr, "Shader Program linked.\n");
+
+		FinishLink();
+
+		if (Valid && PendingKey != 0)
+			SaveCachedBinary(PendingKey);
+	}
+
+	return Valid;
+}
+
+
 // this is the varargs version of the Create method
 
 bool
-GLSLProgram::CreateHelper(char* file0, ...)
+GLSLProgram::CreateHelper(const char* file0, ...)
 {
-	GLsizei n = 0;
-	GLchar* buf;
 	Valid = true;
 
 	IncludeGstap = false;
 	Cshader = Vshader = TCshader = TEshader = Gshader = Fshader = 0;
 	Program = 0;
 	AttributeLocs.clear();
-	UniformLocs.clear();
+	Uniforms.clear();
+	UniformIndex.clear();
+	Pending = true;
+	PendingFromCache = false;
+	PendingKey = 0;
+	PendingShaders.clear();
+	PendingFiles.clear();
+	PendingSourceMaps.clear();
 
 	if (Program == 0)
 	{
@@ -124,21 +315,31 @@ GLSLProgram::CreateHelper(char* file0, ...)
 	// I am depending on the caller passing in a NULL as the final argument.
 	// If they don't, bad things will happen.
 
-	char* file = file0;
+	// first, read all of the shader sources, so that we know what we are building
+	// before we ask the driver to do anything:
+
+	std::vector<const char*> files;
+	std::vector<GLenum> types;
+	std::vector<std::string> sources;
+	std::vector<std::string> sourceMaps;
+
+	const char* file = file0;
 	int type;
 	while (file != NULL)
 	{
 		int maxBinaryTypes = sizeof(BinaryTypes) / sizeof(struct GLbinarytype);
 		type = -1;
-		char* extension = GetExtension(file);
+		const char* extension = GetExtension(file);
 		// fprintf( stderr, "File = '%s', extension = '%s'\n", file, extension );
 
+		bool isBinary = false;
 		for (int i = 0; i < maxBinaryTypes; i++)
 		{
-			if (strcmp(extension, BinaryTypes[i].extension) == 0)
+			if (extension != NULL && strcmp(extension, BinaryTypes[i].extension) == 0)
 			{
 				// fprintf( stderr, "Legal extension = '%s'\n", extension );
 				LoadProgramBinary(file, BinaryTypes[i].format);
+				isBinary = true;
 				break;
 			}
 		}
@@ -146,7 +347,7 @@ GLSLProgram::CreateHelper(char* file0, ...)
 		int maxShaderTypes = sizeof(ShaderTypes) / sizeof(struct GLshadertype);
 		for (int i = 0; i < maxShaderTypes; i++)
 		{
-			if (strcmp(extension, ShaderTypes[i].extension) == 0)
+			if (extension != NULL && strcmp(extension, ShaderTypes[i].extension) == 0)
 			{
 				// fprintf( stderr, "Legal extension = '%s'\n", extension );
 				type = i;
@@ -154,9 +355,8 @@ GLSLProgram::CreateHelper(char* file0, ...)
 			}
 		}
 
-		GLuint shader;
-		bool SkipToNextVararg = false;
-		if (type < 0)
+		bool SkipToNextVararg = isBinary;
+		if (type < 0 && !isBinary)
 		{
 			fprintf(stderr, "Unknown filename extension: '%s'\n", extension);
 			fprintf(stderr, "Legal Extensions are: ");
@@ -176,306 +376,460 @@ GLSLProgram::CreateHelper(char* file0, ...)
 			SkipToNextVararg = true;
 		}
 
-		if (!SkipToNextVararg)
+		if (!SkipToNextVararg && !CanDoShaderType(ShaderTypes[type].name))
 		{
-			switch (ShaderTypes[type].name)
-			{
-			case GL_COMPUTE_SHADER:
-				if (!CanDoComputeShaders)
-				{
-					fprintf(stderr, "Warning: this system cannot handle compute shaders\n");
-					Valid = false;
-					SkipToNextVararg = true;
-				}
-				else
-				{
-					shader = glCreateShader(GL_COMPUTE_SHADER);
-				}
-				break;
-
-			case GL_VERTEX_SHADER:
-				if (!CanDoVertexShaders)
-				{
-					fprintf(stderr, "Warning: this system cannot handle vertex shaders\n");
-					Valid = false;
-					SkipToNextVararg = true;
-				}
-				else
-				{
-					shader = glCreateShader(GL_VERTEX_SHADER);
-				}
-				break;
-
-			case GL_TESS_CONTROL_SHADER:
-				if (!CanDoTessControlShaders)
-				{
-					fprintf(stderr, "Warning: this system cannot handle tessellation control shaders\n");
-					Valid = false;
-					SkipToNextVararg = true;
-				}
-				else
-				{
-					shader = glCreateShader(GL_TESS_CONTROL_SHADER);
-				}
-				break;
-
-			case GL_TESS_EVALUATION_SHADER:
-				if (!CanDoTessEvaluationShaders)
-				{
-					fprintf(stderr, "Warning: this system cannot handle tessellation evaluation shaders\n");
-					Valid = false;
-					SkipToNextVararg = true;
-				}
-				else
-				{
-					shader = glCreateShader(GL_TESS_EVALUATION_SHADER);
-				}
-				break;
-
-			case GL_GEOMETRY_SHADER:
-				if (!CanDoGeometryShaders)
-				{
-					fprintf(stderr, "Warning: this system cannot handle geometry shaders\n");
-					Valid = false;
-					SkipToNextVararg = true;
-				}
-				else
-				{
-					//glProgramParameteriEXT( Program, GL_GEOMETRY_INPUT_TYPE_EXT,  InputTopology );
-					//glProgramParameteriEXT( Program, GL_GEOMETRY_OUTPUT_TYPE_EXT, OutputTopology );
-					//glProgramParameteriEXT( Program, GL_GEOMETRY_VERTICES_OUT_EXT, 1024 );
-					shader = glCreateShader(GL_GEOMETRY_SHADER);
-				}
-				break;
-
-			case GL_FRAGMENT_SHADER:
-				if (!CanDoFragmentShaders)
-				{
-					fprintf(stderr, "Warning: this system cannot handle fragment shaders\n");
-					Valid = false;
-					SkipToNextVararg = true;
-				}
-				else
-				{
-					shader = glCreateShader(GL_FRAGMENT_SHADER);
-				}
-				break;
-			}
+			Valid = false;
+			SkipToNextVararg = true;
 		}
 
-
-		// read the shader source into a buffer:
+		// read the shader source into a string:
 
 		if (!SkipToNextVararg)
 		{
-			FILE* in;
-			int length;
-			FILE* logfile;
-
-			in = fopen(file, "rb");
-			if (in == NULL)
+			std::string source;
+			std::string sourceMap;
+			if (!ReadShaderSource(file, source, sourceMap))
 			{
-				fprintf(stderr, "Cannot open shader file '%s'\n", file);
 				Valid = false;
-				SkipToNextVararg = true;
 			}
-
-			if (!SkipToNextVararg)
+			else
 			{
-				fseek(in, 0, SEEK_END);
-				length = ftell(in);
-				fseek(in, 0, SEEK_SET);		// rewind
-
-				buf = new GLchar[length + 1];
-				fread(buf, sizeof(GLchar), length, in);
-				buf[length] = '\0';
-				fclose(in);
-
-				GLchar* strings[2];
-				int n = 0;
-
-				if (IncludeGstap)
-				{
-					strings[n] = Gstap;
-					n++;
-				}
-
-				strings[n] = buf;
-				n++;
+				files.push_back(file);
+				types.push_back(ShaderTypes[type].name);
+				sources.push_back(source);
+				sourceMaps.push_back(sourceMap);
+			}
+		}
 
-				// Tell GL about the source:
+		// go to the next vararg file:
 
-				glShaderSource(shader, n, (const GLchar**)strings, NULL);
-				delete[] buf;
-				CheckGlErrors("Shader Source");
+		file = va_arg(args, const char*);
+	}
 
-				// compile:
+	va_end(args);
 
-				glCompileShader(shader);
-				GLint infoLogLen;
-				GLint compileStatus;
-				CheckGlErrors("CompileShader:");
-				glGetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
+	Name.clear();
+	for (int i = 0; i < (int)files.size(); i++)
+	{
+		if (i > 0)
+			Name += "+";
+		Name += files[i];
+	}
 
-				if (compileStatus == 0)
-				{
-					fprintf(stderr, "Shader '%s' did not compile.\n", file);
-					glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLen);
-					if (infoLogLen > 0)
-					{
-						GLchar* infoLog = new GLchar[infoLogLen + 1];
-						glGetShaderInfoLog(shader, infoLogLen, NULL, infoLog);
-						infoLog[infoLogLen] = '\0';
-						logfile = fopen("glsllog.txt", "w");
-						if (logfile != NULL)
-						{
-							fprintf(logfile, "\n%s\n", infoLog);
-							fclose(logfile);
-						}
-						fprintf(stderr, "\n%s\n", infoLog);
-						delete[] infoLog;
-					}
-					glDeleteShader(shader);
-					Valid = false;
-				}
-				else
-				{
-					if (Verbose)
-						fprintf(stderr, "Shader '%s' compiled.\n", file);
+	// if this exact program has been linked by this exact driver before,
+	// just hand the driver back its own binary:
 
-					glAttachShader(this->Program, shader);
-				}
-			}
+	if (CanDoBinaryFiles && UseBinaryCache && sources.size() > 0)
+	{
+		PendingKey = GetCacheKey(types, sources);
+		if (LoadCachedBinary(PendingKey))
+		{
+			PendingFromCache = true;
+			return Valid;
 		}
+	}
 
+	// otherwise, start every compile, and the link, without asking how any of them went
+	// (asking would make us wait for them):
 
-
-		// go to the next vararg file:
-
-		file = va_arg(args, char*);
+	for (int i = 0; i < (int)sources.size(); i++)
+	{
+		GLuint shader = glCreateShader(types[i]);
+		CompileShader(shader, sources[i]);
+		glAttachShader(this->Program, shader);
+		PendingShaders.push_back(shader);
+		PendingFiles.push_back(std::string(files[i]));
+		PendingSourceMaps.push_back(sourceMaps[i]);
 	}
 
-	va_end(args);
+	// the binary can only be retrieved if we ask for that before linking:
 
-	// link the entire shader program:
+	if (CanDoBinaryFiles)
+		glProgramParameteri(this->Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
 	glLinkProgram(Program);
 	CheckGlErrors("Link Shader 1");
 
-	GLchar* infoLog;
-	GLint infoLogLen;
-	GLint linkStatus;
-	glGetProgramiv(this->Program, GL_LINK_STATUS, &linkStatus);
-	CheckGlErrors("Link Shader 2");
+	return Valid;
+}
 
-	if (linkStatus == 0)
+
+// return whether this system can build a given type of shader:
+
+bool
+GLSLProgram::CanDoShaderType(GLenum type)
+{
+	switch (type)
 	{
-		glGetProgramiv(this->Program, GL_INFO_LOG_LENGTH, &infoLogLen);
-		fprintf(stderr, "Failed to link program -- Info Log Length = %d\n", infoLogLen);
-		if (infoLogLen > 0)
+	case GL_COMPUTE_SHADER:
+		if (!CanDoComputeShaders)
 		{
-			infoLog = new GLchar[infoLogLen + 1];
-			glGetProgramInfoLog(this->Program, infoLogLen, NULL, infoLog);
-			infoLog[infoLogLen] = '\0';
-			fprintf(stderr, "Info Log:\n%s\n", infoLog);
-			delete[] infoLog;
-
+			fprintf(stderr, "Warning: this system cannot handle compute shaders\n");
+			return false;
 		}
-		glDeleteProgram(Program);
-		Valid = false;
-	}
-	else
-	{
-		if (Verbose)
-			fprintf(stderr, "Shader Program linked.\n");
-		// validate the program:
+		break;
 
-		GLint status;
-		glValidateProgram(Program);
-		glGetProgramiv(Program, GL_VALIDATE_STATUS, &status);
-		if (status == GL_FALSE)
+	case GL_VERTEX_SHADER:
+		if (!CanDoVertexShaders)
 		{
-			fprintf(stderr, "Program is invalid.\n");
-			Valid = false;
+			fprintf(stderr, "Warning: this system cannot handle vertex shaders\n");
+			return false;
 		}
-		else
+		break;
+
+	case GL_TESS_CONTROL_SHADER:
+		if (!CanDoTessControlShaders)
 		{
-			if (Verbose)
-				fprintf(stderr, "Shader Program validated.\n");
+			fprintf(stderr, "Warning: this system cannot handle tessellation control shaders\n");
+			return false;
 		}
-	}
+		break;
 
-	return Valid;
-}
+	case GL_TESS_EVALUATION_SHADER:
+		if (!CanDoTessEvaluationShaders)
+		{
+			fprintf(stderr, "Warning: this system cannot handle tessellation evaluation shaders\n");
+			return false;
+		}
+		break;
 
+	case GL_GEOMETRY_SHADER:
+		if (!CanDoGeometryShaders)
+		{
+			fprintf(stderr, "Warning: this system cannot handle geometry shaders\n");
+			return false;
+		}
+		//glProgramParameteriEXT( Program, GL_GEOMETRY_INPUT_TYPE_EXT,  InputTopology );
+		//glProgramParameteriEXT( Program, GL_GEOMETRY_OUTPUT_TYPE_EXT, OutputTopology );
+		//glProgramParameteriEXT( Program, GL_GEOMETRY_VERTICES_OUT_EXT, 1024 );
+		break;
 
-void
-GLSLProgram::DispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z)
-{
-	Use();
-	glDispatchCompute(num_groups_x, num_groups_y, num_groups_z);
+	case GL_FRAGMENT_SHADER:
+		if (!CanDoFragmentShaders)
+		{
+			fprintf(stderr, "Warning: this system cannot handle fragment shaders\n");
+			return false;
+		}
+		break;
+	}
+	return true;
 }
 
 
-bool
-GLSLProgram::IsValid()
-{
-	return Valid;
-}
-
+// read a whole text file into a string:
 
+static
 bool
-GLSLProgram::IsNotValid()
+ReadTextFile(const char* file, std::string& text)
 {
-	return !Valid;
-}
+	FILE* in = fopen(file, "rb");
+	if (in == NULL)
+		return false;
 
+	fseek(in, 0, SEEK_END);
+	int length = ftell(in);
+	fseek(in, 0, SEEK_SET);		// rewind
 
-void
-GLSLProgram::SetVerbose(bool v)
-{
-	Verbose = v;
+	text.resize(length);
+	if (length > 0)
+		fread(&text[0], sizeof(char), length, in);
+	fclose(in);
+	return true;
 }
 
 
-void
-GLSLProgram::Use()
-{
-	Use(this->Program);
-};
+// replace each #include "file" line with that file's contents
+// (each file is only pulled in once, and #line directives keep the error messages
+// pointing at the right file: the second number in each #line is that file's
+// index in the included list)
 
+#define MAX_INCLUDE_DEPTH	16
 
-void
-GLSLProgram::Use(GLuint p)
+bool
+GLSLProgram::ExpandIncludes(const char* file, const char* text, std::string& out, std::vector<std::string>& included, int depth)
 {
-	if (p != CurrentProgram)
+	int fileIndex = -1;
+	for (int i = 0; i < (int)included.size(); i++)
 	{
-		glUseProgram(p);
-		CurrentProgram = p;
+		if (included[i] == file)
+			fileIndex = i;
 	}
-};
-
-
-void
-GLSLProgram::UseFixedFunction()
-{
-	this->Use(0);
-};
 
+	// included files are looked for next to the file that includes them:
 
-int
-GLSLProgram::GetAttributeLocation(char* name)
-{
-	std::map<char*, int>::iterator pos;
+	std::string directory(file);
+	size_t slash = directory.find_last_of("/\\");
+	directory = (slash == std::string::npos) ? "" : directory.substr(0, slash + 1);
 
-	pos = AttributeLocs.find(name);
-	if (pos == AttributeLocs.end())
+	int lineNumber = 0;
+	const char* p = text;
+	while (*p != '\0')
 	{
-		AttributeLocs[name] = glGetAttribLocation(this->Program, name);
-	}
+		const char* eol = strchr(p, '\n');
+		const char* next = (eol == NULL) ? p + strlen(p) : eol + 1;
+		lineNumber++;
 
-	return AttributeLocs[name];
-};
+		const char* q = p;
+		while (*q == ' ' || *q == '\t')
+			q++;
+
+		if (strncmp(q, "#include", 8) != 0)
+		{
+			out.append(p, next - p);
+			p = next;
+			continue;
+		}
+
+		const char* open = strchr(q, '"');
+		const char* close = (open == NULL) ? NULL : strchr(open + 1, '"');
+		if (close == NULL || close > next)
+		{
+			fprintf(stderr, "%s(%d): badly formed #include\n", file, lineNumber);
+			return false;
+		}
+		std::string includeFile = directory + std::string(open + 1, close - open - 1);
+
+		bool already = false;
+		for (int i = 0; i < (int)included.size(); i++)
+		{
+			if (included[i] == includeFile)
+				already = true;
+		}
+
+		if (!already)
+		{
+			if (depth >= MAX_INCLUDE_DEPTH)
+			{
+				fprintf(stderr, "%s(%d): #includes are nested too deeply\n", file, lineNumber);
+				return false;
+			}
+
+			std::string includeText;
+			if (!ReadTextFile(includeFile.c_str(), includeText))
+			{
+				fprintf(stderr, "%s(%d): cannot open #include file '%s'\n", file, lineNumber, includeFile.c_str());
+				return false;
+			}
+			included.push_back(includeFile);
+
+			char lineDirective[32];
+			sprintf(lineDirective, "#line 1 %d\n", (int)included.size() - 1);
+			out += lineDirective;
+			if (!ExpandIncludes(includeFile.c_str(), includeText.c_str(), out, included, depth + 1))
+				return false;
+			sprintf(lineDirective, "\n#line %d %d\n", lineNumber + 1, fileIndex);
+			out += lineDirective;
+		}
+		else
+		{
+			out += "\n";		// keep the line count right
+		}
+
+		p = next;
+	}
+	return true;
+}
+
+
+// read a shader file and put together the source that will actually be compiled:
+
+bool
+GLSLProgram::ReadShaderSource(const char* file, std::string& source, std::string& sourceMap)
+{
+	std::string text;
+	if (!ReadTextFile(file, text))
+	{
+		fprintf(stderr, "Cannot open shader file '%s'\n", file);
+		return false;
+	}
+	const char* buf = text.c_str();
+
+	// anything we add goes after the #version and #extension lines,
+	// followed by a #line so that error messages match the file:
+
+	int preambleLines = 0;
+	int preambleLength = GetPreambleLength(buf, &preambleLines);
+	char lineDirective[32];
+	sprintf(lineDirective, "\n#line %d 0\n", preambleLines + 1);
+
+	source.assign(buf, preambleLength);
+	source += Defines.Text();
+	if (IncludeGstap)
+		source += Gstap;
+	if (IncludeFrameUniforms)
+		source += FrameUniformsGlsl;
+	source += lineDirective;
+
+	std::vector<std::string> included;
+	included.push_back(std::string(file));
+	if (!ExpandIncludes(file, buf + preambleLength, source, included, 0))
+		return false;
+
+	sourceMap.clear();
+	if (included.size() > 1)
+	{
+		for (int i = 0; i < (int)included.size(); i++)
+		{
+			char entry[16];
+			sprintf(entry, "%s%d = ", i == 0 ? "" : ", ", i);
+			sourceMap += entry;
+			sourceMap += included[i];
+		}
+	}
+	return true;
+}
+
+
+// hand one shader's source to the driver and start it compiling:
+
+void
+GLSLProgram::CompileShader(GLuint shader, const std::string& source)
+{
+	const GLchar* strings[1] = { source.c_str() };
+
+	// Tell GL about the source:
+
+	glShaderSource(shader, 1, strings, NULL);
+	CheckGlErrors("Shader Source");
+
+	// compile:
+
+	glCompileShader(shader);
+	CheckGlErrors("CompileShader:");
+}
+
+
+// returns false (and prints the info log) if a shader did not compile:
+
+bool
+GLSLProgram::CheckCompile(GLuint shader, const char* file, const std::string& sourceMap)
+{
+	GLint infoLogLen;
+	GLint compileStatus;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &compileStatus);
+
+	if (compileStatus == 0)
+	{
+		fprintf(stderr, "Shader '%s' did not compile.\n", file);
+		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infoLogLen);
+		if (infoLogLen > 0)
+		{
+			GLchar* infoLog = new GLchar[infoLogLen + 1];
+			glGetShaderInfoLog(shader, infoLogLen, NULL, infoLog);
+			infoLog[infoLogLen] = '\0';
+			FILE* logfile = fopen("glsllog.txt", "w");
+			if (logfile != NULL)
+			{
+				fprintf(logfile, "\n%s\n", infoLog);
+				fclose(logfile);
+			}
+			fprintf(stderr, "\n%s\n", infoLog);
+			if (!sourceMap.empty())
+				fprintf(stderr, "Source strings: %s\n", sourceMap.c_str());
+			delete[] infoLog;
+		}
+		glDetachShader(this->Program, shader);
+		glDeleteShader(shader);
+		return false;
+	}
+
+	if (Verbose)
+		fprintf(stderr, "Shader '%s' compiled.\n", file);
+	return true;
+}
+
+
+// everything that has to happen once the program has linked, however it got linked:
+
+void
+GLSLProgram::FinishLink()
+{
+	// build the uniform table once, so that setting uniforms never has to ask GL:
+
+	ReflectUniforms();
+	BindFrameUniforms();
+
+	// validate the program:
+
+	GLint status;
+	glValidateProgram(Program);
+	glGetProgramiv(Program, GL_VALIDATE_STATUS, &status);
+	if (status == GL_FALSE)
+	{
+		fprintf(stderr, "Program is invalid.\n");
+		Valid = false;
+	}
+	else
+	{
+		if (Verbose)
+			fprintf(stderr, "Shader Program validated.\n");
+	}
+}
+
+
+void
+GLSLProgram::DispatchCompute(GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z)
+{
+	Use();
+	glDispatchCompute(num_groups_x, num_groups_y, num_groups_z);
+}
+
+
+bool
+GLSLProgram::IsValid()
+{
+	return Valid;
+}
+
+
+bool
+GLSLProgram::IsNotValid()
+{
+	return !Valid;
+}
+
+
+void
+GLSLProgram::SetVerbose(bool v)
+{
+	Verbose = v;
+}
+
+
+void
+GLSLProgram::Use()
+{
+	Use(this->Program);
+};
+
+
+void
+GLSLProgram::Use(GLuint p)
+{
+	GLState::UseProgram(p);
+};
+
+
+void
+GLSLProgram::UseFixedFunction()
+{
+	this->Use(0);
+};
+
+
+int
+GLSLProgram::GetAttributeLocation(char* name)
+{
+	std::map<char*, int>::iterator pos;
+
+	pos = AttributeLocs.find(name);
+	if (pos == AttributeLocs.end())
+	{
+		AttributeLocs[name] = glGetAttribLocation(this->Program, name);
+	}
+
+	return AttributeLocs[name];
+};
 
 
 #ifdef NOT_SUPPORTED
@@ -558,107 +912,244 @@ GLSLProgram::SetAttributeVariable(char* name, VertexBufferObject& vb, GLenum whi
 
 
 	int
-		GLSLProgram::GetUniformLocation(char* name)
+		GLSLProgram::GetUniformLocation(const char* name)
 	{
-		std::map<char*, int>::iterator pos;
+		// the uniform table is keyed by the name's contents, not by the pointer,
+		// so the same name coming from a different buffer still finds its entry:
 
-		pos = UniformLocs.find(name);
-		//if( Verbose )
-			//fprintf( stderr, "Uniform: pos = 0x%016x ; size = %d ; end = 0x%016x\n", pos, UniformLocs.size(), UniformLocs.end() );
-		if (pos == UniformLocs.end())
+		std::unordered_map<std::string, int>::const_iterator it = UniformIndex.find(name);
+		if (it != UniformIndex.end())
 		{
-			GLuint loc = glGetUniformLocation(this->Program, name);
-			UniformLocs[name] = loc;
 			if (Verbose)
-				fprintf(stderr, "Location of '%s' in Program %d = %d\n", name, this->Program, loc);
+				fprintf(stderr, "Location of '%s' in Program %d = %d\n", name, this->Program, Uniforms[it->second].Location);
+			return Uniforms[it->second].Location;
+		}
+
+		if (Verbose)
+			fprintf(stderr, "Location of uniform variable '%s' is -1\n", name);
+		return -1;
+	};
+
+
+	// look up a uniform once, so that it can be set later without any name lookups:
+
+	GLSLUniform
+		GLSLProgram::GetUniform(const char* name)
+	{
+		std::unordered_map<std::string, int>::const_iterator it = UniformIndex.find(name);
+		if (it != UniformIndex.end())
+			return Uniforms[it->second];
+
+		if (Verbose)
+			fprintf(stderr, "Uniform variable '%s' is not active in Program %d\n", name, this->Program);
+		return GLSLUniform();
+	};
+
+
+	// fill the flat uniform table from the linked program
+	// (uniforms that live in uniform blocks have no location and are skipped):
+
+	void
+		GLSLProgram::ReflectUniforms()
+	{
+		Uniforms.clear();
+		UniformIndex.clear();
+
+		GLint numUniforms = 0;
+		GLint maxNameLength = 0;
+		if (CanDoProgramInterfaceQuery)
+		{
+			glGetProgramInterfaceiv(this->Program, GL_UNIFORM, GL_ACTIVE_RESOURCES, &numUniforms);
+			glGetProgramInterfaceiv(this->Program, GL_UNIFORM, GL_MAX_NAME_LENGTH, &maxNameLength);
 		}
 		else
 		{
-			if (Verbose)
+			glGetProgramiv(this->Program, GL_ACTIVE_UNIFORMS, &numUniforms);
+			glGetProgramiv(this->Program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxNameLength);
+		}
+		if (numUniforms <= 0)
+			return;
+
+		GLchar* name = new GLchar[maxNameLength + 1];
+		Uniforms.reserve(numUniforms);
+		UniformIndex.reserve(numUniforms);
+
+		for (int i = 0; i < numUniforms; i++)
+		{
+			GLSLUniform u;
+			if (CanDoProgramInterfaceQuery)
+			{
+				const GLenum props[3] = { GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION };
+				GLint values[3];
+				glGetProgramResourceiv(this->Program, GL_UNIFORM, i, 3, props, 3, NULL, values);
+				glGetProgramResourceName(this->Program, GL_UNIFORM, i, maxNameLength + 1, NULL, name);
+				u.Type = (GLenum)values[0];
+				u.Size = values[1];
+				u.Location = values[2];
+			}
+			else
 			{
-				fprintf(stderr, "Location = %d\n", UniformLocs[name]);
-				if (UniformLocs[name] == -1)
-					fprintf(stderr, "Location of uniform variable '%s' is -1\n", name);
+				glGetActiveUniform(this->Program, i, maxNameLength + 1, NULL, &u.Size, &u.Type, name);
+				u.Location = glGetUniformLocation(this->Program, name);
 			}
+
+			if (u.Location < 0)
+				continue;
+
+			// arrays are reported as "name[0]" -- let them be found as "name" too:
+
+			char* bracket = strstr(name, "[0]");
+			if (bracket != NULL)
+				*bracket = '\0';
+
+			if (Verbose)
+				fprintf(stderr, "Uniform '%s' in Program %d: location = %d, type = 0x%04x, size = %d\n",
+					name, this->Program, u.Location, u.Type, u.Size);
+
+			UniformIndex[std::string(name)] = (int)Uniforms.size();
+			Uniforms.push_back(u);
 		}
 
-		return UniformLocs[name];
+		delete[] name;
+		CheckGlErrors("ReflectUniforms");
 	};
 
 
+	// the name versions find the uniform's handle and set it the way the handle versions do:
+
 	void
-		GLSLProgram::SetUniformVariable(char* name, int val)
+	GLSLProgram::SetUniformVariable(const char* name, int val)
 	{
-		int loc;
-		if ((loc = GetUniformLocation(name)) >= 0)
+		SetUniformVariable(GetUniform(name), val);
+	};
+
+	void
+	GLSLProgram::SetUniformVariable(const char* name, float val)
+	{
+		SetUniformVariable(GetUniform(name), val);
+	};
+
+	void
+	GLSLProgram::SetUniformVariable(const char* name, float val0, float val1, float val2)
+	{
+		SetUniformVariable(GetUniform(name), val0, val1, val2);
+	};
+
+	void
+	GLSLProgram::SetUniformVariable(const char* name, const float vals[3])
+	{
+		SetUniformVariable(GetUniform(name), vals);
+	};
+
+	void
+	GLSLProgram::SetUniformVariable(const char* name, const glm::mat4& matrix)
+	{
+		SetUniformVariable(GetUniform(name), matrix);
+	};
+
+	void
+	GLSLProgram::SetUniformVariable(const char* name, const glm::vec3& vec)
+	{
+		SetUniformVariable(GetUniform(name), vec);
+	};
+
+
+	// the handle versions go straight to the program object when they can,
+	// so they don't have to switch the current program:
+
+	void
+	GLSLProgram::SetUniformVariable(const GLSLUniform& u, int val)
+	{
+		if (u.Location < 0)
+			return;
+
+		if (CanDoProgramUniforms)
+			glProgramUniform1i(this->Program, u.Location, val);
+		else
 		{
 			this->Use();
-			glUniform1i(loc, val);
+			glUniform1i(u.Location, val);
 		}
 	};
 
-
 	void
-		GLSLProgram::SetUniformVariable(char* name, float val)
+	GLSLProgram::SetUniformVariable(const GLSLUniform& u, float val)
 	{
-		int loc;
-		
-		if ((loc = GetUniformLocation(name)) >= 0)
+		if (u.Location < 0)
+			return;
+
+		if (CanDoProgramUniforms)
+			glProgramUniform1f(this->Program, u.Location, val);
+		else
 		{
 			this->Use();
-			glUniform1f(loc, val);
+			glUniform1f(u.Location, val);
 		}
 	};
 
-
 	void
-		GLSLProgram::SetUniformVariable(char* name, float val0, float val1, float val2)
+	GLSLProgram::SetUniformVariable(const GLSLUniform& u, float val0, float val1, float val2)
 	{
-		int loc;
-		if ((loc = GetUniformLocation(name)) >= 0)
+		if (u.Location < 0)
+			return;
+
+		if (CanDoProgramUniforms)
+			glProgramUniform3f(this->Program, u.Location, val0, val1, val2);
+		else
 		{
 			this->Use();
-			glUniform3f(loc, val0, val1, val2);
+			glUniform3f(u.Location, val0, val1, val2);
 		}
 	};
 
-
 	void
-		GLSLProgram::SetUniformVariable(char* name, float vals[3])
+	GLSLProgram::SetUniformVariable(const GLSLUniform& u, const float vals[3])
 	{
-		int loc;
+		if (u.Location < 0)
+			return;
 
-		if ((loc = GetUniformLocation(name)) >= 0)
+		if (CanDoProgramUniforms)
+			glProgramUniform3fv(this->Program, u.Location, 1, vals);
+		else
 		{
 			this->Use();
-			glUniform3fv(loc, 1, vals);
+			glUniform3fv(u.Location, 1, vals);
 		}
 	};
 
 	void
-	GLSLProgram::SetUniformVariable(char* name, glm::mat4& matrix)
+	GLSLProgram::SetUniformVariable(const GLSLUniform& u, const glm::mat4& matrix)
 	{
-		int loc;
+		if (u.Location < 0)
+			return;
 
-		if ((loc = GetUniformLocation(name)) >= 0)
+		if (CanDoProgramUniforms)
+			glProgramUniformMatrix4fv(this->Program, u.Location, 1, false, value_ptr(matrix));
+		else
 		{
 			this->Use();
-			//fprintf(stderr, "%s mat4\n", name);
-			//glUniformMatrix4fv(loc, 16, true, &matrix[0][0]);
-			glUniformMatrix4fv(loc, 1, false, value_ptr(matrix));
+			glUniformMatrix4fv(u.Location, 1, false, value_ptr(matrix));
 		}
 	};
 
 	void
-		GLSLProgram::SetUniformVariable(char* name, glm::vec3& vec)
+	GLSLProgram::SetUniformVariable(const GLSLUniform& u, const glm::vec3& vec)
 	{
-		int loc;
+		SetUniformVariable(u, value_ptr(vec));
+	};
 
-		if ((loc = GetUniformLocation(name)) >= 0)
+	void
+	GLSLProgram::SetUniformVariable(const GLSLUniform& u, const glm::vec4& vec)
+	{
+		if (u.Location < 0)
+			return;
+
+		if (CanDoProgramUniforms)
+			glProgramUniform4fv(this->Program, u.Location, 1, value_ptr(vec));
+		else
 		{
 			this->Use();
-			//fprintf(stderr, "%s vec3\n", name);
-			glUniform3fv(loc, 1, value_ptr(vec) );
+			glUniform4fv(u.Location, 1, value_ptr(vec));
 		}
 	};
 
@@ -725,7 +1216,24 @@ GLSLProgram::SetAttributeVariable(char* name, VertexBufferObject& vb, GLenum whi
 	}
 
 
-	int GLSLProgram::CurrentProgram = 0;
+	bool GLSLProgram::CanDoParallelCompile = false;
+	bool GLSLProgram::ParallelCompileChecked = false;
+	bool GLSLProgram::Profiling = false;
+	std::vector<GLSLProgram*> GLSLProgram::Profiled;
+	std::map<std::string, GLSLProgram*> GLSLProgram::Variants;
+
+
+	// look up an entry point that our glew.h doesn't know about:
+
+	void*
+		GetGLProcAddress(const char* name)
+	{
+#ifdef WIN32
+		return (void*)wglGetProcAddress(name);
+#else
+		return (void*)glXGetProcAddressARB((const GLubyte*)name);
+#endif
+	}
 
 
 
@@ -771,7 +1279,7 @@ GLSLProgram::SetAttributeVariable(char* name, VertexBufferObject& vb, GLenum whi
 	void
 		GLSLProgram::SaveProgramBinary(const char* fileName, GLenum * format)
 	{
-		glProgramParameteri(this->Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+		// note: the retrievable hint is set in CreateHelper( ), before linking
 		GLint length;
 		glGetProgramiv(this->Program, GL_PROGRAM_BINARY_LENGTH, &length);
 		GLubyte* buffer = new GLubyte[length];
@@ -822,6 +1330,464 @@ GLSLProgram::SetAttributeVariable(char* name, VertexBufferObject& vb, GLenum whi
 
 
 
+	void
+		GLSLProgram::SetBinaryCache(bool b)
+	{
+		UseBinaryCache = b;
+	}
+
+
+	// the cache key covers everything that could make a stored binary wrong:
+	// the exact source text of every stage (including anything we inserted)
+	// and the driver that built it
+	// (64-bit FNV-1a)
+
+	static
+	void
+		HashBytes(unsigned long long* hash, const void* data, size_t length)
+	{
+		const unsigned char* p = (const unsigned char*)data;
+		for (size_t i = 0; i < length; i++)
+		{
+			*hash ^= p[i];
+			*hash *= 0x100000001b3ULL;
+		}
+	}
+
+
+	static
+	void
+		HashString(unsigned long long* hash, const char* s)
+	{
+		if (s == NULL)
+			s = "";
+		HashBytes(hash, s, strlen(s) + 1);	// include the '\0' so "ab"+"c" != "a"+"bc"
+	}
+
+
+	unsigned long long
+		GLSLProgram::GetCacheKey(const std::vector<GLenum>& types, const std::vector<std::string>& sources)
+	{
+		unsigned long long hash = 0xcbf29ce484222325ULL;
+		HashString(&hash, (const char*)glGetString(GL_VENDOR));
+		HashString(&hash, (const char*)glGetString(GL_RENDERER));
+		HashString(&hash, (const char*)glGetString(GL_VERSION));
+		for (int i = 0; i < (int)sources.size(); i++)
+		{
+			HashBytes(&hash, &types[i], sizeof(GLenum));
+			HashString(&hash, sources[i].c_str());
+		}
+		if (hash == 0)		// 0 means "no key"
+			hash = 1;
+		return hash;
+	}
+
+
+	static
+	void
+		GetCacheFileName(unsigned long long key, char* fileName)
+	{
+		sprintf(fileName, "%s/%08x%08x.glb", BINARY_CACHE_DIR,
+			(unsigned int)(key >> 32), (unsigned int)(key & 0xffffffff));
+	}
+
+
+	// try to link the program straight from the cache
+	// (returns false if there is no entry, or if the driver will no longer accept it):
+
+	bool
+		GLSLProgram::LoadCachedBinary(unsigned long long key)
+	{
+		char fileName[64];
+		GetCacheFileName(key, fileName);
+
+		FILE* fpin = fopen(fileName, "rb");
+		if (fpin == NULL)
+			return false;
+
+		struct GLbinarycacheheader header;
+		if (fread(&header, sizeof(header), 1, fpin) != 1
+			|| header.Magic != BINARY_CACHE_MAGIC || header.Version != BINARY_CACHE_VERSION
+			|| header.Key != key || header.Length <= 0)
+		{
+			fclose(fpin);
+			return false;
+		}
+
+		GLubyte* buffer = new GLubyte[header.Length];
+		bool ok = fread(buffer, header.Length, 1, fpin) == 1;
+		fclose(fpin);
+
+		if (ok)
+		{
+			glProgramBinary(this->Program, header.Format, buffer, header.Length);
+			GLint success;
+			glGetProgramiv(this->Program, GL_LINK_STATUS, &success);
+			ok = success != 0;
+			if (!ok && Verbose)
+				fprintf(stderr, "The driver rejected cached binary '%s' -- recompiling\n", fileName);
+		}
+		delete[] buffer;
+
+		// don't leave an error from a rejected binary for the next caller to find:
+
+		while (glGetError() != GL_NO_ERROR)
+			;
+
+		return ok;
+	}
+
+
+	void
+		GLSLProgram::SaveCachedBinary(unsigned long long key)
+	{
+		GLint length = 0;
+		glGetProgramiv(this->Program, GL_PROGRAM_BINARY_LENGTH, &length);
+		if (length <= 0)
+			return;
+
+		struct GLbinarycacheheader header;
+		header.Magic = BINARY_CACHE_MAGIC;
+		header.Version = BINARY_CACHE_VERSION;
+		header.Key = key;
+		header.Length = length;
+
+		GLubyte* buffer = new GLubyte[length];
+		glGetProgramBinary(this->Program, length, NULL, &header.Format, buffer);
+		CheckGlErrors("SaveCachedBinary");
+
+		MAKE_DIRECTORY(BINARY_CACHE_DIR);		// ok if it is already there
+
+		char fileName[64];
+		GetCacheFileName(key, fileName);
+		FILE* fpout = fopen(fileName, "wb");
+		if (fpout == NULL)
+		{
+			fprintf(stderr, "Cannot create GLSL binary cache file '%s'\n", fileName);
+			delete[] buffer;
+			return;
+		}
+		fwrite(&header, sizeof(header), 1, fpout);
+		fwrite(buffer, length, 1, fpout);
+		fclose(fpout);
+		delete[] buffer;
+
+		if (Verbose)
+			fprintf(stderr, "Saved program binary '%s' (%d bytes)\n", fileName, length);
+	}
+
+
+	// the defines are written into every shader, right after its #version line
+	// (set them before calling Create):
+
+	void
+		GLSLProgram::SetDefines(const GLSLDefines& defines)
+	{
+		Defines = defines;
+	}
+
+
+	// return the program built from these files with these defines,
+	// creating it (asynchronously -- call Finish( ) on it) the first time it is asked for:
+
+	GLSLProgram*
+		GLSLProgram::Variant(const GLSLDefines& defines, const char* file0, const char* file1, const char* file2, const char* file3, const char* file4, const char* file5)
+	{
+		const char* files[6] = { file0, file1, file2, file3, file4, file5 };
+		std::string key;
+		for (int i = 0; i < 6 && files[i] != NULL; i++)
+		{
+			key += files[i];
+			key += "+";
+		}
+		key += "|" + defines.Key();
+
+		std::map<std::string, GLSLProgram*>::iterator pos = Variants.find(key);
+		if (pos != Variants.end())
+			return pos->second;
+
+		GLSLProgram* program = new GLSLProgram();
+		program->SetDefines(defines);
+		program->CreateAsync(file0, file1, file2, file3, file4, file5);
+		Variants[key] = program;
+		return program;
+	}
+
+
+	// the query target for each GLSLProfileCounter, and whether this driver can do it:
+
+	static const GLenum ProfileTargets[PROFILE_COUNTERS] =
+	{
+		GL_VERTICES_SUBMITTED_ARB,
+		GL_PRIMITIVES_SUBMITTED_ARB,
+		GL_VERTEX_SHADER_INVOCATIONS_ARB,
+		GL_CLIPPING_INPUT_PRIMITIVES_ARB,
+		GL_CLIPPING_OUTPUT_PRIMITIVES_ARB,
+		GL_FRAGMENT_SHADER_INVOCATIONS_ARB,
+		GL_COMPUTE_SHADER_INVOCATIONS_ARB,
+		GL_TIME_ELAPSED
+	};
+
+	static bool ProfileCounterOn[PROFILE_COUNTERS];
+	static bool ProfileCountersChecked = false;
+
+
+	// turn the profiler on or off for every program
+	// (while it is off, BeginProfile( ) and EndProfile( ) do nothing):
+
+	void
+		GLSLProgram::SetProfiling(bool on)
+	{
+		if (!ProfileCountersChecked)
+		{
+			ProfileCountersChecked = true;
+			bool stats = GLEW_ARB_pipeline_statistics_query != GL_FALSE;
+			bool timer = GLEW_ARB_timer_query != GL_FALSE || GLEW_VERSION_3_3 != GL_FALSE;
+			for (int c = 0; c < PROFILE_COUNTERS; c++)
+				ProfileCounterOn[c] = (c == PROFILE_TIME) ? timer : stats;
+			if (!stats)
+				fprintf(stderr, "No GL_ARB_pipeline_statistics_query -- the profile will only have times\n");
+			if (!timer)
+				fprintf(stderr, "No GL_ARB_timer_query -- the profile will only have counts\n");
+		}
+
+		Profiling = on;
+	}
+
+
+	bool
+		GLSLProgram::IsProfiling()
+	{
+		return Profiling;
+	}
+
+
+	// start counting what this program does for the named pass
+	// (call after Use( ), before the draws -- passes cannot nest, even across programs):
+
+	void
+		GLSLProgram::BeginProfile(const char* name)
+	{
+		if (!Profiling || ActivePass >= 0)
+			return;
+
+		int p;
+		for (p = 0; p < (int)ProfilePasses.size(); p++)
+		{
+			if (ProfilePasses[p].Name == name)
+				break;
+		}
+
+		if (p == (int)ProfilePasses.size())
+		{
+			GLSLProfilePass pass;
+			pass.Name = name;
+			glGenQueries(PROFILE_LATENCY * PROFILE_COUNTERS, &pass.Queries[0][0]);
+			for (int i = 0; i < PROFILE_LATENCY; i++)
+				pass.InFlight[i] = false;
+			pass.Next = 0;
+			pass.Warm = false;
+			pass.Samples = 0;
+			for (int c = 0; c < PROFILE_COUNTERS; c++)
+				pass.Totals[c] = 0.;
+			ProfilePasses.push_back(pass);
+			if (p == 0)
+				Profiled.push_back(this);
+		}
+
+		// the queries in this slot were issued PROFILE_LATENCY uses ago, so they should be done by now:
+
+		GLSLProfilePass& pass = ProfilePasses[p];
+		if (pass.InFlight[pass.Next])
+			CollectProfile(pass, pass.Next);
+
+		for (int c = 0; c < PROFILE_COUNTERS; c++)
+		{
+			if (ProfileCounterOn[c])
+				glBeginQuery(ProfileTargets[c], pass.Queries[pass.Next][c]);
+		}
+		ActivePass = p;
+	}
+
+
+	void
+		GLSLProgram::EndProfile()
+	{
+		if (ActivePass < 0)
+			return;
+
+		GLSLProfilePass& pass = ProfilePasses[ActivePass];
+		for (int c = 0; c < PROFILE_COUNTERS; c++)
+		{
+			if (ProfileCounterOn[c])
+				glEndQuery(ProfileTargets[c]);
+		}
+		pass.InFlight[pass.Next] = true;
+		pass.Next = (pass.Next + 1) % PROFILE_LATENCY;
+		ActivePass = -1;
+	}
+
+
+	// the first use of a pass also pays for the driver's lazy shader compile and state validation,
+	// so that result is read but not counted:
+
+	void
+		GLSLProgram::CollectProfile(GLSLProfilePass& pass, int slot)
+	{
+		for (int c = 0; c < PROFILE_COUNTERS; c++)
+		{
+			if (ProfileCounterOn[c])
+			{
+				GLuint64 value = 0;
+				glGetQueryObjectui64v(pass.Queries[slot][c], GL_QUERY_RESULT, &value);
+				if (pass.Warm)
+					pass.Totals[c] += (double)value;
+			}
+		}
+		pass.InFlight[slot] = false;
+		if (pass.Warm)
+			pass.Samples++;
+		pass.Warm = true;
+	}
+
+
+	// print the average counts per use of every pass of every program,
+	// most expensive pass first:
+
+	struct ProfileLine
+	{
+		GLSLProgram*		program;
+		GLSLProfilePass*	pass;
+		double			time;			// ns per use
+	};
+
+	static bool
+		MoreExpensive(const ProfileLine& a, const ProfileLine& b)
+	{
+		return a.time > b.time;
+	}
+
+	void
+		GLSLProgram::PrintProfile(FILE* fp)
+	{
+		std::vector<ProfileLine> lines;
+		for (int i = 0; i < (int)Profiled.size(); i++)
+		{
+			GLSLProgram* program = Profiled[i];
+			for (int p = 0; p < (int)program->ProfilePasses.size(); p++)
+			{
+				GLSLProfilePass& pass = program->ProfilePasses[p];
+				for (int slot = 0; slot < PROFILE_LATENCY; slot++)
+				{
+					if (pass.InFlight[slot])
+						program->CollectProfile(pass, slot);
+				}
+				if (pass.Samples == 0)
+					continue;
+
+				ProfileLine line;
+				line.program = program;
+				line.pass = &pass;
+				line.time = pass.Totals[PROFILE_TIME] / (double)pass.Samples;
+				lines.push_back(line);
+			}
+		}
+		std::sort(lines.begin(), lines.end(), MoreExpensive);
+
+		fprintf(fp, "%-16s %-28s %6s %9s %9s %9s %9s %9s %9s %10s %10s %9s %9s\n",
+			"pass", "program", "uses", "ms/use", "verts", "prims", "vs inv", "clip in", "clip out", "fs inv", "cs inv", "ns/vs", "ns/fs|cs");
+		for (int i = 0; i < (int)lines.size(); i++)
+		{
+			GLSLProfilePass& pass = *lines[i].pass;
+			double n = (double)pass.Samples;
+			double avg[PROFILE_COUNTERS];
+			for (int c = 0; c < PROFILE_COUNTERS; c++)
+				avg[c] = pass.Totals[c] / n;
+
+			// the time per invocation is charged to whichever stage does the per-pixel ( or per-item ) work:
+			double perVertex = avg[PROFILE_VS_INVOCATIONS] > 0. ? avg[PROFILE_TIME] / avg[PROFILE_VS_INVOCATIONS] : 0.;
+			double invocations = avg[PROFILE_FS_INVOCATIONS] > 0. ? avg[PROFILE_FS_INVOCATIONS] : avg[PROFILE_CS_INVOCATIONS];
+			double perInvocation = invocations > 0. ? avg[PROFILE_TIME] / invocations : 0.;
+
+			fprintf(fp, "%-16s %-28s %6d %9.3f %9.0f %9.0f %9.0f %9.0f %9.0f %10.0f %10.0f %9.3f %9.3f\n",
+				pass.Name.c_str(), lines[i].program->Name.c_str(), pass.Samples, avg[PROFILE_TIME] / 1000000.,
+				avg[PROFILE_VERTICES], avg[PROFILE_PRIMITIVES], avg[PROFILE_VS_INVOCATIONS],
+				avg[PROFILE_CLIP_IN], avg[PROFILE_CLIP_OUT], avg[PROFILE_FS_INVOCATIONS], avg[PROFILE_CS_INVOCATIONS],
+				perVertex, perInvocation);
+		}
+	}
+
+
+	// throw away everything counted so far:
+
+	void
+		GLSLProgram::ResetProfile()
+	{
+		for (int i = 0; i < (int)Profiled.size(); i++)
+		{
+			GLSLProgram* program = Profiled[i];
+			for (int p = 0; p < (int)program->ProfilePasses.size(); p++)
+			{
+				GLSLProfilePass& pass = program->ProfilePasses[p];
+				for (int slot = 0; slot < PROFILE_LATENCY; slot++)
+					pass.InFlight[slot] = false;
+				pass.Samples = 0;
+				for (int c = 0; c < PROFILE_COUNTERS; c++)
+					pass.Totals[c] = 0.;
+			}
+		}
+	}
+
+
+	GLSLDefines&
+		GLSLDefines::Require(const char* extension)
+	{
+		Extensions.insert(std::string(extension));
+		return *this;
+	}
+
+
+	GLSLDefines&
+		GLSLDefines::Set(const char* name, const char* value)
+	{
+		Values[std::string(name)] = std::string(value);
+		return *this;
+	}
+
+
+	GLSLDefines&
+		GLSLDefines::Set(const char* name, int value)
+	{
+		char text[16];
+		sprintf(text, "%d", value);
+		return Set(name, text);
+	}
+
+
+	std::string
+		GLSLDefines::Key() const
+	{
+		std::string key;
+		for (std::set<std::string>::const_iterator it = Extensions.begin(); it != Extensions.end(); ++it)
+			key += "+" + *it + ";";
+		for (std::map<std::string, std::string>::const_iterator it = Values.begin(); it != Values.end(); ++it)
+			key += it->first + "=" + it->second + ";";
+		return key;
+	}
+
+
+	std::string
+		GLSLDefines::Text() const
+	{
+		std::string text;
+		for (std::set<std::string>::const_iterator it = Extensions.begin(); it != Extensions.end(); ++it)
+			text += "#extension " + *it + " : require\n";
+		for (std::map<std::string, std::string>::const_iterator it = Values.begin(); it != Values.end(); ++it)
+			text += "#define " + it->first + " " + it->second + "\n";
+		return text;
+	}
+
+
 	void
 		GLSLProgram::SetGstap(bool b)
 	{
@@ -829,6 +1795,42 @@ GLSLProgram::SetAttributeVariable(char* name, VertexBufferObject& vb, GLenum whi
 	}
 
 
+	void
+		GLSLProgram::SetFrameUniforms(bool b)
+	{
+		IncludeFrameUniforms = b;
+	}
+
+
+	// point this program's FrameUniforms block at the shared binding
+	// (the block is inactive, and has no index, if no shader stage reads it):
+
+	void
+		GLSLProgram::BindFrameUniforms()
+	{
+		if (!IncludeFrameUniforms)
+			return;
+
+		GLuint blockIndex = glGetUniformBlockIndex(this->Program, "FrameUniforms");
+		if (blockIndex != GL_INVALID_INDEX)
+			glUniformBlockBinding(this->Program, blockIndex, FRAME_UNIFORMS_BINDING);
+		CheckGlErrors("BindFrameUniforms");
+	}
+
+
+	// point a uniform block of this program at a binding point
+	// (a block the program doesn't have is skipped, so one call can go to every program):
+
+	void
+		GLSLProgram::BindUniformBlock(const char* name, GLuint binding)
+	{
+		GLuint blockIndex = glGetUniformBlockIndex(this->Program, name);
+		if (blockIndex != GL_INVALID_INDEX)
+			glUniformBlockBinding(this->Program, blockIndex, binding);
+		CheckGlErrors("BindUniformBlock");
+	}
+
+
 	const char *tmp =
 	{
 	"#ifndef GSTAP_H\n\
@@ -15,13 +15,29 @@
 #include <GL/glu.h>
 #include "glut.h"
 #include "glm/glm.hpp"
+#include "frameuniforms.h"
+#include "glstate.h"
 #include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <stdarg.h>
 
 #ifndef GL_COMPUTE_SHADER
 #define GL_COMPUTE_SHADER	0x91B9
 #endif
 
+// GL_KHR_parallel_shader_compile / GL_ARB_parallel_shader_compile are newer than our glew.h:
+// (the KHR and ARB versions use the same enum values)
+
+#ifndef GL_MAX_SHADER_COMPILER_THREADS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR	0x91B0
+#endif
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR		0x91B1
+#endif
+
 
 inline int GetOSU(int flag)
 {
@@ -32,7 +48,74 @@ inline int GetOSU(int flag)
 
 
 void	CheckGlErrors(const char*);
+void *	GetGLProcAddress(const char*);
+
+
+// a uniform handle is looked up once by name (after the program is linked)
+// and then used to set the uniform with no lookups, allocations, or glUseProgram( ) calls:
+
+struct GLSLUniform
+{
+	GLint	Location;		// -1 means "not in this program" -- setting it is a no-op
+	GLenum	Type;			// GL_FLOAT, GL_FLOAT_VEC3, GL_SAMPLER_2D, ...
+	GLint	Size;			// > 1 for arrays
 
+	GLSLUniform() : Location(-1), Type(GL_NONE), Size(0) { }
+};
+
+
+
+// a set of preprocessor defines that picks out one variant of a shader program
+// (kept sorted by name, so the same set always gives the same key)
+// and the extensions it needs, which go in as #extension lines ahead of the defines:
+
+class GLSLDefines
+{
+public:
+	std::map<std::string, std::string>	Values;
+	std::set<std::string>			Extensions;
+
+	GLSLDefines&	Require(const char*);
+	GLSLDefines&	Set(const char*, const char* = "1");
+	GLSLDefines&	Set(const char*, int);
+	std::string	Key() const;
+	std::string	Text() const;
+};
+
+
+// the profiler wraps each pass in one query of each of these kinds
+// (the pipeline statistics need GL_ARB_pipeline_statistics_query, the time needs GL_ARB_timer_query):
+
+enum GLSLProfileCounter
+{
+	PROFILE_VERTICES,		// GL_VERTICES_SUBMITTED_ARB
+	PROFILE_PRIMITIVES,		// GL_PRIMITIVES_SUBMITTED_ARB
+	PROFILE_VS_INVOCATIONS,		// GL_VERTEX_SHADER_INVOCATIONS_ARB
+	PROFILE_CLIP_IN,		// GL_CLIPPING_INPUT_PRIMITIVES_ARB
+	PROFILE_CLIP_OUT,		// GL_CLIPPING_OUTPUT_PRIMITIVES_ARB
+	PROFILE_FS_INVOCATIONS,		// GL_FRAGMENT_SHADER_INVOCATIONS_ARB
+	PROFILE_CS_INVOCATIONS,		// GL_COMPUTE_SHADER_INVOCATIONS_ARB
+	PROFILE_TIME,			// GL_TIME_ELAPSED, in nanoseconds
+	PROFILE_COUNTERS
+};
+
+// queries are read back this many uses later, so reading them never stalls the pipeline:
+
+#define PROFILE_LATENCY		4
+
+
+// the counters for one pass ( one BeginProfile( )/EndProfile( ) name ) of one program:
+
+struct GLSLProfilePass
+{
+	std::string	Name;
+	GLuint		Queries[PROFILE_LATENCY][PROFILE_COUNTERS];
+	bool		InFlight[PROFILE_LATENCY];
+	int		Next;			// which set of queries the next BeginProfile( ) uses
+	bool		Warm;			// false until the first result has been thrown away
+	int		Samples;		// how many results have been added into Totals
+	double		Totals[PROFILE_COUNTERS];
+};
 
 
 class GLSLProgram
@@ -45,7 +128,21 @@ private:
 	unsigned int		Fshader;
 	char* Gfile;
 	GLuint			Gshader;
+	bool			IncludeFrameUniforms;
 	bool			IncludeGstap;
+	bool			UseBinaryCache;
+
+	// a program that has been issued but not yet checked:
+	bool			Pending;
+	bool			PendingFromCache;
+	unsigned long long	PendingKey;
+	std::vector<GLuint>	PendingShaders;
+	std::vector<std::string>	PendingFiles;
+	std::vector<std::string>	PendingSourceMaps;	// which #line source number is which file
+	std::string		Name;			// the shader files, for the profile printout
+	std::vector<GLSLProfilePass>	ProfilePasses;
+	int			ActivePass;		// index into ProfilePasses, or -1
+	GLSLDefines		Defines;
 	GLenum			InputTopology;
 	GLenum			OutputTopology;
 	GLuint			Program;
@@ -53,33 +150,58 @@ private:
 	GLuint			TCshader;
 	char* TEfile;
 	GLuint			TEshader;
-	std::map<char*, int>	UniformLocs;
+	std::vector<GLSLUniform>	Uniforms;	// reflected from the linked program
+	std::unordered_map<std::string, int>	UniformIndex;	// name -> index into Uniforms
 	bool			Valid;
 	char* Vfile;
 	GLuint			Vshader;
 	bool			Verbose;
 
-	static int		CurrentProgram;
+	static bool		CanDoParallelCompile;
+	static bool		ParallelCompileChecked;
+	static std::map<std::string, GLSLProgram*>	Variants;
+	static bool		Profiling;
+	static std::vector<GLSLProgram*>	Profiled;	// programs that have at least one pass
 
 	void	AttachShader(GLuint);
 	bool	CanDoBinaryFiles;
+	bool	CanDoProgramInterfaceQuery;
+	bool	CanDoProgramUniforms;
 	bool	CanDoComputeShaders;
 	bool	CanDoFragmentShaders;
 	bool	CanDoGeometryShaders;
 	bool	CanDoTessControlShaders;
 	bool	CanDoTessEvaluationShaders;
 	bool	CanDoVertexShaders;
-	int	CompileShader(GLuint);
-	bool	CreateHelper(char*, ...);
+	bool	CanDoShaderType(GLenum);
+	bool	CheckCompile(GLuint, const char*, const std::string&);
+	bool	ExpandIncludes(const char*, const char*, std::string&, std::vector<std::string>&, int);
+	void	CompileShader(GLuint, const std::string&);
+	bool	CreateHelper(const char*, ...);
+	void	FinishLink();
+	unsigned long long	GetCacheKey(const std::vector<GLenum>&, const std::vector<std::string>&);
+	bool	LoadCachedBinary(unsigned long long);
+	bool	ReadShaderSource(const char*, std::string&, std::string&);
+	void	SaveCachedBinary(unsigned long long);
 	int	GetAttributeLocation(char*);
-	int	GetUniformLocation(char*);
+	int	GetUniformLocation(const char*);
+	void	BindFrameUniforms();
+	void	ReflectUniforms();
+	void	CollectProfile(GLSLProfilePass&, int);
 
 
 public:
 	GLSLProgram();
 
-	bool	Create(char*, char* = NULL, char* = NULL, char* = NULL, char* = NULL, char* = NULL);
+	bool	Create(const char*, const char* = NULL, const char* = NULL, const char* = NULL, const char* = NULL, const char* = NULL);
+	bool	CreateAsync(const char*, const char* = NULL, const char* = NULL, const char* = NULL, const char* = NULL, const char* = NULL);
+	bool	Finish();
+	void	BeginProfile(const char*);
+	void	BindUniformBlock(const char*, GLuint);
+	void	EndProfile();
+	bool	IsReady();
 	void	DispatchCompute(GLuint, GLuint = 1, GLuint = 1);
+	GLSLUniform	GetUniform(const char*);
 	bool	IsExtensionSupported(const char*);
 	bool	IsNotValid();
 	bool	IsValid();
@@ -87,6 +209,8 @@ public:
 	void	LoadProgramBinary(const char*, GLenum);
 	void	SaveBinaryFile(char*);
 	void	SaveProgramBinary(const char*, GLenum*);
+	void	SetDefines(const GLSLDefines&);
+	void	SetBinaryCache(bool);
 	void	SetAttributeVariable(char*, int);
 	void	SetAttributeVariable(char*, float);
 	void	SetAttributeVariable(char*, float, float, float);
@@ -100,20 +224,35 @@ public:
 #ifdef VERTEX_BUFFER_OBJECT_H
 	void	SetAttributeVariable(char*, VertexBufferObject&, GLenum);
 #endif
+	void	SetFrameUniforms(bool);
 	void	SetGstap(bool);
 	void	SetInputTopology(GLenum);
 	void	SetOutputTopology(GLenum);
-	void	SetUniformVariable(char*, int);
-	void	SetUniformVariable(char*, float);
-	void	SetUniformVariable(char*, float, float, float);
-	void	SetUniformVariable(char*, float[3]);
-	void	SetUniformVariable(char*, glm::mat4 &);
-	void	SetUniformVariable(char*, glm::vec3 &);
+	// by name: a hash lookup on each call, so keep these to startup and use GetUniform( ) handles per frame
+	void	SetUniformVariable(const char*, int);
+	void	SetUniformVariable(const char*, float);
+	void	SetUniformVariable(const char*, float, float, float);
+	void	SetUniformVariable(const char*, const float[3]);
+	void	SetUniformVariable(const char*, const glm::mat4&);
+	void	SetUniformVariable(const char*, const glm::vec3&);
+	void	SetUniformVariable(const GLSLUniform&, int);
+	void	SetUniformVariable(const GLSLUniform&, float);
+	void	SetUniformVariable(const GLSLUniform&, float, float, float);
+	void	SetUniformVariable(const GLSLUniform&, const float[3]);
+	void	SetUniformVariable(const GLSLUniform&, const glm::mat4&);
+	void	SetUniformVariable(const GLSLUniform&, const glm::vec3&);
+	void	SetUniformVariable(const GLSLUniform&, const glm::vec4&);
 
 	void	SetVerbose(bool);
 	void	Use();
 	void	Use(GLuint);
 	void	UseFixedFunction();
+
+	static void		PrintProfile(FILE*);
+	static void		ResetProfile();
+	static void		SetProfiling(bool);
+	static bool		IsProfiling();
+	static GLSLProgram*	Variant(const GLSLDefines&, const char*, const char* = NULL, const char* = NULL, const char* = NULL, const char* = NULL, const char* = NULL);
 };
 
 #endif		// #ifndef GLSLPROGRAM_H
\ No newline at end of file
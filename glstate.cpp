@@ -0,0 +1,332 @@
+#include "glstate.h"
+
+
+std::map<GLenum, GLuint>	GLState::Caps;
+std::map<GLenum, GLuint>	GLState::ClientStates;
+std::map<GLenum, GLuint>	GLState::Buffers;
+std::map<GLuint, GLuint>	GLState::IndexedBuffers;
+std::map<GLuint, GLuint>	GLState::Textures;
+std::map<GLenum, GLuint>	GLState::Values;
+GLint				GLState::View[4];
+bool				GLState::ViewKnown = false;
+
+int				GLState::Issued = 0;
+int				GLState::Filtered = 0;
+int				GLState::Frames = 0;
+double				GLState::TotalIssued = 0.;
+double				GLState::TotalFiltered = 0.;
+bool				GLState::Verbose = false;
+int				GLState::LastIssued = 0;
+int				GLState::LastFiltered = 0;
+
+// glActiveTexture's current unit lives in Values under this name:
+
+#define ACTIVE_UNIT	GL_ACTIVE_TEXTURE
+
+
+// returns true (and remembers the new value) if the state needs to be sent to the driver:
+
+bool
+GLState::Changed( std::map<GLenum, GLuint>& shadow, GLenum name, GLuint value )
+{
+	std::map<GLenum, GLuint>::iterator pos = shadow.find( name );
+	if( pos != shadow.end( )  &&  pos->second == value )
+	{
+		Filtered++;
+		return false;
+	}
+	shadow[name] = value;
+	Issued++;
+	return true;
+}
+
+
+// what a single value is set to now -- asked of the driver only if nothing here has set it since the last Invalidate( ):
+
+GLuint
+GLState::Current( GLenum name )
+{
+	std::map<GLenum, GLuint>::iterator pos = Values.find( name );
+	if( pos != Values.end( ) )
+		return pos->second;
+
+	GLint value = 0;
+	glGetIntegerv( name, &value );
+	Values[name] = (GLuint)value;
+	return (GLuint)value;
+}
+
+
+void
+GLState::ActiveTexture( GLenum unit )
+{
+	if( Changed( Values, ACTIVE_UNIT, unit ) )
+		glActiveTexture( unit );
+}
+
+
+void
+GLState::BindBuffer( GLenum target, GLuint buffer )
+{
+	if( Changed( Buffers, target, buffer ) )
+		glBindBuffer( target, buffer );
+}
+
+
+// these also change the generic binding point for target:
+
+void
+GLState::BindBufferBase( GLenum target, GLuint index, GLuint buffer )
+{
+	if( Changed( IndexedBuffers, ( target << 8 ) | index, buffer ) )
+	{
+		glBindBufferBase( target, index, buffer );
+		Buffers[target] = buffer;
+	}
+}
+
+
+// a range binding always goes out, since the offset is usually what's changing:
+
+void
+GLState::BindBufferRange( GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size )
+{
+	glBindBufferRange( target, index, buffer, offset, size );
+	Buffers[target] = buffer;
+	IndexedBuffers.erase( ( target << 8 ) | index );
+	Issued++;
+}
+
+
+// bind texture to target on the given unit ( GL_TEXTURE0, GL_TEXTURE1, ... ),
+// only changing the active unit if the binding itself has to change:
+
+void
+GLState::BindTexture( GLenum unit, GLenum target, GLuint texture )
+{
+	GLuint key = ( ( unit - GL_TEXTURE0 ) << 16 ) | target;
+	std::map<GLuint, GLuint>::iterator pos = Textures.find( key );
+	if( pos != Textures.end( )  &&  pos->second == texture )
+	{
+		Filtered++;
+		return;
+	}
+	Textures[key] = texture;
+	ActiveTexture( unit );
+	glBindTexture( target, texture );
+	Issued++;
+}
+
+
+void
+GLState::BlendFunc( GLenum src, GLenum dst )
+{
+	BlendFuncSeparate( src, dst, src, dst );
+}
+
+
+// (counted as one call, however many of the four factors changed)
+
+void
+GLState::BlendFuncSeparate( GLenum srcRgb, GLenum dstRgb, GLenum srcAlpha, GLenum dstAlpha )
+{
+	int changed = 0;
+	changed += Changed( Values, GL_BLEND_SRC_RGB, srcRgb ) ? 1 : 0;
+	changed += Changed( Values, GL_BLEND_DST_RGB, dstRgb ) ? 1 : 0;
+	changed += Changed( Values, GL_BLEND_SRC_ALPHA, srcAlpha ) ? 1 : 0;
+	changed += Changed( Values, GL_BLEND_DST_ALPHA, dstAlpha ) ? 1 : 0;
+
+	if( changed == 0 )
+	{
+		Filtered -= 3;
+		return;
+	}
+
+	if( srcRgb == srcAlpha  &&  dstRgb == dstAlpha )
+		glBlendFunc( srcRgb, dstRgb );
+	else
+		glBlendFuncSeparate( srcRgb, dstRgb, srcAlpha, dstAlpha );
+	Issued -= changed - 1;
+	Filtered -= 4 - changed;
+}
+
+
+void
+GLState::DepthMask( GLboolean mask )
+{
+	if( Changed( Values, GL_DEPTH_WRITEMASK, mask ) )
+		glDepthMask( mask );
+}
+
+
+void
+GLState::Disable( GLenum cap )
+{
+	SetCap( cap, false );
+}
+
+
+void
+GLState::DisableClientState( GLenum array )
+{
+	SetClientState( array, false );
+}
+
+
+void
+GLState::Enable( GLenum cap )
+{
+	SetCap( cap, true );
+}
+
+
+void
+GLState::EnableClientState( GLenum array )
+{
+	SetClientState( array, true );
+}
+
+
+// call once per frame, after the swap:
+
+void
+GLState::EndFrame( )
+{
+	LastIssued = Issued;
+	LastFiltered = Filtered;
+	TotalIssued += Issued;
+	TotalFiltered += Filtered;
+	Frames++;
+	Issued = Filtered = 0;
+
+	if( Verbose )
+		PrintStats( stderr );
+}
+
+
+// so a pass can put back the blending it found:
+
+void
+GLState::GetBlendFuncSeparate( GLenum *srcRgb, GLenum *dstRgb, GLenum *srcAlpha, GLenum *dstAlpha )
+{
+	*srcRgb = Current( GL_BLEND_SRC_RGB );
+	*dstRgb = Current( GL_BLEND_DST_RGB );
+	*srcAlpha = Current( GL_BLEND_SRC_ALPHA );
+	*dstAlpha = Current( GL_BLEND_DST_ALPHA );
+}
+
+
+// forget everything -- the next call of each kind will go to the driver:
+
+void
+GLState::Invalidate( )
+{
+	Caps.clear( );
+	ClientStates.clear( );
+	Buffers.clear( );
+	IndexedBuffers.clear( );
+	Textures.clear( );
+	Values.clear( );
+	ViewKnown = false;
+}
+
+
+bool
+GLState::IsEnabled( GLenum cap )
+{
+	std::map<GLenum, GLuint>::iterator pos = Caps.find( cap );
+	if( pos != Caps.end( ) )
+		return pos->second != 0;
+
+	bool on = glIsEnabled( cap ) != GL_FALSE;
+	Caps[cap] = on ? 1 : 0;
+	return on;
+}
+
+
+void
+GLState::PrimitiveRestartIndex( GLuint index )
+{
+	if( Changed( Values, GL_PRIMITIVE_RESTART_INDEX, index ) )
+		glPrimitiveRestartIndex( index );
+}
+
+
+void
+GLState::PrintStats( FILE *fp )
+{
+	int total = LastIssued + LastFiltered;
+	fprintf( fp, "GL state: %4d issued, %4d filtered (%5.1f%%) last frame",
+		LastIssued, LastFiltered, total > 0 ? 100. * (double)LastFiltered / (double)total : 0. );
+	if( Frames > 0 )
+		fprintf( fp, "; %7.1f issued, %7.1f filtered per frame over %d frames",
+			TotalIssued / (double)Frames, TotalFiltered / (double)Frames, Frames );
+	fprintf( fp, "\n" );
+}
+
+
+void
+GLState::SetCap( GLenum cap, bool on )
+{
+	if( Changed( Caps, cap, on ? 1 : 0 ) )
+	{
+		if( on )
+			glEnable( cap );
+		else
+			glDisable( cap );
+	}
+}
+
+
+void
+GLState::SetClientState( GLenum array, bool on )
+{
+	if( Changed( ClientStates, array, on ? 1 : 0 ) )
+	{
+		if( on )
+			glEnableClientState( array );
+		else
+			glDisableClientState( array );
+	}
+}
+
+
+void
+GLState::SetVerbose( bool v )
+{
+	Verbose = v;
+}
+
+
+void
+GLState::ShadeModel( GLenum mode )
+{
+	if( Changed( Values, GL_SHADE_MODEL, mode ) )
+		glShadeModel( mode );
+}
+
+
+void
+GLState::UseProgram( GLuint program )
+{
+	if( Changed( Values, GL_CURRENT_PROGRAM, program ) )
+		glUseProgram( program );
+}
+
+
+void
+GLState::Viewport( GLint x, GLint y, GLsizei width, GLsizei height )
+{
+	if( ViewKnown  &&  View[0] == x  &&  View[1] == y  &&  View[2] == width  &&  View[3] == height )
+	{
+		Filtered++;
+		return;
+	}
+	View[0] = x;
+	View[1] = y;
+	View[2] = width;
+	View[3] = height;
+	ViewKnown = true;
+	glViewport( x, y, width, height );
+	Issued++;
+}
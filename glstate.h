@@ -0,0 +1,77 @@
+#ifndef GL_STATE_H
+#define GL_STATE_H
+
+#include <stdio.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "glew.h"
+#include <GL/gl.h>
+
+#include <map>
+
+
+// a shadow copy of the gl state that Display( ), VertexBufferObject::Draw( ),
+// and GLSLProgram::Use( ) change every frame
+//
+// each call compares against the last value that went through here, and only
+// calls into the driver if something actually changed
+// anything that has not gone through here yet is "unknown", so the first call always goes out
+//
+// code that changes one of these states behind our back must call GLState::Invalidate( )
+
+class GLState
+{
+    private:
+	static std::map<GLenum, GLuint>		Caps;		// glEnable/glDisable, keyed by cap
+	static std::map<GLenum, GLuint>		ClientStates;	// glEnableClientState/glDisableClientState
+	static std::map<GLenum, GLuint>		Buffers;	// glBindBuffer, keyed by target
+	static std::map<GLuint, GLuint>		IndexedBuffers;	// glBindBufferBase, keyed by (target<<8) | index
+	static std::map<GLuint, GLuint>		Textures;	// glBindTexture, keyed by (unit<<16) | target
+	static std::map<GLenum, GLuint>		Values;		// single-valued state, keyed by its glGet name
+	static GLint		View[4];
+	static bool		ViewKnown;
+
+	static int		Issued;		// this frame
+	static int		Filtered;	// this frame
+	static int		Frames;
+	static double		TotalIssued;
+	static double		TotalFiltered;
+	static bool		Verbose;
+
+	static bool		Changed( std::map<GLenum, GLuint>&, GLenum, GLuint );
+	static GLuint		Current( GLenum );
+
+    public:
+	static int		LastIssued;	// counts for the most recently finished frame
+	static int		LastFiltered;
+
+	static void	ActiveTexture( GLenum );
+	static void	BindBuffer( GLenum, GLuint );
+	static void	BindBufferBase( GLenum, GLuint, GLuint );
+	static void	BindBufferRange( GLenum, GLuint, GLuint, GLintptr, GLsizeiptr );
+	static void	BindTexture( GLenum, GLenum, GLuint );
+	static void	BlendFunc( GLenum, GLenum );
+	static void	BlendFuncSeparate( GLenum, GLenum, GLenum, GLenum );
+	static void	DepthMask( GLboolean );
+	static void	Disable( GLenum );
+	static void	DisableClientState( GLenum );
+	static void	Enable( GLenum );
+	static void	EnableClientState( GLenum );
+	static void	EndFrame( );
+	static void	GetBlendFuncSeparate( GLenum *, GLenum *, GLenum *, GLenum * );
+	static void	Invalidate( );
+	static bool	IsEnabled( GLenum );
+	static void	PrimitiveRestartIndex( GLuint );
+	static void	PrintStats( FILE * );
+	static void	SetCap( GLenum, bool );
+	static void	SetClientState( GLenum, bool );
+	static void	SetVerbose( bool );
+	static void	ShadeModel( GLenum );
+	static void	UseProgram( GLuint );
+	static void	Viewport( GLint, GLint, GLsizei, GLsizei );
+};
+
+#endif		// #ifndef GL_STATE_H
@@ -0,0 +1,357 @@
+#include "inputrecorder.h"
+
+#include <string.h>
+#include <algorithm>
+
+
+// what each Event is:
+#define EVENT_TICKS		0		// a frame started, and ran X ticks
+#define EVENT_KEY		1
+#define EVENT_BUTTON		2
+#define EVENT_MOTION		3
+#define EVENT_RESHAPE		4
+
+#define ESCAPE_KEY		0x1b
+
+
+InputRecorder *		InputRecorder::Active = NULL;
+
+
+InputRecorder::InputRecorder( )
+{
+	Mode = NONE;
+	Fp = NULL;
+	Next = 0;
+	Scheduler = NULL;
+	Keyboard = NULL;
+	Mouse = NULL;
+	Motion = NULL;
+	Reshape = NULL;
+	Verbose = false;
+	Frames = 0;
+	LastFrame = ReplayStart = 0.;
+}
+
+
+InputRecorder::~InputRecorder( )
+{
+	Close( );
+	if( Active == this )
+		Active = NULL;
+}
+
+
+int
+InputRecorder::BeginFrameCB( int ticks )
+{
+	return Active != NULL ? Active->FrameBegin( ticks ) : ticks;
+}
+
+
+// stop recording (the file is complete) or replaying (and print how it went):
+// (call before exiting)
+
+void
+InputRecorder::Close( )
+{
+	if( Mode == RECORDING )
+	{
+		fclose( Fp );
+		Fp = NULL;
+		fprintf( stderr, "InputRecorder: recorded %d frames\n", Frames );
+	}
+	else if( Mode == REPLAYING )
+	{
+		fprintf( stderr, "InputRecorder: the replay stopped after %d frames\n", Frames );
+		PrintStats( stderr );
+	}
+	Mode = NONE;
+}
+
+
+// a frame is starting, and the clock says to run ticks ticks -- returns how many it should run:
+
+int
+InputRecorder::FrameBegin( int ticks )
+{
+	if( Mode == RECORDING )
+	{
+		Write( EVENT_TICKS, 0, 0, ticks, 0 );
+		Frames++;
+		return ticks;
+	}
+
+	if( Mode != REPLAYING )
+		return ticks;
+
+	double now = FrameScheduler::Now( );
+	if( Frames > 0 )
+		FrameTimes.push_back( now - LastFrame );
+	LastFrame = now;
+
+	// feed in everything that came in before this frame did:
+	// (a recorded quit exits from in here, and that is fine -- Close( ) reports the replay)
+	for( ; Next < Events.size( )  &&  Events[Next].Type != EVENT_TICKS; Next++ )
+	{
+		Event &e = Events[Next];
+		if( Verbose )
+			fprintf( stderr, "InputRecorder: frame %d: replaying event %d (%d, %d, %d, %d)\n", Frames, e.Type, e.Code, e.State, e.X, e.Y );
+		switch( e.Type )
+		{
+			case EVENT_KEY:
+				if( Keyboard != NULL )
+					( *Keyboard )( e.Code, e.X, e.Y );
+				break;
+
+			case EVENT_BUTTON:
+				if( Mouse != NULL )
+					( *Mouse )( e.Code, e.State, e.X, e.Y );
+				break;
+
+			case EVENT_MOTION:
+				if( Motion != NULL )
+					( *Motion )( e.X, e.Y );
+				break;
+
+			case EVENT_RESHAPE:
+				glutReshapeWindow( e.X, e.Y );
+				break;
+		}
+	}
+
+	if( Next >= Events.size( ) )
+	{
+		fprintf( stderr, "InputRecorder: the replay is done -- the input is live again\n" );
+		PrintStats( stderr );
+		Mode = NONE;
+		return ticks;
+	}
+
+	int recorded = Events[Next++].X;
+	Frames++;
+	return recorded;
+}
+
+
+// install the recorder between glut and these callbacks, and between the scheduler and the clock:
+// (call once the window is open, before Record( ) or Replay( ))
+
+void
+InputRecorder::Install( FrameScheduler *scheduler, RecordedKeyboardFunc keyboard, RecordedMouseFunc mouse,
+			RecordedMotionFunc motion, RecordedReshapeFunc reshape )
+{
+	Scheduler = scheduler;
+	Keyboard = keyboard;
+	Mouse = mouse;
+	Motion = motion;
+	Reshape = reshape;
+	Active = this;
+
+	glutKeyboardFunc( InputRecorder::KeyboardCB );
+	glutMouseFunc( InputRecorder::MouseCB );
+	glutMotionFunc( InputRecorder::MotionCB );
+	glutReshapeFunc( InputRecorder::ReshapeCB );
+	if( Scheduler != NULL )
+		Scheduler->SetFrameBegin( InputRecorder::BeginFrameCB );
+}
+
+
+bool
+InputRecorder::IsRecording( )
+{
+	return Mode == RECORDING;
+}
+
+
+bool
+InputRecorder::IsReplaying( )
+{
+	return Mode == REPLAYING;
+}
+
+
+void
+InputRecorder::KeyboardCB( unsigned char c, int x, int y )
+{
+	InputRecorder *r = Active;
+	if( r == NULL  ||  r->Keyboard == NULL )
+		return;
+
+	if( r->Mode == REPLAYING  &&  c != ESCAPE_KEY )
+		return;
+	if( r->Mode == RECORDING )
+		r->Write( EVENT_KEY, c, 0, x, y );
+	( *r->Keyboard )( c, x, y );
+}
+
+
+void
+InputRecorder::MotionCB( int x, int y )
+{
+	InputRecorder *r = Active;
+	if( r == NULL  ||  r->Motion == NULL  ||  r->Mode == REPLAYING )
+		return;
+
+	if( r->Mode == RECORDING )
+		r->Write( EVENT_MOTION, 0, 0, x, y );
+	( *r->Motion )( x, y );
+}
+
+
+void
+InputRecorder::MouseCB( int button, int state, int x, int y )
+{
+	InputRecorder *r = Active;
+	if( r == NULL  ||  r->Mouse == NULL  ||  r->Mode == REPLAYING )
+		return;
+
+	if( r->Mode == RECORDING )
+		r->Write( EVENT_BUTTON, button, state, x, y );
+	( *r->Mouse )( button, state, x, y );
+}
+
+
+// print how long the replayed frames took:
+// (the times are from the start of one frame to the start of the next, so they include any pacing --
+// turn that off with 'v' while recording to time the frames themselves)
+
+void
+InputRecorder::PrintStats( FILE *fp )
+{
+	if( FrameTimes.empty( ) )
+	{
+		fprintf( fp, "Replay: no frames\n" );
+		return;
+	}
+
+	std::vector<double> sorted( FrameTimes );
+	std::sort( sorted.begin( ), sorted.end( ) );
+	int n = (int)sorted.size( );
+	double sum = 0.;
+	for( int i = 0; i < n; i++ )
+		sum += sorted[i];
+
+	fprintf( fp, "Replay: %d frames in %.2f s -- frame ms: %6.2f mean, %6.2f median, %6.2f 99th percentile, %6.2f worst\n",
+		Frames, FrameScheduler::Now( ) - ReplayStart,
+		1000. * sum / (double)n, 1000. * sorted[n/2], 1000. * sorted[std::min( n-1, (int)( 0.99 * n ) )], 1000. * sorted[n-1] );
+}
+
+
+// start writing the input to a file -- returns false if it cannot be opened:
+
+bool
+InputRecorder::Record( const char *file )
+{
+	Close( );
+
+	Fp = fopen( file, "wb" );
+	if( Fp == NULL )
+	{
+		fprintf( stderr, "InputRecorder: cannot create '%s'\n", file );
+		return false;
+	}
+
+	Header h;
+	memcpy( h.Magic, INPUT_RECORD_MAGIC, 4 );
+	h.Version = INPUT_RECORD_VERSION;
+	h.TickSeconds = Scheduler != NULL ? Scheduler->GetTickSeconds( ) : 0.;
+	h.Width = glutGet( GLUT_WINDOW_WIDTH );
+	h.Height = glutGet( GLUT_WINDOW_HEIGHT );
+	fwrite( &h, sizeof(Header), 1, Fp );
+
+	Mode = RECORDING;
+	Frames = 0;
+	fprintf( stderr, "InputRecorder: recording to '%s'\n", file );
+	return true;
+}
+
+
+// start playing back a file that Record( ) wrote -- returns false if it cannot be read:
+
+bool
+InputRecorder::Replay( const char *file )
+{
+	Close( );
+
+	FILE *fp = fopen( file, "rb" );
+	if( fp == NULL )
+	{
+		fprintf( stderr, "InputRecorder: cannot open '%s'\n", file );
+		return false;
+	}
+
+	Header h;
+	if( fread( &h, sizeof(Header), 1, fp ) != 1  ||  memcmp( h.Magic, INPUT_RECORD_MAGIC, 4 ) != 0  ||  h.Version != INPUT_RECORD_VERSION )
+	{
+		fprintf( stderr, "InputRecorder: '%s' is not a version %d input recording\n", file, INPUT_RECORD_VERSION );
+		fclose( fp );
+		return false;
+	}
+
+	Events.clear( );
+	Event e;
+	int frames = 0;
+	while( fread( &e, sizeof(Event), 1, fp ) == 1 )
+	{
+		Events.push_back( e );
+		if( e.Type == EVENT_TICKS )
+			frames++;
+	}
+	fclose( fp );
+
+	if( Scheduler != NULL  &&  h.TickSeconds != Scheduler->GetTickSeconds( ) )
+		fprintf( stderr, "InputRecorder: '%s' was recorded at %.1f ticks per second, not %.1f -- the animation will run at a different speed\n",
+			file, 1. / h.TickSeconds, 1. / Scheduler->GetTickSeconds( ) );
+
+	// the frames are only the same if the window is:
+	if( h.Width != glutGet( GLUT_WINDOW_WIDTH )  ||  h.Height != glutGet( GLUT_WINDOW_HEIGHT ) )
+		glutReshapeWindow( h.Width, h.Height );
+
+	Next = 0;
+	Frames = 0;
+	FrameTimes.clear( );
+	FrameTimes.reserve( frames );
+	LastFrame = ReplayStart = FrameScheduler::Now( );
+	Mode = REPLAYING;
+	fprintf( stderr, "InputRecorder: replaying %d frames from '%s' (%dx%d)\n", frames, file, h.Width, h.Height );
+	return true;
+}
+
+
+void
+InputRecorder::ReshapeCB( int width, int height )
+{
+	InputRecorder *r = Active;
+	if( r == NULL  ||  r->Reshape == NULL )
+		return;
+
+	// (a replay reshapes the window itself, and those have to get through)
+	if( r->Mode == RECORDING )
+		r->Write( EVENT_RESHAPE, 0, 0, width, height );
+	( *r->Reshape )( width, height );
+}
+
+
+// print each input as it is recorded or replayed:
+
+void
+InputRecorder::SetVerbose( bool v )
+{
+	Verbose = v;
+}
+
+
+void
+InputRecorder::Write( int type, int code, int state, int x, int y )
+{
+	Event e;
+	e.Type = (unsigned char)type;
+	e.Code = (unsigned char)code;
+	e.State = (unsigned char)state;
+	e.Pad = 0;
+	e.X = (short)std::max( -32768, std::min( 32767, x ) );
+	e.Y = (short)std::max( -32768, std::min( 32767, y ) );
+	fwrite( &e, sizeof(Event), 1, Fp );
+	if( Verbose  &&  type != EVENT_TICKS )
+		fprintf( stderr, "InputRecorder: frame %d: recorded event %d (%d, %d, %d, %d)\n", Frames, type, code, state, x, y );
+}
@@ -0,0 +1,107 @@
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include <stdio.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "glew.h"
+#include <GL/gl.h>
+#include "glut.h"
+
+#include <vector>
+
+#include "framescheduler.h"
+
+
+#define INPUT_RECORD_MAGIC	"IREC"
+#define INPUT_RECORD_VERSION	1
+
+
+// the glut callbacks that get recorded:
+typedef void (*RecordedKeyboardFunc)( unsigned char, int, int );
+typedef void (*RecordedMouseFunc)( int, int, int, int );
+typedef void (*RecordedMotionFunc)( int, int );
+typedef void (*RecordedReshapeFunc)( int, int );
+
+
+// records the keyboard and mouse input, and how many simulation ticks each frame ran, to a small binary file
+// -- and plays it back, so that two builds can be made to draw exactly the same sequence of frames and their
+// timings compared
+//
+// Install( ) puts it between glut and the program's keyboard, mouse, motion, and reshape callbacks, and has
+// the FrameScheduler ask it how many ticks each frame runs
+// while recording, each input is written as it arrives and each frame's tick count as the frame starts, so
+// the file is the exact order the two came in
+// while replaying, live input is ignored (except for Escape, so a replay can be stopped), and as each frame
+// starts the inputs recorded before it are fed to the callbacks and it runs the ticks it ran when recorded
+// -- the simulation time is the same every frame whatever the clock says, so only how fast they come differs
+// at the end of a replay the frame times are printed, and the input goes back to being live
+//
+// the pop-up menus are not recorded: use the keys while recording
+
+class InputRecorder
+{
+    private:
+	struct Header
+	{
+		char			Magic[4];
+		int			Version;
+		double			TickSeconds;
+		int			Width, Height;		// of the window when recording started
+	};
+
+	struct Event				// 8 bytes each
+	{
+		unsigned char		Type;
+		unsigned char		Code;			// the key, or the button
+		unsigned char		State;			// of the button
+		unsigned char		Pad;
+		short			X, Y;			// the mouse, the window size, or the ticks of a frame
+	};
+
+	enum { NONE, RECORDING, REPLAYING };
+
+	int			Mode;
+	FILE *			Fp;
+	std::vector<Event>	Events;			// the whole replay
+	size_t			Next;			// into Events
+	FrameScheduler *	Scheduler;
+	RecordedKeyboardFunc	Keyboard;
+	RecordedMouseFunc	Mouse;
+	RecordedMotionFunc	Motion;
+	RecordedReshapeFunc	Reshape;
+	bool			Verbose;
+
+	int			Frames;
+	std::vector<double>	FrameTimes;		// seconds between the starts of the replayed frames
+	double			LastFrame;
+	double			ReplayStart;
+
+	static InputRecorder *	Active;
+
+	int			FrameBegin( int );
+	void			Write( int, int, int, int, int );
+	static int		BeginFrameCB( int );
+	static void		KeyboardCB( unsigned char, int, int );
+	static void		MouseCB( int, int, int, int );
+	static void		MotionCB( int, int );
+	static void		ReshapeCB( int, int );
+
+    public:
+	InputRecorder( );
+	~InputRecorder( );
+
+	void			Close( );
+	void			Install( FrameScheduler *, RecordedKeyboardFunc, RecordedMouseFunc, RecordedMotionFunc, RecordedReshapeFunc );
+	bool			IsRecording( );
+	bool			IsReplaying( );
+	void			PrintStats( FILE * = stderr );
+	bool			Record( const char * );
+	bool			Replay( const char * );
+	void			SetVerbose( bool );
+};
+
+#endif		// #ifndef INPUT_RECORDER_H
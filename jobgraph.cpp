@@ -0,0 +1,302 @@
+#include "jobgraph.h"
+
+#include <algorithm>
+#include <chrono>
+
+
+#define TIMELINE_WIDTH		50		// characters in the bar part of PrintTimeline( )
+
+
+static double
+Now( )
+{
+	return std::chrono::duration<double>( std::chrono::steady_clock::now( ).time_since_epoch( ) ).count( );
+}
+
+
+JobGraph::JobGraph( )
+{
+	Remaining = 0;
+	Threads = 0;
+	StartTime = 0.;
+	TotalTime = 0.;
+	Verbose = false;
+}
+
+
+// add a job, and get back the number to pass to After( ):
+
+int
+JobGraph::Add( const char *name, JobFunction function, bool onGlThread )
+{
+	Job job;
+	job.Name = name;
+	job.Function = function;
+	job.OnGlThread = onGlThread;
+	job.Waiting = 0;
+	job.Start = job.End = 0.;
+	job.Thread = -1;
+	Jobs.push_back( job );
+	return (int)Jobs.size( ) - 1;
+}
+
+
+// make job wait for prerequisite to finish:
+
+void
+JobGraph::After( int job, int prerequisite )
+{
+	if( job < 0  ||  job >= (int)Jobs.size( )  ||  prerequisite < 0  ||  prerequisite >= (int)Jobs.size( ) )
+	{
+		fprintf( stderr, "JobGraph: After( %d, %d ) names a job that was never added\n", job, prerequisite );
+		return;
+	}
+	Jobs[job].Prerequisites.push_back( prerequisite );
+	Jobs[prerequisite].Dependents.push_back( job );
+}
+
+
+void
+JobGraph::Execute( int j, int thread )
+{
+	Job &job = Jobs[j];
+	job.Thread = thread;
+	job.Start = Now( ) - StartTime;
+	if( Verbose )
+		fprintf( stderr, "JobGraph: %-24s starts on %s\n", job.Name.c_str( ), job.OnGlThread ? "the gl thread" : "the pool" );
+
+	if( job.Function )
+		job.Function( );
+
+	job.End = Now( ) - StartTime;
+	Finished( j );
+}
+
+
+// hand out the jobs that were only waiting on j:
+
+void
+JobGraph::Finished( int j )
+{
+	std::lock_guard<std::mutex> lock( Lock );
+
+	bool pool = false, gl = false;
+	for( int i = 0; i < (int)Jobs[j].Dependents.size( ); i++ )
+	{
+		Job &dependent = Jobs[ Jobs[j].Dependents[i] ];
+		if( --dependent.Waiting > 0 )
+			continue;
+		if( dependent.OnGlThread )
+		{
+			GlReady.push_back( Jobs[j].Dependents[i] );
+			gl = true;
+		}
+		else
+		{
+			PoolReady.push_back( Jobs[j].Dependents[i] );
+			pool = true;
+		}
+	}
+
+	if( --Remaining == 0 )
+	{
+		PoolWake.notify_all( );
+		GlWake.notify_all( );
+		return;
+	}
+	if( pool )
+		PoolWake.notify_all( );
+	if( gl )
+		GlWake.notify_one( );
+}
+
+
+// a graph with a cycle in it would wait forever, so check first:
+
+bool
+JobGraph::IsAcyclic( )
+{
+	std::vector<int> waiting( Jobs.size( ) );
+	std::vector<int> ready;
+	for( int j = 0; j < (int)Jobs.size( ); j++ )
+	{
+		waiting[j] = (int)Jobs[j].Prerequisites.size( );
+		if( waiting[j] == 0 )
+			ready.push_back( j );
+	}
+
+	int visited = 0;
+	while( ! ready.empty( ) )
+	{
+		int j = ready.back( );
+		ready.pop_back( );
+		visited++;
+		for( int i = 0; i < (int)Jobs[j].Dependents.size( ); i++ )
+		{
+			if( --waiting[ Jobs[j].Dependents[i] ] == 0 )
+				ready.push_back( Jobs[j].Dependents[i] );
+		}
+	}
+	return visited == (int)Jobs.size( );
+}
+
+
+// draw when each job ran, one line per job in the order they started
+// (the jobs marked with a * are the critical path -- shortening any of them brings the end of the graph in):
+
+void
+JobGraph::PrintTimeline( FILE *fp )
+{
+	if( Jobs.empty( ) )
+		return;
+
+	// walk back from the job that finished last: what held each job up was either its latest prerequisite
+	// or, if it started later than that finished, the job that had its thread busy:
+	std::vector<bool> critical( Jobs.size( ), false );
+	int last = 0;
+	for( int j = 1; j < (int)Jobs.size( ); j++ )
+	{
+		if( Jobs[j].End > Jobs[last].End )
+			last = j;
+	}
+	for( int j = last; j >= 0; )
+	{
+		critical[j] = true;
+		int blocker = -1;
+		for( int i = 0; i < (int)Jobs[j].Prerequisites.size( ); i++ )
+		{
+			int p = Jobs[j].Prerequisites[i];
+			if( blocker < 0  ||  Jobs[p].End > Jobs[blocker].End )
+				blocker = p;
+		}
+		for( int k = 0; k < (int)Jobs.size( ); k++ )
+		{
+			if( k == j  ||  Jobs[k].Thread != Jobs[j].Thread  ||  Jobs[k].End > Jobs[j].Start )
+				continue;
+			if( blocker < 0  ||  Jobs[k].End > Jobs[blocker].End )
+				blocker = k;
+		}
+		j = blocker;
+	}
+
+	std::vector<int> order( Jobs.size( ) );
+	for( int j = 0; j < (int)Jobs.size( ); j++ )
+		order[j] = j;
+	std::stable_sort( order.begin( ), order.end( ), [this]( int a, int b ) { return Jobs[a].Start < Jobs[b].Start; } );
+
+	double scale = TotalTime > 0. ? (double)TIMELINE_WIDTH / TotalTime : 0.;
+	double criticalTime = 0.;
+	fprintf( fp, "Startup timeline (%d pool threads, %.1f ms in all):\n", Threads, 1000. * TotalTime );
+	fprintf( fp, "  %-24s %-6s %8s %8s\n", "job", "thread", "start", "ms" );
+	for( int i = 0; i < (int)order.size( ); i++ )
+	{
+		Job &job = Jobs[ order[i] ];
+		char thread[16];
+		if( job.Thread == 0 )
+			snprintf( thread, sizeof(thread), "gl" );
+		else
+			snprintf( thread, sizeof(thread), "pool%d", job.Thread );
+
+		char bar[TIMELINE_WIDTH+1];
+		int from = (int)( job.Start * scale );
+		int to = std::max( from + 1, (int)( job.End * scale + 0.5 ) );
+		for( int c = 0; c < TIMELINE_WIDTH; c++ )
+			bar[c] = ( c >= from  &&  c < to ) ? ( critical[ order[i] ] ? '#' : '=' ) : ' ';
+		bar[TIMELINE_WIDTH] = '\0';
+
+		fprintf( fp, "%c %-24s %-6s %8.1f %8.1f |%s|\n", critical[ order[i] ] ? '*' : ' ',
+			job.Name.c_str( ), thread, 1000. * job.Start, 1000. * ( job.End - job.Start ), bar );
+		if( critical[ order[i] ] )
+			criticalTime += job.End - job.Start;
+	}
+	fprintf( fp, "  critical path: %.1f ms of work, %.1f ms waiting\n", 1000. * criticalTime, 1000. * ( TotalTime - criticalTime ) );
+}
+
+
+// run every job, and return once they have all finished -- this must be called on the gl thread
+// (0 threads means one fewer than there are hardware threads, but at least 1):
+
+bool
+JobGraph::Run( int threads )
+{
+	if( ! IsAcyclic( ) )
+	{
+		fprintf( stderr, "JobGraph: the jobs depend on each other in a circle -- not running any of them\n" );
+		return false;
+	}
+
+	int poolJobs = 0;
+	for( int j = 0; j < (int)Jobs.size( ); j++ )
+	{
+		Jobs[j].Waiting = (int)Jobs[j].Prerequisites.size( );
+		if( ! Jobs[j].OnGlThread )
+			poolJobs++;
+		if( Jobs[j].Waiting == 0 )
+		{
+			if( Jobs[j].OnGlThread )
+				GlReady.push_back( j );
+			else
+				PoolReady.push_back( j );
+		}
+	}
+	Remaining = (int)Jobs.size( );
+
+	if( threads <= 0 )
+		threads = (int)std::thread::hardware_concurrency( ) - 1;
+	if( threads <= 0 )
+		threads = 1;
+	Threads = std::min( threads, poolJobs );
+
+	StartTime = Now( );
+	std::vector<std::thread> pool;
+	for( int t = 0; t < Threads; t++ )
+		pool.push_back( std::thread( &JobGraph::Work, this, t + 1 ) );
+
+	// this thread owns the gl context, so it runs the gl jobs as they become ready:
+	for( ; ; )
+	{
+		int j;
+		{
+			std::unique_lock<std::mutex> lock( Lock );
+			while( Remaining > 0  &&  GlReady.empty( ) )
+				GlWake.wait( lock );
+			if( GlReady.empty( ) )
+				break;
+			j = GlReady.front( );
+			GlReady.pop_front( );
+		}
+		Execute( j, 0 );
+	}
+
+	for( int t = 0; t < (int)pool.size( ); t++ )
+		pool[t].join( );
+	TotalTime = Now( ) - StartTime;
+	return true;
+}
+
+
+void
+JobGraph::SetVerbose( bool v )
+{
+	Verbose = v;
+}
+
+
+void
+JobGraph::Work( int thread )
+{
+	for( ; ; )
+	{
+		int j;
+		{
+			std::unique_lock<std::mutex> lock( Lock );
+			while( Remaining > 0  &&  PoolReady.empty( ) )
+				PoolWake.wait( lock );
+			if( PoolReady.empty( ) )
+				return;
+			j = PoolReady.front( );
+			PoolReady.pop_front( );
+		}
+		Execute( j, thread );
+	}
+}
@@ -0,0 +1,74 @@
+#ifndef JOB_GRAPH_H
+#define JOB_GRAPH_H
+
+#include <stdio.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+// where a job has to run:
+#define JOB_ON_POOL		false		// anywhere -- it does not touch gl
+#define JOB_ON_GL_THREAD	true		// on the thread that owns the gl context (the one that calls Run( ))
+
+
+typedef std::function<void( )>	JobFunction;
+
+
+// a small dependency graph of startup jobs
+//
+// jobs that only use the cpu go to a pool of worker threads, and jobs that make gl calls are run by the thread
+// that called Run( ), in the order they become ready -- a job starts once every job it was told to come After( )
+// has finished, so cpu work like building meshes overlaps with the gl work like starting shader compiles
+//
+// every job's start and finish time is recorded, and PrintTimeline( ) draws them along with the
+// critical path, which is the chain of jobs that decided when the last one finished
+
+class JobGraph
+{
+    private:
+	struct Job
+	{
+		std::string		Name;
+		JobFunction		Function;
+		bool			OnGlThread;
+		std::vector<int>	Prerequisites;
+		std::vector<int>	Dependents;
+		int			Waiting;		// prerequisites that have not finished yet
+		double			Start, End;		// seconds since Run( ) started
+		int			Thread;			// 0 is the gl thread, 1... are the pool
+	};
+
+	std::vector<Job>	Jobs;
+	std::deque<int>		PoolReady;		// under Lock
+	std::deque<int>		GlReady;		// under Lock
+	std::mutex		Lock;
+	std::condition_variable	PoolWake;
+	std::condition_variable	GlWake;
+	int			Remaining;		// under Lock
+	int			Threads;
+	double			StartTime;
+	double			TotalTime;
+	bool			Verbose;
+
+	void			Execute( int, int );
+	void			Finished( int );
+	bool			IsAcyclic( );
+	void			Work( int );
+
+    public:
+	JobGraph( );
+
+	int			Add( const char *, JobFunction, bool = JOB_ON_POOL );
+	void			After( int, int );
+	void			PrintTimeline( FILE * = stderr );
+	bool			Run( int = 0 );
+	void			SetVerbose( bool );
+};
+
+#endif		// #ifndef JOB_GRAPH_H
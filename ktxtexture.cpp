@@ -0,0 +1,210 @@
+#include "ktxtexture.h"
+
+#include <string.h>
+
+
+// the 12-byte identifier and the 13 header words that follow it:
+
+static const unsigned char KtxIdentifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+#define KTX_HEADER_SIZE		( 12 + 13*4 )
+#define KTX_ENDIAN_REF		0x04030201
+
+#define KTX_MAX_DIMENSION	16384
+
+
+struct KtxHeader
+{
+	unsigned int	endianness;
+	unsigned int	glType;
+	unsigned int	glTypeSize;
+	unsigned int	glFormat;
+	unsigned int	glInternalFormat;
+	unsigned int	glBaseInternalFormat;
+	unsigned int	pixelWidth;
+	unsigned int	pixelHeight;
+	unsigned int	pixelDepth;
+	unsigned int	numberOfArrayElements;
+	unsigned int	numberOfFaces;
+	unsigned int	numberOfMipmapLevels;
+	unsigned int	bytesOfKeyValueData;
+};
+
+
+// bytes per pixel, or 0 if it is not a format we know:
+
+static int
+KtxFormatBytes( GLenum internalFormat )
+{
+	switch( internalFormat )
+	{
+		case GL_RGBA8:		return 4;
+		case GL_RG8:		return 2;
+		case GL_R8:		return 1;
+	}
+	return 0;
+}
+
+
+KtxTexture::KtxTexture( )
+{
+	Type = Format = InternalFormat = 0;
+	Width = Height = Layers = 0;
+	Verbose = false;
+}
+
+
+void
+KtxTexture::Close( )
+{
+	File.Close( );
+	LevelData.clear( );
+	Width = Height = Layers = 0;
+}
+
+
+int
+KtxTexture::GetHeight( )
+{
+	return Height;
+}
+
+
+GLenum
+KtxTexture::GetInternalFormat( )
+{
+	return InternalFormat;
+}
+
+
+int
+KtxTexture::GetLayers( )
+{
+	return Layers;
+}
+
+
+// where a level's texels are in the mapped file:
+
+const unsigned char *
+KtxTexture::GetLevel( int level )
+{
+	if( level < 0  ||  level >= (int)LevelData.size( ) )
+		return NULL;
+	return LevelData[level];
+}
+
+
+int
+KtxTexture::GetLevelCount( )
+{
+	return (int)LevelData.size( );
+}
+
+
+int
+KtxTexture::GetWidth( )
+{
+	return Width;
+}
+
+
+// map the file, check its header, and find where each mip level's data starts
+// (an optional file -- one that the caller has something else to fall back on -- that isn't there is not an error):
+
+bool
+KtxTexture::Load( const char *filename, bool optional )
+{
+	Close( );
+
+	if( ! File.Open( filename, optional ) )
+		return false;
+	const unsigned char *data = File.GetData( );
+	size_t size = File.GetSize( );
+
+	if( size < KTX_HEADER_SIZE  ||  memcmp( data, KtxIdentifier, sizeof(KtxIdentifier) ) != 0 )
+	{
+		fprintf( stderr, "File '%s' is not a ktx file\n", filename );
+		Close( );
+		return false;
+	}
+
+	KtxHeader header;
+	memcpy( &header, &data[ sizeof(KtxIdentifier) ], sizeof(header) );
+	if( header.endianness != KTX_ENDIAN_REF )
+	{
+		fprintf( stderr, "Ktx file '%s' was written with the other byte order\n", filename );
+		Close( );
+		return false;
+	}
+
+	int bytes = KtxFormatBytes( header.glInternalFormat );
+	if( bytes == 0 )
+	{
+		fprintf( stderr, "Ktx file '%s' has an unsupported internal format: 0x%x (only rgba8, rg8, and r8 are loaded)\n", filename, header.glInternalFormat );
+		Close( );
+		return false;
+	}
+	if( header.glType != GL_UNSIGNED_BYTE  ||  header.glFormat == 0 )
+	{
+		fprintf( stderr, "Ktx file '%s' has a type and format that don't go with its internal format\n", filename );
+		Close( );
+		return false;
+	}
+	if( header.pixelWidth == 0  ||  header.pixelHeight == 0  ||  header.pixelDepth != 0  ||  header.numberOfFaces != 1
+	 ||  header.pixelWidth > KTX_MAX_DIMENSION  ||  header.pixelHeight > KTX_MAX_DIMENSION  ||  header.numberOfArrayElements > KTX_MAX_DIMENSION )
+	{
+		fprintf( stderr, "Ktx file '%s' is not a 2d texture or 2d texture array: %u x %u x %u, %u faces\n",
+			filename, header.pixelWidth, header.pixelHeight, header.pixelDepth, header.numberOfFaces );
+		Close( );
+		return false;
+	}
+
+	Type = header.glType;
+	Format = header.glFormat;
+	InternalFormat = header.glInternalFormat;
+	Width = (int)header.pixelWidth;
+	Height = (int)header.pixelHeight;
+	Layers = (int)header.numberOfArrayElements;
+
+	// 0 levels means "generate the mips when loading", which is exactly what these files are meant to avoid:
+	int levels = ( header.numberOfMipmapLevels == 0 ) ? 1 : (int)header.numberOfMipmapLevels;
+	int layers = ( Layers > 0 ) ? Layers : 1;
+
+	size_t offset = KTX_HEADER_SIZE + (size_t)header.bytesOfKeyValueData;
+	for( int l = 0, w = Width, h = Height; l < levels; l++, w = ( w > 1 ? w/2 : 1 ), h = ( h > 1 ? h/2 : 1 ) )
+	{
+		// each level is its size, then all of its layers, padded out to 4 bytes:
+		size_t expected = (size_t)( 4 * ( ( w * bytes + 3 ) / 4 ) ) * h * layers;
+
+		if( offset + 4 > size )
+			break;
+		unsigned int imageSize;
+		memcpy( &imageSize, &data[offset], 4 );
+		offset += 4;
+		if( imageSize != expected  ||  offset + imageSize > size )
+			break;
+
+		LevelData.push_back( &data[offset] );
+		offset += ( imageSize + 3 ) & ~3u;
+	}
+
+	if( (int)LevelData.size( ) != levels )
+	{
+		fprintf( stderr, "Ktx file '%s' is truncated or corrupt at mip level %d\n", filename, (int)LevelData.size( ) );
+		Close( );
+		return false;
+	}
+
+	if( Verbose )
+		fprintf( stderr, "KtxTexture: '%s' is %d x %d x %d layers, format 0x%x, %d levels\n",
+			filename, Width, Height, layers, InternalFormat, levels );
+	return true;
+}
+
+
+void
+KtxTexture::SetVerbose( bool v )
+{
+	Verbose = v;
+}
@@ -0,0 +1,53 @@
+#ifndef KTX_TEXTURE_H
+#define KTX_TEXTURE_H
+
+#include <stdio.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "glew.h"
+#include <GL/gl.h>
+
+#include <vector>
+
+#include "mappedfile.h"
+
+
+// a texture in a KTX (version 1) container, as written by tools/texconv
+//
+// the file already holds a plain sized internal format (GL_RGBA8, GL_RG8, or GL_R8) and its whole mip chain,
+// so loading it is just mapping the file and finding where each level starts -- GetLevel( ) points into the mapping,
+// and nothing is decoded, converted, or downsampled at startup
+// (the noise layers copy their rgba8 levels out of it into the buffer the TextureStreamer uploads;
+// texconv's bc4, bc5, and bc7 files are not read here, since the rgba8 noise array has nowhere to put them)
+
+class KtxTexture
+{
+    private:
+	MappedFile		File;
+	GLenum			Type;
+	GLenum			Format;
+	GLenum			InternalFormat;
+	int			Width;
+	int			Height;
+	int			Layers;			// 0 means it is not an array
+	std::vector<const unsigned char *>	LevelData;
+	bool			Verbose;
+
+    public:
+	KtxTexture( );
+
+	void			Close( );
+	int			GetHeight( );
+	GLenum			GetInternalFormat( );
+	int			GetLayers( );
+	const unsigned char *	GetLevel( int );
+	int			GetLevelCount( );
+	int			GetWidth( );
+	bool			Load( const char *, bool = false );
+	void			SetVerbose( bool );
+};
+
+#endif		// #ifndef KTX_TEXTURE_H
@@ -0,0 +1,128 @@
+#include "mappedfile.h"
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+MappedFile::MappedFile( )
+{
+	Data = NULL;
+	Size = 0;
+#ifdef WIN32
+	File = INVALID_HANDLE_VALUE;
+	Mapping = NULL;
+#endif
+}
+
+
+MappedFile::~MappedFile( )
+{
+	Close( );
+}
+
+
+void
+MappedFile::Close( )
+{
+#ifdef WIN32
+	if( Data != NULL )
+		UnmapViewOfFile( Data );
+	if( Mapping != NULL )
+		CloseHandle( Mapping );
+	if( File != INVALID_HANDLE_VALUE )
+		CloseHandle( File );
+	Mapping = NULL;
+	File = INVALID_HANDLE_VALUE;
+#else
+	if( Data != NULL )
+		munmap( (void *)Data, Size );
+#endif
+	Data = NULL;
+	Size = 0;
+}
+
+
+const unsigned char *
+MappedFile::GetData( )
+{
+	return Data;
+}
+
+
+size_t
+MappedFile::GetSize( )
+{
+	return Size;
+}
+
+
+// map the whole file -- returns false (and says why) if it can't be opened or is empty
+// (quiet leaves out the "Cannot open file", for probing for a file that may well not be there):
+
+bool
+MappedFile::Open( const char *filename, bool quiet )
+{
+	Close( );
+
+#ifdef WIN32
+	File = CreateFileA( filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+	if( File == INVALID_HANDLE_VALUE )
+	{
+		if( ! quiet )
+			fprintf( stderr, "Cannot open file '%s'\n", filename );
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if( ! GetFileSizeEx( File, &size )  ||  size.QuadPart == 0 )
+	{
+		fprintf( stderr, "File '%s' is empty\n", filename );
+		Close( );
+		return false;
+	}
+
+	Mapping = CreateFileMappingA( File, NULL, PAGE_READONLY, 0, 0, NULL );
+	if( Mapping != NULL )
+		Data = (const unsigned char *)MapViewOfFile( Mapping, FILE_MAP_READ, 0, 0, 0 );
+	if( Data == NULL )
+	{
+		fprintf( stderr, "Cannot map file '%s'\n", filename );
+		Close( );
+		return false;
+	}
+	Size = (size_t)size.QuadPart;
+#else
+	int fd = open( filename, O_RDONLY );
+	if( fd < 0 )
+	{
+		if( ! quiet )
+			fprintf( stderr, "Cannot open file '%s'\n", filename );
+		return false;
+	}
+
+	struct stat info;
+	if( fstat( fd, &info ) != 0  ||  info.st_size == 0 )
+	{
+		fprintf( stderr, "File '%s' is empty\n", filename );
+		close( fd );
+		return false;
+	}
+
+	void *p = mmap( NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+	close( fd );			// the mapping keeps the file open
+	if( p == MAP_FAILED )
+	{
+		fprintf( stderr, "Cannot map file '%s'\n", filename );
+		return false;
+	}
+	madvise( p, (size_t)info.st_size, MADV_SEQUENTIAL );
+	Data = (const unsigned char *)p;
+	Size = (size_t)info.st_size;
+#endif
+
+	return true;
+}
@@ -0,0 +1,40 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+
+// a whole file, mapped read-only into memory
+// (the pages are only read from disk as they are touched, and nothing is copied into a buffer of ours)
+//
+// it can't be copied, since both copies would unmap the same view when they went away
+
+class MappedFile
+{
+    private:
+	const unsigned char *	Data;
+	size_t			Size;
+#ifdef WIN32
+	HANDLE			File;
+	HANDLE			Mapping;
+#endif
+
+    public:
+	MappedFile( );
+	~MappedFile( );
+
+	MappedFile( const MappedFile & ) = delete;
+	MappedFile &		operator=( const MappedFile & ) = delete;
+
+	void			Close( );
+	const unsigned char *	GetData( );
+	size_t			GetSize( );
+	bool			Open( const char *, bool = false );
+};
+
+#endif		// #ifndef MAPPED_FILE_H
@@ -0,0 +1,317 @@
+#include "multiview.h"
+#include "glstate.h"
+
+#include <stddef.h>
+#include <string.h>
+#include "glm/gtc/matrix_inverse.hpp"
+
+
+// GL_OVR_multiview is newer than our glew.h:
+#ifndef GL_MAX_VIEWS_OVR
+#define GL_MAX_VIEWS_OVR	0x9631
+#endif
+
+typedef void (GLAPIENTRY *FramebufferTextureMultiviewOVRProc)( GLenum, GLenum, GLuint, GLint, GLint, GLsizei );
+static FramebufferTextureMultiviewOVRProc	FramebufferTextureMultiviewOVR = NULL;
+
+
+MultiView::MultiView( )
+{
+	NumViews = 1;
+	Method = MULTIVIEW_NONE;
+	Fbo = BlitFbo = 0;
+	ColorTex = DepthTex = 0;
+	AllocWidth = AllocHeight = 0;
+	Width = Height = 0;
+	Ubo = 0;
+	memset( &Data, 0, sizeof(Data) );
+	Verbose = false;
+}
+
+
+MultiView::~MultiView( )
+{
+	if( Fbo != 0 )
+		glDeleteFramebuffers( 1, &Fbo );
+	if( BlitFbo != 0 )
+		glDeleteFramebuffers( 1, &BlitFbo );
+	if( ColorTex != 0 )
+		glDeleteTextures( 1, &ColorTex );
+	if( DepthTex != 0 )
+		glDeleteTextures( 1, &DepthTex );
+	if( Ubo != 0 )
+		glDeleteBuffers( 1, &Ubo );
+}
+
+
+// pick the variant of a view shader that draws the way Init( ) chose:
+
+void
+MultiView::AddDefines( GLSLDefines &defines )
+{
+	defines.Set( "MULTIVIEW", Method );
+	defines.Set( "NUM_VIEWS", NumViews );
+	if( Method == MULTIVIEW_OVR )
+	{
+		defines.Require( "GL_OVR_multiview2" );
+	}
+	else if( Method == MULTIVIEW_LAYERED )
+	{
+		if( HasExtension( "GL_ARB_shader_viewport_layer_array" ) )
+			defines.Require( "GL_ARB_shader_viewport_layer_array" );
+		else
+			defines.Require( "GL_AMD_vertex_shader_layer" );
+	}
+}
+
+
+// (re)make the texture arrays -- like the other targets, they only ever grow:
+
+void
+MultiView::Allocate( int width, int height )
+{
+	AllocWidth = width;
+	AllocHeight = height;
+
+	if( Fbo == 0 )
+		glGenFramebuffers( 1, &Fbo );
+	if( BlitFbo == 0 )
+		glGenFramebuffers( 1, &BlitFbo );
+	if( ColorTex == 0 )
+		glGenTextures( 1, &ColorTex );
+	if( DepthTex == 0 )
+		glGenTextures( 1, &DepthTex );
+
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D_ARRAY, ColorTex );
+	glTexImage3D( GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, NumViews, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL );
+	glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+	glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D_ARRAY, DepthTex );
+	glTexImage3D( GL_TEXTURE_2D_ARRAY, 0, GL_DEPTH_COMPONENT24, width, height, NumViews, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL );
+	glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+	glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D_ARRAY, 0 );
+
+	// the multiview and layered targets are all of the layers at once, the loop's one layer at a time:
+	glBindFramebuffer( GL_FRAMEBUFFER, Fbo );
+	if( Method == MULTIVIEW_OVR )
+	{
+		( *FramebufferTextureMultiviewOVR )( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, ColorTex, 0, 0, NumViews );
+		( *FramebufferTextureMultiviewOVR )( GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, DepthTex, 0, 0, NumViews );
+	}
+	else if( Method == MULTIVIEW_LAYERED )
+	{
+		glFramebufferTexture( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, ColorTex, 0 );
+		glFramebufferTexture( GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, DepthTex, 0 );
+	}
+	else
+	{
+		glFramebufferTextureLayer( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, ColorTex, 0, 0 );
+		glFramebufferTextureLayer( GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, DepthTex, 0, 0 );
+	}
+
+	GLenum status = glCheckFramebufferStatus( GL_FRAMEBUFFER );
+	if( status != GL_FRAMEBUFFER_COMPLETE )
+		fprintf( stderr, "MultiView: the %dx%d x %d target is not complete (0x%04x)\n", width, height, NumViews, status );
+	else if( Verbose )
+		fprintf( stderr, "MultiView: target is %dx%d x %d views\n", width, height, NumViews );
+}
+
+
+// start drawing the views, each of which is width x height -- returns how many passes to draw:
+// (the viewport is left to the caller, and the views' framebuffer stays bound until End( ))
+
+int
+MultiView::Begin( int width, int height )
+{
+	Width = width > 0 ? width : 1;
+	Height = height > 0 ? height : 1;
+	if( Width > AllocWidth  ||  Height > AllocHeight )
+		Allocate( Width > AllocWidth ? Width : AllocWidth, Height > AllocHeight ? Height : AllocHeight );
+
+	glBindFramebuffer( GL_FRAMEBUFFER, Fbo );
+	glDrawBuffer( GL_COLOR_ATTACHMENT0 );
+	return Method == MULTIVIEW_LOOP ? NumViews : 1;
+}
+
+
+// start pass p of the ones Begin( ) asked for, and clear what it draws into:
+
+void
+MultiView::BeginPass( int p )
+{
+	if( Method == MULTIVIEW_LOOP )
+	{
+		glFramebufferTextureLayer( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, ColorTex, 0, p );
+		glFramebufferTextureLayer( GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, DepthTex, 0, p );
+		Data.uFirstView = p;
+		GLState::BindBuffer( GL_UNIFORM_BUFFER, Ubo );
+		glBufferSubData( GL_UNIFORM_BUFFER, offsetof( ViewUniformData, uFirstView ), sizeof(int), &Data.uFirstView );
+	}
+
+	// (the clear is of the whole of every layer that is attached)
+	glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
+}
+
+
+// point a view shader's uniform block at the views' matrices:
+// (call once it is linked)
+
+void
+MultiView::Bind( GLSLProgram *program )
+{
+	if( program != NULL )
+		program->BindUniformBlock( "ViewUniforms", VIEW_UNIFORMS_BINDING );
+}
+
+
+// put the views side by side, from x, y, in the framebuffer target (0 is the window), and leave that bound:
+
+void
+MultiView::End( GLuint target, int x, int y )
+{
+	glBindFramebuffer( GL_READ_FRAMEBUFFER, BlitFbo );
+	glBindFramebuffer( GL_DRAW_FRAMEBUFFER, target );
+	glDrawBuffer( target == 0 ? GL_BACK : GL_COLOR_ATTACHMENT0 );
+	for( int i = 0; i < NumViews; i++ )
+	{
+		glFramebufferTextureLayer( GL_READ_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, ColorTex, 0, i );
+		glReadBuffer( GL_COLOR_ATTACHMENT0 );
+		glBlitFramebuffer( 0, 0, Width, Height,  x + i * Width, y, x + ( i + 1 ) * Width, y + Height,  GL_COLOR_BUFFER_BIT, GL_NEAREST );
+	}
+	glBindFramebuffer( GL_FRAMEBUFFER, target );
+}
+
+
+// how many instances each draw should be -- gl_InstanceID is the view:
+
+int
+MultiView::GetInstances( )
+{
+	return Method == MULTIVIEW_LAYERED ? NumViews : 1;
+}
+
+
+int
+MultiView::GetMethod( )
+{
+	return Method;
+}
+
+
+const char *
+MultiView::GetMethodName( )
+{
+	switch( Method )
+	{
+		case MULTIVIEW_OVR:		return "GL_OVR_multiview2";
+		case MULTIVIEW_LAYERED:		return "instanced, layered";
+		case MULTIVIEW_LOOP:		return "a draw per view";
+	}
+	return "off";
+}
+
+
+int
+MultiView::GetNumViews( )
+{
+	return NumViews;
+}
+
+
+// glew does not know the newer extensions, so look through the list ourselves:
+
+bool
+MultiView::HasExtension( const char *name )
+{
+	GLint n = 0;
+	glGetIntegerv( GL_NUM_EXTENSIONS, &n );
+	for( int i = 0; i < n; i++ )
+	{
+		const char *ext = (const char *)glGetStringi( GL_EXTENSIONS, i );
+		if( ext != NULL  &&  strcmp( ext, name ) == 0 )
+			return true;
+	}
+	return false;
+}
+
+
+// pick how to draw views views, and make the uniform block -- returns false if multiple views cannot be drawn at all:
+// (the target is made by the first Begin( ))
+
+bool
+MultiView::Init( int views )
+{
+	if( ! GLEW_VERSION_3_2 )
+	{
+		fprintf( stderr, "MultiView: needs OpenGL 3.2 for texture array framebuffers -- drawing one view\n" );
+		Method = MULTIVIEW_NONE;
+		NumViews = 1;
+		return false;
+	}
+
+	NumViews = views < 1 ? 1 : ( views > MULTIVIEW_MAX_VIEWS ? MULTIVIEW_MAX_VIEWS : views );
+	if( NumViews != views )
+		fprintf( stderr, "MultiView: can draw 1 to %d views, not %d -- drawing %d\n", MULTIVIEW_MAX_VIEWS, views, NumViews );
+
+	Method = MULTIVIEW_LOOP;
+	if( HasExtension( "GL_OVR_multiview2" ) )
+	{
+		GLint maxViews = 0;
+		glGetIntegerv( GL_MAX_VIEWS_OVR, &maxViews );
+		FramebufferTextureMultiviewOVR = (FramebufferTextureMultiviewOVRProc)GetGLProcAddress( "glFramebufferTextureMultiviewOVR" );
+		if( FramebufferTextureMultiviewOVR != NULL  &&  maxViews >= NumViews )
+			Method = MULTIVIEW_OVR;
+	}
+	if( Method == MULTIVIEW_LOOP  &&  ( HasExtension( "GL_ARB_shader_viewport_layer_array" ) || HasExtension( "GL_AMD_vertex_shader_layer" ) ) )
+		Method = MULTIVIEW_LAYERED;
+
+	glGenBuffers( 1, &Ubo );
+	GLState::BindBuffer( GL_UNIFORM_BUFFER, Ubo );
+	glBufferData( GL_UNIFORM_BUFFER, sizeof(Data), NULL, GL_DYNAMIC_DRAW );
+	GLState::BindBuffer( GL_UNIFORM_BUFFER, 0 );
+
+	if( Verbose )
+		fprintf( stderr, "MultiView: %d views, %s\n", NumViews, GetMethodName( ) );
+	return true;
+}
+
+
+void
+MultiView::SetVerbose( bool v )
+{
+	Verbose = v;
+}
+
+
+// set view i's modelview and projection matrices (the rest are made from them):
+
+void
+MultiView::SetView( int i, const glm::mat4 &modelView, const glm::mat4 &projection )
+{
+	if( i < 0  ||  i >= MULTIVIEW_MAX_VIEWS )
+		return;
+
+	glm::mat4 mvp = projection * modelView;
+	glm::mat4 normal = glm::mat4( glm::inverseTranspose( glm::mat3( modelView ) ) );
+	memcpy( Data.uViewModelView[i], &modelView[0][0], 16 * sizeof(float) );
+	memcpy( Data.uViewModelViewProjection[i], &mvp[0][0], 16 * sizeof(float) );
+	memcpy( Data.uViewNormal[i], &normal[0][0], 16 * sizeof(float) );
+}
+
+
+// send this frame's views to the gpu and bind them:
+// (the driver keeps the copy the frame before is still drawing with, so there is no ring of them, as FrameUniforms has)
+
+void
+MultiView::Update( )
+{
+	if( Ubo == 0 )
+		return;
+
+	Data.uFirstView = 0;
+	GLState::BindBuffer( GL_UNIFORM_BUFFER, Ubo );
+	glBufferSubData( GL_UNIFORM_BUFFER, 0, sizeof(Data), &Data );
+	GLState::BindBufferRange( GL_UNIFORM_BUFFER, VIEW_UNIFORMS_BINDING, Ubo, 0, sizeof(Data) );
+}
@@ -0,0 +1,92 @@
+#ifndef MULTI_VIEW_H
+#define MULTI_VIEW_H
+
+#include <stdio.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "glew.h"
+#include <GL/gl.h>
+
+#include "glm/glm.hpp"
+#include "glslprogram.h"
+
+
+// the per-view uniform block is bound here (FrameUniforms has 0):
+#define VIEW_UNIFORMS_BINDING		1
+
+// views at most -- must match MAX_VIEWS in views.glsl:
+#define MULTIVIEW_MAX_VIEWS		4
+
+// how a draw reaches every view -- these are #defined to match in views.glsl:
+#define MULTIVIEW_NONE			0
+#define MULTIVIEW_OVR			1		// GL_OVR_multiview2
+#define MULTIVIEW_LAYERED		2		// one instance per view, each setting gl_Layer
+#define MULTIVIEW_LOOP			3		// one draw per view -- what is left when neither of those is there
+
+
+// this must match the std140 layout of ViewUniforms in views.glsl:
+
+struct ViewUniformData
+{
+	float	uViewModelView[MULTIVIEW_MAX_VIEWS][16];
+	float	uViewModelViewProjection[MULTIVIEW_MAX_VIEWS][16];
+	float	uViewNormal[MULTIVIEW_MAX_VIEWS][16];		// a mat3 in the upper left of a mat4
+	int	uFirstView;
+	int	pad[3];
+};
+
+
+// draws two or more views of a scene (the eyes of a stereo display, say) with each pass submitted once for all of them
+//
+// the views are the layers of a color and a depth texture array, and their matrices are in a uniform block,
+// so the cost per extra view is the vertices and pixels it adds, not another trip through the cpu and the driver:
+// the vertex shaders #include "views.glsl", are compiled with AddDefines( ), and take their matrices from the view
+// they are drawn for -- with GL_OVR_multiview2 the driver runs them once per view, and otherwise each draw is
+// instanced GetInstances( ) times and the vertex shader sends each instance to its own layer with gl_Layer
+// (GL_ARB_shader_viewport_layer_array or GL_AMD_vertex_shader_layer)
+// without any of those, each pass is drawn once per view, one layer at a time
+//
+// each frame: SetView( ) each view, Update( ), then for( p = 0; p < Begin( ); p++ ) { BeginPass( p ); draw; }, then End( ),
+// which puts the views side by side in the framebuffer that is to show them
+
+class MultiView
+{
+    private:
+	int			NumViews;
+	int			Method;
+	GLuint			Fbo;
+	GLuint			BlitFbo;		// one layer at a time, to read from in End( )
+	GLuint			ColorTex;		// GL_TEXTURE_2D_ARRAY, a layer per view
+	GLuint			DepthTex;
+	int			AllocWidth, AllocHeight;
+	int			Width, Height;		// of each view, this frame
+	GLuint			Ubo;
+	ViewUniformData		Data;
+	bool			Verbose;
+
+	void			Allocate( int, int );
+	static bool		HasExtension( const char * );
+
+    public:
+	MultiView( );
+	~MultiView( );
+
+	void			AddDefines( GLSLDefines & );
+	int			Begin( int, int );
+	void			BeginPass( int );
+	void			Bind( GLSLProgram * );
+	void			End( GLuint, int, int );
+	int			GetInstances( );
+	int			GetMethod( );
+	const char *		GetMethodName( );
+	int			GetNumViews( );
+	bool			Init( int );
+	void			SetVerbose( bool );
+	void			SetView( int, const glm::mat4 &, const glm::mat4 & );
+	void			Update( );
+};
+
+#endif		// #ifndef MULTI_VIEW_H
@@ -0,0 +1,185 @@
+#define _USE_MATH_DEFINES
+#include "noisebake.h"
+#include "glslprogram.h"
+#include "glstate.h"
+#include <math.h>
+
+#include <vector>
+
+
+// the analytic versions, for the cpu bake and for measuring the error of the lookups
+// (these must match common.glsl):
+
+static double
+SineSeries( double seed )
+{
+	return 8. * sin( seed * M_PI ) + 4. * sin( seed * 4. * M_PI ) + 2. * sin( seed * 8. * M_PI ) + sin( seed * 16. * M_PI );
+}
+
+
+// what GL_LINEAR + GL_REPEAT returns for texture coordinate u in one row of n texels:
+
+static double
+SampleLinear( const float *row, int n, double u )
+{
+	double x = u * (double)n - 0.5;
+	double x0 = floor( x );
+	double w = x - x0;
+	int i0 = ( (int)x0 % n + n ) % n;
+	int i1 = ( i0 + 1 ) % n;
+	return ( 1. - w ) * (double)row[i0]  +  w * (double)row[i1];
+}
+
+
+NoiseBake::NoiseBake( )
+{
+	SeriesTexture = 0;
+	Resolution = 0;
+	Verbose = false;
+}
+
+
+NoiseBake::~NoiseBake( )
+{
+	if( SeriesTexture != 0 )
+		glDeleteTextures( 1, &SeriesTexture );
+}
+
+
+// bind the lookup texture to this unit ( GL_TEXTURE0, GL_TEXTURE1, ... ):
+
+void
+NoiseBake::Bind( GLenum seriesUnit )
+{
+	GLState::BindTexture( seriesUnit, GL_TEXTURE_2D_ARRAY, SeriesTexture );
+}
+
+
+GLuint
+NoiseBake::GetSeriesTexture( )
+{
+	return SeriesTexture;
+}
+
+
+// create the texture and fill it in -- a window must be open and glew must be initialized:
+
+bool
+NoiseBake::Init( int resolution )
+{
+	Resolution = resolution;
+
+	glGenTextures( 1, &SeriesTexture );
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D_ARRAY, SeriesTexture );
+	glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT );
+	glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+	glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+	glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+	glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0 );
+	if( GLEW_ARB_texture_storage  ||  GLEW_VERSION_4_2 )
+		glTexStorage3D( GL_TEXTURE_2D_ARRAY, 1, GL_R32F, Resolution, 1, 2 );
+	else
+		glTexImage3D( GL_TEXTURE_2D_ARRAY, 0, GL_R32F, Resolution, 1, 2, 0, GL_RED, GL_FLOAT, NULL );
+
+	if( ! BakeOnGpu( ) )
+		BakeOnCpu( );
+
+	if( Verbose )
+		MeasureError( );
+	return true;
+}
+
+
+// run noisebake.cs, so that the tables hold exactly what the gpu's own sin( ) gives:
+
+bool
+NoiseBake::BakeOnGpu( )
+{
+	if( ! GLEW_ARB_compute_shader  ||  ! GLEW_ARB_shader_image_load_store )
+		return false;
+
+	GLSLProgram *bake = new GLSLProgram( );
+	bake->SetVerbose( Verbose );
+	if( ! bake->Create( "noisebake.cs" ) )
+	{
+		fprintf( stderr, "NoiseBake: noisebake.cs did not build -- baking on the cpu\n" );
+		delete bake;
+		return false;
+	}
+
+	glBindImageTexture( 0, SeriesTexture, 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_R32F );
+	bake->DispatchCompute( ( Resolution + 63 ) / 64, 1, 2 );
+
+	// the tables are read as a texture from now on:
+	glMemoryBarrier( GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT );
+	bake->Use( 0 );
+	delete bake;
+
+	if( Verbose )
+		fprintf( stderr, "NoiseBake: baked %d x 2 series tables on the gpu\n", Resolution );
+	return true;
+}
+
+
+void
+NoiseBake::BakeOnCpu( )
+{
+	std::vector<float> series( 2 * Resolution );
+	for( int i = 0; i < Resolution; i++ )
+	{
+		double u = ( (double)i + 0.5 ) / (double)Resolution;
+		series[i]              = (float)SineSeries( 2. * u );
+		series[Resolution + i] = (float)sin( 2. * M_PI * u );
+	}
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D_ARRAY, SeriesTexture );
+	glTexSubImage3D( GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, Resolution, 1, 2, GL_RED, GL_FLOAT, &series[0] );
+
+	if( Verbose )
+		fprintf( stderr, "NoiseBake: baked %d x 2 series tables on the cpu\n", Resolution );
+}
+
+
+// read the series layers back and compare what linear filtering returns
+// against the analytic functions, at 8 points between every pair of texels:
+
+void
+NoiseBake::MeasureError( )
+{
+	std::vector<float> series( 2 * Resolution );
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D_ARRAY, SeriesTexture );
+	GLint packAlignment;
+	glGetIntegerv( GL_PACK_ALIGNMENT, &packAlignment );
+	glPixelStorei( GL_PACK_ALIGNMENT, 1 );
+	glGetTexImage( GL_TEXTURE_2D_ARRAY, 0, GL_RED, GL_FLOAT, &series[0] );
+	glPixelStorei( GL_PACK_ALIGNMENT, packAlignment );
+
+	const int samples = 8 * Resolution;
+	double maxSeries = 0., sumSeries = 0.;
+	double maxSin = 0., sumSin = 0.;
+	for( int i = 0; i < samples; i++ )
+	{
+		double u = ( (double)i + 0.25 ) / (double)samples;
+
+		double e = fabs( SampleLinear( &series[0], Resolution, u ) - SineSeries( 2. * u ) );
+		if( e > maxSeries )
+			maxSeries = e;
+		sumSeries += e * e;
+
+		e = fabs( SampleLinear( &series[Resolution], Resolution, u ) - sin( 2. * M_PI * u ) );
+		if( e > maxSin )
+			maxSin = e;
+		sumSin += e * e;
+	}
+
+	// SineSeries( ) spans about -15. -> 15., but the beam only uses its fractional part,
+	// so its error is best read against 1.:
+	fprintf( stderr, "NoiseBake: %d-texel lookups vs. analytic -- SineSeries max %.2e rms %.2e, sin max %.2e rms %.2e\n",
+		Resolution, maxSeries, sqrt( sumSeries / (double)samples ), maxSin, sqrt( sumSin / (double)samples ) );
+}
+
+
+void
+NoiseBake::SetVerbose( bool v )
+{
+	Verbose = v;
+}
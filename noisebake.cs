@@ -0,0 +1,28 @@
+#version 430 compatibility
+#extension GL_ARB_compute_shader:                  enable
+#extension GL_ARB_shader_image_load_store:         enable
+
+// bakes the analytic noise functions from common.glsl into the lookup texture
+// that the USE_NOISE_LUT variants of the beam shaders sample (see noisebake.h)
+
+#include "common.glsl"
+
+// uSeries is 2 layers -- SineSeries( ) over seed in [0.,2.), then sin( ) over one period
+
+layout(r32f, binding = 0) uniform writeonly image2DArray uSeries;
+
+layout(local_size_x = 64, local_size_y = 1, local_size_z = 1) in;
+
+void main()
+{
+    ivec3 texel = ivec3(gl_GlobalInvocationID);
+
+    ivec3 size = imageSize(uSeries);
+    if (texel.x >= size.x || texel.z >= size.z)
+        return;
+
+    // texel centers, so that GL_LINEAR + GL_REPEAT reproduces the periodic function:
+    float u = (float(texel.x) + 0.5) / float(size.x);
+    float value = (texel.z == 0) ? SineSeries(2. * u) : sin(2. * M_PI * u);
+    imageStore(uSeries, texel, vec4(value, 0., 0., 0.));
+}
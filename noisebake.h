@@ -0,0 +1,52 @@
+#ifndef NOISE_BAKE_H
+#define NOISE_BAKE_H
+
+#include <stdio.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "glew.h"
+#include <GL/gl.h>
+
+
+// the lookup texture that replaces the per-fragment sin( ) calls in the beam shaders
+// when they are built with USE_NOISE_LUT (see BakedSineSeries( ) and BakedSin( ) in common.glsl):
+//
+//	SeriesTexture:	resolution x 1 x 2 layers, GL_R32F, linear, repeating in s
+//			layer 0 is SineSeries( seed ) for seed in [0.,2.) -- its period
+//			layer 1 is sin( x ) for x in [0.,2.*M_PI)
+//
+// it is a texture array, like the noise layers, so that every sampler in the beam shaders has the same type
+// (a program whose samplers of different types all start out on unit 0 fails glValidateProgram( ))
+//
+// it is baked by noisebake.cs when the driver can do compute shaders, and on the cpu otherwise
+// (with SetVerbose( true ), which the sample's --lut-error argument turns on, Init( ) also reads it back
+// and prints how far its lookups are from the analytic functions)
+
+#define NOISE_LUT_RESOLUTION	1024
+
+
+class NoiseBake
+{
+    private:
+	GLuint		SeriesTexture;
+	int		Resolution;
+	bool		Verbose;
+
+	bool		BakeOnGpu( );
+	void		BakeOnCpu( );
+	void		MeasureError( );
+
+    public:
+	NoiseBake( );
+	~NoiseBake( );
+
+	void		Bind( GLenum );
+	GLuint		GetSeriesTexture( );
+	bool		Init( int = NOISE_LUT_RESOLUTION );
+	void		SetVerbose( bool );
+};
+
+#endif		// #ifndef NOISE_BAKE_H
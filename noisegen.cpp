@@ -0,0 +1,208 @@
+#include "noisegen.h"
+#include "glslprogram.h"
+#include "glm/gtx/noise_batch.hpp"
+
+#include <math.h>
+#include <thread>
+
+
+NoiseGen::NoiseGen( )
+{
+	Size = 0;
+	BaseFrequency = 4;
+	Threads = 0;
+	Verbose = false;
+}
+
+
+// fill Levels[0] with size x size rgba noise, then build the rest of the mip chain
+// (size must be a power of 2, and baseFrequency must divide it for the noise to tile cleanly):
+
+bool
+NoiseGen::Generate( int size, int baseFrequency )
+{
+	if( size <= 0  ||  ( size & ( size - 1 ) ) != 0 )
+	{
+		fprintf( stderr, "NoiseGen: the size (%d) must be a power of 2\n", size );
+		return false;
+	}
+	Size = size;
+	BaseFrequency = baseFrequency;
+
+	int levels = MipLevels( Size );
+	Levels.resize( levels );
+	for( int l = 0, n = Size; l < levels; l++, n /= 2 )
+		Levels[l].resize( 4 * n * n );
+
+	int threads = Threads;
+	if( threads <= 0 )
+		threads = (int)std::thread::hardware_concurrency( );
+	if( threads <= 0 )
+		threads = 1;
+	if( threads > Size )
+		threads = Size;
+
+	// every thread gets a band of whole rows, so nothing is shared but the output array:
+	std::vector<std::thread> workers;
+	for( int i = 1; i < threads; i++ )
+		workers.push_back( std::thread( &NoiseGen::GenerateRows, this, i * Size / threads, ( i + 1 ) * Size / threads ) );
+	GenerateRows( 0, Size / threads );
+	for( int i = 0; i < (int)workers.size( ); i++ )
+		workers[i].join( );
+
+	for( int l = 1, n = Size; l < levels; l++, n /= 2 )
+		Downsample( &Levels[l-1][0], n, &Levels[l][0] );
+
+	if( Verbose )
+		fprintf( stderr, "NoiseGen: %d x %d, %d octaves from %d cells, %d levels, %d threads\n",
+			Size, Size, NOISE_GEN_OCTAVES, BaseFrequency, levels, threads );
+	return true;
+}
+
+
+void
+NoiseGen::GenerateRows( int t0, int t1 )
+{
+	// a row of one octave at a time goes to glm, which does as many texels at once as a vector register holds:
+	std::vector<glm::vec2> positions( Size );
+	std::vector<float> noise( Size );
+
+	unsigned char *row = &Levels[0][ 4 * t0 * Size ];
+	for( int t = t0; t < t1; t++, row += 4 * Size )
+	{
+		float ft = ( (float)t + 0.5f ) / (float)Size;
+		float freq = (float)BaseFrequency;
+		for( int o = 0; o < NOISE_GEN_OCTAVES; o++, freq *= 2.f )
+		{
+			for( int s = 0; s < Size; s++ )
+			{
+				float fs = ( (float)s + 0.5f ) / (float)Size;
+				positions[s] = glm::vec2( fs * freq, ft * freq );
+			}
+
+			// the period is the number of cells across, so the right edge meets the left:
+			glm::perlin( &positions[0], glm::vec2( freq, freq ), &noise[0], Size );
+
+			unsigned char *rgba = row + o;
+			for( int s = 0; s < Size; s++, rgba += 4 )
+			{
+				float v = 0.5f + 0.5f * noise[s];
+				if( v < 0.f )	v = 0.f;
+				if( v > 1.f )	v = 1.f;
+				*rgba = (unsigned char)( 255.f * v + 0.5f );
+			}
+		}
+	}
+}
+
+
+// run noisegen.cs into level 0 of one layer of a GL_RGBA8 texture array, then have the driver build its mips
+// (this regenerates the mips of every layer in the array)
+// returns false if the driver can't do it, and the cpu path should be used instead:
+
+bool
+NoiseGen::GenerateOnGpu( GLuint texture, int layer, int size, int baseFrequency )
+{
+	if( ! GLEW_ARB_compute_shader  ||  ! GLEW_ARB_shader_image_load_store )
+		return false;
+
+	GLSLProgram *gen = new GLSLProgram( );
+	gen->SetVerbose( Verbose );
+	if( ! gen->Create( "noisegen.cs" ) )
+	{
+		fprintf( stderr, "NoiseGen: noisegen.cs did not build -- generating on the cpu\n" );
+		delete gen;
+		return false;
+	}
+
+	Size = size;
+	BaseFrequency = baseFrequency;
+	Levels.clear( );
+
+	glBindImageTexture( 0, texture, 0, GL_FALSE, layer, GL_WRITE_ONLY, GL_RGBA8 );
+	gen->SetUniformVariable( "uBaseFrequency", (float)baseFrequency );
+	gen->DispatchCompute( ( size + 7 ) / 8, ( size + 7 ) / 8, 1 );
+	glMemoryBarrier( GL_TEXTURE_FETCH_BARRIER_BIT | GL_TEXTURE_UPDATE_BARRIER_BIT );
+	gen->Use( 0 );
+	delete gen;
+
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D_ARRAY, texture );
+	glGenerateMipmap( GL_TEXTURE_2D_ARRAY );
+
+	if( Verbose )
+		fprintf( stderr, "NoiseGen: %d x %d, %d octaves from %d cells, on the gpu\n", Size, Size, NOISE_GEN_OCTAVES, BaseFrequency );
+	return true;
+}
+
+
+int
+NoiseGen::GetLevelCount( )
+{
+	return (int)Levels.size( );
+}
+
+
+const unsigned char *
+NoiseGen::GetLevel( int level )
+{
+	if( level < 0  ||  level >= (int)Levels.size( ) )
+		return NULL;
+	return &Levels[level][0];
+}
+
+
+int
+NoiseGen::GetSize( )
+{
+	return Size;
+}
+
+
+// 0 means one per hardware thread:
+
+void
+NoiseGen::SetThreads( int threads )
+{
+	Threads = threads;
+}
+
+
+void
+NoiseGen::SetVerbose( bool v )
+{
+	Verbose = v;
+}
+
+
+// average each 2x2 block of an n x n rgba image into an (n/2) x (n/2) one:
+
+void
+NoiseGen::Downsample( const unsigned char *src, int n, unsigned char *dst )
+{
+	int half = n / 2;
+	for( int t = 0; t < half; t++ )
+	{
+		const unsigned char *row0 = &src[ 4 * ( 2*t ) * n ];
+		const unsigned char *row1 = row0 + 4 * n;
+		for( int s = 0; s < half; s++, row0 += 8, row1 += 8, dst += 4 )
+		{
+			for( int c = 0; c < 4; c++ )
+				dst[c] = (unsigned char)( ( row0[c] + row0[c+4] + row1[c] + row1[c+4] + 2 ) / 4 );
+		}
+	}
+}
+
+
+// how many levels a full mip chain of a size x size texture has:
+
+int
+NoiseGen::MipLevels( int size )
+{
+	int levels = 1;
+	while( size > 1 )
+	{
+		size /= 2;
+		levels++;
+	}
+	return levels;
+}
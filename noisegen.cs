@@ -0,0 +1,78 @@
+#version 430 compatibility
+#extension GL_ARB_compute_shader:                  enable
+#extension GL_ARB_shader_image_load_store:         enable
+
+// the gpu version of NoiseGen::Generate( ) (see noisegen.h):
+// r, g, b, a are octaves of periodic perlin noise with uBaseFrequency, 2x, 4x, and 8x that many cells across
+
+layout(rgba8, binding = 0) uniform writeonly image2D uNoise;		// one layer of the noise array
+uniform float uBaseFrequency;
+
+layout(local_size_x = 8, local_size_y = 8, local_size_z = 1) in;
+
+
+// classic perlin noise with an explicit period
+// (Stefan Gustavson's pnoise( ) -- the same one glm::perlin( p, rep ) is ported from)
+
+vec4 mod289(vec4 x) { return x - floor(x * (1. / 289.)) * 289.; }
+vec4 permute(vec4 x) { return mod289(((x * 34.) + 1.) * x); }
+vec4 taylorInvSqrt(vec4 r) { return 1.79284291400159 - 0.85373472095314 * r; }
+vec2 fade(vec2 t) { return t * t * t * (t * (t * 6. - 15.) + 10.); }
+
+float
+pnoise(vec2 P, vec2 rep)
+{
+    vec4 Pi = floor(P.xyxy) + vec4(0., 0., 1., 1.);
+    vec4 Pf = fract(P.xyxy) - vec4(0., 0., 1., 1.);
+    Pi = mod(Pi, rep.xyxy);
+    Pi = mod289(Pi);
+    vec4 ix = Pi.xzxz;
+    vec4 iy = Pi.yyww;
+    vec4 fx = Pf.xzxz;
+    vec4 fy = Pf.yyww;
+
+    vec4 i = permute(permute(ix) + iy);
+
+    vec4 gx = 2. * fract(i / 41.) - 1.;
+    vec4 gy = abs(gx) - 0.5;
+    vec4 tx = floor(gx + 0.5);
+    gx = gx - tx;
+
+    vec2 g00 = vec2(gx.x, gy.x);
+    vec2 g10 = vec2(gx.y, gy.y);
+    vec2 g01 = vec2(gx.z, gy.z);
+    vec2 g11 = vec2(gx.w, gy.w);
+
+    vec4 norm = taylorInvSqrt(vec4(dot(g00, g00), dot(g01, g01), dot(g10, g10), dot(g11, g11)));
+    g00 *= norm.x;
+    g01 *= norm.y;
+    g10 *= norm.z;
+    g11 *= norm.w;
+
+    float n00 = dot(g00, vec2(fx.x, fy.x));
+    float n10 = dot(g10, vec2(fx.y, fy.y));
+    float n01 = dot(g01, vec2(fx.z, fy.z));
+    float n11 = dot(g11, vec2(fx.w, fy.w));
+
+    vec2 fade_xy = fade(Pf.xy);
+    vec2 n_x = mix(vec2(n00, n01), vec2(n10, n11), fade_xy.x);
+    float n_xy = mix(n_x.x, n_x.y, fade_xy.y);
+    return 2.3 * n_xy;
+}
+
+
+void main()
+{
+    ivec2 texel = ivec2(gl_GlobalInvocationID.xy);
+    ivec2 size = imageSize(uNoise);
+    if (texel.x >= size.x || texel.y >= size.y)
+        return;
+
+    vec2 st = (vec2(texel) + 0.5) / vec2(size);
+    vec4 octaves;
+    float freq = uBaseFrequency;
+    for (int o = 0; o < 4; o++, freq *= 2.)
+        octaves[o] = pnoise(st * freq, vec2(freq));
+
+    imageStore(uNoise, texel, clamp(0.5 + 0.5 * octaves, 0., 1.));
+}
@@ -0,0 +1,54 @@
+#ifndef NOISE_GEN_H
+#define NOISE_GEN_H
+
+#include <stdio.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "glew.h"
+#include <GL/gl.h>
+
+#include <vector>
+
+
+// tileable multi-octave noise, built at startup instead of being read from a bmp
+//
+// each of r, g, b, a is one octave of periodic perlin noise, mapped to [0.,1.] around 0.5:
+// r has baseFrequency cells across the texture, g twice that, b four times, and a eight times
+// (so r + g + b + a - 2. is four-octave noise centered on 0., the way the beam shaders use it)
+//
+// the cpu path splits the rows over every hardware thread and builds the whole mip chain;
+// the gpu path runs noisegen.cs into one layer of a texture array and lets the driver build the mips
+
+#define NOISE_GEN_OCTAVES	4
+
+
+class NoiseGen
+{
+    private:
+	int		Size;
+	int		BaseFrequency;
+	int		Threads;
+	bool		Verbose;
+	std::vector< std::vector<unsigned char> >	Levels;		// rgba, Levels[0] is Size x Size
+
+	void		GenerateRows( int, int );
+
+    public:
+	NoiseGen( );
+
+	bool		Generate( int, int = 4 );
+	bool		GenerateOnGpu( GLuint, int, int, int = 4 );
+	int		GetLevelCount( );
+	const unsigned char *	GetLevel( int );
+	int		GetSize( );
+	void		SetThreads( int );
+	void		SetVerbose( bool );
+
+	static void	Downsample( const unsigned char *, int, unsigned char * );
+	static int	MipLevels( int );
+};
+
+#endif		// #ifndef NOISE_GEN_H
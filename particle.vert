@@ -2,6 +2,8 @@
 
 uniform int uIndex;
 
+#include "views.glsl"
+
 
 layout (std140, binding = 4) buffer Pos{
 	vec4 Positions[];
@@ -20,5 +22,6 @@ main()
 {
 	vec4 pos = Positions[1];
 
-	gl_Position = gl_ModelViewProjectionMatrix * pos;
+	gl_Position = ViewModelViewProjectionMatrix * pos;
+	SetViewLayer();
 }
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include "reducedpass.h"
+#include "glstate.h"
+
+#include <algorithm>
+
+
+// the texture units the composite reads from:
+#define LOW_COLOR_UNIT		GL_TEXTURE12
+#define LOW_DEPTH_UNIT		GL_TEXTURE13
+#define SCENE_DEPTH_UNIT	GL_TEXTURE14
+
+
+ReducedPass::ReducedPass( )
+{
+	Fbo = ColorTex = DepthTex = 0;
+	AllocWidth = AllocHeight = 0;
+	CompositeFbo = CompositeColor = 0;
+	SceneFbo = SceneColor = SceneDepth = 0;
+	for( int i = 0; i < 4; i++ )
+		SceneViewport[i] = LowViewport[i] = 0;
+	Upsample = NULL;
+	SceneBlend = false;
+	SceneBlendFunc[0] = SceneBlendFunc[2] = GL_ONE;
+	SceneBlendFunc[1] = SceneBlendFunc[3] = GL_ZERO;
+	Divisor = 2;
+	Active = false;
+	Verbose = false;
+}
+
+
+ReducedPass::~ReducedPass( )
+{
+	if( Fbo != 0 )
+		glDeleteFramebuffers( 1, &Fbo );
+	if( CompositeFbo != 0 )
+		glDeleteFramebuffers( 1, &CompositeFbo );
+	if( ColorTex != 0 )
+		glDeleteTextures( 1, &ColorTex );
+	if( DepthTex != 0 )
+		glDeleteTextures( 1, &DepthTex );
+	delete Upsample;
+}
+
+
+// (re)make the reduced target -- it only ever grows, and each frame uses as much of it as it needs:
+
+void
+ReducedPass::Allocate( int width, int height )
+{
+	AllocWidth = width;
+	AllocHeight = height;
+
+	if( Fbo == 0 )
+		glGenFramebuffers( 1, &Fbo );
+	if( ColorTex == 0 )
+		glGenTextures( 1, &ColorTex );
+	if( DepthTex == 0 )
+		glGenTextures( 1, &DepthTex );
+
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D, ColorTex );
+	glTexImage2D( GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D, DepthTex );
+	glTexImage2D( GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, width, height, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+	glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D, 0 );
+
+	glBindFramebuffer( GL_FRAMEBUFFER, Fbo );
+	glFramebufferTexture2D( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ColorTex, 0 );
+	glFramebufferTexture2D( GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, DepthTex, 0 );
+	GLenum status = glCheckFramebufferStatus( GL_FRAMEBUFFER );
+	if( status != GL_FRAMEBUFFER_COMPLETE )
+	{
+		fprintf( stderr, "ReducedPass: the %dx%d target is not complete (0x%04x) -- drawing at full resolution\n",
+			width, height, status );
+		Divisor = 1;
+	}
+	else if( Verbose )
+	{
+		fprintf( stderr, "ReducedPass: target is %dx%d\n", width, height );
+	}
+}
+
+
+// start drawing the pass at 1/GetDivisor( ) of the resolution of the scene, which is in sceneFbo (whose color and
+// depth are the textures sceneColor and sceneDepth), drawn with the viewport x, y, width, height
+// returns false, having changed nothing, if the pass should just be drawn into the scene as usual:
+
+bool
+ReducedPass::Begin( GLuint sceneFbo, GLuint sceneColor, GLuint sceneDepth, GLint x, GLint y, GLsizei width, GLsizei height )
+{
+	Active = false;
+	if( Divisor <= 1  ||  sceneFbo == 0  ||  sceneColor == 0  ||  sceneDepth == 0  ||  Upsample == NULL  ||  ! Upsample->IsValid( ) )
+		return false;
+
+	SceneFbo = sceneFbo;
+	SceneColor = sceneColor;
+	SceneDepth = sceneDepth;
+	SceneViewport[0] = x;
+	SceneViewport[1] = y;
+	SceneViewport[2] = width;
+	SceneViewport[3] = height;
+
+	LowViewport[0] = x / Divisor;
+	LowViewport[1] = y / Divisor;
+	LowViewport[2] = ( width + Divisor - 1 ) / Divisor;
+	LowViewport[3] = ( height + Divisor - 1 ) / Divisor;
+	int needWidth = LowViewport[0] + LowViewport[2];
+	int needHeight = LowViewport[1] + LowViewport[3];
+	if( needWidth > AllocWidth  ||  needHeight > AllocHeight )
+		Allocate( std::max( needWidth, AllocWidth ), std::max( needHeight, AllocHeight ) );
+	if( Divisor <= 1 )
+	{
+		glBindFramebuffer( GL_FRAMEBUFFER, SceneFbo );
+		return false;
+	}
+
+	// the scene's depth, so the pass is hidden where the scene is in front of it:
+	glBindFramebuffer( GL_READ_FRAMEBUFFER, SceneFbo );
+	glBindFramebuffer( GL_DRAW_FRAMEBUFFER, Fbo );
+	glBlitFramebuffer( x, y, x + width, y + height,
+		LowViewport[0], LowViewport[1], LowViewport[0] + LowViewport[2], LowViewport[1] + LowViewport[3],
+		GL_DEPTH_BUFFER_BIT, GL_NEAREST );
+	glBindFramebuffer( GL_FRAMEBUFFER, Fbo );
+	glDrawBuffer( GL_COLOR_ATTACHMENT0 );
+
+	static const GLfloat clear[4] = { 0., 0., 0., 0. };
+	glClearBufferfv( GL_COLOR, 0, clear );
+
+	GLState::Viewport( LowViewport[0], LowViewport[1], LowViewport[2], LowViewport[3] );
+	SceneBlend = GLState::IsEnabled( GL_BLEND );
+	GLState::GetBlendFuncSeparate( &SceneBlendFunc[0], &SceneBlendFunc[1], &SceneBlendFunc[2], &SceneBlendFunc[3] );
+	GLState::Enable( GL_BLEND );
+	GLState::BlendFuncSeparate( GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA );
+	GLState::DepthMask( GL_FALSE );
+
+	Active = true;
+	return true;
+}
+
+
+// blend what was drawn since Begin( ) back over the scene, and leave the scene's framebuffer and viewport bound,
+// and the blending as Begin( ) found it
+// (near, far, and ortho describe the projection, so the composite can compare depths in eye space):
+
+void
+ReducedPass::Composite( float nearPlane, float farPlane, bool ortho )
+{
+	if( ! Active )
+		return;
+	Active = false;
+
+	GLState::DepthMask( GL_TRUE );
+
+	// the composite reads the scene's depth, so it draws through a framebuffer that has only the scene's color:
+	if( CompositeFbo == 0 )
+		glGenFramebuffers( 1, &CompositeFbo );
+	glBindFramebuffer( GL_FRAMEBUFFER, CompositeFbo );
+	if( CompositeColor != SceneColor )
+	{
+		glFramebufferTexture2D( GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, SceneColor, 0 );
+		CompositeColor = SceneColor;
+	}
+	glDrawBuffer( GL_COLOR_ATTACHMENT0 );
+
+	GLState::Viewport( SceneViewport[0], SceneViewport[1], SceneViewport[2], SceneViewport[3] );
+	GLState::Disable( GL_DEPTH_TEST );
+	GLState::Enable( GL_BLEND );
+	GLState::BlendFunc( GL_ONE, GL_ONE_MINUS_SRC_ALPHA );
+	GLState::BindTexture( LOW_COLOR_UNIT, GL_TEXTURE_2D, ColorTex );
+	GLState::BindTexture( LOW_DEPTH_UNIT, GL_TEXTURE_2D, DepthTex );
+	GLState::BindTexture( SCENE_DEPTH_UNIT, GL_TEXTURE_2D, SceneDepth );
+
+	Upsample->SetUniformVariable( USceneViewport, glm::vec4( SceneViewport[0], SceneViewport[1], SceneViewport[2], SceneViewport[3] ) );
+	Upsample->SetUniformVariable( ULowViewport, glm::vec4( LowViewport[0], LowViewport[1], LowViewport[2], LowViewport[3] ) );
+	Upsample->SetUniformVariable( UNear, nearPlane );
+	Upsample->SetUniformVariable( UFar, farPlane );
+	Upsample->SetUniformVariable( UOrtho, ortho ? 1 : 0 );
+
+	Upsample->Use( );
+	Upsample->BeginProfile( "reduced composite" );
+	glBegin( GL_QUADS );
+		glVertex2f( -1., -1. );
+		glVertex2f(  1., -1. );
+		glVertex2f(  1.,  1. );
+		glVertex2f( -1.,  1. );
+	glEnd( );
+	Upsample->EndProfile( );
+	Upsample->Use( 0 );
+
+	GLState::Enable( GL_DEPTH_TEST );
+	GLState::SetCap( GL_BLEND, SceneBlend );
+	GLState::BlendFuncSeparate( SceneBlendFunc[0], SceneBlendFunc[1], SceneBlendFunc[2], SceneBlendFunc[3] );
+	glBindFramebuffer( GL_FRAMEBUFFER, SceneFbo );
+}
+
+
+// collect the composite program that Init( ) started, and set its samplers:
+
+bool
+ReducedPass::Finish( )
+{
+	if( Upsample == NULL  ||  ! Upsample->Finish( ) )
+	{
+		fprintf( stderr, "ReducedPass: cannot compile the composite -- drawing at full resolution\n" );
+		Divisor = 1;
+		return false;
+	}
+
+	Upsample->SetUniformVariable( Upsample->GetUniform( "uLowColor" ), (int)( LOW_COLOR_UNIT - GL_TEXTURE0 ) );
+	Upsample->SetUniformVariable( Upsample->GetUniform( "uLowDepth" ), (int)( LOW_DEPTH_UNIT - GL_TEXTURE0 ) );
+	Upsample->SetUniformVariable( Upsample->GetUniform( "uSceneDepth" ), (int)( SCENE_DEPTH_UNIT - GL_TEXTURE0 ) );
+	USceneViewport = Upsample->GetUniform( "uSceneViewport" );
+	ULowViewport = Upsample->GetUniform( "uLowViewport" );
+	UNear = Upsample->GetUniform( "uNear" );
+	UFar = Upsample->GetUniform( "uFar" );
+	UOrtho = Upsample->GetUniform( "uOrtho" );
+	return true;
+}
+
+
+int
+ReducedPass::GetDivisor( )
+{
+	return Divisor;
+}
+
+
+// start compiling the composite (Finish( ) collects it):
+
+void
+ReducedPass::Init( )
+{
+	if( ! GLEW_VERSION_3_0  &&  ! GLEW_ARB_framebuffer_object )
+	{
+		fprintf( stderr, "ReducedPass: no framebuffer objects -- drawing at full resolution\n" );
+		Divisor = 1;
+		return;
+	}
+
+	Upsample = new GLSLProgram( );
+	Upsample->CreateAsync( "upsample.vert", "upsample.frag" );
+}
+
+
+// 1 (full resolution), 2 (half), or 4 (a quarter):
+
+void
+ReducedPass::SetDivisor( int divisor )
+{
+	Divisor = divisor > 1 ? divisor : 1;
+}
+
+
+void
+ReducedPass::SetVerbose( bool v )
+{
+	Verbose = v;
+}
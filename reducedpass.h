@@ -0,0 +1,70 @@
+#ifndef REDUCED_PASS_H
+#define REDUCED_PASS_H
+
+#include <stdio.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "glew.h"
+#include <GL/gl.h>
+
+#include "glslprogram.h"
+
+
+// draws one pass at half or a quarter of the scene's resolution, and composites it back over the scene
+//
+// Begin( ) downsamples the scene's depth into a small color+depth target and binds it, so whatever is drawn next is
+// depth-tested against the scene there -- it is blended in premultiplied by its alpha, and does not write depth
+// Composite( ) then puts it back over the full-resolution scene with upsample.frag, a bilateral filter that weighs
+// each reduced texel by how close the scene's depth there is to the depth at the full-resolution pixel
+//
+// the scene has to be in a framebuffer object whose depth is a texture (see DynamicResolution), since the
+// composite reads it -- with a divisor of 1, or when drawing straight to the window, Begin( ) returns false
+// and the pass should just be drawn at full resolution
+
+class ReducedPass
+{
+    private:
+	GLuint			Fbo;
+	GLuint			ColorTex;
+	GLuint			DepthTex;
+	int			AllocWidth, AllocHeight;
+	GLuint			CompositeFbo;		// the scene's color texture alone, so its depth can be read while compositing
+	GLuint			CompositeColor;		// what is attached to CompositeFbo
+
+	GLuint			SceneFbo;
+	GLuint			SceneColor;
+	GLuint			SceneDepth;
+	GLint			SceneViewport[4];
+	GLint			LowViewport[4];
+
+	GLSLProgram *		Upsample;
+	GLSLUniform		USceneViewport;
+	GLSLUniform		ULowViewport;
+	GLSLUniform		UNear, UFar, UOrtho;
+
+	bool			SceneBlend;		// the blending Begin( ) found, which Composite( ) puts back
+	GLenum			SceneBlendFunc[4];
+
+	int			Divisor;
+	bool			Active;			// between a Begin( ) that returned true, and Composite( )
+	bool			Verbose;
+
+	void			Allocate( int, int );
+
+    public:
+	ReducedPass( );
+	~ReducedPass( );
+
+	bool			Begin( GLuint, GLuint, GLuint, GLint, GLint, GLsizei, GLsizei );
+	void			Composite( float, float, bool );
+	bool			Finish( );
+	int			GetDivisor( );
+	void			Init( );
+	void			SetDivisor( int );
+	void			SetVerbose( bool );
+};
+
+#endif		// #ifndef REDUCED_PASS_H
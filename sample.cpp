@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include <string.h>
 
 #define _USE_MATH_DEFINES
 #include <math.h>
@@ -18,8 +19,21 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtx/fast_trigonometry.hpp>
 #include "vertexbufferobject.h"
 #include "glslprogram.h"
+#include "noisebake.h"
+#include "noisegen.h"
+#include "bmpimage.h"
+#include "ktxtexture.h"
+#include "texturestreamer.h"
+#include "jobgraph.h"
+#include "framescheduler.h"
+#include "dynamicresolution.h"
+#include "reducedpass.h"
+#include "inputrecorder.h"
+#include "benchmark.h"
+#include "multiview.h"
 
 //	The left mouse button does rotation
 //	The middle mouse button does scaling
@@ -68,6 +82,10 @@ const float SCLFACT = { 0.005f };
 // minimum allowable scale factor:
 const float MINSCALE = { 0.05f };
 
+// the near and far clipping distances, for both projections:
+const float NEAR_PLANE = { 0.1f };
+const float FAR_PLANE  = { 1000.f };
+
 // scroll wheel button values:
 const int SCROLL_WHEEL_UP   = { 3 };
 const int SCROLL_WHEEL_DOWN = { 4 };
@@ -127,15 +145,22 @@ GLuint	AxesList;				// list to hold the axes
 int		AxesOn;					// != 0 means to draw the axes
 int		DebugOn;				// != 0 means to print debugging info
 int		MainWindow;				// window id for main graphics window
+bool	StateStatsOn;			// print the GLState issued/filtered counts every frame
+bool	TimingStatsOn;			// print the FrameScheduler's frame timing every second
 float	Scale;					// scaling factor
 int		WhichProjection;		// ORTHO or PERSP
 int		Xmouse, Ymouse;			// mouse values
 float	Xrot, Yrot;				// rotation angles in degrees
 // Beam Objects
-VertexBufferObject* BeamVBO;
-GLSLProgram*		BeamShader;
-GLuint				NoiseTexture;
-GLuint				NoiseMask;
+#define NUM_BEAM_LODS		3			// levels of detail the beam can be built at
+VertexBufferObject* BeamVBO;			// one of BeamLods
+VertexBufferObject* BeamLods[NUM_BEAM_LODS];	// built as they are needed
+int					BeamLod;
+GLSLProgram*		BeamShader;		// BeamShaders[UseNoiseLut]
+GLSLProgram*		BeamShaders[2];		// [0]: analytic noise, [1]: baked noise lookups
+GLuint				NoiseLayers;		// GL_TEXTURE_2D_ARRAY: noise, noise mask, whoosh (a placeholder until they are streamed in)
+int					NoiseLayersPending;	// layers the streamer has not uploaded yet
+TextureStreamer*	Streamer;
 GLSLProgram*		BeamMainParticles;
 GLuint				PosSSBO;
 GLuint				VelSSBO;
@@ -143,10 +168,48 @@ GLuint				ColSSBO;
 VertexBufferObject* ParticleVBO;
 GLSLProgram*		ParticleShader;
 GLuint				ParticleTexture;
-GLSLProgram*		WhooshShader;
-GLuint				WhooshTexture;
+GLSLProgram*		WhooshShader;		// WhooshShaders[UseNoiseLut]
+GLSLProgram*		WhooshShaders[2];
+NoiseBake*			NoiseLuts;			// the baked lookups for the USE_NOISE_LUT variants
+bool				LutErrorOn;			// have NoiseLuts print how far its lookups are from the functions they replace
+bool				UseNoiseLut;
+FrameUniforms*		PerFrame;
+FrameScheduler*		Scheduler;		// paces the frames and ticks Animate( )
+DynamicResolution*	Resolution;		// the scene's render target, scaled to hold the gpu to FRAME_BUDGET_MS
+ReducedPass*		WhooshPass;		// draws the whoosh at 1/WHOOSH_DIVISOR of the resolution
+InputRecorder*		Recorder;		// records the input to a file (--record), or plays it back (--replay)
+Benchmark*			Bench;			// runs the --bench matrix, or is NULL
+char*				BenchOutName;		// what --bench writes .json and .csv files of
+MultiView*			Views;			// draws --views n views at once, or is NULL
+bool				ViewsOn;		// draw the views ('m'), rather than the one
+GLSLProgram*		BeamViewShaders[2];	// the view variants of BeamShaders, WhooshShaders, and ParticleShader
+GLSLProgram*		WhooshViewShaders[2];
+GLSLProgram*		ParticleViewShader;
+// the layers of NoiseLayers -- these are also #defined in the beam-family shaders:
+#define NOISE_LAYER		0
+#define NOISE_MASK_LAYER	1
+#define WHOOSH_LAYER		2
+#define NUM_NOISE_LAYERS	3
+#define NOISE_LAYER_SIZE	512			// every layer gets resampled to this -- must be a power of 2
+#define NOISE_BASE_FREQUENCY	4			// perlin cells across the lowest octave of the noise layer
+#define NOISE_ON_GPU		false			// true = generate the noise layer with noisegen.cs
 #define NUM_PARTICLES		64 * 64
+#define MAX_PARTICLES		64 * 64 * 4		// the particle buffers hold this many -- the benchmark draws up to it
 #define WORK_GROUP_SIZE		128
+#define FRAME_RATE		60.			// frames per second, or 0 to be paced by vsync
+#define TICK_RATE		60.			// Animate( )s per second -- the particle update steps a fixed DT
+#define MAX_CATCH_UP_TICKS	4			// Animate( )s per frame at most, after a hitch
+#define FRAME_BUDGET_MS		16.6			// gpu milliseconds per frame that the resolution scaling aims for
+#define MIN_RESOLUTION_SCALE	0.25			// fraction of the window size the scene can be drawn at, at least
+#define WHOOSH_DIVISOR		2			// the whoosh is drawn at 1/this of the scene's resolution (1, 2, or 4)
+#define BEAM_LOD		1			// the beam's level of detail (CreateBeam( )'s first argument)
+#define BENCH_OUT		"bench"			// --bench writes BENCH_OUT.json and BENCH_OUT.csv
+#define STEREO_SEPARATION	0.1f			// between the eyes of neighboring views
+#define STEREO_CONVERGENCE	3.f			// how far in front of the eyes the views line up (the look-at point)
+// the --bench matrix:
+const int	BenchParticleCounts[ ] = { 1024, 4096, 16384 };
+const int	BenchLods[ ] = { 0, 1, 2 };
+int		NumParticles = NUM_PARTICLES;		// how many of the MAX_PARTICLES are updated and drawn
 // Animation Timers
 const int   MS_IN_STAR_ANIMATION = 1000;
 const int   MS_IN_BUMP_ANIMATION = 10000;
@@ -159,36 +222,49 @@ float		StarTime;
 
 // function prototypes:
 void	Animate( );
+void	BenchApply( const BenchCamera &, int, int, bool );
 void	Display( );
 void	DoAxesMenu( int );
 void	DoMainMenu( int );
 void	DoProjectMenu( int );
 void	DoRasterString( float, float, float, char * );
 void	DoStrokeString( float, float, float, float, char * );
+void	DrawScene( bool, GLint, GLint, GLsizei );
+void	DrawViews( const glm::mat4 &, int, int );
+void	FinishBench( );
 float	ElapsedSeconds( );
+void	BakeNoiseLuts( );
+void	BuildMeshes( );
+void	CompileShaders( );
+void	FinishShaders( );
 void	InitGraphics( );
 void	InitLists( );
 void	InitMenus( );
+void	InitTextures( );
 void	Keyboard( unsigned char, int, int );
 void	MouseButton( int, int, int, int );
 void	MouseMotion( int, int );
 void	Reset( );
 void	Resize( int, int );
+void	RunBenchHidden( );
 void	Visibility( int );
 // Utility Functions
 void			Axes( float );
-unsigned char*	BmpToTexture( char *, int *, int * );
+bool			DecodeNoiseLayer( int, unsigned char * );
+GLuint			LoadNoiseLayers( );
 unsigned char*  ReadTexture2D(char*, int*, int*);
 void			HsvRgb( float[3], float [3] );
-int				ReadInt( FILE * );
-short			ReadShort( FILE * );
 // Transformation Functions
 void			Cross(float[3], float[3], float[3]);
 float			Dot(float [3], float [3]);
 float			Unit(float [3], float [3]);
 float			SmoothStep(float, float, float);
 // Geometry Functions
+VertexBufferObject*	BuildBeam( int );
 void			CreateBeam(int, float, float, int, int, int, int);
+void			ResetParticles( );
+void			SeedParticles( );
+void			SetBeamLod( int );
 void			SetupParticleBuffer();
 
 // main program:
@@ -200,11 +276,90 @@ main( int argc, char *argv[ ] )
 	// pull some command line arguments out)
 	glutInit( &argc, argv );
 
-	// setup all the graphics stuff:
+	// what is left is ours:
+	//	--record file		write the keyboard and mouse input, and the frames' ticks, to file
+	//	--replay file		play back a --record file, exactly, and print how long its frames took
+	//	--bench			run the benchmark matrix, write BENCH_OUT.json and BENCH_OUT.csv, and exit
+	//	--hidden		... and run it in a loop of its own, with the window hidden, rather than in glut's
+	//				(this is not headless: it still needs a display, and a window for the gl context)
+	//	--warmup n, --frames n	frames per benchmark run to warm up with, and to measure
+	//	--out name		write the benchmark to name.json and name.csv
+	//	--views n		draw n views of the scene side by side, each pass submitted once for all of them ('m' switches)
+	//	--lut-error		print the error of the baked noise lookups against the functions they replace
+	char *recordFile = NULL;
+	char *replayFile = NULL;
+	bool bench = false;
+	BenchOutName = (char *)BENCH_OUT;
+	bool hidden = false;
+	int benchWarmup = BENCH_DEFAULT_WARMUP;
+	int benchFrames = BENCH_DEFAULT_FRAMES;
+	int numViews = 1;
+	for( int i = 1; i < argc; i++ )
+	{
+		if( strcmp( argv[i], "--record" ) == 0  &&  i+1 < argc )
+			recordFile = argv[++i];
+		else if( strcmp( argv[i], "--replay" ) == 0  &&  i+1 < argc )
+			replayFile = argv[++i];
+		else if( strcmp( argv[i], "--bench" ) == 0 )
+			bench = true;
+		else if( strcmp( argv[i], "--hidden" ) == 0 )
+			bench = hidden = true;
+		else if( strcmp( argv[i], "--warmup" ) == 0  &&  i+1 < argc )
+			benchWarmup = atoi( argv[++i] );
+		else if( strcmp( argv[i], "--frames" ) == 0  &&  i+1 < argc )
+			benchFrames = atoi( argv[++i] );
+		else if( strcmp( argv[i], "--out" ) == 0  &&  i+1 < argc )
+			BenchOutName = argv[++i];
+		else if( strcmp( argv[i], "--views" ) == 0  &&  i+1 < argc )
+			numViews = atoi( argv[++i] );
+		else if( strcmp( argv[i], "--lut-error" ) == 0 )
+			LutErrorOn = true;
+		else
+			fprintf( stderr, "Don't know what to do with the argument '%s'\n", argv[i] );
+	}
+
+	// open the window and setup the callbacks and glew:
 	InitGraphics( );
 
-	// create the display structures that will not change:
-	InitLists( );
+	// pick how the views get drawn before the shaders are compiled, since it picks their variants:
+	if( numViews > 1 )
+	{
+		Views = new MultiView( );
+		Views->SetVerbose( true );
+		if( Views->Init( numViews ) )
+		{
+			ViewsOn = true;
+		}
+		else
+		{
+			delete Views;
+			Views = NULL;
+		}
+	}
+
+	// then get everything the first frame needs ready as a graph of jobs,
+	// so that the cpu-only ones run on other threads while this one does the gl ones:
+	JobGraph startup;
+	int shaders   = startup.Add( "start shader compiles", CompileShaders, JOB_ON_GL_THREAD );
+	int textures  = startup.Add( "start noise streaming", InitTextures,   JOB_ON_GL_THREAD );
+	int luts      = startup.Add( "bake noise luts",       BakeNoiseLuts,  JOB_ON_GL_THREAD );
+	int seed      = startup.Add( "seed particles",        SeedParticles,  JOB_ON_POOL );
+	int particles = startup.Add( "particle buffers",      SetupParticleBuffer, JOB_ON_GL_THREAD );
+	int meshes    = startup.Add( "build meshes",          BuildMeshes,    JOB_ON_POOL );
+	int lists     = startup.Add( "upload meshes, lists",  InitLists,      JOB_ON_GL_THREAD );
+	int finish    = startup.Add( "finish shaders",        FinishShaders,  JOB_ON_GL_THREAD );
+	startup.After( particles, seed );
+	startup.After( lists, meshes );
+	startup.After( finish, shaders );
+
+	// (waiting for the compiles blocks the gl thread, so do it last and give the driver the most time:)
+	startup.After( finish, textures );
+	startup.After( finish, luts );
+	startup.After( finish, particles );
+	startup.After( finish, lists );
+
+	startup.Run( );
+	startup.PrintTimeline( );
 
 	// init all the global variables used by Display( ):
 	// this will also post a redisplay
@@ -213,6 +368,55 @@ main( int argc, char *argv[ ] )
 	// setup all the user interface stuff:
 	InitMenus( );
 
+	if( bench )
+	{
+		// the benchmark moves the camera itself, runs flat out, and draws at a fixed full scale,
+		// so that every build it is run on draws the same frames:
+		Bench = new Benchmark( );
+		Bench->SetFrames( benchWarmup, benchFrames );
+		Bench->SetVerbose( true );
+		for( size_t i = 0; i < sizeof(BenchParticleCounts) / sizeof(BenchParticleCounts[0]); i++ )
+			Bench->AddParticleCount( BenchParticleCounts[i] );
+		for( size_t i = 0; i < sizeof(BenchLods) / sizeof(BenchLods[0]); i++ )
+			Bench->AddLod( BenchLods[i] );
+
+		// (the beam runs from the origin out along +Z)
+		BenchCamera closeFrom = {  10.,  20., 3.0f };
+		BenchCamera closeTo   = {  10.,  50., 3.5f };
+		BenchCamera fullFrom  = {   0.,  80., 0.35f };
+		BenchCamera fullTo    = {   0., 100., 0.35f };
+		BenchCamera orbitFrom = {  30.,   0., 0.6f };
+		BenchCamera orbitTo   = {  30., 360., 0.6f };
+		Bench->AddPath( "close-up",  closeFrom, closeTo );
+		Bench->AddPath( "full-beam", fullFrom,  fullTo );
+		Bench->AddPath( "orbit",     orbitFrom, orbitTo );
+
+		Resolution->SetScaleRange( 1., 1. );
+		Scheduler->SetTargetRate( -1. );
+		Scheduler->SetFrameBegin( Benchmark::FrameBeginCB );
+		if( ! Bench->Start( BenchApply ) )
+			DoMainMenu( QUIT );
+		if( hidden )
+		{
+			Scheduler->SetTick( Animate );
+			RunBenchHidden( );		// will not return here
+		}
+	}
+	else
+	{
+		// put the recorder between glut and the input callbacks:
+		// (a replay draws at a fixed full scale, so that every build it is timed on draws the same pixels)
+		Recorder = new InputRecorder( );
+		Recorder->Install( Scheduler, Keyboard, MouseButton, MouseMotion, Resize );
+		if( recordFile != NULL )
+			Recorder->Record( recordFile );
+		else if( replayFile != NULL  &&  Recorder->Replay( replayFile ) )
+			Resolution->SetScaleRange( 1., 1. );
+	}
+
+	// start pacing the frames, which from now on call Animate( ) and post the redisplays:
+	Scheduler->Start( Animate );
+
 	// draw the scene once and wait for some interaction:
 	// (this will never return)
 	glutSetWindow( MainWindow );
@@ -225,17 +429,19 @@ main( int argc, char *argv[ ] )
 
 
 // this is where one would put code that is to be called
-// everytime the glut main loop has nothing to do
+// once per simulation tick -- the FrameScheduler calls it
+// TICK_RATE times a second, however fast the frames are going
 //
 // this is typically where animation parameters are set
 //
-// do not call Display( ) from here -- let glutMainLoop( ) do it
+// do not call Display( ) from here -- the FrameScheduler posts the redisplays
 void
 Animate( )
 {
 	// put animation stuff in here -- change some global variables
 	// for Display( ) to find:
-	int ms = glutGet(GLUT_ELAPSED_TIME);
+	// (the animations run off the simulation clock, so they stay in step with the particles)
+	int ms = (int)( 1000. * Scheduler->GetSimTime( ) );
 	int BumpMs = ms % MS_IN_BUMP_ANIMATION;
 	int BulbMs = ms % MS_IN_BULB_ANIMATION;
 	int SpinMs = ms % MS_IN_SPIN_ANIMATION;
@@ -247,16 +453,35 @@ Animate( )
 	StarTime = (float)StarMs / (float)MS_IN_STAR_ANIMATION;
 
 	// Run Compute Shaders
-	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, PosSSBO);
-	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, VelSSBO);
-	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, ColSSBO);
+	GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, PosSSBO);
+	GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, VelSSBO);
+	GLState::BindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, ColSSBO);
 
 	BeamMainParticles->Use();
-	BeamMainParticles->DispatchCompute(NUM_PARTICLES / WORK_GROUP_SIZE, 1, 1);
+	BeamMainParticles->BeginProfile("particle update");
+	BeamMainParticles->DispatchCompute(NumParticles / WORK_GROUP_SIZE, 1, 1);
+	BeamMainParticles->EndProfile();
+}
 
-	// force a call to Display( ) next time it is convenient:
-	glutSetWindow( MainWindow );
-	glutPostRedisplay( );
+
+// set up a frame of the benchmark -- the Benchmark calls it as each frame starts:
+void
+BenchApply( const BenchCamera &camera, int particles, int lod, bool first )
+{
+	Xrot = camera.Xrot;
+	Yrot = camera.Yrot;
+	Scale = camera.Scale;
+	WhichProjection = PERSP;
+
+	// each run starts from the same particles:
+	if( first )
+	{
+		if( particles > 0 )
+			NumParticles = particles < MAX_PARTICLES ? particles : MAX_PARTICLES;
+		if( lod >= 0 )
+			SetBeamLod( lod );
+		ResetParticles( );
+	}
 }
 
 
@@ -272,22 +497,26 @@ Display( )
 	// set which window we want to do the graphics into:
 	glutSetWindow( MainWindow );
 
+	// draw into the offscreen target, at whatever fraction of the window size is holding the frame budget:
+	Resolution->Begin( glutGet( GLUT_WINDOW_WIDTH ), glutGet( GLUT_WINDOW_HEIGHT ) );
+
 	// erase the background:
-	glDrawBuffer( GL_BACK );
 	glClear( GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT );
 
-	glEnable( GL_DEPTH_TEST );
+	// the state changes from here on go through GLState,
+	// so the ones that are the same as last frame never reach the driver:
+	GLState::Enable( GL_DEPTH_TEST );
 
 	// specify shading to be flat:
-	glShadeModel( GL_FLAT );
+	GLState::ShadeModel( GL_FLAT );
 
-	// set the viewport to a square centered in the window:
-	GLsizei vx = glutGet( GLUT_WINDOW_WIDTH );
-	GLsizei vy = glutGet( GLUT_WINDOW_HEIGHT );
+	// set the viewport to a square centered in the window (as much of it as is being drawn):
+	GLsizei vx = Resolution->GetWidth( );
+	GLsizei vy = Resolution->GetHeight( );
 	GLsizei v = vx < vy ? vx : vy;			// minimum dimension
 	GLint xl = ( vx - v ) / 2;
 	GLint yb = ( vy - v ) / 2;
-	glViewport( xl, yb,  v, v );
+	GLState::Viewport( xl, yb,  v, v );
 
 	// set the viewing volume:
 	// remember that the Z clipping  values are actually
@@ -300,9 +529,9 @@ Display( )
 	glm::mat4 projection;
 
 	if (WhichProjection == ORTHO)
-		projection = glm::ortho(-3., 3., -3., 3., 0.1, 1000.);
+		projection = glm::ortho(-3.f, 3.f, -3.f, 3.f, NEAR_PLANE, FAR_PLANE);
 	else
-		projection = glm::perspective(D2R * 90., 1., 0.1, 1000.);
+		projection = glm::perspective(D2R * 90.f, 1.f, NEAR_PLANE, FAR_PLANE);
 
 	// apply the projection matrix:
 	glMultMatrixf(glm::value_ptr(projection));
@@ -350,63 +579,40 @@ Display( )
 	*/
 
 	// possibly draw the axes:
-	if( AxesOn != 0 )
+	// (they are drawn with the fixed-function matrices, so they are only in the single view)
+	bool views = Views != NULL  &&  ViewsOn;
+	if( AxesOn != 0  &&  ! views )
 	{
 		glColor3f( 1., 1., 1. );
 		glCallList( AxesList );
 	}
 
 	// since we are using glScalef( ), be sure normals get unitized:
-	glEnable( GL_NORMALIZE );
+	GLState::Enable( GL_NORMALIZE );
+
+	// upload whatever textures have finished decoding:
+	Streamer->Update( );
 
 	// draw the current object:
-	glActiveTexture(GL_TEXTURE8);
-	glBindTexture(GL_TEXTURE_2D, NoiseTexture);
-	
-	glActiveTexture(GL_TEXTURE9);
-	glBindTexture(GL_TEXTURE_2D, NoiseMask);
-
-	BeamShader->Use();
-	glm::vec3 lightPos = { -1., 5., 5. };
-	BeamShader->SetUniformVariable("uLightPos", lightPos);
-	BeamShader->SetUniformVariable("uBumpTime", BumpTime);
-	BeamShader->SetUniformVariable("uBulbTime", BulbTime);
-	BeamShader->SetUniformVariable("uSpinTime", SpinTime);
-	BeamShader->SetUniformVariable("uNoise", 8);
-	BeamShader->SetUniformVariable("uNoiseMask", 9);
-	BeamShader->SetUniformVariable("uIsWhoosh", 0);
-	BeamVBO->Draw();
-	BeamShader->Use(0);
-
-	glActiveTexture(GL_TEXTURE9);
-	glBindTexture(GL_TEXTURE_2D, WhooshTexture);
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	WhooshShader->Use();
-	WhooshShader->SetUniformVariable("uLightPos", lightPos);
-	WhooshShader->SetUniformVariable("uBumpTime", BumpTime);
-	WhooshShader->SetUniformVariable("uBulbTime", BulbTime);
-	WhooshShader->SetUniformVariable("uSpinTime", SpinTime);
-	WhooshShader->SetUniformVariable("uStarTime", StarTime);
-	WhooshShader->SetUniformVariable("uIsWhoosh", 1);
-	WhooshShader->SetUniformVariable("uNoise", 8);
-	WhooshShader->SetUniformVariable("uWhoosh", 9);
-	BeamVBO->Draw();
-	WhooshShader->Use(0);
-
-	ParticleShader->Use();
-	//ParticleShader->SetAttributeVariable("aVertex", &PosSSBO, GL_VERTEX);
-	//for (int i = 0; i < NUM_PARTICLES; i++) {
-		glBindBuffer(GL_ARRAY_BUFFER, PosSSBO);
-		glVertexPointer(4, GL_FLOAT, 0, (void*)0);
-		glEnableClientState(GL_VERTEX_ARRAY);
-		glDrawArrays(GL_POINTS, 0, NUM_PARTICLES);
-		glDisableClientState(GL_VERTEX_ARRAY);
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		
-		//ParticleVBO->Draw();
-	//}
-	ParticleShader->Use(0);
+	// (one bind of the noise layers covers both the beam and the whoosh)
+	GLState::BindTexture(GL_TEXTURE8, GL_TEXTURE_2D_ARRAY, NoiseLayers);
+	if (UseNoiseLut)
+		NoiseLuts->Bind(GL_TEXTURE10);
+
+	// the light and the animation times are shared by every program:
+	PerFrame->Data.uLightPos[0] = -1.;
+	PerFrame->Data.uLightPos[1] =  5.;
+	PerFrame->Data.uLightPos[2] =  5.;
+	PerFrame->Data.uBumpTime = BumpTime;
+	PerFrame->Data.uBulbTime = BulbTime;
+	PerFrame->Data.uSpinTime = SpinTime;
+	PerFrame->Data.uStarTime = StarTime;
+	PerFrame->Update();
+
+	if( views )
+		DrawViews( modelView, vx, vy );
+	else
+		DrawScene( false, xl, yb, v );
 
 	/*
 	// draw some gratuitous text that just rotates on top of the scene:
@@ -433,8 +639,19 @@ Display( )
 	DoRasterString( 5., 5., 0., (char *)"Text That Doesn't" );
 	*/
 
+	// stretch the scene back up to the size of the window:
+	Resolution->End( );
+
 	// swap the double-buffered framebuffers:
 	glutSwapBuffers( );
+	GLState::EndFrame( );
+	if( Bench != NULL )
+	{
+		Bench->EndFrame( );
+		if( Bench->IsDone( ) )
+			FinishBench( );		// will not return here
+	}
+	Scheduler->EndFrame( );
 
 	// be sure the graphics buffer has been sent:
 	// note: be sure to use glFlush( ) here, not glFinish( ) !
@@ -467,6 +684,9 @@ DoMainMenu( int id )
 			// gracefully exit the program:
 			glutSetWindow( MainWindow );
 			glFinish( );
+			if( Recorder != NULL )
+				Recorder->Close( );
+			Scheduler->Stop( );
 			glutDestroyWindow( MainWindow );
 			exit( 0 );
 			break;
@@ -531,6 +751,120 @@ DoStrokeString( float x, float y, float z, float ht, char *s )
 }
 
 
+// draw the beam, the particles, and the whoosh -- into the scene's viewport xl, yb, v x v,
+// or, if views is true, into every view at once (see DrawViews( )):
+void
+DrawScene( bool views, GLint xl, GLint yb, GLsizei v )
+{
+	GLSLProgram *beamShader = views ? BeamViewShaders[UseNoiseLut] : BeamShader;
+	GLSLProgram *particleShader = views ? ParticleViewShader : ParticleShader;
+	GLSLProgram *whooshShader = views ? WhooshViewShaders[UseNoiseLut] : WhooshShader;
+	int instances = views ? Views->GetInstances( ) : 1;
+
+	beamShader->Use();
+	beamShader->BeginProfile(UseNoiseLut ? "beam (lut)" : "beam");
+	BeamVBO->Draw( instances );
+	beamShader->EndProfile();
+	beamShader->Use(0);
+
+	particleShader->Use();
+	particleShader->BeginProfile("particles");
+	//ParticleShader->SetAttributeVariable("aVertex", &PosSSBO, GL_VERTEX);
+	//for (int i = 0; i < NUM_PARTICLES; i++) {
+		GLState::BindBuffer(GL_ARRAY_BUFFER, PosSSBO);
+		glVertexPointer(4, GL_FLOAT, 0, (void*)0);
+		GLState::EnableClientState(GL_VERTEX_ARRAY);
+		GLState::DisableClientState(GL_NORMAL_ARRAY);		// BeamVBO->Draw( ) leaves these on
+		GLState::DisableClientState(GL_COLOR_ARRAY);
+		GLState::DisableClientState(GL_TEXTURE_COORD_ARRAY);
+		if( instances > 1 )
+			glDrawArraysInstanced(GL_POINTS, 0, NumParticles, instances);
+		else
+			glDrawArrays(GL_POINTS, 0, NumParticles);
+		
+		//ParticleVBO->Draw();
+	//}
+	particleShader->EndProfile();
+	particleShader->Use(0);
+
+	// the whoosh is soft, so it can be drawn at a fraction of the resolution and composited back over the rest
+	// (it comes last, so everything it can be in front of or behind is already in the depth buffer)
+	// -- the views are layers of a texture array, which the reduced pass does not draw into, so they get it at full resolution:
+	bool reduced = ! views  &&  WhooshPass->Begin( Resolution->GetFramebuffer( ), Resolution->GetColorTexture( ), Resolution->GetDepthTexture( ),
+						xl, yb, v, v );
+	if( ! reduced )
+	{
+		GLState::Enable(GL_BLEND);
+		GLState::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	}
+	char whooshPass[64];
+	sprintf( whooshPass, "whoosh%s%s", UseNoiseLut ? " (lut)" : "", reduced ? ( WhooshPass->GetDivisor( ) == 2 ? " 1/2" : " 1/4" ) : "" );
+	whooshShader->Use();
+	whooshShader->BeginProfile(whooshPass);
+	BeamVBO->Draw( instances );
+	whooshShader->EndProfile();
+	whooshShader->Use(0);
+	WhooshPass->Composite( NEAR_PLANE, FAR_PLANE, WhichProjection == ORTHO );
+}
+
+
+// draw the scene from every view, side by side across the width x height of the scene's target:
+// (each view's eye is moved sideways from the one eye of modelView, and its frustum skewed back,
+// so that the views line up at the look-at point)
+void
+DrawViews( const glm::mat4 &modelView, int width, int height )
+{
+	int n = Views->GetNumViews( );
+	int w = width / n;
+	GLsizei v = w < height ? w : height;
+	for( int i = 0; i < n; i++ )
+	{
+		float offset = STEREO_SEPARATION * ( (float)i - 0.5f * (float)( n - 1 ) );
+		glm::mat4 eyeView = glm::translate( glm::mat4( 1. ), glm::vec3( -offset, 0., 0. ) ) * modelView;
+		glm::mat4 projection;
+		if( WhichProjection == ORTHO )
+		{
+			projection = glm::ortho( -3.f - offset, 3.f - offset, -3.f, 3.f, NEAR_PLANE, FAR_PLANE );
+		}
+		else
+		{
+			float shift = NEAR_PLANE * offset / STEREO_CONVERGENCE;	// (a 90 degree fov is NEAR_PLANE either side)
+			projection = glm::frustum( -NEAR_PLANE - shift, NEAR_PLANE - shift, -NEAR_PLANE, NEAR_PLANE, NEAR_PLANE, FAR_PLANE );
+		}
+		Views->SetView( i, eyeView, projection );
+	}
+	Views->Update( );
+
+	// one pass draws every view, unless each needs its own:
+	int passes = Views->Begin( w, height );
+	for( int p = 0; p < passes; p++ )
+	{
+		Views->BeginPass( p );
+		GLState::Viewport( ( w - v ) / 2, ( height - v ) / 2, v, v );
+		DrawScene( true, 0, 0, v );
+	}
+	Views->End( Resolution->GetFramebuffer( ), 0, 0 );
+}
+
+
+// the benchmark is over -- report it and exit:
+void
+FinishBench( )
+{
+	Bench->Report( stderr );
+
+	char file[256];
+	sprintf( file, "%.240s.json", BenchOutName );
+	if( Bench->WriteJson( file ) )
+		fprintf( stderr, "Benchmark: wrote %s\n", file );
+	sprintf( file, "%.240s.csv", BenchOutName );
+	if( Bench->WriteCsv( file ) )
+		fprintf( stderr, "Benchmark: wrote %s\n", file );
+
+	DoMainMenu( QUIT );
+}
+
+
 // return the number of seconds since the start of the program:
 float
 ElapsedSeconds( )
@@ -627,7 +961,7 @@ InitGraphics( )
 	glutTabletButtonFunc( NULL );
 	glutMenuStateFunc( NULL );
 	glutTimerFunc( -1, NULL, 0 );
-	glutIdleFunc( Animate );
+	glutIdleFunc( NULL );
 
 	// init glew (a window must be open to do this):
 #ifdef WIN32
@@ -642,89 +976,327 @@ InitGraphics( )
 #endif
 
 	
-	int numS, numT;// , numP;
-	//unsigned char* NoiseTextureArray = ReadTexture2D("noise2d.064.tex", &numS, &numT);
-	unsigned char* NoiseTextureArray = BmpToTexture("Noise.bmp", &numS, &numT);
-	if (NoiseTextureArray == NULL) {
-		printf("Error loading Noise Texture\n");
+	// the timers that pace the frames replace an idle function that would spin a core:
+	Scheduler = new FrameScheduler( );
+	Scheduler->SetTargetRate( FRAME_RATE );
+	Scheduler->SetTickRate( TICK_RATE );
+	Scheduler->SetCatchUp( MAX_CATCH_UP_TICKS );
+
+	// the scene is drawn offscreen, at a resolution that keeps the gpu time per frame within the budget:
+	Resolution = new DynamicResolution( );
+	Resolution->SetBudget( FRAME_BUDGET_MS );
+	Resolution->SetScaleRange( MIN_RESOLUTION_SCALE, 1. );
+	Resolution->Init( );
+
+	// the per-frame uniform buffer that every shader program reads:
+	PerFrame = new FrameUniforms();
+	PerFrame->Init();
+}
+
+
+// start all of the shader compiles, so that the driver can work on them
+// while the textures load and the meshes are built -- FinishShaders( ) collects them:
+void
+CompileShaders( )
+{
+	// (the beam and the whoosh are two variants of the same shaders)
+	GLSLDefines beamDefines;
+	beamDefines.Set("NOISE_LAYER", NOISE_LAYER).Set("NOISE_MASK_LAYER", NOISE_MASK_LAYER).Set("WHOOSH_LAYER", WHOOSH_LAYER);
+	// (each comes in a variant that evaluates its noise functions, and one that looks them up)
+	for (int lut = 0; lut < 2; lut++)
+	{
+		GLSLDefines defines(beamDefines);
+		defines.Set("USE_NOISE_LUT", lut);
+		BeamShaders[lut] = GLSLProgram::Variant(GLSLDefines(defines).Set("IS_WHOOSH", 0), "beam.vert", "beam.frag");
+		WhooshShaders[lut] = GLSLProgram::Variant(GLSLDefines(defines).Set("IS_WHOOSH", 1), "beam.vert", "whoosh.frag");
 	}
-	glGenTextures(1, &NoiseTexture);
-	glBindTexture(GL_TEXTURE_2D, NoiseTexture);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	//glTexParameteri(GL_TEXTURE_3D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexImage2D(GL_TEXTURE_2D, 0, 3, numS, numT, 0, GL_RGB, GL_UNSIGNED_BYTE, NoiseTextureArray);
-
-	int width, height;
-	unsigned char* NoiseMaskArray = BmpToTexture("noise1.bmp", &width, &height);
-	if (NoiseTextureArray == NULL) {
-		printf("Error loading Noise Texture\n");
+	UseNoiseLut = true;
+	BeamShader = BeamShaders[UseNoiseLut];
+	WhooshShader = WhooshShaders[UseNoiseLut];
+
+	BeamMainParticles = new GLSLProgram();
+	BeamMainParticles->CreateAsync("mainParticles.cs");
+
+	ParticleShader = new GLSLProgram();
+	ParticleShader->CreateAsync("particle.vert", "particle.frag");
+
+	// the views draw with variants that take their matrices from the views' uniform block:
+	if( Views != NULL )
+	{
+		for (int lut = 0; lut < 2; lut++)
+		{
+			GLSLDefines defines(beamDefines);
+			defines.Set("USE_NOISE_LUT", lut);
+			Views->AddDefines(defines);
+			BeamViewShaders[lut] = GLSLProgram::Variant(GLSLDefines(defines).Set("IS_WHOOSH", 0), "beam.vert", "beam.frag");
+			WhooshViewShaders[lut] = GLSLProgram::Variant(GLSLDefines(defines).Set("IS_WHOOSH", 1), "beam.vert", "whoosh.frag");
+		}
+		GLSLDefines particleDefines;
+		Views->AddDefines(particleDefines);
+		ParticleViewShader = GLSLProgram::Variant(particleDefines, "particle.vert", "particle.frag");
 	}
-	glGenTextures(1, &NoiseMask);
-	glBindTexture(GL_TEXTURE_2D, NoiseMask);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexImage2D(GL_TEXTURE_2D, 0, 3, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NoiseMaskArray);
-
-	BeamShader = new GLSLProgram();
-	bool valid = BeamShader->Create("beam.vert", "beam.frag");
+
+	WhooshPass = new ReducedPass( );
+	WhooshPass->SetDivisor( WHOOSH_DIVISOR );
+	WhooshPass->Init( );
+}
+
+
+// the noise, the noise mask, and the whoosh all live in one texture array,
+// which is decoded on the streamer's threads while the rest of the startup goes on:
+void
+InitTextures( )
+{
+	Streamer = new TextureStreamer( );
+	Streamer->Init( );
+	NoiseLayers = LoadNoiseLayers( );
+}
+
+
+// bake the noise functions that the USE_NOISE_LUT variants look up:
+void
+BakeNoiseLuts( )
+{
+	NoiseLuts = new NoiseBake();
+	NoiseLuts->SetVerbose(LutErrorOn);
+	NoiseLuts->Init(NOISE_LUT_RESOLUTION);
+}
+
+
+// decode one layer of the noise array, and its whole mip chain, into rgba (level 0 first, each level tightly packed)
+// -- this runs on a TextureStreamer worker, so it must not touch gl:
+// (the noise is generated, and the other layers come from their ktx file if there is one that fits,
+// otherwise from their bmp, and are left black if neither is there)
+
+bool
+DecodeNoiseLayer( int layer, unsigned char *rgba )
+{
+	char *files[NUM_NOISE_LAYERS];
+	files[NOISE_LAYER]      = NULL;			// made by NoiseGen
+	files[NOISE_MASK_LAYER] = (char *)"noise1.bmp";
+	files[WHOOSH_LAYER]     = (char *)"woosh.bmp";
+
+	// these are optional -- make them with, say:  tools/texconv -format rgba8 noise1.bmp noise1.ktx
+	// (they are not kept with the sources: the rgba8 one, with its mips, is bigger than the bmp, and the noise array is rgba8,
+	// so there is no compressed format that it could take)
+	char *ktxFiles[NUM_NOISE_LAYERS];
+	ktxFiles[NOISE_LAYER]      = NULL;
+	ktxFiles[NOISE_MASK_LAYER] = (char *)"noise1.ktx";
+	ktxFiles[WHOOSH_LAYER]     = (char *)"woosh.ktx";
+
+	int levels = NoiseGen::MipLevels( NOISE_LAYER_SIZE );
+
+	// the noise itself is generated at exactly the layer size, so it needs no resampling:
+	if( files[layer] == NULL )
+	{
+		NoiseGen noise;
+		noise.Generate( NOISE_LAYER_SIZE, NOISE_BASE_FREQUENCY );
+		for( int l = 0, n = NOISE_LAYER_SIZE; l < levels; l++, n /= 2 )
+		{
+			memcpy( rgba, noise.GetLevel( l ), 4*n*n );
+			rgba += 4*n*n;
+		}
+		return true;
+	}
+
+	// a ktx that is already GL_RGBA8 at the layer size, with the whole mip chain, is copied straight out of the file:
+	KtxTexture ktx;
+	if( ktx.Load( ktxFiles[layer], true )  &&  ktx.GetInternalFormat( ) == GL_RGBA8  &&  ktx.GetLayers( ) == 0  &&  ktx.GetLevelCount( ) == levels
+	 &&  ktx.GetWidth( ) == NOISE_LAYER_SIZE  &&  ktx.GetHeight( ) == NOISE_LAYER_SIZE )
+	{
+		for( int l = 0, n = NOISE_LAYER_SIZE; l < levels; l++, n /= 2 )
+		{
+			memcpy( rgba, ktx.GetLevel( l ), 4*n*n );
+			rgba += 4*n*n;
+		}
+		return true;
+	}
+
+	// the bmp comes back already swizzled to rgba, so a layer-sized one is copied straight from it:
+	BmpImage bmp;
+	if( ! bmp.Load( files[layer], GL_RGBA ) )
+	{
+		fprintf( stderr, "Layer %d of the noise texture ('%s') will be black\n", layer, files[layer] );
+		memset( rgba, 0, 4 * NOISE_LAYER_SIZE * NOISE_LAYER_SIZE );
+	}
+	else if( bmp.GetWidth( ) == NOISE_LAYER_SIZE  &&  bmp.GetHeight( ) == NOISE_LAYER_SIZE )
+	{
+		memcpy( rgba, bmp.GetPixels( ), 4 * NOISE_LAYER_SIZE * NOISE_LAYER_SIZE );
+	}
+	else
+	{
+		int width = bmp.GetWidth( );
+		int height = bmp.GetHeight( );
+		const unsigned char *src = bmp.GetPixels( );
+
+		// bilinear resample, wrapping at the edges like GL_REPEAT does:
+		unsigned char *lp = rgba;
+		for( int t = 0; t < NOISE_LAYER_SIZE; t++ )
+		{
+			float ft = ( (float)t + 0.5f ) * (float)height / (float)NOISE_LAYER_SIZE - 0.5f;
+			int t0 = (int)floor( ft );
+			float wt = ft - (float)t0;
+			int t1 = ( t0 + 1 + height ) % height;
+			t0 = ( t0 + height ) % height;
+			for( int s = 0; s < NOISE_LAYER_SIZE; s++, lp += 4 )
+			{
+				float fs = ( (float)s + 0.5f ) * (float)width / (float)NOISE_LAYER_SIZE - 0.5f;
+				int s0 = (int)floor( fs );
+				float ws = fs - (float)s0;
+				int s1 = ( s0 + 1 + width ) % width;
+				s0 = ( s0 + width ) % width;
+				for( int c = 0; c < 3; c++ )
+				{
+					float v00 = src[ 4*( t0*width + s0 ) + c ];
+					float v01 = src[ 4*( t0*width + s1 ) + c ];
+					float v10 = src[ 4*( t1*width + s0 ) + c ];
+					float v11 = src[ 4*( t1*width + s1 ) + c ];
+					float v = ( 1.f - wt ) * ( ( 1.f - ws ) * v00 + ws * v01 )  +  wt * ( ( 1.f - ws ) * v10 + ws * v11 );
+					lp[c] = (unsigned char)( v + 0.5f );
+				}
+				lp[3] = 255;
+			}
+		}
+	}
+
+	// each level is downsampled from the one right before it:
+	for( int l = 1, n = NOISE_LAYER_SIZE; l < levels; l++, n /= 2 )
+	{
+		NoiseGen::Downsample( rgba, n, rgba + 4*n*n );
+		rgba += 4*n*n;
+	}
+	return true;
+}
+
+
+// make the mipmapped noise texture array, and start streaming its layers into it
+// returns a 1x1 placeholder for Display( ) to bind until every layer is in -- NoiseLayers is then switched to the real one:
+
+GLuint
+LoadNoiseLayers( )
+{
+	int levels = NoiseGen::MipLevels( NOISE_LAYER_SIZE );
+
+	GLuint tex;
+	glGenTextures( 1, &tex );
+	GLState::BindTexture( GL_TEXTURE0, GL_TEXTURE_2D_ARRAY, tex );
+	glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT );
+	glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT );
+	glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+	glTexParameteri( GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR );
+	if( GLEW_ARB_texture_storage )
+	{
+		glTexStorage3D( GL_TEXTURE_2D_ARRAY, levels, GL_RGBA8, NOISE_LAYER_SIZE, NOISE_LAYER_SIZE, NUM_NOISE_LAYERS );
+	}
+	else
+	{
+		for( int l = 0, n = NOISE_LAYER_SIZE; l < levels; l++, n /= 2 )
+			glTexImage3D( GL_TEXTURE_2D_ARRAY, l, GL_RGBA8, n, n, NUM_NOISE_LAYERS, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL );
+	}
+
+	NoiseLayersPending = 0;
+	for( int l = 0; l < NUM_NOISE_LAYERS; l++ )
+	{
+		// the gpu path rebuilds the mips of the whole array, so it has to come before the streamed layers land:
+		if( l == NOISE_LAYER  &&  NOISE_ON_GPU )
+		{
+			NoiseGen noise;
+			if( noise.GenerateOnGpu( tex, NOISE_LAYER, NOISE_LAYER_SIZE, NOISE_BASE_FREQUENCY ) )
+				continue;
+		}
+
+		TextureRequest r;
+		r.Texture = tex;
+		r.Target = GL_TEXTURE_2D_ARRAY;
+		r.Layer = l;
+		r.Width = r.Height = NOISE_LAYER_SIZE;
+		r.Levels = levels;
+		r.Decode = [l]( unsigned char *rgba ) { return DecodeNoiseLayer( l, rgba ); };
+		r.Done = [tex]( bool ) { if( --NoiseLayersPending == 0 ) NoiseLayers = tex; };
+		Streamer->Load( r );
+		NoiseLayersPending++;
+	}
+
+	if( NoiseLayersPending == 0 )
+		return tex;
+
+	// mid-gray is "no noise" to the beam shaders:
+	static const unsigned char gray[4] = { 128, 128, 128, 255 };
+	return TextureStreamer::CreatePlaceholder( GL_TEXTURE_2D_ARRAY, NUM_NOISE_LAYERS, gray );
+}
+
+
+// wait for the shader programs that InitGraphics( ) started,
+// and set the uniforms that never change:
+void
+FinishShaders( )
+{
+	bool valid = BeamShaders[0]->Finish() && BeamShaders[1]->Finish();
 	if (!valid) {
 		printf("Error loading shader\n");
 	}
 
-	BeamMainParticles = new GLSLProgram();
-	valid = BeamMainParticles->Create("mainParticles.cs");
+	valid = BeamMainParticles->Finish();
 	if (!valid) {
 		printf("Error loading Computer Shader\n");
 	}
-	SetupParticleBuffer();
 
-	ParticleShader = new GLSLProgram();
-	valid = ParticleShader->Create("particle.vert", "particle.frag");
+	valid = ParticleShader->Finish();
 	if (!valid) {
 		printf("Error loading Computer Shader\n");
 	}
 
-	WhooshShader = new GLSLProgram();
-	valid = WhooshShader->Create("beam.vert", "whoosh.frag");
+	valid = WhooshShaders[0]->Finish() && WhooshShaders[1]->Finish();
 	if (!valid) {
 		printf("Error loading Computer Shader\n");
 	}
 
-	unsigned char* WhooshArray = BmpToTexture("woosh.bmp", &width, &height);
-	if (NoiseTextureArray == NULL) {
-		printf("Error loading Noise Texture\n");
+	WhooshPass->Finish( );
+
+	if (Views != NULL)
+	{
+		valid = BeamViewShaders[0]->Finish() && BeamViewShaders[1]->Finish()
+			&& WhooshViewShaders[0]->Finish() && WhooshViewShaders[1]->Finish() && ParticleViewShader->Finish();
+		if (!valid) {
+			fprintf(stderr, "Error loading the view shaders -- drawing one view\n");
+			ViewsOn = false;
+			delete Views;
+			Views = NULL;
+		}
+	}
+
+	// the samplers never change, so set them once:
+	for (int lut = 0; lut < 2; lut++)
+	{
+		BeamShaders[lut]->SetUniformVariable("uNoiseLayers", 8);
+		WhooshShaders[lut]->SetUniformVariable("uNoiseLayers", 8);
 	}
-	glGenTextures(1, &WhooshTexture);
-	glBindTexture(GL_TEXTURE_2D, WhooshTexture);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-	glTexImage2D(GL_TEXTURE_2D, 0, 3, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, WhooshArray);
+	BeamShaders[1]->SetUniformVariable("uNoiseLut", 10);
+	WhooshShaders[1]->SetUniformVariable("uNoiseLut", 10);
+	if (Views != NULL)
+	{
+		for (int lut = 0; lut < 2; lut++)
+		{
+			BeamViewShaders[lut]->SetUniformVariable("uNoiseLayers", 8);
+			WhooshViewShaders[lut]->SetUniformVariable("uNoiseLayers", 8);
+			Views->Bind(BeamViewShaders[lut]);
+			Views->Bind(WhooshViewShaders[lut]);
+		}
+		BeamViewShaders[1]->SetUniformVariable("uNoiseLut", 10);
+		WhooshViewShaders[1]->SetUniformVariable("uNoiseLut", 10);
+		Views->Bind(ParticleViewShader);
+	}
+	WhooshShader->UseFixedFunction( );
 }
 
 
-// initialize the display lists that will not change:
-// (a display list is a way to store opengl commands in
-//  memory so that they can be played back efficiently at a later time
-//  with a call to glCallList( )
+// build the vertex buffer objects' vertices -- this is a startup job on the pool, so it must not touch gl
+// (their buffers are filled on the gl thread, by InitLists( )):
 void
-InitLists( )
+BuildMeshes( )
 {
-	glutSetWindow( MainWindow );
-
-	BeamVBO = new VertexBufferObject();
-	BeamVBO->CollapseCommonVertices(true);
-	float radius = 0.3;
-	// Create the Beam Vertices
-	BeamVBO->glBegin(GL_TRIANGLE_STRIP);
-		CreateBeam(1, radius, 8., 0, 30, 0, 70);
-	BeamVBO->glEnd();
+	BeamLod = BEAM_LOD;
+	BeamLods[BeamLod] = BuildBeam( BeamLod );
 
 	ParticleVBO = new VertexBufferObject();
 	ParticleVBO->CollapseCommonVertices(false);
@@ -741,6 +1313,54 @@ InitLists( )
 		ParticleVBO->glTexCoord2f(0., 1.);
 		ParticleVBO->glVertex3f(-.5, .5, 0.);
 	ParticleVBO->glEnd();
+}
+
+
+// build the beam's vertices at a level of detail -- this does not touch gl, so the buffer still has to be Upload( )ed:
+// (CreateBeam( ) builds into BeamVBO, so this leaves BeamVBO pointing at what it returns)
+VertexBufferObject *
+BuildBeam( int lod )
+{
+	BeamVBO = new VertexBufferObject();
+	BeamVBO->CollapseCommonVertices(true);
+	float radius = 0.3;
+	// Create the Beam Vertices
+	BeamVBO->glBegin(GL_TRIANGLE_STRIP);
+		CreateBeam(lod, radius, 8., 0, 30, 0, 70);
+	BeamVBO->glEnd();
+	return BeamVBO;
+}
+
+
+// draw the beam at another level of detail, building it the first time it is asked for:
+void
+SetBeamLod( int lod )
+{
+	if( lod < 0  ||  lod >= NUM_BEAM_LODS )
+		return;
+
+	if( BeamLods[lod] == NULL )
+	{
+		BeamLods[lod] = BuildBeam( lod );
+		BeamLods[lod]->Upload( );
+	}
+	BeamVBO = BeamLods[lod];
+	BeamLod = lod;
+}
+
+
+// initialize the display lists that will not change:
+// (a display list is a way to store opengl commands in
+//  memory so that they can be played back efficiently at a later time
+//  with a call to glCallList( )
+void
+InitLists( )
+{
+	glutSetWindow( MainWindow );
+
+	// move the meshes that BuildMeshes( ) made into their buffers now, rather than in the first Display( ):
+	BeamVBO->Upload( );
+	ParticleVBO->Upload( );
 
 	// create the axes:
 	AxesList = glGenLists( 1 );
@@ -761,6 +1381,27 @@ Keyboard( unsigned char c, int x, int y )
 
 	switch( c )
 	{
+		case 'l':
+		case 'L':
+			// switch between the analytic and the baked noise functions:
+			UseNoiseLut = ! UseNoiseLut;
+			BeamShader = BeamShaders[UseNoiseLut];
+			WhooshShader = WhooshShaders[UseNoiseLut];
+			fprintf( stderr, "Noise functions are %s\n", UseNoiseLut ? "looked up" : "evaluated" );
+			break;
+
+		case 'm':
+		case 'M':
+			// switch between drawing the --views views and the one:
+			if( Views == NULL )
+			{
+				fprintf( stderr, "There is only one view -- start with --views n for more\n" );
+				break;
+			}
+			ViewsOn = ! ViewsOn;
+			fprintf( stderr, "Drawing %d view%s\n", ViewsOn ? Views->GetNumViews( ) : 1, ViewsOn ? "s" : "" );
+			break;
+
 		case 'o':
 		case 'O':
 			WhichProjection = ORTHO;
@@ -771,6 +1412,61 @@ Keyboard( unsigned char c, int x, int y )
 			WhichProjection = PERSP;
 			break;
 
+		case 'f':
+		case 'F':
+			// profile the shader passes until 'f' is hit again, then print what they cost:
+			if( GLSLProgram::IsProfiling( ) )
+			{
+				GLSLProgram::SetProfiling( false );
+				GLSLProgram::PrintProfile( stderr );
+				GLSLProgram::ResetProfile( );
+			}
+			else
+			{
+				GLSLProgram::SetProfiling( true );
+			}
+			break;
+
+		case 's':
+		case 'S':
+			StateStatsOn = ! StateStatsOn;
+			GLState::SetVerbose( StateStatsOn );
+			break;
+
+		case 't':
+		case 'T':
+			// print the frame rate, jitter, and cpu use once a second until 't' is hit again:
+			TimingStatsOn = ! TimingStatsOn;
+			Scheduler->SetVerbose( TimingStatsOn );
+			Resolution->SetVerbose( TimingStatsOn );
+			break;
+
+		case 'r':
+		case 'R':
+			// switch the dynamic resolution scaling on and off:
+			Resolution->SetEnabled( ! Resolution->IsEnabled( ) );
+			fprintf( stderr, "Dynamic resolution is %s\n", Resolution->IsEnabled( ) ? "on" : "off" );
+			break;
+
+		case 'v':
+		case 'V':
+			// switch between pacing the frames ourselves and letting vsync do it:
+			Scheduler->SetTargetRate( Scheduler->GetTargetRate( ) > 0. ? 0. : FRAME_RATE );
+			if( Scheduler->GetTargetRate( ) > 0. )
+				fprintf( stderr, "Frames are paced at %.0f fps\n", Scheduler->GetTargetRate( ) );
+			else
+				fprintf( stderr, "Frames are paced by vsync\n" );
+			break;
+
+		case 'w':
+		case 'W':
+			// draw the whoosh at full, half, and quarter resolution in turn
+			// (profile each with 'f' to see what it saves):
+			WhooshPass->SetDivisor( WhooshPass->GetDivisor( ) >= 4 ? 1 : 2 * WhooshPass->GetDivisor( ) );
+			fprintf( stderr, "The whoosh is drawn at 1/%d resolution%s\n", WhooshPass->GetDivisor( ),
+				WhooshPass->GetDivisor( ) > 1  &&  ! Resolution->IsEnabled( ) ? " (once dynamic resolution is on)" : "" );
+			break;
+
 		case 'q':
 		case 'Q':
 		case ESCAPE:
@@ -881,6 +1577,22 @@ MouseMotion( int x, int y )
 }
 
 
+// --hidden: draw the benchmark's frames back to back, in a loop of our own rather than glut's,
+// with the window hidden -- it is still created, on a display, since it is what owns the gl context,
+// and the frames are still drawn and swapped just as they are when it shows:
+void
+RunBenchHidden( )
+{
+	glutHideWindow( );
+	while( ! Bench->IsDone( ) )
+	{
+		Scheduler->Step( );
+		Display( );
+	}
+	FinishBench( );
+}
+
+
 // reset the transformations and the colors:
 // this only sets the global variables --
 // the glut main loop is responsible for redrawing the scene
@@ -917,17 +1629,14 @@ Visibility ( int state )
 	if( DebugOn != 0 )
 		fprintf( stderr, "Visibility: %d\n", state );
 
+	// while the window is not visible, nothing is animated or redrawn:
+	Scheduler->SetVisible( state == GLUT_VISIBLE );
+
 	if( state == GLUT_VISIBLE )
 	{
 		glutSetWindow( MainWindow );
 		glutPostRedisplay( );
 	}
-	else
-	{
-		// could optimize by keeping track of the fact
-		// that the window is not visible and avoid
-		// animating or redrawing it ...
-	}
 }
 
 
@@ -1046,145 +1755,6 @@ Axes( float length )
 
 }
 
-struct bmfh
-{
-	short bfType;
-	int bfSize;
-	short bfReserved1;
-	short bfReserved2;
-	int bfOffBits;
-} FileHeader;
-
-struct bmih
-{
-	int biSize;
-	int biWidth;
-	int biHeight;
-	short biPlanes;
-	short biBitCount;
-	int biCompression;
-	int biSizeImage;
-	int biXPelsPerMeter;
-	int biYPelsPerMeter;
-	int biClrUsed;
-	int biClrImportant;
-} InfoHeader;
-
-const int birgb = { 0 };
-
-// read a BMP file into a Texture:
-unsigned char *
-BmpToTexture( char *filename, int *width, int *height )
-{
-	FILE *fp = fopen( filename, "rb" );
-	if( fp == NULL )
-	{
-		fprintf( stderr, "Cannot open Bmp file '%s'\n", filename );
-		return NULL;
-	}
-
-	FileHeader.bfType = ReadShort( fp );
-
-
-	// if bfType is not 0x4d42, the file is not a bmp:
-	if( FileHeader.bfType != 0x4d42 )
-	{
-		fprintf( stderr, "File '%s' is the wrong type of file: 0x%0x\n", filename, FileHeader.bfType );
-		fclose( fp );
-		return NULL;
-	}
-
-	FileHeader.bfSize = ReadInt( fp );
-	FileHeader.bfReserved1 = ReadShort( fp );
-	FileHeader.bfReserved2 = ReadShort( fp );
-	FileHeader.bfOffBits = ReadInt( fp );
-
-	InfoHeader.biSize = ReadInt( fp );
-	InfoHeader.biWidth = ReadInt( fp );
-	InfoHeader.biHeight = ReadInt( fp );
-
-	int nums = InfoHeader.biWidth;
-	int numt = InfoHeader.biHeight;
-
-	InfoHeader.biPlanes = ReadShort( fp );
-	InfoHeader.biBitCount = ReadShort( fp );
-	InfoHeader.biCompression = ReadInt( fp );
-	InfoHeader.biSizeImage = ReadInt( fp );
-	InfoHeader.biXPelsPerMeter = ReadInt( fp );
-	InfoHeader.biYPelsPerMeter = ReadInt( fp );
-	InfoHeader.biClrUsed = ReadInt( fp );
-	InfoHeader.biClrImportant = ReadInt( fp );
-
-	fprintf( stderr, "Image size in file '%s' is: %d x %d\n", filename, nums, numt );
-
-	unsigned char * texture = new unsigned char[ 3 * nums * numt ];
-	if( texture == NULL )
-	{
-		fprintf( stderr, "Cannot allocate the texture array!\b" );
-		return NULL;
-	}
-
-	// extra padding bytes:
-	int numextra =  4*(( (3*InfoHeader.biWidth)+3)/4) - 3*InfoHeader.biWidth;
-
-	// we do not support compression:
-	if( InfoHeader.biCompression != birgb )
-	{
-		fprintf( stderr, "Image file '%s' has the wrong type of image compression: %d\n", filename, InfoHeader.biCompression );
-		fclose( fp );
-		return NULL;
-	}
-
-	rewind( fp );
-	fseek( fp, 14+40, SEEK_SET );
-
-	if( InfoHeader.biBitCount == 24 )
-	{
-		unsigned char *tp = texture;
-		for( int t = 0; t < numt; t++ )
-		{
-			for( int s = 0; s < nums; s++, tp += 3 )
-			{
-				*(tp+2) = fgetc( fp );		// b
-				*(tp+1) = fgetc( fp );		// g
-				*(tp+0) = fgetc( fp );		// r
-			}
-
-			for( int e = 0; e < numextra; e++ )
-			{
-				fgetc( fp );
-			}
-		}
-	}
-
-	fclose( fp );
-
-	*width = nums;
-	*height = numt;
-	return texture;
-}
-
-int
-ReadInt( FILE *fp )
-{
-	unsigned char b3, b2, b1, b0;
-	b0 = fgetc( fp );
-	b1 = fgetc( fp );
-	b2 = fgetc( fp );
-	b3 = fgetc( fp );
-	return ( b3 << 24 )  |  ( b2 << 16 )  |  ( b1 << 8 )  |  b0;
-}
-
-short
-ReadShort( FILE *fp )
-{
-	unsigned char b1, b0;
-	b0 = fgetc( fp );
-	b1 = fgetc( fp );
-	return ( b1 << 8 )  |  b0;
-}
-
-
 // function to convert HSV to RGB
 // 0.  <=  s, v, r, g, b  <=  1.
 // 0.  <= h  <=  360.
@@ -1383,6 +1953,16 @@ CreateBeam(int _levelOfDetail, float _radius, float _length, int _sourceType, in
 	int shaftVerts  = shaftRows  * cols;
 	int tipVerts    = tipRows	 * cols;
 	Vert* points = new Vert[totalVerts];
+
+	// Every row goes around the same cols angles, so take their sines and cosines once, all in one call
+	float* angles = new float[cols];
+	float* sines = new float[cols];
+	float* cosines = new float[cols];
+	for (int j = 0; j < cols; j++) {
+		angles[j] = ((float)j / (float)cols) * (float)(2. * M_PI);
+	}
+	glm::sincos(angles, sines, cosines, cols);
+
 	float curRadius = 0.;
 	for (int i = 0; i < totalVerts; i++) {
 		// Get the column index
@@ -1417,11 +1997,14 @@ CreateBeam(int _levelOfDetail, float _radius, float _length, int _sourceType, in
 		float theta = (float)curColumn / (float)cols;
 		points[i].ST[0] = theta;
 		points[i].ST[1] = curZ / _length;
-		points[i].V[0] = curRadius * (float)sin(theta * 2. * M_PI);
-		points[i].V[1] = curRadius * (float)cos(theta * 2. * M_PI);
+		points[i].V[0] = curRadius * sines[curColumn];
+		points[i].V[1] = curRadius * cosines[curColumn];
 		points[i].V[2] = curZ;
 
 	}
+	delete[] angles;
+	delete[] sines;
+	delete[] cosines;
 
 	// Build Normals
 	// For each Vertex
@@ -1580,50 +2163,79 @@ CreateBeam(int _levelOfDetail, float _radius, float _length, int _sourceType, in
 	}
 }
 
+// where SeedParticles( ) leaves the particles for SetupParticleBuffer( ) to upload:
+struct Pos	SeedPos[MAX_PARTICLES];
+struct Vel	SeedVel[MAX_PARTICLES];
+struct Col	SeedCol[MAX_PARTICLES];
+int		NumSeeded = 0;		// how many of them have been made up so far
+
+// make up the starting positions, velocities, and colors of particles first through last-1
+// (in that order, so the first NUM_PARTICLES come out of rand( ) just as they always have):
+void
+SeedParticleRange( int first, int last ) {
+	float xRange = 1.;
+	float yRange = 1.;
+	float zRange = 10.;
+	for (int i = first; i < last; i++)	{
+		SeedPos[i].x = xRange / (float)(rand() % 501 - 250);
+		SeedPos[i].y = yRange / (float)(rand() % 501 - 250);
+		SeedPos[i].z = zRange / (float)(rand() % 990 + 11);
+		SeedPos[i].w = 1.;
+	}
+	float xyVelMax = 10.;
+	float zVelMax = 100.;
+	for (int i = first; i < last; i++) {
+		SeedVel[i].vX = xyVelMax / (float)(rand() % 1001 - 500);
+		SeedVel[i].vY = xyVelMax / (float)(rand() % 1001 - 500);
+		SeedVel[i].vZ = zVelMax / (float)(rand() % 1001);
+		SeedVel[i].vW = 0.;
+	}
+	for (int i = first; i < last; i++) {
+		float dist = sqrt(SeedPos[i].x * SeedPos[i].x + SeedPos[i].y * SeedPos[i].y);
+		SeedCol[i].r = 230. / dist;
+		SeedCol[i].g = 250. / dist;
+		SeedCol[i].b = 252. / dist;
+		SeedCol[i].a = 1. / (dist + 0.01);
+	}
+	if( last > NumSeeded )
+		NumSeeded = last;
+}
+
+// make up the particles that are drawn -- the benchmark makes up any more it needs as it asks for them
+// -- this is a startup job on the pool, so it must not touch gl:
+void
+SeedParticles( ) {
+	SeedParticleRange( 0, NumParticles );
+}
+
 void 
 SetupParticleBuffer() {
 	printf("Starting Perticle Buffer Setup\n");
-	GLint bufMask = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;		// Invalidate makes a big difference when re-writing
 	
 	// Initialize the Position Buffer
 	glGenBuffers(1, &PosSSBO);
-	glBindBuffer(GL_SHADER_STORAGE_BUFFER, PosSSBO);
-	glBufferData(GL_SHADER_STORAGE_BUFFER, NUM_PARTICLES * sizeof(struct Pos), NULL, GL_STATIC_DRAW);
-	float xRange = 1.;
-	float yRange = 1.;
-	float zRange = 10.;
-	struct Pos* points = (struct Pos*)glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, NUM_PARTICLES * sizeof(struct Pos), bufMask);
-	for (int i = 0; i < NUM_PARTICLES; i++)	{
-		points[i].x = xRange / (float)(rand() % 501 - 250);
-		points[i].y = yRange / (float)(rand() % 501 - 250);
-		points[i].z = zRange / (float)(rand() % 990 + 11);
-		points[i].w = 1.;
-	}
-	glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+	GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, PosSSBO);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, MAX_PARTICLES * sizeof(struct Pos), SeedPos, GL_STATIC_DRAW);
 	// Initialize the Velocity Buffer
 	glGenBuffers(1, &VelSSBO);
-	glBindBuffer(GL_SHADER_STORAGE_BUFFER, VelSSBO);
-	glBufferData(GL_SHADER_STORAGE_BUFFER, NUM_PARTICLES * sizeof(struct Vel), NULL, GL_STATIC_DRAW);
-	struct Vel* vels = (struct Vel*)glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, NUM_PARTICLES * sizeof(struct Vel), bufMask);
-	float xyVelMax = 10.;
-	float zVelMax = 100.;
-	for (int i = 0; i < NUM_PARTICLES; i++) {
-		vels[i].vX = xyVelMax / (float)(rand() % 1001 - 500);
-		vels[i].vY = xyVelMax / (float)(rand() % 1001 - 500);
-		vels[i].vZ = zVelMax / (float)(rand() % 1001);
-	}
-	glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
+	GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, VelSSBO);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, MAX_PARTICLES * sizeof(struct Vel), SeedVel, GL_STATIC_DRAW);
 	// Initialize the Color Buffer
 	glGenBuffers(1, &ColSSBO);
-	glBindBuffer(GL_SHADER_STORAGE_BUFFER, ColSSBO);
-	glBufferData(GL_SHADER_STORAGE_BUFFER, NUM_PARTICLES * sizeof(struct Col), NULL, GL_STATIC_DRAW);
-	struct Col* cols = (struct Col*)glMapBufferRange(GL_SHADER_STORAGE_BUFFER, 0, NUM_PARTICLES * sizeof(struct Col), bufMask);
-	for (int i = 0; i < NUM_PARTICLES; i++) {
-		float dist = sqrt(points[i].x * points[i].x + points[i].y * points[i].y);
-		cols[i].r = 230. / dist;
-		cols[i].g = 250. / dist;
-		cols[i].b = 252. / dist;
-		cols[i].a = 1. / (dist + 0.01);
-	}
-	glUnmapBuffer(GL_SHADER_STORAGE_BUFFER);
-}
\ No newline at end of file
+	GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, ColSSBO);
+	glBufferData(GL_SHADER_STORAGE_BUFFER, MAX_PARTICLES * sizeof(struct Col), SeedCol, GL_STATIC_DRAW);
+}
+
+// put the particles that are drawn back where SeedParticles( ) started them, making up any it did not:
+void
+ResetParticles( )
+{
+	if( NumParticles > NumSeeded )
+		SeedParticleRange( NumSeeded, NumParticles );
+	GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, PosSSBO);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, NumParticles * sizeof(struct Pos), SeedPos);
+	GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, VelSSBO);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, NumParticles * sizeof(struct Vel), SeedVel);
+	GLState::BindBuffer(GL_SHADER_STORAGE_BUFFER, ColSSBO);
+	glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, NumParticles * sizeof(struct Col), SeedCol);
+}
@@ -0,0 +1,384 @@
+#include "texturestreamer.h"
+#include "glstate.h"
+
+#include <string.h>
+#include <chrono>
+
+
+#define STAGING_ALIGNMENT	256		// every region starts on this, which is more than any texel needs
+
+
+static double
+Now( )
+{
+	return std::chrono::duration<double>( std::chrono::steady_clock::now( ).time_since_epoch( ) ).count( );
+}
+
+
+TextureRequest::TextureRequest( )
+{
+	Texture = 0;
+	Target = GL_TEXTURE_2D;
+	Layer = 0;
+	Width = Height = 0;
+	Levels = 1;
+	Format = GL_RGBA;
+	Type = GL_UNSIGNED_BYTE;
+	TexelBytes = 4;
+}
+
+
+// how much staging memory the whole mip chain takes:
+
+size_t
+TextureRequest::Bytes( )
+{
+	size_t bytes = 0;
+	for( int l = 0, w = Width, h = Height; l < Levels; l++, w = ( w > 1 ? w/2 : 1 ), h = ( h > 1 ? h/2 : 1 ) )
+		bytes += (size_t)w * h * TexelBytes;
+	return bytes;
+}
+
+
+TextureStreamer::TextureStreamer( )
+{
+	Pbo = 0;
+	Staging = NULL;
+	Capacity = 0;
+	Head = 0;
+	Quit = false;
+	Budget = 4*1024*1024;
+	Pending = 0;
+	Uploaded = 0;
+	UploadedBytes = 0.;
+	StartTime = 0.;
+	Verbose = false;
+}
+
+
+TextureStreamer::~TextureStreamer( )
+{
+	{
+		std::lock_guard<std::mutex> lock( Lock );
+		Quit = true;
+	}
+	Wake.notify_all( );
+	for( int i = 0; i < (int)Workers.size( ); i++ )
+		Workers[i].join( );
+}
+
+
+// carve size bytes out of the staging ring, if there is room between the newest region and the oldest one still in use:
+
+bool
+TextureStreamer::Allocate( size_t size, size_t *offset )
+{
+	size = ( size + STAGING_ALIGNMENT - 1 ) & ~(size_t)( STAGING_ALIGNMENT - 1 );
+	if( size > Capacity )
+		return false;
+
+	if( Live.empty( ) )
+		Head = 0;
+	size_t tail = Live.empty( ) ? Capacity : Live.front( ).Offset;
+
+	if( ! Live.empty( )  &&  Head == tail )
+		return false;						// completely full
+
+	if( Live.empty( )  ||  Head > tail )
+	{
+		// the free space is [Head, Capacity) and then [0, tail):
+		if( Head + size <= Capacity )
+			*offset = Head;
+		else if( size <= tail )
+			*offset = 0;
+		else
+			return false;
+	}
+	else
+	{
+		// the free space is [Head, tail):
+		if( Head + size > tail )
+			return false;
+		*offset = Head;
+	}
+
+	Head = *offset + size;
+	Region r = { *offset, size, 0 };
+	Live.push_back( r );
+	return true;
+}
+
+
+// block until every texture that has been loaded is uploaded (for when there is nothing to draw without them):
+
+void
+TextureStreamer::Finish( )
+{
+	size_t budget = Budget;
+	Budget = 0;
+	while( Pending > 0 )
+	{
+		Update( );
+		if( Pending > 0 )
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+	}
+	Budget = budget;
+	Retire( true );
+}
+
+
+// map the staging ring and start the workers (0 means one fewer than there are hardware threads, but at least 1):
+
+bool
+TextureStreamer::Init( int workers, size_t stagingBytes )
+{
+	if( GLEW_ARB_buffer_storage  ||  GLEW_VERSION_4_4 )
+	{
+		GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		glGenBuffers( 1, &Pbo );
+		GLState::BindBuffer( GL_PIXEL_UNPACK_BUFFER, Pbo );
+		glBufferStorage( GL_PIXEL_UNPACK_BUFFER, stagingBytes, NULL, flags );
+		Staging = (unsigned char *)glMapBufferRange( GL_PIXEL_UNPACK_BUFFER, 0, stagingBytes, flags );
+		GLState::BindBuffer( GL_PIXEL_UNPACK_BUFFER, 0 );
+		if( Staging == NULL )
+		{
+			fprintf( stderr, "TextureStreamer: cannot map the staging buffer -- decoding into client memory instead\n" );
+			glDeleteBuffers( 1, &Pbo );
+			Pbo = 0;
+		}
+		else
+		{
+			Capacity = stagingBytes;
+		}
+	}
+
+	if( workers <= 0 )
+		workers = (int)std::thread::hardware_concurrency( ) - 1;
+	if( workers <= 0 )
+		workers = 1;
+	for( int i = 0; i < workers; i++ )
+		Workers.push_back( std::thread( &TextureStreamer::Work, this ) );
+
+	if( Verbose )
+		fprintf( stderr, "TextureStreamer: %d workers, %s\n", workers, Staging != NULL ? "persistent pbo staging" : "client memory staging" );
+	return true;
+}
+
+
+bool
+TextureStreamer::IsIdle( )
+{
+	return Pending == 0;
+}
+
+
+// queue a texture to be decoded and uploaded -- nothing happens until the next Update( ):
+
+void
+TextureStreamer::Load( const TextureRequest &request )
+{
+	Job *job = new Job;
+	job->Request = request;
+	job->Offset = 0;
+	job->Memory = NULL;
+	job->OwnMemory = false;
+	job->Ok = false;
+	Waiting.push_back( job );
+
+	if( Pending == 0 )
+		StartTime = Now( );
+	Pending++;
+}
+
+
+// give back the staging regions whose uploads the gpu has finished reading (in order, since the ring is a fifo):
+
+void
+TextureStreamer::Retire( bool wait )
+{
+	while( ! Live.empty( )  &&  Live.front( ).Fence != 0 )
+	{
+		GLuint64 timeout = wait ? 1000000000 : 0;
+		GLenum status = glClientWaitSync( Live.front( ).Fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout );
+		if( status != GL_ALREADY_SIGNALED  &&  status != GL_CONDITION_SATISFIED )
+			break;
+		glDeleteSync( Live.front( ).Fence );
+		Live.pop_front( );
+	}
+}
+
+
+// bytes of decoded texels to upload per Update( ) (0 = no limit) -- at least one texture always goes, however big:
+
+void
+TextureStreamer::SetUploadBudget( size_t bytes )
+{
+	Budget = bytes;
+}
+
+
+void
+TextureStreamer::SetVerbose( bool v )
+{
+	Verbose = v;
+}
+
+
+// call once a frame on the gl thread:
+
+void
+TextureStreamer::Update( )
+{
+	Retire( false );
+
+	// hand out staging memory in the order the textures were loaded:
+	int handed = 0;
+	while( ! Waiting.empty( ) )
+	{
+		Job *job = Waiting.front( );
+		size_t bytes = job->Request.Bytes( );
+		if( Staging != NULL  &&  bytes <= Capacity )
+		{
+			if( ! Allocate( bytes, &job->Offset ) )
+				break;
+			job->Memory = Staging + job->Offset;
+		}
+		else
+		{
+			job->Memory = new unsigned char[ bytes ];
+			job->OwnMemory = true;
+		}
+		Waiting.pop_front( );
+
+		std::lock_guard<std::mutex> lock( Lock );
+		Queued.push_back( job );
+		handed++;
+	}
+	if( handed > 0 )
+		Wake.notify_all( );
+
+	// and upload what the workers have finished, up to the budget:
+	std::vector<Job *> ready;
+	{
+		std::lock_guard<std::mutex> lock( Lock );
+		size_t spent = 0;
+		while( ! Decoded.empty( ) )
+		{
+			size_t bytes = Decoded.front( )->Request.Bytes( );
+			if( Budget != 0  &&  spent != 0  &&  spent + bytes > Budget )
+				break;
+			spent += bytes;
+			ready.push_back( Decoded.front( ) );
+			Decoded.pop_front( );
+		}
+	}
+	for( int i = 0; i < (int)ready.size( ); i++ )
+		Upload( ready[i] );
+}
+
+
+void
+TextureStreamer::Upload( Job *job )
+{
+	TextureRequest &r = job->Request;
+	bool staged = ! job->OwnMemory;
+
+	if( job->Ok )
+	{
+		GLState::BindTexture( GL_TEXTURE0, r.Target, r.Texture );
+		if( staged )
+			GLState::BindBuffer( GL_PIXEL_UNPACK_BUFFER, Pbo );
+		glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+
+		// with the pbo bound, the "pointer" is an offset into it:
+		const unsigned char *src = staged ? (const unsigned char *)(size_t)job->Offset : job->Memory;
+		for( int l = 0, w = r.Width, h = r.Height; l < r.Levels; l++, w = ( w > 1 ? w/2 : 1 ), h = ( h > 1 ? h/2 : 1 ) )
+		{
+			if( r.Target == GL_TEXTURE_2D_ARRAY )
+				glTexSubImage3D( r.Target, l, 0, 0, r.Layer, w, h, 1, r.Format, r.Type, src );
+			else
+				glTexSubImage2D( r.Target, l, 0, 0, w, h, r.Format, r.Type, src );
+			src += (size_t)w * h * r.TexelBytes;
+		}
+
+		glPixelStorei( GL_UNPACK_ALIGNMENT, 4 );
+		if( staged )
+			GLState::BindBuffer( GL_PIXEL_UNPACK_BUFFER, 0 );
+		Uploaded++;
+		UploadedBytes += (double)r.Bytes( );
+	}
+
+	if( staged )
+	{
+		// the region can be reused once the gpu has pulled the texels out of it:
+		for( int i = 0; i < (int)Live.size( ); i++ )
+		{
+			if( Live[i].Offset == job->Offset  &&  Live[i].Fence == 0 )
+			{
+				Live[i].Fence = glFenceSync( GL_SYNC_GPU_COMMANDS_COMPLETE, 0 );
+				break;
+			}
+		}
+	}
+	else
+	{
+		delete [ ] job->Memory;			// (without a pbo, glTexSubImage*( ) has already copied it)
+	}
+
+	if( r.Done )
+		r.Done( job->Ok );
+	delete job;
+
+	Pending--;
+	if( Pending == 0  &&  Verbose )
+		fprintf( stderr, "TextureStreamer: %d textures, %.1f MB, streamed in %.1f ms\n",
+			Uploaded, UploadedBytes / ( 1024.*1024. ), 1000. * ( Now( ) - StartTime ) );
+}
+
+
+void
+TextureStreamer::Work( )
+{
+	for( ; ; )
+	{
+		Job *job;
+		{
+			std::unique_lock<std::mutex> lock( Lock );
+			while( ! Quit  &&  Queued.empty( ) )
+				Wake.wait( lock );
+			if( Queued.empty( ) )
+				return;
+			job = Queued.front( );
+			Queued.pop_front( );
+		}
+
+		job->Ok = job->Request.Decode ? job->Request.Decode( job->Memory ) : false;
+
+		std::lock_guard<std::mutex> lock( Lock );
+		Decoded.push_back( job );
+	}
+}
+
+
+// a 1x1 texture (or array of 1x1 layers) of one color, to bind until the real one has been uploaded:
+
+GLuint
+TextureStreamer::CreatePlaceholder( GLenum target, int layers, const unsigned char rgba[4] )
+{
+	std::vector<unsigned char> texels( 4 * ( layers > 0 ? layers : 1 ) );
+	for( int i = 0; i < (int)texels.size( ); i++ )
+		texels[i] = rgba[ i % 4 ];
+
+	GLuint tex;
+	glGenTextures( 1, &tex );
+	GLState::BindTexture( GL_TEXTURE0, target, tex );
+	glTexParameteri( target, GL_TEXTURE_WRAP_S, GL_REPEAT );
+	glTexParameteri( target, GL_TEXTURE_WRAP_T, GL_REPEAT );
+	glTexParameteri( target, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
+	glTexParameteri( target, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
+	if( target == GL_TEXTURE_2D_ARRAY )
+		glTexImage3D( target, 0, GL_RGBA8, 1, 1, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, &texels[0] );
+	else
+		glTexImage2D( target, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, &texels[0] );
+	return tex;
+}
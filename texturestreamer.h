@@ -0,0 +1,119 @@
+#ifndef TEXTURE_STREAMER_H
+#define TEXTURE_STREAMER_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#include "glew.h"
+#include <GL/gl.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+// fills the staging memory with every mip level of one texture (or one layer of an array), level 0 first,
+// each level tightly packed and starting right after the one before it -- runs on a worker thread, so no gl calls:
+typedef std::function<bool( unsigned char * )>	TextureDecoder;
+
+// runs on the gl thread once the upload has been issued, with whether the decoder succeeded:
+typedef std::function<void( bool )>		TextureDone;
+
+
+// what to decode, and where its texels go:
+
+struct TextureRequest
+{
+	GLuint		Texture;
+	GLenum		Target;			// GL_TEXTURE_2D or GL_TEXTURE_2D_ARRAY (whose storage must already exist)
+	int		Layer;			// for GL_TEXTURE_2D_ARRAY
+	int		Width, Height;
+	int		Levels;
+	GLenum		Format, Type;
+	int		TexelBytes;
+	TextureDecoder	Decode;
+	TextureDone	Done;
+
+	TextureRequest( );
+	size_t		Bytes( );
+};
+
+
+// decodes textures on worker threads, straight into persistently mapped pixel-buffer-object memory,
+// and uploads them from there on the gl thread without stalling it
+//
+// Load( ) only queues the request; Update( ), called once a frame on the gl thread, hands requests to the workers as
+// staging memory frees up, issues glTexSubImage*( ) from the pbo for the ones that are decoded (up to a per-frame budget),
+// and fences each upload so its part of the staging ring is reused only after the gpu has read it
+// until a texture's Done( ) runs, the program should keep drawing with a placeholder (see CreatePlaceholder( ))
+//
+// without GL_ARB_buffer_storage the workers decode into ordinary memory and the upload comes from there
+
+class TextureStreamer
+{
+    private:
+	struct Job
+	{
+		TextureRequest		Request;
+		size_t			Offset;		// into the staging ring
+		unsigned char *		Memory;		// where the decoder writes
+		bool			OwnMemory;	// Memory is ours to delete [ ], not part of the ring
+		bool			Ok;
+	};
+
+	struct Region
+	{
+		size_t			Offset;
+		size_t			Size;
+		GLsync			Fence;
+	};
+
+	GLuint			Pbo;
+	unsigned char *		Staging;		// the persistent mapping of Pbo, or NULL
+	size_t			Capacity;
+	size_t			Head;
+	std::deque<Region>	Live;			// staging regions in the order they were handed out
+
+	std::deque<Job *>	Waiting;		// gl thread only: not given staging memory yet
+	std::deque<Job *>	Queued;			// under Lock: for the workers
+	std::deque<Job *>	Decoded;		// under Lock: for the gl thread
+	std::mutex		Lock;
+	std::condition_variable	Wake;
+	std::vector<std::thread>	Workers;
+	bool			Quit;
+
+	size_t			Budget;
+	int			Pending;		// loaded but not yet Done( )
+	int			Uploaded;
+	double			UploadedBytes;
+	double			StartTime;
+	bool			Verbose;
+
+	bool			Allocate( size_t, size_t * );
+	void			Retire( bool );
+	void			Upload( Job * );
+	void			Work( );
+
+    public:
+	TextureStreamer( );
+	~TextureStreamer( );
+
+	void			Finish( );
+	bool			Init( int = 0, size_t = 16*1024*1024 );
+	bool			IsIdle( );
+	void			Load( const TextureRequest & );
+	void			SetUploadBudget( size_t );
+	void			SetVerbose( bool );
+	void			Update( );
+
+	static GLuint		CreatePlaceholder( GLenum, int, const unsigned char [4] );
+};
+
+#endif		// #ifndef TEXTURE_STREAMER_H
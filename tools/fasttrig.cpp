@@ -0,0 +1,274 @@
+// fasttrig -- check glm's array sincos( ) and fastSinCos( ) against std::sin and std::cos, and time them against them
+//
+//	fasttrig [-count n] [-nobench]
+//
+// for floats and for doubles, count random angles are taken from each of a set of ranges, from [-1,1] out to [-1e30,1e30],
+// and their sines and cosines are compared against the exact ones -- a float's against std::sin and std::cos of it as a
+// double, and a double's against std::sin and std::cos of it as a long double
+// sincos( ) is reported in ulps, fastSinCos( ) in absolute error, along with 0, -0, inf, and nan, and sincos( ) of 1e6,
+// which comes out the same on every instruction set now that the angles past the polynomials' limits go to std::sin and std::cos
+// the exit status is 1 if sincos( ) is more than 1 ulp out, fastSinCos( ) more than 2e-5, or the twide<N> overloads
+// give other bits than the arrays
+// (msvc's long double is a double, so there the doubles are measured against a std::sin that is itself within an ulp or so)
+// unless -nobench is given, it then prints how long each takes per angle, against std::sin plus std::cos
+//
+// build it from this directory with, for example:
+//	cl /O2 /EHsc /fp:precise /I.. fasttrig.cpp
+//	cl /O2 /EHsc /fp:precise /arch:AVX2 /I.. fasttrig.cpp
+//	g++ -std=c++11 -O2 -I.. fasttrig.cpp -o fasttrig
+//	g++ -std=c++11 -O2 -mavx2 -mfma -I.. fasttrig.cpp -o fasttrig
+// (not with /fp:fast or -ffast-math, which let the compiler undo the reduction's exact sums)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "glm/glm.hpp"
+#include "glm/gtx/fast_trigonometry.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+
+#define DEFAULT_COUNT	1000000		// angles checked in each range
+#define NUM_RANGES	8
+#define MAX_ULPS	1.0		// what sincos( ) must be within,
+#define MAX_FAST_ERROR	2.e-5		// and what fastSinCos( ) must be within
+
+#define BENCH_SIZE	1000000		// angles each timed loop goes over
+#define BENCH_RANGE	100.		// within this of 0
+#define BENCH_RUNS	10		// the best run is reported
+
+static const double Ranges[NUM_RANGES] = { 1., 100., 6400., 1.e5, 1.e6, 1.e8, 1.e9, 1.e30 };
+
+
+// a small lcg, so every build and every platform sees the same angles:
+static unsigned int Seed = 1;
+
+static double
+Random( double range )
+{
+	Seed = Seed * 1664525u + 1013904223u;
+	double a = (double)( Seed >> 8 ) / (double)( 1 << 24 );
+	Seed = Seed * 1664525u + 1013904223u;
+	double b = (double)( Seed >> 8 ) / (double)( 1 << 24 ) / (double)( 1 << 24 );
+	return range * ( 2. * ( a + b ) - 1. );		// 48 random bits, so the doubles are not all on a coarse grid
+}
+
+
+// the exact values, and how far off a result is, in ulps of the exact value rounded to the result's type:
+static long double	Exact( float x, bool cosine )	{ return cosine ? cos( (double)x ) : sin( (double)x ); }
+static long double	Exact( double x, bool cosine )	{ return cosine ? cosl( (long double)x ) : sinl( (long double)x ); }
+
+template <typename T>
+static double
+Ulps( T got, long double exact )
+{
+	T rounded = (T)exact;
+	if( rounded == (T)0 )
+		return got == (T)0 ? 0. : 1.e30;
+	long double ulp = ldexpl( 1.L, std::ilogb( rounded ) - ( std::numeric_limits<T>::digits - 1 ) );
+	return (double)( fabsl( (long double)got - exact ) / ulp );
+}
+
+
+// each of sincos( ) and fastSinCos( ) over count angles in [-range,range], as arrays with one thread and with four,
+// and through the twide<N> overloads for floats:
+template <typename T>
+struct Run
+{
+	std::vector<T>	angle, sinA, cosA, sinF, cosF, sin4, cos4;
+
+	void	Go( int count, double range );
+	bool	SameAsWide( ) const;
+};
+
+template <typename T>
+void
+Run<T>::Go( int count, double range )
+{
+	angle.resize( count );
+	for( int i = 0; i < count; i++ )
+		angle[i] = (T)Random( range );
+	sinA.resize( count );  cosA.resize( count );
+	sinF.resize( count );  cosF.resize( count );
+	sin4.resize( count );  cos4.resize( count );
+
+	glm::sincos( &angle[0], &sinA[0], &cosA[0], count );
+	glm::fastSinCos( &angle[0], &sinF[0], &cosF[0], count );
+	glm::sincos( &angle[0], &sin4[0], &cos4[0], count, 4 );
+}
+
+template <>
+bool
+Run<double>::SameAsWide( ) const
+{
+	return true;
+}
+
+template <>
+bool
+Run<float>::SameAsWide( ) const
+{
+	const int N = glm::detail::wide_width;
+	for( size_t i = 0; i + N <= angle.size( ); i += N )
+	{
+		glm::twide<N> s, c, fs, fc;
+		glm::sincos( glm::twide<N>::load( &angle[i] ), s, c );
+		glm::fastSinCos( glm::twide<N>::load( &angle[i] ), fs, fc );
+		float S[N], C[N], FS[N], FC[N];
+		s.store( S );  c.store( C );  fs.store( FS );  fc.store( FC );
+		if( memcmp( S, &sinA[i], sizeof(S) ) != 0  ||  memcmp( C, &cosA[i], sizeof(C) ) != 0  ||
+		    memcmp( FS, &sinF[i], sizeof(FS) ) != 0  ||  memcmp( FC, &cosF[i], sizeof(FC) ) != 0 )
+			return false;
+	}
+	return true;
+}
+
+
+template <typename T>
+static bool
+Check( const char *type, int count )
+{
+	Seed = 1;
+	bool good = true;
+	fprintf( stderr, "%s:            sincos( ) ulps           fastSinCos( ) error\n", type );
+	fprintf( stderr, "  within          sin       cos            sin        cos\n" );
+	for( int r = 0; r < NUM_RANGES; r++ )
+	{
+		Run<T> run;
+		run.Go( count, Ranges[r] );
+
+		double sinUlps = 0., cosUlps = 0., sinError = 0., cosError = 0.;
+		for( int i = 0; i < count; i++ )
+		{
+			long double s = Exact( run.angle[i], false );
+			long double c = Exact( run.angle[i], true );
+			sinUlps = glm::max( sinUlps, Ulps( run.sinA[i], s ) );
+			cosUlps = glm::max( cosUlps, Ulps( run.cosA[i], c ) );
+			sinError = glm::max( sinError, (double)fabsl( run.sinF[i] - s ) );
+			cosError = glm::max( cosError, (double)fabsl( run.cosF[i] - c ) );
+		}
+		bool threaded = memcmp( &run.sinA[0], &run.sin4[0], count * sizeof(T) ) == 0  &&  memcmp( &run.cosA[0], &run.cos4[0], count * sizeof(T) ) == 0;
+		bool wide = run.SameAsWide( );
+		bool ok = sinUlps <= MAX_ULPS  &&  cosUlps <= MAX_ULPS  &&  sinError <= MAX_FAST_ERROR  &&  cosError <= MAX_FAST_ERROR  &&  threaded  &&  wide;
+
+		fprintf( stderr, "  %-8g   %8.3f  %8.3f       %9.2e  %9.2e%s%s%s\n", Ranges[r], sinUlps, cosUlps, sinError, cosError,
+			threaded ? "" : "  (4 threads differ!)", wide ? "" : "  (twide differs!)", ok ? "" : "  <-- out" );
+		good = good  &&  ok;
+	}
+
+	// the special angles:
+	T special[5] = { (T)0., -(T)0., std::numeric_limits<T>::infinity( ), -std::numeric_limits<T>::infinity( ), std::numeric_limits<T>::quiet_NaN( ) };
+	T sinS[5], cosS[5], sinFS[5], cosFS[5];
+	glm::sincos( special, sinS, cosS, 5 );
+	glm::fastSinCos( special, sinFS, cosFS, 5 );
+	bool ok = sinS[0] == (T)0.  &&  cosS[0] == (T)1.  &&  sinS[1] == (T)0.  &&  cosS[1] == (T)1.  &&
+		sinFS[0] == (T)0.  &&  cosFS[0] == (T)1.  &&  sinFS[1] == (T)0.  &&  cosFS[1] == (T)1.;
+	for( int i = 2; i < 5; i++ )
+		ok = ok  &&  sinS[i] != sinS[i]  &&  cosS[i] != cosS[i]  &&  sinFS[i] != sinFS[i]  &&  cosFS[i] != cosFS[i];
+	fprintf( stderr, "  0, -0, inf, -inf, nan: %s\n", ok ? "sin 0, cos 1, then nans" : "wrong!" );
+	good = good  &&  ok;
+
+	T big = (T)1.e6, sinB, cosB;
+	glm::sincos( &big, &sinB, &cosB, 1 );
+	fprintf( stderr, "  sincos( 1e6 ) = %.9f, %.9f  (exact %.9f, %.9f)\n", (double)sinB, (double)cosB, (double)Exact( big, false ), (double)Exact( big, true ) );
+
+	return good;
+}
+
+
+//////////////////////////////////////
+// the timed loops -- ns per angle, the best of BENCH_RUNS runs over BENCH_SIZE angles
+
+template <typename T>
+struct Bench
+{
+	std::vector<T>	angle, sinA, cosA;
+
+	Bench( )
+	{
+		Seed = 2;
+		angle.resize( BENCH_SIZE );  sinA.resize( BENCH_SIZE );  cosA.resize( BENCH_SIZE );
+		for( int i = 0; i < BENCH_SIZE; i++ )
+			angle[i] = (T)Random( BENCH_RANGE );
+	}
+
+	// which: 0 = std::sin and std::cos, 1 = sincos( ), 2 = fastSinCos( )
+	double
+	Time( int which )
+	{
+		double best = 1.e30;
+		for( int run = 0; run < BENCH_RUNS; run++ )
+		{
+			std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now( );
+			if( which == 0 )
+			{
+				for( int i = 0; i < BENCH_SIZE; i++ )
+				{
+					sinA[i] = std::sin( angle[i] );
+					cosA[i] = std::cos( angle[i] );
+				}
+			}
+			else if( which == 1 )
+				glm::sincos( &angle[0], &sinA[0], &cosA[0], BENCH_SIZE );
+			else
+				glm::fastSinCos( &angle[0], &sinA[0], &cosA[0], BENCH_SIZE );
+			std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now( );
+
+			double ns = std::chrono::duration<double, std::nano>( t1 - t0 ).count( ) / (double)BENCH_SIZE;
+			if( ns < best )
+				best = ns;
+		}
+		return best;
+	}
+
+	void
+	Print( const char *type )
+	{
+		double libm = Time( 0 );
+		double accurate = Time( 1 );
+		double fast = Time( 2 );
+		fprintf( stderr, "  %-7s std::sin + std::cos %6.2f    sincos( ) %6.2f  (%.1fx)    fastSinCos( ) %6.2f  (%.1fx)\n",
+			type, libm, accurate, libm / accurate, fast, libm / fast );
+	}
+};
+
+
+int
+main( int argc, char *argv[ ] )
+{
+	int count = DEFAULT_COUNT;
+	bool bench = true;
+	for( int i = 1; i < argc; i++ )
+	{
+		if( strcmp( argv[i], "-count" ) == 0  &&  i+1 < argc )
+			count = atoi( argv[++i] );
+		else if( strcmp( argv[i], "-nobench" ) == 0 )
+			bench = false;
+		else
+		{
+			fprintf( stderr, "Usage: fasttrig [-count n] [-nobench]\n" );
+			return 2;
+		}
+	}
+	if( count < 1 )
+		count = 1;
+
+	fprintf( stderr, "glm sincos lanes: %d\n", (int)glm::detail::wide_width );
+
+	bool good = Check<float>( "float", count );
+	good = Check<double>( "double", count )  &&  good;
+
+	if( bench )
+	{
+		fprintf( stderr, "ns per angle, best of %d runs over %d angles within %g of 0, one thread:\n", BENCH_RUNS, BENCH_SIZE, BENCH_RANGE );
+		Bench<float>( ).Print( "float" );
+		Bench<double>( ).Print( "double" );
+	}
+
+	return good ? 0 : 1;
+}
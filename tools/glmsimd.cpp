@@ -0,0 +1,316 @@
+// glmsimd -- time glm's vec4 and mat4 code, and check that GLM_FORCE_SIMD_STRICT gives the bits the scalar code does
+//
+//	glmsimd [-write file] [-check file] [-nobench]
+//
+// it is built twice, once with GLM_FORCE_PURE (the platform independent code) and once for the SSE or AVX paths:
+// -write saves the results of a fixed set of products, inverses, transposes, and vec4 operators,
+// and -check compares the same results from this build against a saved file, bit for bit,
+// printing how many floats differ for each operation, and by how many ulps at most (the exit status is 1 if any do)
+// unless -nobench is given, each build then prints how long each operation takes, in ns
+//
+// build it from this directory with, for example:
+//	cl /O2 /EHsc /DGLM_FORCE_PURE /I.. glmsimd.cpp /Feglmsimd_pure.exe
+//	cl /O2 /EHsc /arch:AVX2 /DGLM_FORCE_SIMD_STRICT /I.. glmsimd.cpp
+//	g++ -O2 -ffp-contract=off -DGLM_FORCE_PURE -I.. glmsimd.cpp -o glmsimd_pure
+//	g++ -O2 -ffp-contract=off -mavx2 -mfma -DGLM_FORCE_SIMD_STRICT -I.. glmsimd.cpp -o glmsimd
+// and then:
+//	glmsimd_pure -write pure.bin
+//	glmsimd -check pure.bin
+// (without GLM_FORCE_SIMD_STRICT the check shows how far the faster SIMD code is from the scalar code)
+// add -DGLM_FORCE_SIMD_STORAGE to time the paths with the register kept in vec4 itself, which makes it 16 byte aligned
+// (every build also checks, as it compiles, that vec4 has the layout it should)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "glm/glm.hpp"
+
+#include <chrono>
+#include <vector>
+
+
+// the SIMD paths leave vec4 four plain floats, and so leave alone the layout of what holds one,
+// unless GLM_FORCE_SIMD_STORAGE (or msvc's language extensions) keeps a register in it:
+struct FloatAndVec4
+{
+	float		f;
+	glm::vec4	v;
+};
+
+static_assert( sizeof(glm::vec4) == 16  &&  sizeof(glm::ivec4) == 16  &&  sizeof(glm::dvec4) == 32, "vec4 is not four components" );
+#if GLM_HAS_SIMD_STORAGE
+static_assert( alignof(glm::vec4) == alignof(glm::detail::simd<float>::type)  &&  sizeof(FloatAndVec4) == 16 + alignof(glm::vec4), "vec4 is not aligned like its register" );
+#else
+static_assert( alignof(glm::vec4) == alignof(glm::tvec1<float>)  &&  alignof(glm::ivec4) == alignof(glm::tvec1<int>)  &&  alignof(glm::dvec4) == alignof(glm::tvec1<double>), "vec4 is more aligned than its components" );
+static_assert( sizeof(FloatAndVec4) == 20, "a float and a vec4 are not 20 bytes" );
+#endif
+
+
+#define NUM_CASES	2000		// random matrices and vectors that are checked
+#define BENCH_SIZE	1024		// elements each timed loop goes over
+#define BENCH_PASSES	200		// times it goes over them, per run
+#define BENCH_RUNS	25		// the best run is reported
+
+#define NUM_MAT_OPS	4
+#define NUM_VEC_OPS	9
+
+static const char *MatOpNames[NUM_MAT_OPS] = { "mat4*mat4", "inverse", "transpose", "mat4/mat4" };
+static const char *VecOpNames[NUM_VEC_OPS] = { "mat4*vec4", "vec4*mat4", "vec4+vec4", "vec4-vec4", "vec4*vec4", "vec4/vec4",
+						"vec4*float", "float/vec4", "-vec4" };
+
+// one case's results, in the order they are written:
+struct Results
+{
+	glm::mat4	mats[NUM_MAT_OPS];
+	glm::vec4	vecs[NUM_VEC_OPS];
+};
+
+
+// a small lcg, so every build and every platform sees the same numbers:
+static unsigned int Seed = 1;
+
+static float
+Random( float low, float high )
+{
+	Seed = Seed * 1664525u + 1013904223u;
+	return low + ( high - low ) * (float)( Seed >> 8 ) / (float)( 1 << 24 );
+}
+
+
+// a matrix that is comfortably invertible -- random, plus a diagonal that dominates it:
+static glm::mat4
+RandomMatrix( )
+{
+	glm::mat4 m;
+	for( int c = 0; c < 4; c++ )
+		for( int r = 0; r < 4; r++ )
+			m[c][r] = Random( -2.f, 2.f ) + ( c == r ? 4.f : 0.f );
+	return m;
+}
+
+
+static glm::vec4
+RandomVector( )
+{
+	return glm::vec4( Random( -2.f, 2.f ), Random( -2.f, 2.f ), Random( -2.f, 2.f ), Random( 0.5f, 2.f ) );
+}
+
+
+static void
+Compute( std::vector<Results> &results )
+{
+	Seed = 1;
+	results.resize( NUM_CASES );
+	for( int i = 0; i < NUM_CASES; i++ )
+	{
+		glm::mat4 a = RandomMatrix( );
+		glm::mat4 b = RandomMatrix( );
+		glm::vec4 v = RandomVector( );
+		glm::vec4 w = RandomVector( );
+		float s = Random( 0.5f, 2.f );
+
+		Results &r = results[i];
+		r.mats[0] = a * b;
+		r.mats[1] = glm::inverse( a );
+		r.mats[2] = glm::transpose( a );
+		r.mats[3] = a / b;
+		r.vecs[0] = a * v;
+		r.vecs[1] = v * a;
+		r.vecs[2] = v + w;
+		r.vecs[3] = v - w;
+		r.vecs[4] = v * w;
+		r.vecs[5] = v / w;
+		r.vecs[6] = v * s;
+		r.vecs[7] = s / w;
+		r.vecs[8] = -v;
+	}
+}
+
+
+// how many floats of the operation differ, and by how many ulps at most:
+static void
+Differ( const float *mine, const float *theirs, int n, int *count, int *ulps )
+{
+	for( int i = 0; i < n; i++ )
+	{
+		int a, b;
+		memcpy( &a, &mine[i], sizeof(int) );
+		memcpy( &b, &theirs[i], sizeof(int) );
+		if( a == b )
+			continue;
+		( *count )++;
+		int d = a > b ? a - b : b - a;
+		if( d > *ulps )
+			*ulps = d;
+	}
+}
+
+
+static bool
+Check( const std::vector<Results> &results, const char *file )
+{
+	std::vector<Results> saved( NUM_CASES );
+	FILE *fp = fopen( file, "rb" );
+	if( fp == NULL )
+	{
+		fprintf( stderr, "Cannot open '%s'\n", file );
+		return false;
+	}
+	size_t got = fread( &saved[0], sizeof(Results), NUM_CASES, fp );
+	fclose( fp );
+	if( got != NUM_CASES )
+	{
+		fprintf( stderr, "'%s' is too short -- was it written by this version of glmsimd?\n", file );
+		return false;
+	}
+
+	bool same = true;
+	for( int op = 0; op < NUM_MAT_OPS + NUM_VEC_OPS; op++ )
+	{
+		int count = 0, ulps = 0, n = 0;
+		for( int i = 0; i < NUM_CASES; i++ )
+		{
+			const float *mine, *theirs;
+			if( op < NUM_MAT_OPS )
+			{
+				mine = &results[i].mats[op][0][0];
+				theirs = &saved[i].mats[op][0][0];
+				n = 16;
+			}
+			else
+			{
+				mine = &results[i].vecs[op - NUM_MAT_OPS][0];
+				theirs = &saved[i].vecs[op - NUM_MAT_OPS][0];
+				n = 4;
+			}
+			Differ( mine, theirs, n, &count, &ulps );
+		}
+		const char *name = op < NUM_MAT_OPS ? MatOpNames[op] : VecOpNames[op - NUM_MAT_OPS];
+		if( count == 0 )
+			fprintf( stderr, "%-12s same bits\n", name );
+		else
+			fprintf( stderr, "%-12s %6d of %6d floats differ, by up to %d ulps\n", name, count, NUM_CASES * n, ulps );
+		same = same  &&  count == 0;
+	}
+	return same;
+}
+
+
+//////////////////////////////////////
+// the timed loops -- each goes over all BENCH_SIZE elements once
+
+static std::vector<glm::mat4>	A, B, M;
+static std::vector<glm::vec4>	V, W, O;
+
+static void	MulMat( )	{ for( int i = 0; i < BENCH_SIZE; i++ )  M[i] = A[i] * B[i]; }
+static void	MulVec( )	{ for( int i = 0; i < BENCH_SIZE; i++ )  O[i] = A[i] * V[i]; }
+static void	MulRow( )	{ for( int i = 0; i < BENCH_SIZE; i++ )  O[i] = V[i] * A[i]; }
+static void	Inverse( )	{ for( int i = 0; i < BENCH_SIZE; i++ )  M[i] = glm::inverse( A[i] ); }
+static void	Transpose( )	{ for( int i = 0; i < BENCH_SIZE; i++ )  M[i] = glm::transpose( A[i] ); }
+static void	Arithmetic( )	{ for( int i = 0; i < BENCH_SIZE; i++ )  O[i] = ( V[i] + W[i] ) * V[i] - W[i] / 2.f; }
+
+// best ns per element over BENCH_RUNS runs:
+// (called through a pointer, so the compiler cannot fold the passes of a run into one)
+static double
+Time( void ( * volatile loop )( ) )
+{
+	double best = 1.e30;
+	for( int run = 0; run < BENCH_RUNS; run++ )
+	{
+		std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now( );
+		for( int pass = 0; pass < BENCH_PASSES; pass++ )
+			( *loop )( );
+		std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now( );
+		double ns = std::chrono::duration<double, std::nano>( t1 - t0 ).count( ) / ( (double)BENCH_PASSES * (double)BENCH_SIZE );
+		if( ns < best )
+			best = ns;
+	}
+	return best;
+}
+
+
+static void
+Bench( )
+{
+	Seed = 2;
+	A.resize( BENCH_SIZE );  B.resize( BENCH_SIZE );  M.resize( BENCH_SIZE );
+	V.resize( BENCH_SIZE );  W.resize( BENCH_SIZE );  O.resize( BENCH_SIZE );
+	for( int i = 0; i < BENCH_SIZE; i++ )
+	{
+		A[i] = RandomMatrix( );
+		B[i] = RandomMatrix( );
+		V[i] = RandomVector( );
+		W[i] = RandomVector( );
+	}
+
+	fprintf( stderr, "ns per operation, best of %d runs over %d elements:\n", BENCH_RUNS, BENCH_SIZE );
+	fprintf( stderr, "  mat4*mat4  %6.2f\n", Time( MulMat ) );
+	fprintf( stderr, "  mat4*vec4  %6.2f\n", Time( MulVec ) );
+	fprintf( stderr, "  vec4*mat4  %6.2f\n", Time( MulRow ) );
+	fprintf( stderr, "  inverse    %6.2f\n", Time( Inverse ) );
+	fprintf( stderr, "  transpose  %6.2f\n", Time( Transpose ) );
+	fprintf( stderr, "  vec4 ops   %6.2f   ((v+w)*v - w/2)\n", Time( Arithmetic ) );
+
+	// use the results, so none of the loops can be thrown away:
+	float sum = 0.f;
+	for( int i = 0; i < BENCH_SIZE; i++ )
+		sum += M[i][1][2] + O[i].w;
+	fprintf( stderr, "  (checksum %g)\n", sum );
+}
+
+
+int
+main( int argc, char *argv[ ] )
+{
+	const char *writeFile = NULL;
+	const char *checkFile = NULL;
+	bool bench = true;
+	for( int i = 1; i < argc; i++ )
+	{
+		if( strcmp( argv[i], "-write" ) == 0  &&  i+1 < argc )
+			writeFile = argv[++i];
+		else if( strcmp( argv[i], "-check" ) == 0  &&  i+1 < argc )
+			checkFile = argv[++i];
+		else if( strcmp( argv[i], "-nobench" ) == 0 )
+			bench = false;
+		else
+		{
+			fprintf( stderr, "Usage: glmsimd [-write file] [-check file] [-nobench]\n" );
+			return 2;
+		}
+	}
+
+	const char *path = "platform independent";
+	if( GLM_ARCH & GLM_ARCH_AVX2 )
+		path = "AVX2";
+	else if( GLM_ARCH & GLM_ARCH_AVX )
+		path = "AVX";
+	else if( GLM_ARCH & GLM_ARCH_SSE2 )
+		path = "SSE2";
+	fprintf( stderr, "glm code path: %s%s%s%s\n", path, GLM_HAS_SIMD_STORAGE ? ", register storage" : "",
+		GLM_SIMD_STRICT ? ", strict" : "", GLM_SIMD_FMA ? ", fused multiply-adds" : "" );
+
+	std::vector<Results> results;
+	Compute( results );
+
+	if( writeFile != NULL )
+	{
+		FILE *fp = fopen( writeFile, "wb" );
+		if( fp == NULL  ||  fwrite( &results[0], sizeof(Results), NUM_CASES, fp ) != NUM_CASES )
+		{
+			fprintf( stderr, "Cannot write '%s'\n", writeFile );
+			return 1;
+		}
+		fclose( fp );
+	}
+
+	bool same = true;
+	if( checkFile != NULL )
+		same = Check( results, checkFile );
+
+	if( bench )
+		Bench( );
+
+	return same ? 0 : 1;
+}
@@ -0,0 +1,374 @@
+// glmwide -- check glm's wide (structure-of-arrays) vectors against the scalar glm functions, and time a kernel with each
+//
+//	glmwide [-nobench]
+//
+// every lane-wise function of gtx_wide is run over the same vectors as the scalar glm function it stands in for,
+// 4 lanes and 8 lanes at a time, going through load_aos( ) and store_aos( ) (and load_strided( ) and store_strided( ))
+// with a count that is not a multiple of either, so that the last load and store of each is a partial one
+// the results are compared bit for bit, and the floats just past the end of each output are checked to be untouched
+// -- the exit status is 1 if anything differs
+// unless -nobench is given, a normalize( cross( ) ) and mix( ) kernel is then timed over an array of vec3s,
+// with the scalar functions and with each lane width
+//
+// the wide functions give the same bits only when neither side is compiled with fused multiply-adds,
+// so build it from this directory with, for example:
+//	cl /O2 /EHsc /fp:precise /I.. glmwide.cpp
+//	cl /O2 /EHsc /fp:precise /arch:AVX /I.. glmwide.cpp
+//	g++ -std=c++11 -O2 -ffp-contract=off -I.. glmwide.cpp -o glmwide
+//	g++ -std=c++11 -O2 -ffp-contract=off -mavx -I.. glmwide.cpp -o glmwide
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "glm/glm.hpp"
+#include "glm/gtx/wide.hpp"
+
+#include <chrono>
+#include <vector>
+
+
+#define NUM_VECTORS	10007		// not a multiple of 4 or 8, so each output ends with a partial store
+#define PAD		8		// floats past the end of S that a twide<8>::load( ) may read
+#define SENTINEL	-12345.f	// what is past the end of each output, and must still be there after it is written
+
+#define BENCH_SIZE	4096		// vectors each timed loop goes over
+#define BENCH_PASSES	100		// times it goes over them, per run
+#define BENCH_RUNS	25		// the best run is reported
+
+
+// a small lcg, so every build and every platform sees the same vectors:
+static unsigned int Seed = 1;
+
+static float
+Random( float low, float high )
+{
+	Seed = Seed * 1664525u + 1013904223u;
+	return low + ( high - low ) * (float)( Seed >> 8 ) / (float)( 1 << 24 );
+}
+
+
+static std::vector<glm::vec3>	A3, B3;
+static std::vector<glm::vec4>	A4, B4;
+static std::vector<float>	S;		// in [0,1], for mix( ) and the like
+
+static void
+MakeInputs( )
+{
+	Seed = 1;
+	A3.resize( NUM_VECTORS );  B3.resize( NUM_VECTORS );
+	A4.resize( NUM_VECTORS );  B4.resize( NUM_VECTORS );
+	S.resize( NUM_VECTORS + PAD );
+	for( int i = 0; i < NUM_VECTORS; i++ )
+	{
+		for( int c = 0; c < 3; c++ )
+		{
+			A3[i][c] = Random( -2.f, 2.f );
+			B3[i][c] = Random( -2.f, 2.f );
+		}
+		for( int c = 0; c < 4; c++ )
+		{
+			A4[i][c] = Random( -2.f, 2.f );
+			B4[i][c] = Random( -2.f, 2.f );
+		}
+		S[i] = Random( 0.f, 1.f );
+	}
+	for( int i = NUM_VECTORS; i < NUM_VECTORS + PAD; i++ )
+		S[i] = 0.f;
+}
+
+
+// how many of the n floats differ, and by how many ulps at most, and whether the pad floats after them were left alone:
+static bool
+Report( const char *name, int lanes, const float *scalar, const float *wide, int n )
+{
+	int count = 0, ulps = 0;
+	for( int i = 0; i < n; i++ )
+	{
+		int a, b;
+		memcpy( &a, &scalar[i], sizeof(int) );
+		memcpy( &b, &wide[i], sizeof(int) );
+		if( a == b )
+			continue;
+		count++;
+		int d = a > b ? a - b : b - a;
+		if( d > ulps )
+			ulps = d;
+	}
+
+	bool untouched = true;
+	for( int i = n; i < n + PAD; i++ )
+		untouched = untouched  &&  wide[i] == SENTINEL;
+
+	if( count == 0 )
+		fprintf( stderr, "  %-22s x%d  same bits%s\n", name, lanes, untouched ? "" : ", but it wrote past the end!" );
+	else
+		fprintf( stderr, "  %-22s x%d  %6d of %6d floats differ, by up to %d ulps%s\n", name, lanes, count, n, ulps,
+			untouched ? "" : ", and it wrote past the end!" );
+	return count == 0  &&  untouched;
+}
+
+
+// each check runs scalar over every vector, with a and b the i-th vectors of the inputs and s = S[i],
+// then wide over them N at a time, with a and b loaded with load_aos( ) and s with twide<N>::load( ):
+
+// a vec3 (or vec4) result, stored with store_aos( ):
+#define VEC_FLOATS( vec )	(int)( sizeof(vec) / sizeof(float) )
+
+#define CHECK_VEC( name, vec, A, B, scalar, wide )							\
+	{												\
+		std::vector<float> want( VEC_FLOATS( vec ) * NUM_VECTORS );				\
+		std::vector<float> got( VEC_FLOATS( vec ) * NUM_VECTORS + PAD, SENTINEL );		\
+		for( int i = 0; i < NUM_VECTORS; i++ )							\
+		{											\
+			vec a = A[i], b = B[i];								\
+			float s = S[i];									\
+			vec r = scalar;									\
+			memcpy( &want[VEC_FLOATS( vec ) * i], &r[0], sizeof(vec) );			\
+		}											\
+		for( int i = 0; i < NUM_VECTORS; i += N )						\
+		{											\
+			int count = NUM_VECTORS - i < N ? NUM_VECTORS - i : N;				\
+			Wide a, b;									\
+			glm::load_aos( a, &A[i], count );						\
+			glm::load_aos( b, &B[i], count );						\
+			glm::twide<N> s = glm::twide<N>::load( &S[i] );					\
+			glm::store_aos( (vec *)&got[VEC_FLOATS( vec ) * i], Wide( wide ), count );	\
+		}											\
+		same = Report( name, N, &want[0], &got[0], VEC_FLOATS( vec ) * NUM_VECTORS )  &&  same;	\
+	}
+
+// a float result, one per lane:
+#define CHECK_FLOAT( name, vec, A, B, scalar, wide )							\
+	{												\
+		std::vector<float> want( NUM_VECTORS );							\
+		std::vector<float> got( NUM_VECTORS + PAD, SENTINEL );					\
+		for( int i = 0; i < NUM_VECTORS; i++ )							\
+		{											\
+			vec a = A[i], b = B[i];								\
+			float s = S[i];									\
+			want[i] = scalar;								\
+		}											\
+		for( int i = 0; i < NUM_VECTORS; i += N )						\
+		{											\
+			int count = NUM_VECTORS - i < N ? NUM_VECTORS - i : N;				\
+			Wide a, b;									\
+			glm::load_aos( a, &A[i], count );						\
+			glm::load_aos( b, &B[i], count );						\
+			glm::twide<N> s = glm::twide<N>::load( &S[i] );					\
+			float lanes[N];									\
+			glm::twide<N>( wide ).store( lanes );						\
+			memcpy( &got[i], lanes, count * sizeof(float) );				\
+		}											\
+		same = Report( name, N, &want[0], &got[0], NUM_VECTORS )  &&  same;			\
+	}
+
+template <int N>
+static bool
+Check3( )
+{
+	typedef glm::tvec3x<N> Wide;
+	bool same = true;
+
+	CHECK_VEC( "vec3 + - * /",		glm::vec3, A3, B3, ( a + b ) * a - b / ( s + 1.f ),	( a + b ) * a - b / ( s + 1.f ) )
+	CHECK_VEC( "vec3 * float, -vec3",	glm::vec3, A3, B3, -( a * 3.f ) / 2.f + b * s,		-( a * 3.f ) / 2.f + b * s )
+	CHECK_VEC( "cross",			glm::vec3, A3, B3, glm::cross( a, b ),			glm::cross( a, b ) )
+	CHECK_VEC( "normalize",			glm::vec3, A3, B3, glm::normalize( a ),			glm::normalize( a ) )
+	CHECK_VEC( "min, max",			glm::vec3, A3, B3, glm::min( a, b ) + glm::max( a, b ) * 2.f,	glm::min( a, b ) + glm::max( a, b ) * 2.f )
+	CHECK_VEC( "clamp",			glm::vec3, A3, B3, glm::clamp( a, -1.f, 0.5f ),		glm::clamp( a, -1.f, 0.5f ) )
+	CHECK_VEC( "mix, by lane",		glm::vec3, A3, B3, glm::mix( a, b, s ),			glm::mix( a, b, s ) )
+	CHECK_VEC( "mix, by float",		glm::vec3, A3, B3, glm::mix( a, b, 0.3f ),		glm::mix( a, b, 0.3f ) )
+	CHECK_VEC( "smoothstep",		glm::vec3, A3, B3, glm::smoothstep( -1.f, 1.5f, a ),	glm::smoothstep( -1.f, 1.5f, a ) )
+	CHECK_FLOAT( "dot vec3",		glm::vec3, A3, B3, glm::dot( a, b ),			glm::dot( a, b ) )
+	CHECK_FLOAT( "length vec3",		glm::vec3, A3, B3, glm::length( a ),			glm::length( a ) )
+	CHECK_FLOAT( "distance",		glm::vec3, A3, B3, glm::distance( a, b ),		glm::distance( a, b ) )
+
+	// the float functions, on the lanes of a.x:
+	CHECK_FLOAT( "floor, fract",		glm::vec3, A3, B3, glm::floor( a.x * 7.f ) + glm::fract( a.y * 5.f ),	glm::floor( a.x * 7.f ) + glm::fract( a.y * 5.f ) )
+	CHECK_FLOAT( "mod",			glm::vec3, A3, B3, glm::mod( a.x * 7.f, 1.5f ) + glm::mod( a.y, b.z ),	glm::mod( a.x * 7.f, 1.5f ) + glm::mod( a.y, b.z ) )
+	// (glm 0.9.6's scalar step( ) of two floats doesn't compile, so the scalar side is spelled out the way it is defined)
+	CHECK_FLOAT( "step",			glm::vec3, A3, B3, ( a.x < 0.25f ? 0.f : 1.f ) + ( b.y < a.y ? 0.f : 1.f ) + ( 0.5f < a.z ? 0.f : 1.f ),
+										glm::step( 0.25f, a.x ) + glm::step( a.y, b.y ) + glm::step( a.z, 0.5f ) )
+	CHECK_FLOAT( "abs, sqrt, inversesqrt",	glm::vec3, A3, B3, glm::sqrt( glm::abs( a.x ) ) + glm::inversesqrt( glm::abs( a.y ) + 0.01f ),
+										glm::sqrt( glm::abs( a.x ) ) + glm::inversesqrt( glm::abs( a.y ) + 0.01f ) )
+	CHECK_FLOAT( "clamp, mix float",	glm::vec3, A3, B3, glm::clamp( a.x, b.x, b.x + 1.f ) + glm::mix( a.y, b.y, s ),
+										glm::clamp( a.x, b.x, b.x + 1.f ) + glm::mix( a.y, b.y, s ) )
+	CHECK_FLOAT( "smoothstep float",	glm::vec3, A3, B3, glm::smoothstep( b.x, b.x + 2.5f, a.x ),	glm::smoothstep( b.x, b.x + 2.5f, a.x ) )
+
+	return same;
+}
+
+template <int N>
+static bool
+Check4( )
+{
+	typedef glm::tvec4x<N> Wide;
+	bool same = true;
+
+	CHECK_VEC( "vec4 + - * /",		glm::vec4, A4, B4, ( a + b ) * a - b / ( s + 1.f ),	( a + b ) * a - b / ( s + 1.f ) )
+	CHECK_VEC( "vec4 * float, -vec4",	glm::vec4, A4, B4, -( a * 3.f ) / 2.f + b * s,		-( a * 3.f ) / 2.f + b * s )
+	CHECK_VEC( "normalize vec4",		glm::vec4, A4, B4, glm::normalize( a ),			glm::normalize( a ) )
+	CHECK_VEC( "min, max vec4",		glm::vec4, A4, B4, glm::min( a, b ) + glm::max( a, b ) * 2.f,	glm::min( a, b ) + glm::max( a, b ) * 2.f )
+	CHECK_VEC( "clamp vec4",		glm::vec4, A4, B4, glm::clamp( a, -1.f, 0.5f ),	glm::clamp( a, -1.f, 0.5f ) )
+	CHECK_VEC( "mix vec4",			glm::vec4, A4, B4, glm::mix( a, b, s ) + glm::mix( a, b, 0.3f ),	glm::mix( a, b, s ) + glm::mix( a, b, 0.3f ) )
+	CHECK_VEC( "smoothstep vec4",		glm::vec4, A4, B4, glm::smoothstep( -1.f, 1.5f, a ),	glm::smoothstep( -1.f, 1.5f, a ) )
+	CHECK_FLOAT( "dot vec4",		glm::vec4, A4, B4, glm::dot( a, b ),			glm::dot( a, b ) )
+	CHECK_FLOAT( "length vec4",		glm::vec4, A4, B4, glm::length( a ),			glm::length( a ) )
+
+	return same;
+}
+
+#undef CHECK_VEC
+#undef VEC_FLOATS
+#undef CHECK_FLOAT
+
+
+// a vertex like VertexBufferObject's, to go through load_strided( ) and store_strided( ):
+struct Vertex
+{
+	glm::vec3	position;
+	float		pad;
+	glm::vec4	color;
+};
+
+template <int N>
+static bool
+CheckStrided( )
+{
+	std::vector<Vertex> in( NUM_VECTORS ), want( NUM_VECTORS + PAD ), got( NUM_VECTORS + PAD );
+	for( int i = 0; i < NUM_VECTORS + PAD; i++ )
+	{
+		want[i].position = got[i].position = glm::vec3( SENTINEL );
+		want[i].color = got[i].color = glm::vec4( SENTINEL );
+		want[i].pad = got[i].pad = SENTINEL;
+	}
+	for( int i = 0; i < NUM_VECTORS; i++ )
+	{
+		in[i].position = A3[i];
+		in[i].color = A4[i];
+		in[i].pad = S[i];
+		want[i].position = glm::normalize( in[i].position );
+		want[i].color = in[i].color * 2.f;
+	}
+
+	for( int i = 0; i < NUM_VECTORS; i += N )
+	{
+		int count = NUM_VECTORS - i < N ? NUM_VECTORS - i : N;
+		glm::tvec3x<N> p;
+		glm::tvec4x<N> c;
+		glm::load_strided( p, &in[i].position[0], sizeof(Vertex), count );
+		glm::load_strided( c, &in[i].color[0], sizeof(Vertex), count );
+		glm::store_strided( &got[i].position[0], sizeof(Vertex), glm::normalize( p ), count );
+		glm::store_strided( &got[i].color[0], sizeof(Vertex), c * 2.f, count );
+	}
+
+	int floats = (int)( sizeof(Vertex) / sizeof(float) );		// == PAD
+	std::vector<float> wantFloats( floats * ( NUM_VECTORS + PAD ) ), gotFloats( floats * ( NUM_VECTORS + PAD ) );
+	memcpy( &wantFloats[0], &want[0], wantFloats.size( ) * sizeof(float) );
+	memcpy( &gotFloats[0], &got[0], gotFloats.size( ) * sizeof(float) );
+
+	// want is SENTINEL in every pad and in the vertices past the end, so comparing all of it also checks
+	// that nothing but the positions and colors was written (the last vertex, PAD floats, is Report( )'s past-the-end check):
+	return Report( "load/store_strided", N, &wantFloats[0], &gotFloats[0], floats * ( NUM_VECTORS + PAD ) - PAD );
+}
+
+
+//////////////////////////////////////
+// the timed kernel: n = normalize( cross( a, b ) ), then mix( n, a, s ), over BENCH_SIZE vec3s
+
+static std::vector<glm::vec3>	Out;
+
+static void
+KernelScalar( )
+{
+	for( int i = 0; i < BENCH_SIZE; i++ )
+		Out[i] = glm::mix( glm::normalize( glm::cross( A3[i], B3[i] ) ), A3[i], S[i] );
+}
+
+template <int N>
+static void
+KernelWide( )
+{
+	for( int i = 0; i < BENCH_SIZE; i += N )
+	{
+		glm::tvec3x<N> a, b;
+		glm::load_aos( a, &A3[i] );
+		glm::load_aos( b, &B3[i] );
+		glm::store_aos( &Out[i], glm::mix( glm::normalize( glm::cross( a, b ) ), a, glm::twide<N>::load( &S[i] ) ) );
+	}
+}
+
+// best ns per vector over BENCH_RUNS runs:
+// (called through a pointer, so the compiler cannot fold the passes of a run into one)
+static double
+Time( void ( * volatile loop )( ) )
+{
+	double best = 1.e30;
+	for( int run = 0; run < BENCH_RUNS; run++ )
+	{
+		std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now( );
+		for( int pass = 0; pass < BENCH_PASSES; pass++ )
+			( *loop )( );
+		std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now( );
+		double ns = std::chrono::duration<double, std::nano>( t1 - t0 ).count( ) / ( (double)BENCH_PASSES * (double)BENCH_SIZE );
+		if( ns < best )
+			best = ns;
+	}
+	return best;
+}
+
+
+static void
+Bench( )
+{
+	Out.resize( BENCH_SIZE );
+
+	double scalar = Time( KernelScalar );
+	double x4 = Time( KernelWide<4> );
+	double x8 = Time( KernelWide<8> );
+	fprintf( stderr, "ns per vec3 of mix( normalize( cross( a, b ) ), a, s ), best of %d runs over %d vectors:\n", BENCH_RUNS, BENCH_SIZE );
+	fprintf( stderr, "  scalar   %6.2f\n", scalar );
+	fprintf( stderr, "  x4       %6.2f  (%.1fx)\n", x4, scalar / x4 );
+	fprintf( stderr, "  x8       %6.2f  (%.1fx)\n", x8, scalar / x8 );
+
+	// use the results, so the loops cannot be thrown away:
+	float sum = 0.f;
+	for( int i = 0; i < BENCH_SIZE; i++ )
+		sum += Out[i].x;
+	fprintf( stderr, "  (checksum %g)\n", sum );
+}
+
+
+int
+main( int argc, char *argv[ ] )
+{
+	bool bench = true;
+	for( int i = 1; i < argc; i++ )
+	{
+		if( strcmp( argv[i], "-nobench" ) == 0 )
+			bench = false;
+		else
+		{
+			fprintf( stderr, "Usage: glmwide [-nobench]\n" );
+			return 2;
+		}
+	}
+
+	const char *x4 = ( GLM_ARCH & GLM_ARCH_SSE2 ) ? "SSE" : "portable";
+	const char *x8 = ( GLM_ARCH & GLM_ARCH_AVX ) ? "AVX" : "portable";
+	fprintf( stderr, "glm wide lanes: x4 %s, x8 %s\n", x4, x8 );
+
+	MakeInputs( );
+	bool same = true;
+	same = Check3<4>( )  &&  same;
+	same = Check3<8>( )  &&  same;
+	same = Check4<4>( )  &&  same;
+	same = Check4<8>( )  &&  same;
+	same = CheckStrided<4>( )  &&  same;
+	same = CheckStrided<8>( )  &&  same;
+
+	if( bench )
+		Bench( );
+
+	return same ? 0 : 1;
+}
@@ -0,0 +1,231 @@
+// noisebatch -- check glm's batch perlin( ) and simplex( ) against the scalar ones, and time a noise tile with each
+//
+//	noisebatch [-size n] [-octaves n] [-threads n] [-nobench]
+//
+// every function of gtx_noise_batch (perlin, periodic perlin, and simplex, of vec2, vec3, and vec4) is run over the
+// same positions as the gtc_noise function it replaces, with one thread and with several, and the results are compared
+// bit for bit -- the exit status is 1 if any differ
+// unless -nobench is given, a size x size tile of periodic perlin( ) vec2 noise, octaves octaves deep, is then made
+// the way NoiseGen makes it, one row of one octave at a time, with the scalar function and with the batch one
+//
+// the batch functions give the same bits only when neither side is compiled with fused multiply-adds,
+// so build it from this directory with, for example:
+//	cl /O2 /EHsc /fp:precise /I.. noisebatch.cpp
+//	cl /O2 /EHsc /fp:precise /arch:AVX /I.. noisebatch.cpp
+//	g++ -std=c++11 -O2 -ffp-contract=off -pthread -I.. noisebatch.cpp -o noisebatch
+//	g++ -std=c++11 -O2 -ffp-contract=off -mavx -pthread -I.. noisebatch.cpp -o noisebatch
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/noise.hpp"
+#include "glm/gtx/noise_batch.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+
+#define NUM_POSITIONS	20011		// not a multiple of any lane count, so the tail of each array is checked too
+#define NEAR_RANGE	40.f		// most positions are within this of the origin,
+#define FAR_RANGE	3000.f		// and every seventh is within this, where the lattice hashes are large
+#define CHECK_THREADS	4
+
+#define DEFAULT_SIZE	1024
+#define DEFAULT_OCTAVES	4
+#define BASE_FREQUENCY	4.f
+#define BENCH_RUNS	3		// the best run is reported
+
+
+// a small lcg, so every build and every platform sees the same positions:
+static unsigned int Seed = 1;
+
+static float
+Random( float range )
+{
+	Seed = Seed * 1664525u + 1013904223u;
+	return range * ( 2.f * (float)( Seed >> 8 ) / (float)( 1 << 24 ) - 1.f );
+}
+
+
+static float
+Coordinate( int i )
+{
+	return Random( i % 7 == 6 ? FAR_RANGE : NEAR_RANGE );
+}
+
+
+// how many results differ from the scalar ones, and by how much at most:
+static bool
+Report( const char *name, const std::vector<float> &scalar, const std::vector<float> &batch1, const std::vector<float> &batchN )
+{
+	int count = 0;
+	float most = 0.f;
+	for( int i = 0; i < NUM_POSITIONS; i++ )
+	{
+		float b[2] = { batch1[i], batchN[i] };
+		for( int k = 0; k < 2; k++ )
+		{
+			if( memcmp( &b[k], &scalar[i], sizeof(float) ) == 0 )
+				continue;
+			count++;
+			float d = b[k] > scalar[i] ? b[k] - scalar[i] : scalar[i] - b[k];
+			if( d > most )
+				most = d;
+		}
+	}
+
+	if( count == 0 )
+		fprintf( stderr, "%-16s same bits\n", name );
+	else
+		fprintf( stderr, "%-16s %6d of %6d results differ, by up to %g\n", name, count, 2 * NUM_POSITIONS, most );
+	return count == 0;
+}
+
+
+// run the scalar function over every position, then the batch one with one thread and with CHECK_THREADS:
+#define CHECK( name, vec, scalarCall, batchCall )							\
+	{												\
+		std::vector<vec> p( NUM_POSITIONS );							\
+		for( int i = 0; i < NUM_POSITIONS; i++ )						\
+			for( int c = 0; c < p[i].length( ); c++ )					\
+				p[i][c] = Coordinate( i );						\
+		std::vector<float> scalar( NUM_POSITIONS ), batch1( NUM_POSITIONS ), batchN( NUM_POSITIONS );	\
+		for( int i = 0; i < NUM_POSITIONS; i++ )						\
+			scalar[i] = scalarCall;								\
+		{ float *out = &batch1[0];  int threads = 1;  batchCall; }				\
+		{ float *out = &batchN[0];  int threads = CHECK_THREADS;  batchCall; }			\
+		same = Report( name, scalar, batch1, batchN )  &&  same;				\
+	}
+
+static bool
+Check( )
+{
+	Seed = 1;
+	bool same = true;
+	glm::vec2 rep2( 5.f, 7.f );
+	glm::vec3 rep3( 5.f, 7.f, 3.f );
+	glm::vec4 rep4( 5.f, 7.f, 3.f, 11.f );
+
+	CHECK( "perlin vec2",          glm::vec2, glm::perlin( p[i] ),         glm::perlin( &p[0], out, NUM_POSITIONS, threads ) )
+	CHECK( "perlin vec3",          glm::vec3, glm::perlin( p[i] ),         glm::perlin( &p[0], out, NUM_POSITIONS, threads ) )
+	CHECK( "perlin vec4",          glm::vec4, glm::perlin( p[i] ),         glm::perlin( &p[0], out, NUM_POSITIONS, threads ) )
+	CHECK( "perlin vec2, rep",     glm::vec2, glm::perlin( p[i], rep2 ),   glm::perlin( &p[0], rep2, out, NUM_POSITIONS, threads ) )
+	CHECK( "perlin vec3, rep",     glm::vec3, glm::perlin( p[i], rep3 ),   glm::perlin( &p[0], rep3, out, NUM_POSITIONS, threads ) )
+	CHECK( "perlin vec4, rep",     glm::vec4, glm::perlin( p[i], rep4 ),   glm::perlin( &p[0], rep4, out, NUM_POSITIONS, threads ) )
+	CHECK( "simplex vec2",         glm::vec2, glm::simplex( p[i] ),        glm::simplex( &p[0], out, NUM_POSITIONS, threads ) )
+	CHECK( "simplex vec3",         glm::vec3, glm::simplex( p[i] ),        glm::simplex( &p[0], out, NUM_POSITIONS, threads ) )
+	CHECK( "simplex vec4",         glm::vec4, glm::simplex( p[i] ),        glm::simplex( &p[0], out, NUM_POSITIONS, threads ) )
+
+	return same;
+}
+
+#undef CHECK
+
+
+// a size x size tile of octaves of periodic noise, one row of one octave at a time, as NoiseGen makes it
+// (batch says whether the rows go to the batch function, and threads is how many bands it splits each row into):
+static double
+Tile( int size, int octaves, bool batch, int threads, std::vector<float> &tile )
+{
+	std::vector<glm::vec2> positions( size );
+	std::vector<float> noise( size );
+	tile.assign( (size_t)size * (size_t)size, 0.f );
+
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now( );
+	for( int t = 0; t < size; t++ )
+	{
+		float ft = (float)t / (float)size;
+		float freq = BASE_FREQUENCY;
+		float amp = 0.5f;
+		for( int o = 0; o < octaves; o++, freq *= 2.f, amp *= 0.5f )
+		{
+			for( int s = 0; s < size; s++ )
+				positions[s] = glm::vec2( (float)s / (float)size * freq, ft * freq );
+
+			if( batch )
+				glm::perlin( &positions[0], glm::vec2( freq, freq ), &noise[0], size, threads );
+			else
+				for( int s = 0; s < size; s++ )
+					noise[s] = glm::perlin( positions[s], glm::vec2( freq, freq ) );
+
+			float *row = &tile[(size_t)t * (size_t)size];
+			for( int s = 0; s < size; s++ )
+				row[s] += amp * noise[s];
+		}
+	}
+	std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now( );
+	return std::chrono::duration<double, std::milli>( t1 - t0 ).count( );
+}
+
+
+static double
+BestTile( int size, int octaves, bool batch, int threads, std::vector<float> &tile )
+{
+	double best = 1.e30;
+	for( int run = 0; run < BENCH_RUNS; run++ )
+	{
+		double ms = Tile( size, octaves, batch, threads, tile );
+		if( ms < best )
+			best = ms;
+	}
+	return best;
+}
+
+
+static bool
+Bench( int size, int octaves, int threads )
+{
+	std::vector<float> scalar, batch1, batchN;
+	double scalarMs = BestTile( size, octaves, false, 1, scalar );
+	double batch1Ms = BestTile( size, octaves, true, 1, batch1 );
+	double batchNMs = BestTile( size, octaves, true, threads, batchN );
+
+	fprintf( stderr, "%d x %d tile, %d octaves of periodic perlin vec2, best of %d:\n", size, size, octaves, BENCH_RUNS );
+	fprintf( stderr, "  scalar               %8.1f ms\n", scalarMs );
+	fprintf( stderr, "  batch, 1 thread      %8.1f ms  (%.1fx)\n", batch1Ms, scalarMs / batch1Ms );
+	fprintf( stderr, "  batch, %2d threads    %8.1f ms  (%.1fx)\n", threads, batchNMs, scalarMs / batchNMs );
+
+	bool same = scalar == batch1  &&  scalar == batchN;
+	if( ! same )
+		fprintf( stderr, "  the tiles are not the same!\n" );
+	return same;
+}
+
+
+int
+main( int argc, char *argv[ ] )
+{
+	int size = DEFAULT_SIZE;
+	int octaves = DEFAULT_OCTAVES;
+	int threads = 0;
+	bool bench = true;
+	for( int i = 1; i < argc; i++ )
+	{
+		if( strcmp( argv[i], "-size" ) == 0  &&  i+1 < argc )
+			size = atoi( argv[++i] );
+		else if( strcmp( argv[i], "-octaves" ) == 0  &&  i+1 < argc )
+			octaves = atoi( argv[++i] );
+		else if( strcmp( argv[i], "-threads" ) == 0  &&  i+1 < argc )
+			threads = atoi( argv[++i] );
+		else if( strcmp( argv[i], "-nobench" ) == 0 )
+			bench = false;
+		else
+		{
+			fprintf( stderr, "Usage: noisebatch [-size n] [-octaves n] [-threads n] [-nobench]\n" );
+			return 2;
+		}
+	}
+	if( threads <= 0 )
+		threads = glm::max( 1, (int)std::thread::hardware_concurrency( ) );
+
+	fprintf( stderr, "glm noise lanes: %d\n", (int)glm::detail::wide_width );
+
+	bool same = Check( );
+	if( bench  &&  size > 0  &&  octaves > 0 )
+		same = Bench( size, octaves, threads )  &&  same;
+
+	return same ? 0 : 1;
+}
@@ -0,0 +1,511 @@
+// texconv -- turn a bmp into a KTX (version 1) file, with its mips, that KtxTexture can map without touching the pixels
+//
+//	texconv [-format rgba8|rg8|r8|bc4|bc5|bc7] [-nomips] in.bmp out.ktx
+//
+// the whole mip chain is built here (a 2x2 box filter), so the program doesn't have to build it at startup
+// r8 and bc4 keep just the red channel, rg8 and bc5 keep red and green, and bc7 (mode 6 only) keeps all four
+// for the compressed formats, the psnr of each level against the uncompressed pixels is printed as it goes
+// (KtxTexture reads the plain formats only -- the bc ones are standard KTX files, for loaders that upload compressed levels)
+//
+// build it from this directory with, for example:
+//	cl /O2 /EHsc /DWIN32 /I.. texconv.cpp ..\bmpimage.cpp ..\mappedfile.cpp
+//	g++ -O2 -I.. texconv.cpp ../bmpimage.cpp ../mappedfile.cpp -o texconv
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "bmpimage.h"
+
+#include <vector>
+
+
+#define FORMAT_RGBA8	0
+#define FORMAT_RG8	1
+#define FORMAT_R8	2
+#define FORMAT_BC4	3
+#define FORMAT_BC5	4
+#define FORMAT_BC7	5
+
+struct FormatInfo
+{
+	const char *	name;
+	GLenum		type;
+	GLenum		format;
+	GLenum		internalFormat;
+	GLenum		baseInternalFormat;
+	int		bytes;			// per pixel, or per 4x4 block
+};
+
+static const FormatInfo Formats[ ] =
+{
+	{ "rgba8",	GL_UNSIGNED_BYTE,	GL_RGBA,	GL_RGBA8,			GL_RGBA,	4 },
+	{ "rg8",	GL_UNSIGNED_BYTE,	GL_RG,		GL_RG8,				GL_RG,		2 },
+	{ "r8",		GL_UNSIGNED_BYTE,	GL_RED,		GL_R8,				GL_RED,		1 },
+	{ "bc4",	0,			0,		GL_COMPRESSED_RED_RGTC1,	GL_RED,		8 },
+	{ "bc5",	0,			0,		GL_COMPRESSED_RG_RGTC2,		GL_RG,		16 },
+	{ "bc7",	0,			0,		GL_COMPRESSED_RGBA_BPTC_UNORM,	GL_RGBA,	16 },
+};
+
+static const unsigned char KtxIdentifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+
+// ---------------------------------------------------------------------------------------------------------------
+// mips
+
+// one level smaller: each texel is the average of the 2x2 block above it (or the 2x1 / 1x2 one, when a side is already 1):
+
+static void
+Downsample( const std::vector<unsigned char> &src, int w, int h, std::vector<unsigned char> &dst )
+{
+	int dw = ( w > 1 ) ? w/2 : 1;
+	int dh = ( h > 1 ) ? h/2 : 1;
+	dst.resize( 4 * dw * dh );
+	for( int t = 0; t < dh; t++ )
+	{
+		int t0 = ( h > 1 ) ? 2*t : 0;
+		int t1 = ( h > 1 ) ? 2*t + 1 : 0;
+		for( int s = 0; s < dw; s++ )
+		{
+			int s0 = ( w > 1 ) ? 2*s : 0;
+			int s1 = ( w > 1 ) ? 2*s + 1 : 0;
+			for( int c = 0; c < 4; c++ )
+			{
+				int sum = src[ 4*( t0*w + s0 ) + c ] + src[ 4*( t0*w + s1 ) + c ] + src[ 4*( t1*w + s0 ) + c ] + src[ 4*( t1*w + s1 ) + c ];
+				dst[ 4*( t*dw + s ) + c ] = (unsigned char)( ( sum + 2 ) / 4 );
+			}
+		}
+	}
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+// bc4 (one channel: two 8-bit endpoints and a 3-bit index per texel)
+
+// returns the block's squared error:
+
+static double
+EncodeBc4( const unsigned char v[16], unsigned char out[8] )
+{
+	int lo = 255, hi = 0;
+	for( int i = 0; i < 16; i++ )
+	{
+		if( v[i] < lo )		lo = v[i];
+		if( v[i] > hi )		hi = v[i];
+	}
+
+	// with r0 > r1 the palette is r0, r1, and 6 evenly spaced values between them:
+	int palette[8];
+	palette[0] = hi;
+	palette[1] = lo;
+	for( int i = 2; i < 8; i++ )
+		palette[i] = ( ( 8 - i ) * hi + ( i - 1 ) * lo + 3 ) / 7;
+
+	unsigned long long bits = 0;
+	double error = 0.;
+	for( int i = 0; i < 16; i++ )
+	{
+		int best = 0, bestd = 1 << 30;
+		for( int p = 0; p < 8; p++ )
+		{
+			int d = ( v[i] - palette[p] ) * ( v[i] - palette[p] );
+			if( d < bestd )
+			{
+				bestd = d;
+				best = p;
+			}
+		}
+		bits |= (unsigned long long)best << ( 3*i );
+		error += bestd;
+	}
+
+	// (hi == lo puts the block in the other mode, where index 0 is still r0 -- and every index is 0)
+	out[0] = (unsigned char)hi;
+	out[1] = (unsigned char)lo;
+	for( int b = 0; b < 6; b++ )
+		out[2+b] = (unsigned char)( bits >> ( 8*b ) );
+	return error;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+// bc7 mode 6 (one subset: rgba endpoints of 7 bits plus a shared low "p" bit each, and a 4-bit index per texel)
+
+static const int Bc7Weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+
+// the closest 7+1 bit endpoint to e, trying both p bits:
+
+static void
+QuantizeBc7( const float e[4], int q[4], int *p )
+{
+	double besterr = 1e30;
+	for( int pbit = 0; pbit < 2; pbit++ )
+	{
+		int qq[4];
+		double err = 0.;
+		for( int c = 0; c < 4; c++ )
+		{
+			int v = (int)floor( ( e[c] - pbit ) / 2.f + 0.5f );
+			if( v < 0 )	v = 0;
+			if( v > 127 )	v = 127;
+			qq[c] = v;
+			float d = (float)( 2*v + pbit ) - e[c];
+			err += d * d;
+		}
+		if( err < besterr )
+		{
+			besterr = err;
+			*p = pbit;
+			memcpy( q, qq, sizeof(qq) );
+		}
+	}
+}
+
+
+// pick every texel's index for the endpoints a and b (8-bit values), and return the squared error:
+
+static double
+IndexBc7( const unsigned char px[16][4], const int a[4], const int b[4], int idx[16] )
+{
+	int palette[16][4];
+	for( int i = 0; i < 16; i++ )
+		for( int c = 0; c < 4; c++ )
+			palette[i][c] = ( ( 64 - Bc7Weights[i] ) * a[c] + Bc7Weights[i] * b[c] + 32 ) >> 6;
+
+	double error = 0.;
+	for( int t = 0; t < 16; t++ )
+	{
+		int best = 0, bestd = 1 << 30;
+		for( int i = 0; i < 16; i++ )
+		{
+			int d = 0;
+			for( int c = 0; c < 4; c++ )
+				d += ( px[t][c] - palette[i][c] ) * ( px[t][c] - palette[i][c] );
+			if( d < bestd )
+			{
+				bestd = d;
+				best = i;
+			}
+		}
+		idx[t] = best;
+		error += bestd;
+	}
+	return error;
+}
+
+
+struct BitWriter
+{
+	unsigned char *	out;
+	int		pos;
+
+	void
+	Put( int value, int bits )
+	{
+		for( int b = 0; b < bits; b++, pos++ )
+		{
+			if( ( value >> b ) & 1 )
+				out[ pos / 8 ] |= (unsigned char)( 1 << ( pos % 8 ) );
+		}
+	}
+};
+
+
+static double
+EncodeBc7( const unsigned char px[16][4], unsigned char out[16] )
+{
+	// endpoints along the principal axis of the texels' colors:
+	float mean[4] = { 0., 0., 0., 0. };
+	for( int t = 0; t < 16; t++ )
+		for( int c = 0; c < 4; c++ )
+			mean[c] += px[t][c] / 16.f;
+
+	float cov[4][4];
+	memset( cov, 0, sizeof(cov) );
+	for( int t = 0; t < 16; t++ )
+		for( int i = 0; i < 4; i++ )
+			for( int j = 0; j < 4; j++ )
+				cov[i][j] += ( px[t][i] - mean[i] ) * ( px[t][j] - mean[j] );
+
+	float axis[4] = { 1., 1., 1., 1. };
+	for( int iter = 0; iter < 8; iter++ )
+	{
+		float next[4] = { 0., 0., 0., 0. };
+		for( int i = 0; i < 4; i++ )
+			for( int j = 0; j < 4; j++ )
+				next[i] += cov[i][j] * axis[j];
+		float len = sqrtf( next[0]*next[0] + next[1]*next[1] + next[2]*next[2] + next[3]*next[3] );
+		if( len < 1e-6f )
+			break;
+		for( int i = 0; i < 4; i++ )
+			axis[i] = next[i] / len;
+	}
+
+	float tmin = 1e30f, tmax = -1e30f;
+	for( int t = 0; t < 16; t++ )
+	{
+		float d = 0.;
+		for( int c = 0; c < 4; c++ )
+			d += ( px[t][c] - mean[c] ) * axis[c];
+		if( d < tmin )	tmin = d;
+		if( d > tmax )	tmax = d;
+	}
+
+	float e0[4], e1[4];
+	for( int c = 0; c < 4; c++ )
+	{
+		e0[c] = mean[c] + tmin * axis[c];
+		e1[c] = mean[c] + tmax * axis[c];
+	}
+
+	int q0[4], q1[4], p0 = 0, p1 = 0;
+	int idx[16];
+	double error = 1e30;
+	for( int pass = 0; pass < 2; pass++ )
+	{
+		int qa[4], qb[4], pa, pb, aa[4], bb[4], ii[16];
+		QuantizeBc7( e0, qa, &pa );
+		QuantizeBc7( e1, qb, &pb );
+		for( int c = 0; c < 4; c++ )
+		{
+			aa[c] = 2*qa[c] + pa;
+			bb[c] = 2*qb[c] + pb;
+		}
+		double err = IndexBc7( px, aa, bb, ii );
+		if( err < error )
+		{
+			error = err;
+			memcpy( q0, qa, sizeof(qa) );	memcpy( q1, qb, sizeof(qb) );
+			p0 = pa;			p1 = pb;
+			memcpy( idx, ii, sizeof(ii) );
+		}
+		if( pass == 1 )
+			break;
+
+		// refit the endpoints to the chosen indices (least squares), and see if that does any better:
+		float s00 = 0., s01 = 0., s11 = 0.;
+		float r0[4] = { 0., 0., 0., 0. }, r1[4] = { 0., 0., 0., 0. };
+		for( int t = 0; t < 16; t++ )
+		{
+			float w = Bc7Weights[ idx[t] ] / 64.f;
+			s00 += ( 1.f - w ) * ( 1.f - w );
+			s01 += ( 1.f - w ) * w;
+			s11 += w * w;
+			for( int c = 0; c < 4; c++ )
+			{
+				r0[c] += ( 1.f - w ) * px[t][c];
+				r1[c] += w * px[t][c];
+			}
+		}
+		float det = s00 * s11 - s01 * s01;
+		if( fabsf( det ) < 1e-6f )
+			break;
+		for( int c = 0; c < 4; c++ )
+		{
+			e0[c] = ( s11 * r0[c] - s01 * r1[c] ) / det;
+			e1[c] = ( s00 * r1[c] - s01 * r0[c] ) / det;
+			if( e0[c] < 0.f )	e0[c] = 0.f;
+			if( e0[c] > 255.f )	e0[c] = 255.f;
+			if( e1[c] < 0.f )	e1[c] = 0.f;
+			if( e1[c] > 255.f )	e1[c] = 255.f;
+		}
+	}
+
+	// the first texel's index is stored with only 3 bits, so its top bit has to be 0:
+	if( idx[0] & 8 )
+	{
+		int tq[4];
+		memcpy( tq, q0, sizeof(tq) );	memcpy( q0, q1, sizeof(tq) );	memcpy( q1, tq, sizeof(tq) );
+		int tp = p0;	p0 = p1;	p1 = tp;
+		for( int t = 0; t < 16; t++ )
+			idx[t] = 15 - idx[t];
+	}
+
+	memset( out, 0, 16 );
+	BitWriter bw = { out, 0 };
+	bw.Put( 1 << 6, 7 );				// mode 6
+	for( int c = 0; c < 4; c++ )
+	{
+		bw.Put( q0[c], 7 );
+		bw.Put( q1[c], 7 );
+	}
+	bw.Put( p0, 1 );
+	bw.Put( p1, 1 );
+	for( int t = 0; t < 16; t++ )
+		bw.Put( idx[t], t == 0 ? 3 : 4 );
+	return error;
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------
+// one level
+
+// the texels of one level in the file's layout, and the squared error the compression added (0 for the plain formats):
+
+static double
+EncodeLevel( const std::vector<unsigned char> &rgba, int w, int h, int format, std::vector<unsigned char> &out )
+{
+	const FormatInfo &f = Formats[format];
+	out.clear( );
+
+	if( format <= FORMAT_R8 )
+	{
+		int stride = 4 * ( ( w * f.bytes + 3 ) / 4 );
+		out.resize( stride * h, 0 );
+		for( int t = 0; t < h; t++ )
+			for( int s = 0; s < w; s++ )
+				memcpy( &out[ t*stride + s*f.bytes ], &rgba[ 4*( t*w + s ) ], f.bytes );
+		return 0.;
+	}
+
+	int bw = ( w + 3 ) / 4;
+	int bh = ( h + 3 ) / 4;
+	out.resize( bw * bh * f.bytes );
+	double error = 0.;
+	unsigned char *op = &out[0];
+	for( int by = 0; by < bh; by++ )
+	{
+		for( int bx = 0; bx < bw; bx++, op += f.bytes )
+		{
+			// (a block hanging off the edge of a small level repeats the last row and column)
+			unsigned char px[16][4];
+			for( int y = 0; y < 4; y++ )
+			{
+				for( int x = 0; x < 4; x++ )
+				{
+					int s = 4*bx + x;	if( s >= w )	s = w - 1;
+					int t = 4*by + y;	if( t >= h )	t = h - 1;
+					memcpy( px[ 4*y + x ], &rgba[ 4*( t*w + s ) ], 4 );
+				}
+			}
+
+			if( format == FORMAT_BC7 )
+			{
+				error += EncodeBc7( px, op );
+				continue;
+			}
+
+			int channels = ( format == FORMAT_BC5 ) ? 2 : 1;
+			for( int c = 0; c < channels; c++ )
+			{
+				unsigned char v[16];
+				for( int i = 0; i < 16; i++ )
+					v[i] = px[i][c];
+				error += EncodeBc4( v, op + 8*c );
+			}
+		}
+	}
+	return error;
+}
+
+
+static void
+PutInt( FILE *fp, unsigned int v )
+{
+	fwrite( &v, 4, 1, fp );
+}
+
+
+int
+main( int argc, char *argv[ ] )
+{
+	int format = FORMAT_RGBA8;
+	bool mips = true;
+	const char *in = NULL, *out = NULL;
+	for( int i = 1; i < argc; i++ )
+	{
+		if( strcmp( argv[i], "-format" ) == 0  &&  i+1 < argc )
+		{
+			i++;
+			format = -1;
+			for( int f = 0; f < (int)( sizeof(Formats) / sizeof(Formats[0]) ); f++ )
+				if( strcmp( argv[i], Formats[f].name ) == 0 )
+					format = f;
+			if( format < 0 )
+			{
+				fprintf( stderr, "Unknown format '%s'\n", argv[i] );
+				return 1;
+			}
+		}
+		else if( strcmp( argv[i], "-nomips" ) == 0 )
+			mips = false;
+		else if( in == NULL )
+			in = argv[i];
+		else if( out == NULL )
+			out = argv[i];
+	}
+	if( in == NULL  ||  out == NULL )
+	{
+		fprintf( stderr, "Usage: texconv [-format rgba8|rg8|r8|bc4|bc5|bc7] [-nomips] in.bmp out.ktx\n" );
+		return 1;
+	}
+
+	BmpImage bmp;
+	if( ! bmp.Load( in, GL_RGBA ) )
+		return 1;
+	int w = bmp.GetWidth( );
+	int h = bmp.GetHeight( );
+	std::vector<unsigned char> level( bmp.GetPixels( ), bmp.GetPixels( ) + 4*w*h );
+	bmp.Close( );
+
+	int levels = 1;
+	if( mips )
+		for( int n = ( w > h ? w : h ); n > 1; n /= 2 )
+			levels++;
+
+	FILE *fp = fopen( out, "wb" );
+	if( fp == NULL )
+	{
+		fprintf( stderr, "Cannot open '%s' for writing\n", out );
+		return 1;
+	}
+
+	const FormatInfo &f = Formats[format];
+	fwrite( KtxIdentifier, 1, sizeof(KtxIdentifier), fp );
+	PutInt( fp, 0x04030201 );
+	PutInt( fp, f.type );
+	PutInt( fp, 1 );					// glTypeSize: bytes, or compressed blocks
+	PutInt( fp, f.format );
+	PutInt( fp, f.internalFormat );
+	PutInt( fp, f.baseInternalFormat );
+	PutInt( fp, w );
+	PutInt( fp, h );
+	PutInt( fp, 0 );					// depth
+	PutInt( fp, 0 );					// array elements
+	PutInt( fp, 1 );					// faces
+	PutInt( fp, levels );
+	PutInt( fp, 0 );					// key/value data
+
+	size_t total = 0;
+	std::vector<unsigned char> data, next;
+	for( int l = 0; l < levels; l++ )
+	{
+		double error = EncodeLevel( level, w, h, format, data );
+		PutInt( fp, (unsigned int)data.size( ) );
+		fwrite( &data[0], 1, data.size( ), fp );
+		static const unsigned char pad[3] = { 0, 0, 0 };
+		fwrite( pad, 1, ( 4 - data.size( ) % 4 ) % 4, fp );
+		total += data.size( );
+
+		if( format >= FORMAT_BC4 )
+		{
+			int channels = ( format == FORMAT_BC4 ) ? 1 : ( format == FORMAT_BC5 ) ? 2 : 4;
+			double mse = error / ( (double)w * h * channels );
+			fprintf( stderr, "level %2d: %4d x %4d, psnr %.2f dB\n", l, w, h, mse > 0. ? 10. * log10( 255.*255. / mse ) : 99.99 );
+		}
+
+		if( l + 1 < levels )
+		{
+			Downsample( level, w, h, next );
+			level.swap( next );
+			w = ( w > 1 ) ? w/2 : 1;
+			h = ( h > 1 ) ? h/2 : 1;
+		}
+	}
+	fclose( fp );
+
+	fprintf( stderr, "Wrote '%s': %s, %d levels, %lu bytes of texels\n", out, f.name, levels, (unsigned long)total );
+	return 0;
+}
@@ -0,0 +1,416 @@
+// transformbatch -- check glm's batch transforms against transforming one point at a time, and time them
+//
+//	transformbatch [-nobench]
+//
+// transform_points( ), project_points( ), and transform_normals( ) are run over every count from 0 to 10001,
+// so that every block of lanes ends short somewhere, and once over 65539, enough for four bands of a thread each:
+// in place on the positions (or normals) of points laid out like VertexBufferObject's, and from one array
+// of vec3s to another, each with one thread, four, and one per hardware thread
+// each result is compared bit for bit against mat4 * vec4 (or the normal matrix times the normal, normalized)
+// done one at a time, and all of the rest of the points, and everything past count, is checked to be untouched
+// mul_batch( ) is checked the same way against mat4 * mat4, over a few counts
+// the exit status is 1 if anything differs
+// unless -nobench is given, it then prints how long each takes over 10001 points, against the loop it replaces
+//
+// the batch gives the same bits only when neither it nor mat4 * vec4 is compiled with fused multiply-adds,
+// so build it from this directory with, for example:
+//	cl /O2 /EHsc /fp:precise /I.. transformbatch.cpp
+//	cl /O2 /EHsc /fp:precise /arch:AVX2 /DGLM_FORCE_SIMD_STRICT /I.. transformbatch.cpp
+//	g++ -std=c++11 -O2 -ffp-contract=off -pthread -I.. transformbatch.cpp -o transformbatch
+//	g++ -std=c++11 -O2 -ffp-contract=off -mavx2 -mfma -DGLM_FORCE_SIMD_STRICT -pthread -I.. transformbatch.cpp -o transformbatch
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtx/transform_batch.hpp"
+
+#include <chrono>
+#include <vector>
+
+
+#define MAX_COUNT	10001		// every count up to this is checked
+#define BIG_COUNT	( 4 * GLM_TRANSFORM_BATCH_MIN_PER_THREAD + 3 )	// and this one, split into bands that are not whole blocks
+#define SENTINEL	-12345.f	// what is past count in each output, and must still be there after it is written
+
+#define BENCH_PASSES	20		// calls over MAX_COUNT points, per run
+#define BENCH_RUNS	25		// the best run is reported
+
+static const int Threads[3] = { 1, 4, 0 };
+
+enum { POINTS, PROJECT, NORMALS, NUM_OPS };
+static const char *OpNames[NUM_OPS] = { "transform_points", "project_points", "transform_normals" };
+
+
+// laid out like VertexBufferObject's, so the positions are 44 bytes apart, with the normal after each:
+struct Point
+{
+	float x, y, z;
+	float nx, ny, nz;
+	float r, g, b;
+	float s, t;
+};
+
+
+// a small lcg, so every build and every platform sees the same points:
+static unsigned int Seed = 1;
+
+static float
+Random( float low, float high )
+{
+	Seed = Seed * 1664525u + 1013904223u;
+	return low + ( high - low ) * (float)( Seed >> 8 ) / (float)( 1 << 24 );
+}
+
+
+static glm::mat4		Model;		// rotated, scaled unevenly, and moved, so the normal matrix is not just Model
+static glm::mat4		Mvp;		// a projection and view times Model
+static glm::mat3		Normal;		// the normal matrix of Model, the way transform_normals( ) makes it
+
+static std::vector<Point>	Orig;		// BIG_COUNT points
+static std::vector<Point>	Want[NUM_OPS];	// Orig with the positions (or the normals) done one at a time
+
+// which floats of a Point each operation works on:
+static int	Field( int op )		{ return op == NORMALS ? 3 : 0; }
+
+static glm::vec3
+Scalar( int op, const glm::vec3 &v )
+{
+	if( op == POINTS )
+		return glm::vec3( Model * glm::vec4( v, 1.f ) );
+	if( op == PROJECT )
+	{
+		glm::vec4 c = Mvp * glm::vec4( v, 1.f );
+		return glm::vec3( c ) / c.w;
+	}
+	return glm::normalize( Normal * v );
+}
+
+static void
+Batch( int op, const float *in, size_t inStride, float *out, size_t outStride, size_t count, int threads )
+{
+	if( op == POINTS )
+		glm::transform_points( Model, in, inStride, out, outStride, count, threads );
+	else if( op == PROJECT )
+		glm::project_points( Mvp, in, inStride, out, outStride, count, threads );
+	else
+		glm::transform_normals( Model, in, inStride, out, outStride, count, threads );
+}
+
+static void
+MakeInputs( )
+{
+	Seed = 1;
+	Model = glm::translate( glm::mat4( 1.f ), glm::vec3( 0.5f, -1.f, 2.f ) );
+	Model = glm::rotate( Model, 0.7f, glm::normalize( glm::vec3( 1.f, 2.f, 3.f ) ) );
+	Model = glm::scale( Model, glm::vec3( 2.f, 0.5f, 1.5f ) );
+	glm::mat4 view = glm::lookAt( glm::vec3( 0.f, 0.f, 12.f ), glm::vec3( 0.f, 0.f, 0.f ), glm::vec3( 0.f, 1.f, 0.f ) );
+	Mvp = glm::perspective( 1.f, 1.5f, 0.1f, 100.f ) * view * Model;
+	Normal = glm::transpose( glm::inverse( glm::mat3( Model ) ) );
+
+	Orig.resize( BIG_COUNT );
+	for( int i = 0; i < BIG_COUNT; i++ )
+	{
+		float *f = &Orig[i].x;
+		for( int c = 0; c < 11; c++ )
+			f[c] = Random( -4.f, 4.f );
+	}
+
+	for( int op = 0; op < NUM_OPS; op++ )
+	{
+		Want[op] = Orig;
+		for( int i = 0; i < BIG_COUNT; i++ )
+		{
+			float *f = &Want[op][i].x + Field( op );
+			glm::vec3 r = Scalar( op, glm::vec3( f[0], f[1], f[2] ) );
+			f[0] = r.x;  f[1] = r.y;  f[2] = r.z;
+		}
+	}
+}
+
+
+// how many of the n floats differ, and by how many ulps at most:
+static void
+Differ( const float *mine, const float *theirs, int n, int *count, int *ulps )
+{
+	for( int i = 0; i < n; i++ )
+	{
+		int a, b;
+		memcpy( &a, &mine[i], sizeof(int) );
+		memcpy( &b, &theirs[i], sizeof(int) );
+		if( a == b )
+			continue;
+		( *count )++;
+		int d = a > b ? a - b : b - a;
+		if( d > *ulps )
+			*ulps = d;
+	}
+}
+
+static bool
+Report( const char *name, const char *layout, int threads, int count, const float *want, const float *got, int n )
+{
+	int differ = 0, ulps = 0;
+	if( got != NULL )
+		Differ( want, got, n, &differ, &ulps );
+	if( differ == 0 )
+		fprintf( stderr, "  %-18s %-14s threads %d  same bits\n", name, layout, threads );
+	else
+		fprintf( stderr, "  %-18s %-14s threads %d  count %d: %d of %d floats differ, by up to %d ulps\n",
+			name, layout, threads, count, differ, n, ulps );
+	return differ == 0;
+}
+
+
+// every count up to MAX_COUNT, then BIG_COUNT:
+static int
+NextCount( int count )
+{
+	if( count < MAX_COUNT )
+		return count + 1;
+	return count == MAX_COUNT ? BIG_COUNT : BIG_COUNT + 1;
+}
+
+
+// in place, on the positions (or normals) of an array of Points:
+static bool
+CheckPoints( int op, int threads )
+{
+	std::vector<Point> buf( Orig ), want( Orig );
+	int floats = (int)( sizeof(Point) / sizeof(float) );
+	for( int n = 0; n <= BIG_COUNT; n = NextCount( n ) )
+	{
+		int total = n <= MAX_COUNT ? MAX_COUNT : BIG_COUNT;		// the points up to this after n must be untouched
+		float *f = &buf[0].x + Field( op );
+		Batch( op, f, sizeof(Point), f, sizeof(Point), n, threads );
+
+		if( memcmp( &buf[0], &Want[op][0], n * sizeof(Point) ) != 0  ||
+		    memcmp( &buf[0] + n, &Orig[0] + n, ( total - n ) * sizeof(Point) ) != 0 )
+		{
+			memcpy( &want[0], &Want[op][0], n * sizeof(Point) );
+			return Report( OpNames[op], "Point, in place", threads, n, &want[0].x, &buf[0].x, floats * total );
+		}
+		memcpy( &buf[0], &Orig[0], n * sizeof(Point) );
+	}
+	return Report( OpNames[op], "Point, in place", threads, 0, NULL, NULL, 0 );
+}
+
+
+// from one array of vec3s to another, through the vec3 overloads:
+static bool
+CheckVec3( int op, int threads )
+{
+	std::vector<glm::vec3> in( BIG_COUNT ), want( BIG_COUNT ), got( BIG_COUNT, glm::vec3( SENTINEL ) ), untouched( BIG_COUNT, glm::vec3( SENTINEL ) );
+	for( int i = 0; i < BIG_COUNT; i++ )
+	{
+		const float *o = &Orig[i].x + Field( op );
+		const float *w = &Want[op][i].x + Field( op );
+		in[i] = glm::vec3( o[0], o[1], o[2] );
+		want[i] = glm::vec3( w[0], w[1], w[2] );
+	}
+
+	// the counts only go up, so everything past n is still SENTINEL if nothing was written there:
+	for( int n = 0; n <= BIG_COUNT; n = NextCount( n ) )
+	{
+		int total = n <= MAX_COUNT ? MAX_COUNT : BIG_COUNT;
+		if( op == POINTS )
+			glm::transform_points( Model, &in[0], &got[0], n, threads );
+		else if( op == PROJECT )
+			glm::project_points( Mvp, &in[0], &got[0], n, threads );
+		else
+			glm::transform_normals( Model, &in[0], &got[0], n, threads );
+
+		if( memcmp( &got[0], &want[0], n * sizeof(glm::vec3) ) != 0  ||
+		    memcmp( &got[0] + n, &untouched[0], ( total - n ) * sizeof(glm::vec3) ) != 0 )
+		{
+			std::vector<glm::vec3> expect( untouched );
+			for( int i = 0; i < n; i++ )
+				expect[i] = want[i];
+			return Report( OpNames[op], "vec3 arrays", threads, n, &expect[0].x, &got[0].x, 3 * total );
+		}
+	}
+	return Report( OpNames[op], "vec3 arrays", threads, 0, NULL, NULL, 0 );
+}
+
+
+// a[i] * b[i] and a[0] * b[i], over a few counts:
+static bool
+CheckMul( int threads )
+{
+	static const int Counts[ ] = { 0, 1, 2, 3, 5, 7, 8, 9, 1001, BIG_COUNT };
+	int numCounts = (int)( sizeof(Counts) / sizeof(Counts[0]) );
+	int most = Counts[numCounts - 1];
+
+	Seed = 2;
+	std::vector<glm::mat4> a( most ), b( most ), wantEach( most ), wantOne( most );
+	for( int i = 0; i < most; i++ )
+	{
+		for( int c = 0; c < 4; c++ )
+			for( int r = 0; r < 4; r++ )
+			{
+				a[i][c][r] = Random( -2.f, 2.f );
+				b[i][c][r] = Random( -2.f, 2.f );
+			}
+	}
+	for( int i = 0; i < most; i++ )
+	{
+		wantEach[i] = a[i] * b[i];
+		wantOne[i] = a[0] * b[i];
+	}
+
+	bool same = true;
+	for( int k = 0; k < numCounts  &&  same; k++ )
+	{
+		int n = Counts[k];
+		std::vector<glm::mat4> each( most, glm::mat4( SENTINEL ) ), one( most, glm::mat4( SENTINEL ) );
+		std::vector<glm::mat4> expectEach( each ), expectOne( one );
+		glm::mul_batch( &a[0], &b[0], &each[0], n, threads );
+		glm::mul_batch( a[0], &b[0], &one[0], n, threads );
+		for( int i = 0; i < n; i++ )
+		{
+			expectEach[i] = wantEach[i];
+			expectOne[i] = wantOne[i];
+		}
+		if( memcmp( &each[0], &expectEach[0], most * sizeof(glm::mat4) ) != 0 )
+			same = Report( "mul_batch", "a[i] * b[i]", threads, n, &expectEach[0][0][0], &each[0][0][0], 16 * most );
+		else if( memcmp( &one[0], &expectOne[0], most * sizeof(glm::mat4) ) != 0 )
+			same = Report( "mul_batch", "a * b[i]", threads, n, &expectOne[0][0][0], &one[0][0][0], 16 * most );
+	}
+	if( same )
+		Report( "mul_batch", "", threads, 0, NULL, NULL, 0 );
+	return same;
+}
+
+
+//////////////////////////////////////
+// the timed calls -- each goes over MAX_COUNT points once, from In to Out
+
+static std::vector<Point>	In, Out;
+static std::vector<glm::vec3>	In3, Out3;
+static int			BenchOp;
+static bool			BenchVec3;
+static int			BenchThreads;
+
+static void
+LoopScalar( )
+{
+	if( BenchVec3 )
+	{
+		for( int i = 0; i < MAX_COUNT; i++ )
+			Out3[i] = Scalar( BenchOp, In3[i] );
+		return;
+	}
+
+	int field = Field( BenchOp );
+	for( int i = 0; i < MAX_COUNT; i++ )
+	{
+		const float *f = &In[i].x + field;
+		glm::vec3 r = Scalar( BenchOp, glm::vec3( f[0], f[1], f[2] ) );
+		float *o = &Out[i].x + field;
+		o[0] = r.x;  o[1] = r.y;  o[2] = r.z;
+	}
+}
+
+static void
+LoopBatch( )
+{
+	if( BenchVec3 )
+		Batch( BenchOp, &In3[0].x, sizeof(glm::vec3), &Out3[0].x, sizeof(glm::vec3), MAX_COUNT, BenchThreads );
+	else
+		Batch( BenchOp, &In[0].x + Field( BenchOp ), sizeof(Point), &Out[0].x + Field( BenchOp ), sizeof(Point), MAX_COUNT, BenchThreads );
+}
+
+// best us per call over BENCH_RUNS runs:
+// (called through a pointer, so the compiler cannot fold the passes of a run into one)
+static double
+Time( void ( * volatile loop )( ) )
+{
+	double best = 1.e30;
+	for( int run = 0; run < BENCH_RUNS; run++ )
+	{
+		std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now( );
+		for( int pass = 0; pass < BENCH_PASSES; pass++ )
+			( *loop )( );
+		std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now( );
+		double us = std::chrono::duration<double, std::micro>( t1 - t0 ).count( ) / (double)BENCH_PASSES;
+		if( us < best )
+			best = us;
+	}
+	return best;
+}
+
+
+static void
+Bench( )
+{
+	In.assign( Orig.begin( ), Orig.begin( ) + MAX_COUNT );
+	Out = In;
+	In3.resize( MAX_COUNT );
+	Out3.resize( MAX_COUNT );
+	for( int i = 0; i < MAX_COUNT; i++ )
+		In3[i] = glm::vec3( In[i].x, In[i].y, In[i].z );
+
+	fprintf( stderr, "us per call over %d points, best of %d runs:\n", MAX_COUNT, BENCH_RUNS );
+	fprintf( stderr, "                                     one at a time   batch, 1 thread      batch, all threads\n" );
+	for( int op = 0; op < NUM_OPS; op++ )
+	{
+		for( int layout = 0; layout < 2; layout++ )
+		{
+			BenchOp = op;
+			BenchVec3 = layout == 1;
+			double scalar = Time( LoopScalar );
+			BenchThreads = 1;
+			double one = Time( LoopBatch );
+			BenchThreads = 0;
+			double all = Time( LoopBatch );
+			fprintf( stderr, "  %-18s %-14s %8.1f        %8.1f  (%.1fx)     %8.1f  (%.1fx)\n", OpNames[op], BenchVec3 ? "vec3 arrays" : "Point",
+				scalar, one, scalar / one, all, scalar / all );
+		}
+	}
+
+	// use the results, so none of the loops can be thrown away:
+	float sum = 0.f;
+	for( int i = 0; i < MAX_COUNT; i++ )
+		sum += Out[i].x + Out[i].nx + Out3[i].y;
+	fprintf( stderr, "  (checksum %g)\n", sum );
+}
+
+
+int
+main( int argc, char *argv[ ] )
+{
+	bool bench = true;
+	for( int i = 1; i < argc; i++ )
+	{
+		if( strcmp( argv[i], "-nobench" ) == 0 )
+			bench = false;
+		else
+		{
+			fprintf( stderr, "Usage: transformbatch [-nobench]\n" );
+			return 2;
+		}
+	}
+
+	fprintf( stderr, "glm batch lanes: %d for vec3 arrays, %d for Points%s\n",
+		glm::detail::transform_batch_x8( sizeof(glm::vec3), sizeof(glm::vec3) ) ? 8 : 4,
+		glm::detail::transform_batch_x8( sizeof(Point), sizeof(Point) ) ? 8 : 4,
+		GLM_SIMD_FMA ? ", fused multiply-adds (the bits will differ)" : "" );
+
+	MakeInputs( );
+	bool same = true;
+	for( int op = 0; op < NUM_OPS; op++ )
+		for( int t = 0; t < 3; t++ )
+		{
+			same = CheckPoints( op, Threads[t] )  &&  same;
+			same = CheckVec3( op, Threads[t] )  &&  same;
+		}
+	for( int t = 0; t < 3; t++ )
+		same = CheckMul( Threads[t] )  &&  same;
+
+	if( bench )
+		Bench( );
+
+	return same ? 0 : 1;
+}
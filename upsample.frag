@@ -0,0 +1,60 @@
+#version 330 compatibility
+
+// composites a pass that was drawn at a fraction of the resolution back over the full-resolution scene
+//
+// each full-resolution pixel blends the 4 reduced texels around it, weighted bilinearly and by how close the
+// scene's depth at each of them (downsampled) is to the scene's depth at the pixel -- so where the pixel is on
+// one side of an edge in the scene, it takes its color from the texels on the same side, instead of
+// leaving a halo across the edge the way a plain bilinear upsample does
+//
+// the reduced pass is premultiplied by its alpha, and is blended with GL_ONE, GL_ONE_MINUS_SRC_ALPHA
+
+uniform sampler2D uLowColor;		// the reduced pass, premultiplied, with 0 alpha wherever it drew nothing
+uniform sampler2D uLowDepth;		// the scene's depth, downsampled (the reduced pass does not write depth)
+uniform sampler2D uSceneDepth;		// the full-resolution scene's depth
+uniform vec4 uSceneViewport;		// x, y, width, height of the full-resolution viewport
+uniform vec4 uLowViewport;		// and of the viewport the reduced pass was drawn with
+uniform float uNear, uFar;
+uniform bool uOrtho;
+
+float
+LinearDepth(float d)
+{
+	if (uOrtho)
+		return uNear + d * (uFar - uNear);
+	float z = 2. * d - 1.;
+	return 2. * uNear * uFar / (uFar + uNear - z * (uFar - uNear));
+}
+
+void
+main()
+{
+	float z = LinearDepth(texelFetch(uSceneDepth, ivec2(gl_FragCoord.xy), 0).r);
+	float tolerance = .01 * z;
+
+	// the 4 reduced texels whose centers surround this pixel's center:
+	vec2 low = (gl_FragCoord.xy - uSceneViewport.xy) * uLowViewport.zw / uSceneViewport.zw + uLowViewport.xy - .5;
+	ivec2 base = ivec2(floor(low));
+	vec2 f = low - vec2(base);
+
+	vec4 color = vec4(0.);
+	float total = 0.;
+	for (int j = 0; j < 2; j++)
+	{
+		for (int i = 0; i < 2; i++)
+		{
+			ivec2 t = clamp(base + ivec2(i, j), ivec2(uLowViewport.xy), ivec2(uLowViewport.xy + uLowViewport.zw) - 1);
+			float zt = LinearDepth(texelFetch(uLowDepth, t, 0).r);
+			float w = (i == 0 ? 1. - f.x : f.x) * (j == 0 ? 1. - f.y : f.y);
+			w /= tolerance + abs(z - zt);
+
+			color += w * texelFetch(uLowColor, t, 0);
+			total += w;
+		}
+	}
+	color /= total;
+
+	if (color.a <= 0.)
+		discard;
+	gl_FragColor = color;
+}
@@ -0,0 +1,9 @@
+#version 330 compatibility
+
+// a quad that covers the viewport -- the fragment shader works from gl_FragCoord
+
+void
+main()
+{
+	gl_Position = vec4(gl_Vertex.xy, 0., 1.);
+}
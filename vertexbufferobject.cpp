@@ -50,8 +50,10 @@ VertexBufferObject::CollapseCommonVertices( bool tf )
 }
 
 
+// draw the vbo -- more than one instance draws it that many times in one call (gl_InstanceID says which):
+
 void
-VertexBufferObject::Draw( )
+VertexBufferObject::Draw( int instances )
 {
 	int numPoints   = (int) PointVec.size( );
 	int numElements = (int) ElementVec.size( );
@@ -65,90 +67,110 @@ VertexBufferObject::Draw( )
 
 
 	if( isFirstDraw )
-	{
-		glGenBuffers( 1, &pbuffer );
-		glBindBuffer( GL_ARRAY_BUFFER, pbuffer );
-		glBufferData( GL_ARRAY_BUFFER, numPoints * sizeof(struct Point), NULL, GL_STATIC_DRAW );
-		parray = (struct Point *) glMapBuffer( GL_ARRAY_BUFFER, GL_WRITE_ONLY );
-		(void) memmove( &parray[0].x, &PointVec[0].x, numPoints * sizeof(struct Point) );
-
-		// note: the memmove is the same as saying:
-		// for( int i = 0; i < numPoints; i++ )
-		// {
-		//	parray[i].x = PointVec[i].x;
-		//	parray[i].y = PointVec[i].y;
-		//	parray[i].z = PointVec[i].z;
-		//	parray[i].nx = PointVec[i].nx;
-		//	parray[i].ny = PointVec[i].ny;
-		//	parray[i].nz = PointVec[i].nz;
-		//	parray[i].r = PointVec[i].r;
-		//	parray[i].g = PointVec[i].g;
-		//	parray[i].b = PointVec[i].b;
-		//	parray[i].s = PointVec[i].s;
-		//	parray[i].t = PointVec[i].t;
-		// }
-
-
-		glUnmapBuffer( GL_ARRAY_BUFFER );
-		parray = NULL;
-
-		glGenBuffers( 1, &ebuffer );
-		glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, ebuffer );
-		glBufferData( GL_ELEMENT_ARRAY_BUFFER, numElements * sizeof(GLuint), NULL, GL_STATIC_DRAW );
-		earray = (GLuint *) glMapBuffer( GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY );
-		for( int i = 0; i < numElements; i++ )
-		{
-			earray[i] = ElementVec[i];
-		}
-		glUnmapBuffer( GL_ELEMENT_ARRAY_BUFFER );
-		earray = NULL;
-
-		isFirstDraw = false;
-	}
+		Upload( );
 
-	glBindBuffer( GL_ARRAY_BUFFER, pbuffer );
+	// all of the state below goes through GLState, so drawing the same vbo again,
+	// or another one with the same vertex layout, doesn't re-send any of it:
+	GLState::BindBuffer( GL_ARRAY_BUFFER, pbuffer );
 	if( collapseCommonVertices )
-		glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, ebuffer );
+		GLState::BindBuffer( GL_ELEMENT_ARRAY_BUFFER, ebuffer );
+	GLState::PrimitiveRestartIndex( VertexBufferObject::RESTART_INDEX );
+	GLState::Enable( GL_PRIMITIVE_RESTART );
 
 	glVertexPointer(   THREE_VALUES, GL_FLOAT, sizeof(struct Point), (GLvoid *)ELEMENT_OFFSET( &parray[0].x, &parray[0].x ) );
 
-	glEnableClientState( GL_VERTEX_ARRAY );
+	GLState::EnableClientState( GL_VERTEX_ARRAY );
 	if( hasNormals )	
 	{
 		glNormalPointer(   GL_FLOAT, sizeof(struct Point),               ELEMENT_OFFSET( &parray[0].x, &parray[0].nx ) );
 				// the leading THREE_VALUES is implied
-		glEnableClientState( GL_NORMAL_ARRAY );
 	}
+	GLState::SetClientState( GL_NORMAL_ARRAY, hasNormals );
 
 	if( hasColors )
 	{
 		glColorPointer(    THREE_VALUES, GL_FLOAT, sizeof(struct Point), ELEMENT_OFFSET( &parray[0].x, &parray[0].r ) );
-		glEnableClientState( GL_COLOR_ARRAY );
 	}
+	GLState::SetClientState( GL_COLOR_ARRAY, hasColors );
 
 	if( hasTexCoords )
 	{
 		glTexCoordPointer( TWO_VALUES,   GL_FLOAT, sizeof(struct Point), ELEMENT_OFFSET( &parray[0].x, &parray[0].s ) );
-		glEnableClientState( GL_TEXTURE_COORD_ARRAY );
 	}
+	GLState::SetClientState( GL_TEXTURE_COORD_ARRAY, hasTexCoords );
 
 
 	if( collapseCommonVertices || restartFound )
 	{
-		glDrawElements( topology, numElements, GL_UNSIGNED_INT, BUFFER_OFFSET( 0 ) );
+		if( instances > 1 )
+			glDrawElementsInstanced( topology, numElements, GL_UNSIGNED_INT, BUFFER_OFFSET( 0 ), instances );
+		else
+			glDrawElements( topology, numElements, GL_UNSIGNED_INT, BUFFER_OFFSET( 0 ) );
 	}
 	else
 	{
-		glDrawArrays( topology, 0, numPoints );
+		if( instances > 1 )
+			glDrawArraysInstanced( topology, 0, numPoints, instances );
+		else
+			glDrawArrays( topology, 0, numPoints );
 	}
 
-	glBindBuffer( GL_ARRAY_BUFFER,         0 );
-	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+	// the buffer bindings and client states are left as they are --
+	// whoever draws next sets the ones it needs, and GLState drops the ones that match
+}
+
+
+// copy the vertices and the elements into their buffer objects
+// (Draw( ) does this itself the first time, if it has not been done yet --
+//  calling it ahead of time just moves that work out of the first frame):
+
+void
+VertexBufferObject::Upload( )
+{
+	int numPoints   = (int) PointVec.size( );
+	int numElements = (int) ElementVec.size( );
+
+	if( ! isFirstDraw  ||  ! hasVertices  ||  numPoints == 0  ||  numElements == 0 )
+		return;
+
+	glGenBuffers( 1, &pbuffer );
+	GLState::BindBuffer( GL_ARRAY_BUFFER, pbuffer );
+	glBufferData( GL_ARRAY_BUFFER, numPoints * sizeof(struct Point), NULL, GL_STATIC_DRAW );
+	parray = (struct Point *) glMapBuffer( GL_ARRAY_BUFFER, GL_WRITE_ONLY );
+	(void) memmove( &parray[0].x, &PointVec[0].x, numPoints * sizeof(struct Point) );
+
+	// note: the memmove is the same as saying:
+	// for( int i = 0; i < numPoints; i++ )
+	// {
+	//	parray[i].x = PointVec[i].x;
+	//	parray[i].y = PointVec[i].y;
+	//	parray[i].z = PointVec[i].z;
+	//	parray[i].nx = PointVec[i].nx;
+	//	parray[i].ny = PointVec[i].ny;
+	//	parray[i].nz = PointVec[i].nz;
+	//	parray[i].r = PointVec[i].r;
+	//	parray[i].g = PointVec[i].g;
+	//	parray[i].b = PointVec[i].b;
+	//	parray[i].s = PointVec[i].s;
+	//	parray[i].t = PointVec[i].t;
+	// }
+
+
+	glUnmapBuffer( GL_ARRAY_BUFFER );
+	parray = NULL;
+
+	glGenBuffers( 1, &ebuffer );
+	GLState::BindBuffer( GL_ELEMENT_ARRAY_BUFFER, ebuffer );
+	glBufferData( GL_ELEMENT_ARRAY_BUFFER, numElements * sizeof(GLuint), NULL, GL_STATIC_DRAW );
+	earray = (GLuint *) glMapBuffer( GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY );
+	for( int i = 0; i < numElements; i++ )
+	{
+		earray[i] = ElementVec[i];
+	}
+	glUnmapBuffer( GL_ELEMENT_ARRAY_BUFFER );
+	earray = NULL;
 
-	glDisableClientState( GL_VERTEX_ARRAY );
-	glDisableClientState( GL_NORMAL_ARRAY );
-	glDisableClientState( GL_COLOR_ARRAY );
-	glDisableClientState( GL_TEXTURE_COORD_ARRAY );
+	isFirstDraw = false;
 }
 
 
@@ -295,8 +317,6 @@ VertexBufferObject::Reset( )
 {
 	isFirstDraw = true;
 	hasVertices = hasNormals = hasColors = hasTexCoords = false;
-	glPrimitiveRestartIndex( VertexBufferObject::RESTART_INDEX );
-	glEnable( GL_PRIMITIVE_RESTART );
 	if( parray != NULL )
 	{
 		delete [ ] parray;
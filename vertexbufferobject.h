@@ -8,6 +8,7 @@
 #include "glew.h"
 #include "glut.h"
 #include <GL/gl.h>
+#include "glstate.h"
 
 #include <stdio.h>
 #include <math.h>
@@ -94,7 +95,7 @@ class VertexBufferObject
 
     public:
 	void CollapseCommonVertices( bool );
-	void Draw( );
+	void Draw( int = 1 );
 	void glBegin( GLenum );
 	void glColor3f( GLfloat, GLfloat, GLfloat );
 	void glColor3fv( GLfloat * );
@@ -108,6 +109,7 @@ class VertexBufferObject
 	void Print( char * = (char *)"", FILE * = stderr );
 	void RestartPrimitive( );
 	void SetVerbose( bool );
+	void Upload( );
 
 	VertexBufferObject( )
 	{
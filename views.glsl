@@ -0,0 +1,68 @@
+// views.glsl -- the matrices of the view a vertex is being drawn for
+// (pulled in with #include "views.glsl" by the vertex shaders that can draw more than one view at once)
+
+// MULTIVIEW is set when the program is created, to how a draw reaches each view's layer of the target:
+//	MULTIVIEW_NONE		one view, from the fixed-function matrices
+//	MULTIVIEW_OVR		GL_OVR_multiview: the driver runs the vertex shader once per view, gl_ViewID_OVR says which
+//	MULTIVIEW_LAYERED	an instanced draw, one instance per view, that sets gl_Layer in the vertex shader
+//	MULTIVIEW_LOOP		one draw per view, each into its own layer -- uFirstView says which
+
+#define MULTIVIEW_NONE		0
+#define MULTIVIEW_OVR		1
+#define MULTIVIEW_LAYERED	2
+#define MULTIVIEW_LOOP		3
+
+#ifndef MULTIVIEW
+#define MULTIVIEW		MULTIVIEW_NONE
+#endif
+#ifndef NUM_VIEWS
+#define NUM_VIEWS		1
+#endif
+
+// must match MULTIVIEW_MAX_VIEWS in multiview.h:
+#define MAX_VIEWS		4
+
+
+#if MULTIVIEW != MULTIVIEW_NONE
+
+// must match the std140 layout of ViewUniformData in multiview.h
+// (the normal matrices are mat4s, since a mat3 array pads each column out to a vec4 anyway):
+layout(std140) uniform ViewUniforms
+{
+	mat4	uViewModelView[MAX_VIEWS];
+	mat4	uViewModelViewProjection[MAX_VIEWS];
+	mat4	uViewNormal[MAX_VIEWS];
+	int	uFirstView;
+};
+
+#if MULTIVIEW == MULTIVIEW_OVR
+layout(num_views = NUM_VIEWS) in;
+#define VIEW		( uFirstView + int(gl_ViewID_OVR) )
+#elif MULTIVIEW == MULTIVIEW_LAYERED
+#define VIEW		( uFirstView + gl_InstanceID )
+#else
+#define VIEW		uFirstView
+#endif
+
+#define ViewModelViewMatrix		uViewModelView[VIEW]
+#define ViewModelViewProjectionMatrix	uViewModelViewProjection[VIEW]
+#define ViewNormalMatrix		mat3(uViewNormal[VIEW])
+
+#else
+
+#define ViewModelViewMatrix		gl_ModelViewMatrix
+#define ViewModelViewProjectionMatrix	gl_ModelViewProjectionMatrix
+#define ViewNormalMatrix		gl_NormalMatrix
+
+#endif
+
+
+// send the vertex to its view's layer of the target -- call it once, anywhere in main( ):
+
+void
+SetViewLayer()
+{
+#if MULTIVIEW == MULTIVIEW_LAYERED
+	gl_Layer = gl_InstanceID;
+#endif
+}
@@ -4,30 +4,19 @@ in vec3 vN, vL, vE;
 in vec2 vST;
 in vec3 vModelPos;
 
-uniform sampler2D uNoise;
-uniform sampler2D uNoiseMask;
-uniform sampler2D uWhoosh;
-uniform float uBumpTime;
-uniform float uSpinTime;
-uniform float uBulbTime;
-uniform float uStarTime;
+// uLightPos and the u*Time animation values come from the FrameUniforms block,
+// which GLSLProgram adds to every shader
 
-const float M_PI = 3.141593;
+uniform sampler2DArray uNoiseLayers;		// NOISE_LAYER, NOISE_MASK_LAYER, WHOOSH_LAYER
 
-float 
-rand21(float s, float t)
-{
-	float num1 = fract(sin(s * 342.54 * 2. * M_PI) + sin(t * 987.21 * 2. * M_PI));
-	float num2 = fract(cos(s * 28.54 * 2. * M_PI) + cos(t * 635.17 * 2. * M_PI));
-	return dot(num1, num2);
-}
+#include "common.glsl"
 
 vec4 
 CreateStarfield()
 {
 	float snFreq = 10.;
 	float snAmp = .5;
-	vec4 nv = texture2D(uNoise, snFreq * vST - uStarTime);
+	vec4 nv = texture(uNoiseLayers, vec3(snFreq * vST - uStarTime, NOISE_LAYER));
 	float n = nv.r + nv.g + nv.b + nv.a;
 	n = (n - 2.);
 	n *= snAmp;
@@ -57,7 +46,6 @@ CreateStarfield()
 	float sSquare = dS * dS;
 	float tSquare = dT * dT;
 	float dist = sqrt(sSquare + tSquare);
-	float seed = rand21(float(curCol), float(curRow));
 	float nD = dist + n;
 	float scale = nD / dist;
 	dS *= scale;
@@ -85,11 +73,11 @@ void main()
 
 	vec2 whooshST = vST;
 	whooshST -= uBulbTime;
-	whooshST.s *= 3. + .05 * sin(whooshST.t * 32. + uBulbTime * 32. * M_PI);
-	whooshST.t *= 4. + .1 * sin(whooshST.s * 32. + uBulbTime * 32. * M_PI);
+	whooshST.s *= 3. + .05 * BakedSin(whooshST.t * 32. + uBulbTime * 32. * M_PI);
+	whooshST.t *= 4. + .1 * BakedSin(whooshST.s * 32. + uBulbTime * 32. * M_PI);
 	whooshST.t *= 3.;
-	vec4 col = texture2D(uWhoosh, fract(whooshST));
-	col.a *= abs(sin(vST.t * 6. - uSpinTime * 4. * M_PI));
+	vec4 col = texture(uNoiseLayers, vec3(fract(whooshST), WHOOSH_LAYER));
+	col.a *= abs(BakedSin(vST.t * 6. - uSpinTime * 4. * M_PI));
 	if(col.rgb == vec3(0.)){
 		col.a = 0.;
 	}